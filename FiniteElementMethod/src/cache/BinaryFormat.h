@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace fem::cache
+{
+
+inline constexpr uint32_t BINARY_MAGIC = 0x424D4546; // "FEMB" read as little-endian bytes
+inline constexpr uint16_t BINARY_VERSION = 1;
+inline constexpr size_t BINARY_ALIGNMENT = 64;       // Of every section, so mapped arrays are cache line and SIMD aligned
+
+enum class BinaryKind : uint8_t
+{
+	SparseMatrix = 1, // Sections: outer indices, inner indices, values
+	Vector = 2,       // Sections: values
+	Indices = 3,      // Sections: indices
+	Pattern = 4,      // Sections: block byte offsets, coded outer and inner indices, first nonzero of each block
+	Values = 5,       // Sections: block byte offsets, compressed values
+	Mesh = 6,         // MeshBinaryHeader, sections listed by MeshSection
+};
+
+enum class BinaryCodec : uint8_t
+{
+	None = 0,
+	DeltaVarint = 1,  // Zigzag deltas of the indices within each outer vector as LEB128 varints
+	ShuffleZstd = 2,  // Byte planes of each block of values, zstd compressed
+};
+
+/// <summary>
+/// Fixed header at the start of every cache .bin file, followed by up to three sections at aligned offsets.
+/// Raw kinds store the arrays exactly as Eigen holds them in memory, so a mapped file can be wrapped in Eigen::Map without copies.
+/// Pattern and Values are the compressed form, decoded block by block into owning storage
+/// </summary>
+struct BinaryHeader
+{
+	uint32_t magic = BINARY_MAGIC;
+	uint16_t version = BINARY_VERSION;
+	BinaryKind kind = BinaryKind::SparseMatrix;
+	uint8_t indexWidth = 0;   // Bytes per stored index, 0 when there are none
+	uint8_t scalarWidth = 0;  // Bytes per stored value, 0 when there are none
+	uint8_t storageOrder = 0; // 1 for row-major, 0 for column-major sparse matrices
+	BinaryCodec codec = BinaryCodec::None;
+	uint8_t reserved = 0;
+	uint32_t blockSize = 0;   // Outer vectors or values per independently coded block, 0 when stored raw
+
+	int64_t rows = 0;
+	int64_t cols = 0;
+	int64_t count = 0; // Nonzeros of a sparse matrix, elements of a vector or index list
+
+	uint64_t sectionOffsets[3] = {}; // From the start of the file
+	uint64_t sectionSizes[3] = {};   // In bytes
+	uint64_t checksum = 0;           // XXH3 of the sections in order
+
+	uint8_t padding[32] = {};
+};
+
+static_assert(sizeof(BinaryHeader) == 128, "BinaryHeader layout is part of the file format");
+static_assert(sizeof(BinaryHeader) % BINARY_ALIGNMENT == 0);
+
+enum class MeshSection : uint8_t
+{
+	NodeIds = 0,   // uint64 gmsh tags
+	X,             // double, coordinates stored as separate arrays
+	Y,
+	QuadIds,       // uint64 gmsh tags
+	QuadNodes,     // uint32 local node indices, four per quad
+	LineIds,       // uint64 gmsh tags
+	LineNodes,     // uint32 local node indices, two per line
+	Groups,        // MeshGroupRecord per physical group
+	GroupNames,    // Names of all groups back to back
+	GroupLines,    // uint32 local line indices of all groups back to back
+	Count,
+};
+
+inline constexpr size_t MESH_SECTION_COUNT = static_cast<size_t>(MeshSection::Count);
+
+/// <summary>
+/// Header of the binary mesh stored with a cache entry. Starts like BinaryHeader, so the magic,
+/// version and kind are checked the same way
+/// </summary>
+struct MeshBinaryHeader
+{
+	uint32_t magic = BINARY_MAGIC;
+	uint16_t version = BINARY_VERSION;
+	BinaryKind kind = BinaryKind::Mesh;
+	uint8_t reserved[9] = {};
+
+	uint64_t nodes = 0;
+	uint64_t quads = 0;
+	uint64_t lines = 0;
+	uint64_t groups = 0;
+
+	uint64_t sectionOffsets[MESH_SECTION_COUNT] = {};
+	uint64_t sectionSizes[MESH_SECTION_COUNT] = {};
+	uint64_t checksum = 0; // XXH3 of the sections in order
+
+	uint8_t padding[40] = {};
+};
+
+static_assert(sizeof(MeshBinaryHeader) == 256, "MeshBinaryHeader layout is part of the file format");
+static_assert(sizeof(MeshBinaryHeader) % BINARY_ALIGNMENT == 0);
+
+struct MeshGroupRecord
+{
+	int32_t tag = 0;
+	int32_t dimension = 0;
+	uint64_t nameOffset = 0; // Into GroupNames
+	uint64_t nameLength = 0;
+	uint64_t lineOffset = 0; // Into GroupLines, in lines
+	uint64_t lineCount = 0;
+};
+
+static_assert(sizeof(MeshGroupRecord) == 40);
+
+} // namespace fem::cache
@@ -0,0 +1,109 @@
+#include "CacheKey.h"
+
+#include "domain/ElementMatrixBuilder.h"
+
+#include <format>
+#include <utility>
+
+namespace fem::cache
+{
+
+namespace
+{
+
+void AppendValue(std::string& out, std::string_view key, double value)
+{
+	// Hex floats are exact, -0.0 is folded so it does not split the key
+	out += std::format("{}={:a}\n", key, value == 0.0 ? 0.0 : value);
+}
+
+void AppendValue(std::string& out, std::string_view key, const std::optional<double>& value)
+{
+	if (value)
+		AppendValue(out, key, *value);
+	else
+		out += std::format("{}=none\n", key);
+}
+
+std::string_view ToString(domain::model::BoundaryConditionType type)
+{
+	using enum domain::model::BoundaryConditionType;
+
+	switch (type)
+	{
+	case Temperature: return "temperature";
+	case Flux:        return "flux";
+	case Convection:  return "convection";
+	}
+
+	return "unknown";
+}
+
+void AppendAxis(std::string& out, std::string_view name, const mesh::model::GridAxis& axis)
+{
+	for (std::size_t i = 0; i < axis.points.size(); ++i)
+		AppendValue(out, std::format("{}.points[{}]", name, i), axis.points[i]);
+
+	for (std::size_t i = 0; i < axis.divisions.size(); ++i)
+		out += std::format("{}.divisions[{}]={}\n", name, i, axis.divisions[i]);
+
+	for (std::size_t i = 0; i < axis.progression.size(); ++i)
+		AppendValue(out, std::format("{}.progression[{}]", name, i), axis.progression[i]);
+}
+
+std::string CanonicalMeshSpec(const mesh::model::StructuredMeshSpec& spec)
+{
+	std::string out = "generator=structured\n";
+
+	AppendAxis(out, "x", spec.x);
+	AppendAxis(out, "y", spec.y);
+
+	for (std::size_t side = 0; side < spec.boundaryNames.size(); ++side)
+		for (std::size_t i = 0; i < spec.boundaryNames[side].size(); ++i)
+			out += std::format("boundary[{}][{}]={}\n", side, i, spec.boundaryNames[side][i]);
+
+	return out;
+}
+
+}
+
+CacheKey CacheKey::FromConfig(const config::ProblemConfig& config, const std::string& configFile)
+{
+	const auto& material = config.material;
+	const auto& bc = config.boundaryCondition;
+
+	std::string settings = std::format("version={}\n", VERSION);
+
+	AppendValue(settings, "material.conductivity", material.conductivity);
+	AppendValue(settings, "material.density", material.density);
+	AppendValue(settings, "material.specific_heat", material.specificHeat);
+
+	settings += std::format("bc.group={}\n", bc.physicalGroupName);
+	settings += std::format("bc.type={}\n", ToString(bc.type));
+
+	AppendValue(settings, "bc.temperature", bc.temperature);
+	AppendValue(settings, "bc.heat_flux", bc.heatFlux);
+	AppendValue(settings, "bc.alpha", bc.alpha);
+	AppendValue(settings, "bc.ambient_temperature", bc.ambientTemperature);
+
+	settings += std::format("quadrature.quad={}\n", std::to_underlying(domain::ElementMatrixBuilder::QUAD_SCHEMA));
+	settings += std::format("quadrature.line={}\n", std::to_underlying(domain::ElementMatrixBuilder::LINE_SCHEMA));
+
+	if (config.structuredMesh)
+	{
+		return CacheKey{
+			.meshFile = config.structuredMesh->Describe(),
+			.meshSpec = CanonicalMeshSpec(*config.structuredMesh),
+			.configFile = configFile,
+			.assemblySettings = std::move(settings)
+		};
+	}
+
+	return CacheKey{
+		.meshFile = config.meshPath.string(),
+		.configFile = configFile,
+		.assemblySettings = std::move(settings)
+	};
+}
+
+} // namespace fem::cache
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "config/ProblemConfig.h"
+
+#include <string>
+
+namespace fem::cache
+{
+
+/// <summary>
+/// Identifies a cached system by the mesh content and the settings its assembly depends on. Time stepping,
+/// solver and output settings, the material name and the formatting of the config file are not part of it
+/// </summary>
+struct CacheKey
+{
+	static constexpr int VERSION = 1; // Bump when the canonical settings or the assembly itself change
+
+	std::string meshFile;         // Description of the grid when the mesh is generated
+	std::string meshSpec;         // Canonical generator settings, hashed in place of the mesh file when set
+	std::string configFile;       // Recorded in the metadata only
+	std::string assemblySettings; // Canonical text, one key=value per line with doubles in exact hex form
+
+	static CacheKey FromConfig(const config::ProblemConfig& config, const std::string& configFile);
+};
+
+} // namespace fem::cache
@@ -1,10 +1,16 @@
 ﻿#include "CacheManager.h"
 
 #include "MatrixSerializer.h"
+#include "FileHashCache.h"
+#include "FileLock.h"
 #include "HashUtils.h"
+#include "MeshSerializer.h"
+#include "SparseCodec.h"
+#include "StagingPath.h"
 
 #include "logger/logger.h"
 
+#include <algorithm>
 #include <chrono>
 #include <filesystem>
 #include <fstream>
@@ -17,9 +23,28 @@ namespace fem::cache
 
 namespace fs = std::filesystem;
 
-std::string CacheManager::GetCacheDir(const std::string& cacheRoot, const std::string& meshFile, const std::string& configFile)
+std::optional<std::string> CacheManager::ComputeMeshHash(const std::string& cacheRoot, const CacheKey& key)
 {
-	auto combinedHash = HashUtils::ComputeMultiFileHash({ meshFile, configFile });
+	if (!key.meshSpec.empty())
+		return HashUtils::ComputeStringHash(key.meshSpec);
+
+	return FileHashCache::GetFileHash(cacheRoot, key.meshFile);
+}
+
+std::optional<std::string> CacheManager::ComputeKeyHash(const std::string& cacheRoot, const CacheKey& key)
+{
+	auto meshHash = ComputeMeshHash(cacheRoot, key);
+	if (!meshHash)
+	{
+		return std::nullopt;
+	}
+
+	return HashUtils::CombineHashes({ *meshHash, HashUtils::ComputeStringHash(key.assemblySettings) });
+}
+
+std::string CacheManager::GetCacheDir(const std::string& cacheRoot, const CacheKey& key)
+{
+	auto combinedHash = ComputeKeyHash(cacheRoot, key);
 	if (!combinedHash)
 	{
 		return "";
@@ -34,10 +59,10 @@ bool CacheManager::SaveSteadySystem(
 	const std::string& cacheRoot,
 	const SpMat& H,
 	const Vec& P,
-	const std::string& meshFile,
-	const std::string& configFile)
+	const CacheKey& key,
+	bool compress)
 {
-	std::string cacheDir = GetCacheDir(cacheRoot, meshFile, configFile);
+	std::string cacheDir = GetCacheDir(cacheRoot, key);
 	if (cacheDir.empty())
 	{
 		LOG_ERROR("Failed to compute cache directory path");
@@ -45,37 +70,41 @@ bool CacheManager::SaveSteadySystem(
 	}
 
 	LOG_INFO("Saving steady-state system to cache: {}", cacheDir);
-	fs::create_directories(cacheDir);
 
-	auto meshHash = HashUtils::ComputeFileHash(meshFile);
-	auto configHash = HashUtils::ComputeFileHash(configFile);
-	auto combinedHash = HashUtils::ComputeMultiFileHash({ meshFile, configFile });
+	// Memoized by GetCacheDir above, neither rehashes the mesh
+	auto meshHash = ComputeMeshHash(cacheRoot, key);
+	auto combinedHash = ComputeKeyHash(cacheRoot, key);
 
-	if (!meshHash || !configHash || !combinedHash)
+	if (!meshHash || !combinedHash)
 	{
 		LOG_ERROR("Failed to compute input file hashes");
 		return false;
 	}
 
-	if (!MatrixSerializer::SaveSparseMatrix(cacheDir + "/H.bin", H))
-	{
-		return false;
-	}
+	// Written aside and renamed into place, so no reader sees a partial entry. The analysis and
+	// factors of a previous system are not carried over
+	std::error_code ec;
+	std::string stagingDir = StagingPath::Make(cacheRoot, "tmp");
+	fs::create_directories(stagingDir, ec);
 
-	if (!MatrixSerializer::SaveVector(cacheDir + "/P.bin", P))
+	CacheMetadata meta;
+
+	if (!SaveSystemFiles(stagingDir, H, nullptr, P, compress, meta))
 	{
+		fs::remove_all(stagingDir, ec);
 		return false;
 	}
 
-	CacheMetadata meta;
-	meta.meshFile = meshFile;
-	meta.configFile = configFile;
+	meta.meshFile = key.meshFile;
+	meta.configFile = key.configFile;
 	meta.combinedHash = *combinedHash;
 	meta.meshHash = *meshHash;
-	meta.configHash = *configHash;
-	meta.meshFileSize = fs::file_size(meshFile);
-	meta.configFileSize = fs::file_size(configFile);
+	meta.assemblyHash = HashUtils::ComputeStringHash(key.assemblySettings);
+	meta.assemblySettings = key.assemblySettings;
+	meta.meshFileSize = key.meshSpec.empty() ? fs::file_size(key.meshFile) : 0;
+	meta.configFileSize = fs::file_size(key.configFile);
 	meta.cacheCreatedTime = GetCurrentTimestamp();
+	meta.lastAccessTime = GetUnixTime();
 	meta.matrixHRows = H.rows();
 	meta.matrixHCols = H.cols();
 	meta.matrixHNonzeros = H.nonZeros();
@@ -85,12 +114,13 @@ bool CacheManager::SaveSteadySystem(
 	meta.vectorPSize = P.size();
 	meta.hasCapacityMatrix = false;
 
-	if (!SaveMetadata(cacheDir + "/metadata.json", meta))
+	if (!SaveMetadata(stagingDir + "/metadata.json", meta) || !PublishEntry(cacheRoot, stagingDir, cacheDir))
 	{
+		fs::remove_all(stagingDir, ec);
 		return false;
 	}
 
-	LOG_INFO("Cache saved successfully");
+	LOG_INFO("Cache saved successfully{}", meta.compressed ? " (compressed)" : "");
 	LOG_INFO("  Hash: {}", meta.combinedHash.substr(0, 16));
 	LOG_INFO("  Matrix H: {}x{}, {} nonzeros", meta.matrixHRows, meta.matrixHCols, meta.matrixHNonzeros);
 
@@ -102,10 +132,10 @@ bool CacheManager::SaveTransientSystem(
 	const SpMat& H,
 	const SpMat& C,
 	const Vec& P,
-	const std::string& meshFile,
-	const std::string& configFile)
+	const CacheKey& key,
+	bool compress)
 {
-	std::string cacheDir = GetCacheDir(cacheRoot, meshFile, configFile);
+	std::string cacheDir = GetCacheDir(cacheRoot, key);
 	if (cacheDir.empty())
 	{
 		LOG_ERROR("Failed to compute cache directory path");
@@ -113,42 +143,41 @@ bool CacheManager::SaveTransientSystem(
 	}
 
 	LOG_INFO("Saving transient system to cache: {}", cacheDir);
-	fs::create_directories(cacheDir);
 
-	auto meshHash = HashUtils::ComputeFileHash(meshFile);
-	auto configHash = HashUtils::ComputeFileHash(configFile);
-	auto combinedHash = HashUtils::ComputeMultiFileHash({ meshFile, configFile });
+	// Memoized by GetCacheDir above, neither rehashes the mesh
+	auto meshHash = ComputeMeshHash(cacheRoot, key);
+	auto combinedHash = ComputeKeyHash(cacheRoot, key);
 
-	if (!meshHash || !configHash || !combinedHash)
+	if (!meshHash || !combinedHash)
 	{
 		LOG_ERROR("Failed to compute input file hashes");
 		return false;
 	}
 
-	if (!MatrixSerializer::SaveSparseMatrix(cacheDir + "/H.bin", H))
-	{
-		return false;
-	}
+	// Written aside and renamed into place, so no reader sees a partial entry. The analysis and
+	// factors of a previous system are not carried over
+	std::error_code ec;
+	std::string stagingDir = StagingPath::Make(cacheRoot, "tmp");
+	fs::create_directories(stagingDir, ec);
 
-	if (!MatrixSerializer::SaveSparseMatrix(cacheDir + "/C.bin", C))
-	{
-		return false;
-	}
+	CacheMetadata meta;
 
-	if (!MatrixSerializer::SaveVector(cacheDir + "/P.bin", P))
+	if (!SaveSystemFiles(stagingDir, H, &C, P, compress, meta))
 	{
+		fs::remove_all(stagingDir, ec);
 		return false;
 	}
 
-	CacheMetadata meta;
-	meta.meshFile = meshFile;
-	meta.configFile = configFile;
+	meta.meshFile = key.meshFile;
+	meta.configFile = key.configFile;
 	meta.combinedHash = *combinedHash;
 	meta.meshHash = *meshHash;
-	meta.configHash = *configHash;
-	meta.meshFileSize = fs::file_size(meshFile);
-	meta.configFileSize = fs::file_size(configFile);
+	meta.assemblyHash = HashUtils::ComputeStringHash(key.assemblySettings);
+	meta.assemblySettings = key.assemblySettings;
+	meta.meshFileSize = key.meshSpec.empty() ? fs::file_size(key.meshFile) : 0;
+	meta.configFileSize = fs::file_size(key.configFile);
 	meta.cacheCreatedTime = GetCurrentTimestamp();
+	meta.lastAccessTime = GetUnixTime();
 	meta.matrixHRows = H.rows();
 	meta.matrixHCols = H.cols();
 	meta.matrixHNonzeros = H.nonZeros();
@@ -158,12 +187,13 @@ bool CacheManager::SaveTransientSystem(
 	meta.vectorPSize = P.size();
 	meta.hasCapacityMatrix = true;
 
-	if (!SaveMetadata(cacheDir + "/metadata.json", meta))
+	if (!SaveMetadata(stagingDir + "/metadata.json", meta) || !PublishEntry(cacheRoot, stagingDir, cacheDir))
 	{
+		fs::remove_all(stagingDir, ec);
 		return false;
 	}
 
-	LOG_INFO("Cache saved successfully");
+	LOG_INFO("Cache saved successfully{}", meta.compressed ? " (compressed)" : "");
 	LOG_INFO("  Hash: {}", meta.combinedHash.substr(0, 16));
 	LOG_INFO("  Matrix H: {}x{}, {} nonzeros", meta.matrixHRows, meta.matrixHCols, meta.matrixHNonzeros);
 	LOG_INFO("  Matrix C: {}x{}, {} nonzeros", meta.matrixCRows, meta.matrixCCols, meta.matrixCNonzeros);
@@ -173,11 +203,33 @@ bool CacheManager::SaveTransientSystem(
 
 std::optional<CacheManager::SystemCache> CacheManager::LoadSystem(
 	const std::string& cacheRoot,
-	const std::string& meshFile,
-	const std::string& configFile,
+	const CacheKey& key,
 	bool strictValidation)
 {
-	std::string cacheDir = GetCacheDir(cacheRoot, meshFile, configFile);
+	auto mapped = MapSystem(cacheRoot, key, strictValidation);
+	if (!mapped)
+	{
+		return std::nullopt;
+	}
+
+	SystemCache cache;
+	cache.hasCapacity = mapped->hasCapacity;
+	cache.H = mapped->H.View();
+	cache.P = mapped->P.View();
+
+	if (cache.hasCapacity)
+		cache.C = mapped->C.View();
+
+	LOG_INFO("System loaded from cache successfully");
+	return cache;
+}
+
+std::optional<CacheManager::MappedSystemCache> CacheManager::MapSystem(
+	const std::string& cacheRoot,
+	const CacheKey& key,
+	bool strictValidation)
+{
+	std::string cacheDir = GetCacheDir(cacheRoot, key);
 	if (cacheDir.empty())
 	{
 		LOG_TRACE("Failed to compute cache directory path");
@@ -191,6 +243,13 @@ std::optional<CacheManager::SystemCache> CacheManager::LoadSystem(
 		return std::nullopt;
 	}
 
+	// Held while the files are opened. Mapped pages outlive a later replacement or eviction of the entry
+	FileLock lock;
+	if (!lock.Lock(GetLockPath(cacheDir), FileLock::Mode::Shared))
+	{
+		return std::nullopt;
+	}
+
 	auto meta = LoadMetadata(metadataPath);
 	if (!meta)
 	{
@@ -203,63 +262,532 @@ std::optional<CacheManager::SystemCache> CacheManager::LoadSystem(
 
 	if (strictValidation)
 	{
-		if (!ValidateInputFiles(meshFile, configFile, *meta))
+		if (!ValidateInputFiles(cacheRoot, key, *meta))
 		{
-			LOG_ERROR("Cache validation failed - input files have changed!");
+			LOG_ERROR("Cache validation failed - mesh or assembly settings have changed!");
 			return std::nullopt;
 		}
-		LOG_INFO("Cache validation passed - input files unchanged");
+		LOG_INFO("Cache validation passed - mesh and assembly settings unchanged");
 	}
 
-	SystemCache cache;
+	MappedSystemCache cache;
 	cache.hasCapacity = meta->hasCapacityMatrix;
 
-	if (!MatrixSerializer::LoadSparseMatrix(cacheDir + "/H.bin", cache.H))
+	if (meta->compressed)
 	{
-		LOG_ERROR("Failed to load matrix H");
-		return std::nullopt;
-	}
+		// Compressed entries are decoded into owning storage, the views then point there instead of at the pages
+		SpMat pattern;
+		if (!MatrixSerializer::LoadCompressedPattern(cacheDir + "/pattern.zbin", pattern))
+		{
+			LOG_ERROR("Failed to load the pattern of matrix H");
+			return std::nullopt;
+		}
+
+		SpMat C;
+		if (cache.hasCapacity)
+		{
+			// Only the indices are shared, copying the whole matrix would also copy values that are overwritten next
+			if (meta->sharedPattern)
+			{
+				C.resize(pattern.rows(), pattern.cols());
+				C.resizeNonZeros(pattern.nonZeros());
+				std::copy_n(pattern.outerIndexPtr(), pattern.outerSize() + 1, C.outerIndexPtr());
+				std::copy_n(pattern.innerIndexPtr(), pattern.nonZeros(), C.innerIndexPtr());
+			}
+
+			if ((!meta->sharedPattern && !MatrixSerializer::LoadCompressedPattern(cacheDir + "/C_pattern.zbin", C))
+				|| !MatrixSerializer::LoadCompressedValues(cacheDir + "/C.zbin", C))
+			{
+				LOG_ERROR("Failed to load matrix C");
+				return std::nullopt;
+			}
+
+			cache.C.Adopt(std::move(C));
+		}
+
+		if (!MatrixSerializer::LoadCompressedValues(cacheDir + "/H.zbin", pattern))
+		{
+			LOG_ERROR("Failed to load matrix H");
+			return std::nullopt;
+		}
 
-	if (cache.hasCapacity && !MatrixSerializer::LoadSparseMatrix(cacheDir + "/C.bin", cache.C))
+		cache.H.Adopt(std::move(pattern));
+	}
+	else
 	{
-		LOG_ERROR("Failed to load matrix C");
-		return std::nullopt;
+		if (!MatrixSerializer::MapSparseMatrix(cacheDir + "/H.bin", cache.H, strictValidation))
+		{
+			LOG_ERROR("Failed to load matrix H");
+			return std::nullopt;
+		}
+
+		if (cache.hasCapacity && !MatrixSerializer::MapSparseMatrix(cacheDir + "/C.bin", cache.C, strictValidation))
+		{
+			LOG_ERROR("Failed to load matrix C");
+			return std::nullopt;
+		}
 	}
 
-	if (!MatrixSerializer::LoadVector(cacheDir + "/P.bin", cache.P))
+	if (!MatrixSerializer::MapVector(cacheDir + "/P.bin", cache.P, strictValidation))
 	{
 		LOG_ERROR("Failed to load vector P");
 		return std::nullopt;
 	}
 
-	if (cache.H.rows() != meta->matrixHRows || cache.H.cols() != meta->matrixHCols)
+	if (cache.H.rows != meta->matrixHRows || cache.H.cols != meta->matrixHCols)
 	{
 		LOG_ERROR("Matrix H dimensions mismatch!");
 		return std::nullopt;
 	}
 
-	if (cache.hasCapacity && (cache.C.rows() != meta->matrixCRows || cache.C.cols() != meta->matrixCCols))
+	if (cache.hasCapacity && (cache.C.rows != meta->matrixCRows || cache.C.cols != meta->matrixCCols))
 	{
 		LOG_ERROR("Matrix C dimensions mismatch!");
 		return std::nullopt;
 	}
 
-	if (cache.P.size() != meta->vectorPSize)
+	if (cache.P.size != meta->vectorPSize)
 	{
 		LOG_ERROR("Vector P size mismatch!");
 		return std::nullopt;
 	}
 
-	LOG_INFO("System loaded from cache successfully");
+	lock.Unlock();
+
+	UpdateMetadata(cacheDir, [](CacheMetadata& meta)
+	{
+		meta.lastAccessTime = GetUnixTime();
+		return true;
+	});
+
+	LOG_TRACE("System mapped from cache: {}", cacheDir);
 	return cache;
 }
 
+bool CacheManager::SaveSystemFiles(
+	const std::string& cacheDir,
+	const SpMat& H,
+	const SpMat* C,
+	const Vec& P,
+	bool compress,
+	CacheMetadata& meta)
+{
+	meta.compressed = compress;
+	meta.sharedPattern = false;
+
+	if (!MatrixSerializer::SaveVector(cacheDir + "/P.bin", P))
+	{
+		return false;
+	}
+
+	if (!compress)
+	{
+		return MatrixSerializer::SaveSparseMatrix(cacheDir + "/H.bin", H)
+			&& (!C || MatrixSerializer::SaveSparseMatrix(cacheDir + "/C.bin", *C));
+	}
+
+	if (!MatrixSerializer::SaveCompressedPattern(cacheDir + "/pattern.zbin", H)
+		|| !MatrixSerializer::SaveCompressedValues(cacheDir + "/H.zbin", H))
+	{
+		return false;
+	}
+
+	if (C)
+	{
+		// H and C are assembled from the same element stencils, so C usually reuses the pattern of H
+		meta.sharedPattern = SparseCodec::SamePattern(H, *C);
+
+		if (!meta.sharedPattern && !MatrixSerializer::SaveCompressedPattern(cacheDir + "/C_pattern.zbin", *C))
+		{
+			return false;
+		}
+
+		if (!MatrixSerializer::SaveCompressedValues(cacheDir + "/C.zbin", *C))
+		{
+			return false;
+		}
+	}
+
+	size_t rawBytes = (H.outerSize() + 1 + H.nonZeros()) * sizeof(SpMat::StorageIndex) + H.nonZeros() * sizeof(double);
+	size_t storedBytes = fs::file_size(cacheDir + "/pattern.zbin") + fs::file_size(cacheDir + "/H.zbin");
+
+	if (C)
+	{
+		rawBytes += (C->outerSize() + 1 + C->nonZeros()) * sizeof(SpMat::StorageIndex) + C->nonZeros() * sizeof(double);
+		storedBytes += fs::file_size(cacheDir + "/C.zbin") + (meta.sharedPattern ? 0 : fs::file_size(cacheDir + "/C_pattern.zbin"));
+	}
+
+	LOG_INFO("Compressed system matrices: {:.2f} MB of {:.2f} MB raw{}",
+		storedBytes / (1024.0 * 1024.0), rawBytes / (1024.0 * 1024.0), meta.sharedPattern ? ", pattern shared by H and C" : "");
+
+	return true;
+}
+
+bool CacheManager::SaveSymbolicAnalysis(
+	const std::string& cacheRoot,
+	const CacheKey& key,
+	const SymbolicCache& symbolic)
+{
+	std::string cacheDir = GetCacheDir(cacheRoot, key);
+	if (cacheDir.empty())
+	{
+		LOG_ERROR("Failed to compute cache directory path");
+		return false;
+	}
+
+	if (!fs::exists(cacheDir))
+	{
+		LOG_TRACE("No system cache to attach the symbolic analysis to: {}", cacheDir);
+		return false;
+	}
+
+	FileLock lock;
+	if (!lock.Lock(GetLockPath(cacheDir), FileLock::Mode::Exclusive))
+	{
+		return false;
+	}
+
+	auto meta = LoadMetadata(cacheDir + "/metadata.json");
+	if (!meta)
+	{
+		LOG_TRACE("No system cache to attach the symbolic analysis to: {}", cacheDir);
+		return false;
+	}
+
+	if (!MatrixSerializer::SaveIndices(cacheDir + "/symbolic.bin", symbolic.permutation))
+	{
+		return false;
+	}
+
+	meta->hasSymbolicAnalysis = true;
+	meta->symbolicSignature = symbolic.signature;
+	meta->symbolicRows = symbolic.rows;
+	meta->symbolicNonzeros = symbolic.nonZeros;
+	meta->symbolicAnalysisTimeMs = symbolic.analysisTimeMs;
+	meta->symbolicHits = 0;
+	meta->symbolicLastSavedMs = 0.0;
+
+	if (!SaveMetadata(cacheDir + "/metadata.json", *meta))
+	{
+		return false;
+	}
+
+	LOG_INFO("Symbolic analysis saved to cache: {} ({} rows, analysis took {:.2f} ms)", symbolic.signature, symbolic.rows, symbolic.analysisTimeMs);
+	return true;
+}
+
+std::optional<CacheManager::SymbolicCache> CacheManager::LoadSymbolicAnalysis(
+	const std::string& cacheRoot,
+	const CacheKey& key)
+{
+	std::string cacheDir = GetCacheDir(cacheRoot, key);
+	if (cacheDir.empty())
+	{
+		return std::nullopt;
+	}
+
+	if (!fs::exists(cacheDir))
+	{
+		return std::nullopt;
+	}
+
+	FileLock lock;
+	if (!lock.Lock(GetLockPath(cacheDir), FileLock::Mode::Shared))
+	{
+		return std::nullopt;
+	}
+
+	auto meta = LoadMetadata(cacheDir + "/metadata.json");
+	if (!meta || !meta->hasSymbolicAnalysis)
+	{
+		LOG_TRACE("No symbolic analysis cached in: {}", cacheDir);
+		return std::nullopt;
+	}
+
+	SymbolicCache symbolic;
+	symbolic.signature = meta->symbolicSignature;
+	symbolic.rows = meta->symbolicRows;
+	symbolic.nonZeros = meta->symbolicNonzeros;
+	symbolic.analysisTimeMs = meta->symbolicAnalysisTimeMs;
+
+	if (!MatrixSerializer::LoadIndices(cacheDir + "/symbolic.bin", symbolic.permutation))
+	{
+		LOG_WARN("Failed to load cached symbolic analysis");
+		return std::nullopt;
+	}
+
+	if (symbolic.permutation.size() != static_cast<size_t>(symbolic.rows))
+	{
+		LOG_WARN("Cached permutation size mismatch, ignoring it");
+		return std::nullopt;
+	}
+
+	LOG_INFO("Symbolic analysis loaded from cache: {} (saves up to {:.2f} ms)", symbolic.signature, symbolic.analysisTimeMs);
+	return symbolic;
+}
+
+bool CacheManager::RecordSymbolicReuse(
+	const std::string& cacheRoot,
+	const CacheKey& key,
+	double savedMs)
+{
+	std::string cacheDir = GetCacheDir(cacheRoot, key);
+	if (cacheDir.empty())
+	{
+		return false;
+	}
+
+	return UpdateMetadata(cacheDir, [savedMs](CacheMetadata& meta)
+	{
+		if (!meta.hasSymbolicAnalysis)
+			return false;
+
+		meta.symbolicHits++;
+		meta.symbolicLastSavedMs = savedMs;
+		return true;
+	});
+}
+
+bool CacheManager::SaveMesh(
+	const std::string& cacheRoot,
+	const CacheKey& key,
+	const mesh::model::Mesh& mesh)
+{
+	std::string cacheDir = GetCacheDir(cacheRoot, key);
+	if (cacheDir.empty())
+	{
+		LOG_ERROR("Failed to compute cache directory path");
+		return false;
+	}
+
+	if (!fs::exists(cacheDir))
+	{
+		LOG_TRACE("No system cache to attach the mesh to: {}", cacheDir);
+		return false;
+	}
+
+	FileLock lock;
+	if (!lock.Lock(GetLockPath(cacheDir), FileLock::Mode::Exclusive))
+	{
+		return false;
+	}
+
+	auto meta = LoadMetadata(cacheDir + "/metadata.json");
+	if (!meta)
+	{
+		LOG_TRACE("No system cache to attach the mesh to: {}", cacheDir);
+		return false;
+	}
+
+	auto start = std::chrono::steady_clock::now();
+
+	if (!MeshSerializer::SaveMesh(cacheDir + "/mesh.bin", mesh))
+	{
+		return false;
+	}
+
+	auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	meta->hasBinaryMesh = true;
+
+	if (!SaveMetadata(cacheDir + "/metadata.json", *meta))
+	{
+		return false;
+	}
+
+	LOG_INFO("Mesh saved to cache: {} nodes, {} quads ({:.2f} MB, written in {:.2f} ms)",
+		mesh.GetNodesCount(), mesh.GetQuads().size(),
+		fs::file_size(cacheDir + "/mesh.bin") / (1024.0 * 1024.0), elapsed);
+
+	return true;
+}
+
+std::optional<mesh::model::Mesh> CacheManager::LoadMesh(
+	const std::string& cacheRoot,
+	const CacheKey& key)
+{
+	std::string cacheDir = GetCacheDir(cacheRoot, key);
+	if (cacheDir.empty())
+	{
+		return std::nullopt;
+	}
+
+	if (!fs::exists(cacheDir))
+	{
+		return std::nullopt;
+	}
+
+	FileLock lock;
+	if (!lock.Lock(GetLockPath(cacheDir), FileLock::Mode::Shared))
+	{
+		return std::nullopt;
+	}
+
+	auto meta = LoadMetadata(cacheDir + "/metadata.json");
+	if (!meta || !meta->hasBinaryMesh)
+	{
+		LOG_TRACE("No binary mesh cached in: {}", cacheDir);
+		return std::nullopt;
+	}
+
+	auto start = std::chrono::steady_clock::now();
+
+	auto mesh = MeshSerializer::LoadMesh(cacheDir + "/mesh.bin", true);
+	if (!mesh)
+	{
+		LOG_WARN("Failed to load cached mesh");
+		return std::nullopt;
+	}
+
+	auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	LOG_INFO("Mesh loaded from cache: {} nodes, {} quads, {} lines in {:.2f} ms",
+		mesh->GetNodesCount(), mesh->GetQuads().size(), mesh->GetLines().size(), elapsed);
+
+	return mesh;
+}
+
+bool CacheManager::SaveFactor(
+	const std::string& cacheRoot,
+	const CacheKey& key,
+	const FactorCache& factor)
+{
+	std::string cacheDir = GetCacheDir(cacheRoot, key);
+	if (cacheDir.empty())
+	{
+		LOG_ERROR("Failed to compute cache directory path");
+		return false;
+	}
+
+	if (!fs::exists(cacheDir))
+	{
+		LOG_TRACE("No system cache to attach the factors to: {}", cacheDir);
+		return false;
+	}
+
+	FileLock lock;
+	if (!lock.Lock(GetLockPath(cacheDir), FileLock::Mode::Exclusive))
+	{
+		return false;
+	}
+
+	auto meta = LoadMetadata(cacheDir + "/metadata.json");
+	if (!meta)
+	{
+		LOG_TRACE("No system cache to attach the factors to: {}", cacheDir);
+		return false;
+	}
+
+	auto start = std::chrono::steady_clock::now();
+
+	if (!MatrixSerializer::SaveFactor(cacheDir + "/factor_L.bin", factor.L)
+		|| !MatrixSerializer::SaveVector(cacheDir + "/factor_D.bin", factor.D)
+		|| !MatrixSerializer::SaveIndices(cacheDir + "/factor_perm.bin", factor.permutation))
+	{
+		return false;
+	}
+
+	auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	meta->hasFactor = true;
+	meta->factorSignature = factor.signature;
+	meta->factorMatrixHash = factor.matrixHash;
+	meta->factorNonzeros = factor.L.nonZeros();
+	meta->factorizationTimeMs = factor.factorizationTimeMs;
+	meta->factorHits = 0;
+	meta->factorLastLoadMs = 0.0;
+
+	if (!SaveMetadata(cacheDir + "/metadata.json", *meta))
+	{
+		return false;
+	}
+
+	LOG_INFO("Cholesky factors saved to cache: {} ({} nonzeros, {:.2f} MB, written in {:.2f} ms)",
+		factor.signature, factor.L.nonZeros(),
+		fs::file_size(cacheDir + "/factor_L.bin") / (1024.0 * 1024.0), elapsed);
+
+	return true;
+}
+
+std::optional<CacheManager::FactorCache> CacheManager::LoadFactor(
+	const std::string& cacheRoot,
+	const CacheKey& key,
+	const std::string& matrixHash)
+{
+	std::string cacheDir = GetCacheDir(cacheRoot, key);
+	if (cacheDir.empty())
+	{
+		return std::nullopt;
+	}
+
+	if (!fs::exists(cacheDir))
+	{
+		return std::nullopt;
+	}
+
+	FileLock lock;
+	if (!lock.Lock(GetLockPath(cacheDir), FileLock::Mode::Shared))
+	{
+		return std::nullopt;
+	}
+
+	auto meta = LoadMetadata(cacheDir + "/metadata.json");
+	if (!meta || !meta->hasFactor)
+	{
+		LOG_TRACE("No Cholesky factors cached in: {}", cacheDir);
+		return std::nullopt;
+	}
+
+	if (meta->factorMatrixHash != matrixHash)
+	{
+		LOG_INFO("Cached Cholesky factors belong to a different matrix, ignoring them");
+		return std::nullopt;
+	}
+
+	auto start = std::chrono::steady_clock::now();
+
+	// Loaded straight into the returned optional, wrapping a finished FactorCache would copy L
+	std::optional<FactorCache> result;
+	auto& factor = result.emplace();
+	factor.signature = meta->factorSignature;
+	factor.matrixHash = meta->factorMatrixHash;
+	factor.factorizationTimeMs = meta->factorizationTimeMs;
+
+	if (!MatrixSerializer::LoadFactor(cacheDir + "/factor_L.bin", factor.L)
+		|| !MatrixSerializer::LoadVector(cacheDir + "/factor_D.bin", factor.D)
+		|| !MatrixSerializer::LoadIndices(cacheDir + "/factor_perm.bin", factor.permutation))
+	{
+		LOG_WARN("Failed to load cached Cholesky factors");
+		return std::nullopt;
+	}
+
+	if (static_cast<size_t>(factor.L.nonZeros()) != meta->factorNonzeros)
+	{
+		LOG_WARN("Cached Cholesky factor size mismatch, ignoring it");
+		return std::nullopt;
+	}
+
+	auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	LOG_INFO("Cholesky factors loaded from cache in {:.2f} ms (factorization took {:.2f} ms)", elapsed, factor.factorizationTimeMs);
+
+	lock.Unlock();
+
+	UpdateMetadata(cacheDir, [elapsed](CacheMetadata& meta)
+	{
+		meta.factorHits++;
+		meta.factorLastLoadMs = elapsed;
+		return true;
+	});
+
+	return result;
+}
+
 bool CacheManager::IsValidCache(
 	const std::string& cacheRoot,
-	const std::string& meshFile,
-	const std::string& configFile)
+	const CacheKey& key)
 {
-	std::string cacheDir = GetCacheDir(cacheRoot, meshFile, configFile);
+	std::string cacheDir = GetCacheDir(cacheRoot, key);
 	if (cacheDir.empty())
 	{
 		return false;
@@ -271,7 +799,7 @@ bool CacheManager::IsValidCache(
 		return false;
 	}
 
-	return ValidateInputFiles(meshFile, configFile, *meta);
+	return ValidateInputFiles(cacheRoot, key, *meta);
 }
 
 bool CacheManager::ClearCache(const std::string& cacheRoot)
@@ -313,6 +841,23 @@ bool CacheManager::ClearAllCaches(const std::string& cacheRoot)
 				count++;
 			}
 		}
+
+		// Locks outlive their entries by design, drop those left without one unless somebody holds them
+		for (const auto& entry : fs::directory_iterator(cacheRoot))
+		{
+			const auto& path = entry.path();
+			if (!entry.is_regular_file() || path.extension() != ".lock")
+				continue;
+
+			std::error_code ec;
+			if (fs::exists(fs::path(path).replace_extension(), ec) || ec)
+				continue;
+
+			FileLock lock;
+			if (lock.Lock(path.string(), FileLock::Mode::Exclusive, false))
+				fs::remove(path, ec);
+		}
+
 		LOG_INFO("Cleared {} cache entries from: {}", count, cacheRoot);
 		return true;
 	}
@@ -323,9 +868,95 @@ bool CacheManager::ClearAllCaches(const std::string& cacheRoot)
 	}
 }
 
-void CacheManager::PrintCacheInfo(const std::string& cacheRoot, const std::string& meshFile, const std::string& configFile)
+size_t CacheManager::EnforceSizeLimit(const std::string& cacheRoot, uint64_t maxBytes)
 {
-	std::string cacheDir = GetCacheDir(cacheRoot, meshFile, configFile);
+	struct Entry
+	{
+		fs::path path;
+		uint64_t bytes;
+		int64_t lastAccessTime;
+	};
+
+	std::vector<Entry> entries;
+	uint64_t totalBytes = 0;
+
+	std::error_code ec;
+	for (const auto& entry : fs::directory_iterator(cacheRoot, ec))
+	{
+		if (!entry.is_directory(ec))
+			continue;
+
+		if (StagingPath::Is(entry.path()))
+		{
+			// Replaced entries are garbage at once, unfinished writes only once their writer is surely gone
+			const bool retired = entry.path().filename().string().starts_with(".old-");
+			const auto age = fs::file_time_type::clock::now() - entry.last_write_time(ec);
+
+			if (retired || (!ec && age > STALE_STAGING_AGE))
+				fs::remove_all(entry.path(), ec);
+
+			continue;
+		}
+
+		auto meta = GetMetadata(entry.path().string());
+		if (!meta)
+			continue;
+
+		entries.push_back(Entry{ entry.path(), GetDirectorySize(entry.path()), meta->lastAccessTime });
+		totalBytes += entries.back().bytes;
+	}
+
+	if (totalBytes <= maxBytes)
+		return 0;
+
+	std::ranges::sort(entries, {}, &Entry::lastAccessTime);
+
+	size_t evicted = 0;
+	uint64_t freedBytes = 0;
+
+	for (const auto& entry : entries)
+	{
+		if (totalBytes <= maxBytes)
+			break;
+
+		const std::string cacheDir = entry.path.string();
+
+		// Entries another process is reading or writing are skipped rather than waited for
+		FileLock lock;
+		if (!lock.Lock(GetLockPath(cacheDir), FileLock::Mode::Exclusive, false))
+			continue;
+
+		const std::string retiredDir = StagingPath::Make(cacheRoot, "old");
+		fs::rename(entry.path, retiredDir, ec);
+
+		if (ec)
+		{
+			LOG_WARN("Failed to evict cache entry {}: {}", cacheDir, ec.message());
+			continue;
+		}
+
+		// Removed while held, a process still waiting on the old lock then finds the entry gone
+		fs::remove(GetLockPath(cacheDir), ec);
+
+		lock.Unlock();
+		fs::remove_all(retiredDir, ec);
+
+		LOG_TRACE("Evicted cache entry {} ({:.2f} MB)", cacheDir, entry.bytes / (1024.0 * 1024.0));
+
+		totalBytes -= entry.bytes;
+		freedBytes += entry.bytes;
+		evicted++;
+	}
+
+	LOG_INFO("Evicted {} least recently used cache entries ({:.2f} MB), {:.2f} MB of {:.2f} MB allowed in use",
+		evicted, freedBytes / (1024.0 * 1024.0), totalBytes / (1024.0 * 1024.0), maxBytes / (1024.0 * 1024.0));
+
+	return evicted;
+}
+
+void CacheManager::PrintCacheInfo(const std::string& cacheRoot, const CacheKey& key)
+{
+	std::string cacheDir = GetCacheDir(cacheRoot, key);
 	if (cacheDir.empty())
 	{
 		LOG_INFO("Failed to compute cache directory path");
@@ -342,12 +973,13 @@ void CacheManager::PrintCacheInfo(const std::string& cacheRoot, const std::strin
 	LOG_INFO("Cache Information:");
 	LOG_INFO("  Location: {}", cacheDir);
 	LOG_INFO("  Created: {}", meta->cacheCreatedTime);
+	LOG_INFO("  Last used: {}", FormatUnixTime(meta->lastAccessTime));
 	LOG_INFO("  Input Files:");
 	LOG_INFO("    Mesh:   {} ({:.2f} MB)", meta->meshFile, meta->meshFileSize / (1024.0 * 1024.0));
 	LOG_INFO("    Config: {} ({:.2f} KB)", meta->configFile, meta->configFileSize / 1024.0);
 	LOG_INFO("  Hashes:");
 	LOG_INFO("    Mesh:     {}", meta->meshHash);
-	LOG_INFO("    Config:   {}", meta->configHash);
+	LOG_INFO("    Assembly: {}", meta->assemblyHash);
 	LOG_INFO("    Combined: {}", meta->combinedHash);
 	LOG_INFO("  System:");
 	LOG_INFO("    Matrix H: {}x{}, {} nonzeros",
@@ -358,16 +990,24 @@ void CacheManager::PrintCacheInfo(const std::string& cacheRoot, const std::strin
 			meta->matrixCRows, meta->matrixCCols, meta->matrixCNonzeros);
 	}
 	LOG_INFO("    Vector P: {} elements", meta->vectorPSize);
-
-	size_t cacheSize = 0;
-	for (const auto& entry : fs::recursive_directory_iterator(cacheDir))
+	LOG_INFO("    Format:   {}", meta->compressed ? (meta->sharedPattern ? "compressed, shared pattern" : "compressed") : "raw (memory-mapped)");
+	LOG_INFO("    Mesh:     {}", meta->hasBinaryMesh ? "binary (gmsh skipped on load)" : "not cached");
+	if (meta->hasSymbolicAnalysis)
 	{
-		if (entry.is_regular_file())
-		{
-			cacheSize += entry.file_size();
-		}
+		LOG_INFO("  Symbolic analysis:");
+		LOG_INFO("    Signature: {} ({} rows)", meta->symbolicSignature, meta->symbolicRows);
+		LOG_INFO("    Analysis:  {:.2f} ms, reused {} times (last saved {:.2f} ms)",
+			meta->symbolicAnalysisTimeMs, meta->symbolicHits, meta->symbolicLastSavedMs);
 	}
-	LOG_INFO("  Cache size: {:.2f} MB", cacheSize / (1024.0 * 1024.0));
+	if (meta->hasFactor)
+	{
+		LOG_INFO("  Cholesky factors:");
+		LOG_INFO("    Signature:     {} ({} nonzeros)", meta->factorSignature, meta->factorNonzeros);
+		LOG_INFO("    Factorization: {:.2f} ms, loaded {} times (last load {:.2f} ms)",
+			meta->factorizationTimeMs, meta->factorHits, meta->factorLastLoadMs);
+	}
+
+	LOG_INFO("  Cache size: {:.2f} MB", GetDirectorySize(cacheDir) / (1024.0 * 1024.0));
 }
 
 void CacheManager::ListCaches(const std::string& cacheRoot)
@@ -385,23 +1025,17 @@ void CacheManager::ListCaches(const std::string& cacheRoot)
 
 	for (const auto& entry : fs::directory_iterator(cacheRoot))
 	{
-		if (!entry.is_directory()) continue;
+		if (!entry.is_directory() || StagingPath::Is(entry.path())) continue;
 
 		auto meta = GetMetadata(entry.path().string());
 		if (!meta) continue;
 
-		size_t dirSize = 0;
-		for (const auto& file : fs::recursive_directory_iterator(entry.path()))
-		{
-			if (file.is_regular_file())
-			{
-				dirSize += file.file_size();
-			}
-		}
+		size_t dirSize = GetDirectorySize(entry.path());
 
-		LOG_INFO("  [{}] {} - {}x{} matrix, {:.2f} MB",
+		LOG_INFO("  [{}] {} (last used {}) - {}x{} matrix, {:.2f} MB",
 			entry.path().filename().string(),
 			meta->cacheCreatedTime,
+			FormatUnixTime(meta->lastAccessTime),
 			meta->matrixHRows, meta->matrixHCols,
 			dirSize / (1024.0 * 1024.0));
 
@@ -424,10 +1058,12 @@ bool CacheManager::SaveMetadata(const std::string& filename, const CacheMetadata
 	j["config_file"] = meta.configFile;
 	j["combined_hash"] = meta.combinedHash;
 	j["mesh_hash"] = meta.meshHash;
-	j["config_hash"] = meta.configHash;
+	j["assembly_hash"] = meta.assemblyHash;
+	j["assembly_settings"] = meta.assemblySettings;
 	j["mesh_file_size"] = meta.meshFileSize;
 	j["config_file_size"] = meta.configFileSize;
 	j["cache_created_time"] = meta.cacheCreatedTime;
+	j["last_access_time"] = meta.lastAccessTime;
 	j["matrix_h_rows"] = meta.matrixHRows;
 	j["matrix_h_cols"] = meta.matrixHCols;
 	j["matrix_h_nonzeros"] = meta.matrixHNonzeros;
@@ -436,15 +1072,52 @@ bool CacheManager::SaveMetadata(const std::string& filename, const CacheMetadata
 	j["matrix_c_nonzeros"] = meta.matrixCNonzeros;
 	j["vector_p_size"] = meta.vectorPSize;
 	j["has_capacity_matrix"] = meta.hasCapacityMatrix;
+	j["compressed"] = meta.compressed;
+	j["shared_pattern"] = meta.sharedPattern;
+	j["binary_mesh"] = meta.hasBinaryMesh;
 
-	std::ofstream file(filename);
-	if (!file.is_open())
+	if (meta.hasSymbolicAnalysis)
 	{
-		return false;
+		j["symbolic"]["signature"] = meta.symbolicSignature;
+		j["symbolic"]["rows"] = meta.symbolicRows;
+		j["symbolic"]["nonzeros"] = meta.symbolicNonzeros;
+		j["symbolic"]["analysis_time_ms"] = meta.symbolicAnalysisTimeMs;
+		j["symbolic"]["hits"] = meta.symbolicHits;
+		j["symbolic"]["last_saved_ms"] = meta.symbolicLastSavedMs;
 	}
 
-	file << j.dump(2);
-	return true;
+	if (meta.hasFactor)
+	{
+		j["factor"]["signature"] = meta.factorSignature;
+		j["factor"]["matrix_hash"] = meta.factorMatrixHash;
+		j["factor"]["nonzeros"] = meta.factorNonzeros;
+		j["factor"]["factorization_time_ms"] = meta.factorizationTimeMs;
+		j["factor"]["hits"] = meta.factorHits;
+		j["factor"]["last_load_ms"] = meta.factorLastLoadMs;
+	}
+
+	// Replaced with a rename, a reader never parses a half-written file
+	const std::string tempFilename = filename + ".tmp";
+
+	{
+		std::ofstream file(tempFilename);
+		if (!file.is_open())
+		{
+			return false;
+		}
+
+		file << j.dump(2);
+
+		if (!file)
+		{
+			return false;
+		}
+	}
+
+	std::error_code ec;
+	fs::rename(tempFilename, filename, ec);
+
+	return !ec;
 }
 
 std::optional<CacheManager::CacheMetadata> CacheManager::LoadMetadata(const std::string& filename)
@@ -470,10 +1143,12 @@ std::optional<CacheManager::CacheMetadata> CacheManager::LoadMetadata(const std:
 		meta.configFile = j["config_file"];
 		meta.combinedHash = j["combined_hash"];
 		meta.meshHash = j["mesh_hash"];
-		meta.configHash = j["config_hash"];
+		meta.assemblyHash = j.value("assembly_hash", "");
+		meta.assemblySettings = j.value("assembly_settings", "");
 		meta.meshFileSize = j["mesh_file_size"];
 		meta.configFileSize = j["config_file_size"];
 		meta.cacheCreatedTime = j["cache_created_time"];
+		meta.lastAccessTime = j.value("last_access_time", int64_t{ 0 });
 		meta.matrixHRows = j["matrix_h_rows"];
 		meta.matrixHCols = j["matrix_h_cols"];
 		meta.matrixHNonzeros = j["matrix_h_nonzeros"];
@@ -482,6 +1157,36 @@ std::optional<CacheManager::CacheMetadata> CacheManager::LoadMetadata(const std:
 		meta.matrixCNonzeros = j["matrix_c_nonzeros"];
 		meta.vectorPSize = j["vector_p_size"];
 		meta.hasCapacityMatrix = j["has_capacity_matrix"];
+		meta.compressed = j.value("compressed", false);
+		meta.sharedPattern = j.value("shared_pattern", false);
+		meta.hasBinaryMesh = j.value("binary_mesh", false);
+
+		// Optional, older caches have no symbolic analysis
+		if (j.contains("symbolic"))
+		{
+			const auto& symbolic = j["symbolic"];
+
+			meta.hasSymbolicAnalysis = true;
+			meta.symbolicSignature = symbolic["signature"];
+			meta.symbolicRows = symbolic["rows"];
+			meta.symbolicNonzeros = symbolic["nonzeros"];
+			meta.symbolicAnalysisTimeMs = symbolic["analysis_time_ms"];
+			meta.symbolicHits = symbolic.value("hits", size_t{ 0 });
+			meta.symbolicLastSavedMs = symbolic.value("last_saved_ms", 0.0);
+		}
+
+		if (j.contains("factor"))
+		{
+			const auto& factor = j["factor"];
+
+			meta.hasFactor = true;
+			meta.factorSignature = factor["signature"];
+			meta.factorMatrixHash = factor["matrix_hash"];
+			meta.factorNonzeros = factor["nonzeros"];
+			meta.factorizationTimeMs = factor["factorization_time_ms"];
+			meta.factorHits = factor.value("hits", size_t{ 0 });
+			meta.factorLastLoadMs = factor.value("last_load_ms", 0.0);
+		}
 
 		return meta;
 	}
@@ -493,23 +1198,17 @@ std::optional<CacheManager::CacheMetadata> CacheManager::LoadMetadata(const std:
 }
 
 bool CacheManager::ValidateInputFiles(
-	const std::string& meshFile,
-	const std::string& configFile,
+	const std::string& cacheRoot,
+	const CacheKey& key,
 	const CacheMetadata& meta)
 {
-	if (!fs::exists(meshFile))
+	if (key.meshSpec.empty() && !fs::exists(key.meshFile))
 	{
-		LOG_ERROR("Mesh file not found: {}", meshFile);
+		LOG_ERROR("Mesh file not found: {}", key.meshFile);
 		return false;
 	}
 
-	if (!fs::exists(configFile))
-	{
-		LOG_ERROR("Config file not found: {}", configFile);
-		return false;
-	}
-
-	auto currentCombinedHash = HashUtils::ComputeMultiFileHash({ meshFile, configFile });
+	auto currentCombinedHash = ComputeKeyHash(cacheRoot, key);
 
 	if (!currentCombinedHash)
 	{
@@ -519,7 +1218,7 @@ bool CacheManager::ValidateInputFiles(
 
 	if (*currentCombinedHash != meta.combinedHash)
 	{
-		LOG_WARN("Input files have changed!");
+		LOG_WARN("Mesh or assembly settings have changed!");
 		LOG_WARN("  Expected hash: {}", meta.combinedHash);
 		LOG_WARN("  Current hash:  {}", *currentCombinedHash);
 		return false;
@@ -528,6 +1227,107 @@ bool CacheManager::ValidateInputFiles(
 	return true;
 }
 
+bool CacheManager::PublishEntry(const std::string& cacheRoot, const std::string& stagingDir, const std::string& cacheDir)
+{
+	FileLock lock;
+	if (!lock.Lock(GetLockPath(cacheDir), FileLock::Mode::Exclusive))
+	{
+		return false;
+	}
+
+	std::error_code ec;
+	std::string retiredDir;
+
+	// A directory cannot be renamed over another one, so the previous entry is moved aside first
+	if (fs::exists(cacheDir))
+	{
+		retiredDir = StagingPath::Make(cacheRoot, "old");
+		fs::rename(cacheDir, retiredDir, ec);
+
+		if (ec)
+		{
+			LOG_ERROR("Failed to replace cache entry {}: {}", cacheDir, ec.message());
+			return false;
+		}
+	}
+
+	fs::rename(stagingDir, cacheDir, ec);
+
+	if (ec)
+	{
+		LOG_ERROR("Failed to publish cache entry {}: {}", cacheDir, ec.message());
+
+		if (!retiredDir.empty())
+			fs::rename(retiredDir, cacheDir, ec);
+
+		return false;
+	}
+
+	lock.Unlock();
+
+	if (!retiredDir.empty())
+		fs::remove_all(retiredDir, ec);
+
+	return true;
+}
+
+bool CacheManager::UpdateMetadata(const std::string& cacheDir, const std::function<bool(CacheMetadata&)>& update)
+{
+	FileLock lock;
+	if (!lock.Lock(GetLockPath(cacheDir), FileLock::Mode::Exclusive))
+	{
+		return false;
+	}
+
+	auto meta = LoadMetadata(cacheDir + "/metadata.json");
+	if (!meta || !update(*meta))
+	{
+		return false;
+	}
+
+	return SaveMetadata(cacheDir + "/metadata.json", *meta);
+}
+
+std::string CacheManager::GetLockPath(const std::string& cacheDir)
+{
+	// Next to the entry rather than inside it, so the lock outlives the directory being replaced
+	return cacheDir + ".lock";
+}
+
+uint64_t CacheManager::GetDirectorySize(const fs::path& path)
+{
+	uint64_t size = 0;
+
+	std::error_code ec;
+	for (const auto& entry : fs::recursive_directory_iterator(path, ec))
+	{
+		if (entry.is_regular_file(ec))
+		{
+			size += entry.file_size(ec);
+		}
+	}
+
+	return size;
+}
+
+int64_t CacheManager::GetUnixTime()
+{
+	using namespace std::chrono;
+
+	return duration_cast<seconds>(system_clock::now().time_since_epoch()).count();
+}
+
+std::string CacheManager::FormatUnixTime(int64_t time)
+{
+	if (time == 0)
+	{
+		return "never";
+	}
+
+	const std::chrono::sys_seconds point{ std::chrono::seconds{ time } };
+	return std::format("{:%Y-%m-%d %H:%M:%S} UTC", point);
+}
+
 std::string CacheManager::GetCurrentTimestamp()
 {
 	using namespace std::chrono;
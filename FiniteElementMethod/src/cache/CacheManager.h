@@ -1,7 +1,15 @@
 #pragma once
 
+#include "CacheKey.h"
+#include "MatrixSerializer.h"
+
 #include "math/math.h"
+#include "mesh/model/Mesh.h"
 
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
 #include <string>
 #include <vector>
 #include <optional>
@@ -23,16 +31,54 @@ public:
 		bool hasCapacity;
 	};
 
+	/// <summary>
+	/// System mapped from the cache files without copies, the views stay valid while this object lives
+	/// </summary>
+	struct MappedSystemCache
+	{
+		MappedSparseMatrix H;
+		MappedSparseMatrix C; // Unmapped when there is no capacity matrix
+		MappedVector P;
+		bool hasCapacity;
+	};
+
+	/// <summary>
+	/// Fill-reducing permutation of the system matrix, stored next to H.bin since it depends only on its pattern
+	/// </summary>
+	struct SymbolicCache
+	{
+		std::string signature; // Solver, ordering and backend that computed it
+		int64_t rows = 0;      // Of the analyzed matrix
+		int64_t nonZeros = 0;
+		std::vector<int> permutation;
+		double analysisTimeMs = 0.0;
+	};
+
+	/// <summary>
+	/// Numeric Cholesky factors of one exact matrix, identified by a hash of its pattern and values
+	/// </summary>
+	struct FactorCache
+	{
+		std::string signature;  // Solver, ordering and backend that computed it
+		std::string matrixHash; // HashUtils::ComputeMatrixHash of the factorized matrix
+		CscMat L;
+		Vec D;                  // Empty for LL^T
+		std::vector<int> permutation;
+		double factorizationTimeMs = 0.0;
+	};
+
 	struct CacheMetadata
 	{
 		std::string meshFile;
 		std::string configFile;
-		std::string combinedHash;
+		std::string combinedHash;     // Of meshHash and assemblyHash
 		std::string meshHash;
-		std::string configHash;
+		std::string assemblyHash;
+		std::string assemblySettings; // CacheKey::assemblySettings the entry was built with
 		size_t meshFileSize;
 		size_t configFileSize;
 		std::string cacheCreatedTime;
+		int64_t lastAccessTime = 0; // Unix seconds, entries used longest ago are evicted first
 		size_t matrixHRows;
 		size_t matrixHCols;
 		size_t matrixHNonzeros;
@@ -41,49 +87,145 @@ public:
 		size_t matrixCNonzeros;
 		size_t vectorPSize;
 		bool hasCapacityMatrix;
+		bool compressed = false;    // Pattern and values in .zbin files instead of raw H.bin and C.bin
+		bool sharedPattern = false; // C stored as values on the pattern of H
+		bool hasBinaryMesh = false; // mesh.bin, read instead of the mesh file on later runs
+
+		bool hasSymbolicAnalysis = false;
+		std::string symbolicSignature;
+		int64_t symbolicRows = 0;
+		int64_t symbolicNonzeros = 0;
+		double symbolicAnalysisTimeMs = 0.0; // When it was computed
+		size_t symbolicHits = 0;             // Runs that reused it
+		double symbolicLastSavedMs = 0.0;    // Analysis time saved by the most recent reuse
+
+		bool hasFactor = false;
+		std::string factorSignature;
+		std::string factorMatrixHash;
+		size_t factorNonzeros = 0;
+		double factorizationTimeMs = 0.0; // When it was computed
+		size_t factorHits = 0;            // Runs that loaded it
+		double factorLastLoadMs = 0.0;    // Load time of the most recent reuse
 	};
 
 	static bool SaveSteadySystem(
 		const std::string& cacheRoot,
 		const SpMat& H,
 		const Vec& P,
-		const std::string& meshFile,
-		const std::string& configFile);
+		const CacheKey& key,
+		bool compress = false);
 
 	static bool SaveTransientSystem(
 		const std::string& cacheRoot,
 		const SpMat& H,
 		const SpMat& C,
 		const Vec& P,
-		const std::string& meshFile,
-		const std::string& configFile);
+		const CacheKey& key,
+		bool compress = false);
 
 	static std::optional<SystemCache> LoadSystem(
 		const std::string& cacheRoot,
-		const std::string& meshFile,
-		const std::string& configFile,
+		const CacheKey& key,
 		bool strictValidation = true);
 
+	/// <summary>
+	/// Same validation as LoadSystem, but the matrices are served from the shared page cache instead of being copied.
+	/// Strict validation also verifies the checksums of the mapped files
+	/// </summary>
+	static std::optional<MappedSystemCache> MapSystem(
+		const std::string& cacheRoot,
+		const CacheKey& key,
+		bool strictValidation = true);
+
+	/// <summary>
+	/// Attaches a symbolic analysis to an existing system cache, replacing any previous one
+	/// </summary>
+	static bool SaveSymbolicAnalysis(
+		const std::string& cacheRoot,
+		const CacheKey& key,
+		const SymbolicCache& symbolic);
+
+	static std::optional<SymbolicCache> LoadSymbolicAnalysis(
+		const std::string& cacheRoot,
+		const CacheKey& key);
+
+	/// <summary>
+	/// Records in the metadata that a run reused the stored analysis and how much time that saved
+	/// </summary>
+	static bool RecordSymbolicReuse(
+		const std::string& cacheRoot,
+		const CacheKey& key,
+		double savedMs);
+
+	/// <summary>
+	/// Attaches the binary form of the mesh to an existing system cache
+	/// </summary>
+	static bool SaveMesh(
+		const std::string& cacheRoot,
+		const CacheKey& key,
+		const mesh::model::Mesh& mesh);
+
+	static std::optional<mesh::model::Mesh> LoadMesh(
+		const std::string& cacheRoot,
+		const CacheKey& key);
+
+	static bool SaveFactor(
+		const std::string& cacheRoot,
+		const CacheKey& key,
+		const FactorCache& factor);
+
+	/// <summary>
+	/// Factors stored for exactly the matrix with matrixHash, nullopt for any other matrix
+	/// </summary>
+	static std::optional<FactorCache> LoadFactor(
+		const std::string& cacheRoot,
+		const CacheKey& key,
+		const std::string& matrixHash);
+
 	static bool IsValidCache(
 		const std::string& cacheRoot,
-		const std::string& meshFile,
-		const std::string& configFile);
+		const CacheKey& key);
 
 	static bool ClearCache(const std::string& cacheRoot);
 
 	static bool ClearAllCaches(const std::string& cacheRoot);
 
-	static void PrintCacheInfo(const std::string& cacheRoot, const std::string& meshFile, const std::string& configFile);
+	/// <summary>
+	/// Evicts the least recently used entries until the cache fits in maxBytes, skipping entries that are in use.
+	/// Also removes staging directories left behind by interrupted writers. Returns the number of evicted entries
+	/// </summary>
+	static size_t EnforceSizeLimit(const std::string& cacheRoot, uint64_t maxBytes);
+
+	static void PrintCacheInfo(const std::string& cacheRoot, const CacheKey& key);
 
 	static void ListCaches(const std::string& cacheRoot);
 
 	static std::optional<CacheMetadata> GetMetadata(const std::string& cacheDir);
 
 private:
-	static std::string GetCacheDir(const std::string& cacheRoot, const std::string& meshFile, const std::string& configFile);
+	static constexpr auto STALE_STAGING_AGE = std::chrono::hours(24);
+
+	static bool SaveSystemFiles(const std::string& cacheDir, const SpMat& H, const SpMat* C, const Vec& P, bool compress, CacheMetadata& meta);
+	static std::optional<std::string> ComputeMeshHash(const std::string& cacheRoot, const CacheKey& key);
+	static std::optional<std::string> ComputeKeyHash(const std::string& cacheRoot, const CacheKey& key);
+	static std::string GetCacheDir(const std::string& cacheRoot, const CacheKey& key);
+	/// <summary>
+	/// Swaps the staging directory in for the entry under its exclusive lock
+	/// </summary>
+	static bool PublishEntry(const std::string& cacheRoot, const std::string& stagingDir, const std::string& cacheDir);
+
+	/// <summary>
+	/// Read-modify-write of the entry metadata under its exclusive lock, nothing is written when update returns false
+	/// </summary>
+	static bool UpdateMetadata(const std::string& cacheDir, const std::function<bool(CacheMetadata&)>& update);
+
+	static std::string GetLockPath(const std::string& cacheDir);
+	static uint64_t GetDirectorySize(const std::filesystem::path& path);
+	static int64_t GetUnixTime();
+	static std::string FormatUnixTime(int64_t time);
 	static bool SaveMetadata(const std::string& filename, const CacheMetadata& meta);
 	static std::optional<CacheMetadata> LoadMetadata(const std::string& filename);
-	static bool ValidateInputFiles(const std::string& meshFile, const std::string& configFile, const CacheMetadata& meta);
+	static bool ValidateInputFiles(const std::string& cacheRoot, const CacheKey& key, const CacheMetadata& meta);
 	static std::string GetCurrentTimestamp();
 
 	CacheManager() = delete;
@@ -0,0 +1,115 @@
+#include "CacheWriter.h"
+
+#include "logger/logger.h"
+
+#include <chrono>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace fem::cache
+{
+
+CacheWriter::~CacheWriter()
+{
+	Wait();
+
+	{
+		std::lock_guard lock(m_Mutex);
+		m_Stop = true;
+	}
+
+	m_JobAvailable.notify_one();
+
+	if (m_Thread.joinable())
+		m_Thread.join();
+}
+
+void CacheWriter::Submit(std::string name, std::function<void()> job)
+{
+	{
+		std::lock_guard lock(m_Mutex);
+
+		if (!m_Thread.joinable())
+			m_Thread = std::thread(&CacheWriter::Run, this);
+
+		m_Jobs.push_back(Job{ std::move(name), std::move(job) });
+	}
+
+	m_JobAvailable.notify_one();
+}
+
+double CacheWriter::Wait()
+{
+	auto start = std::chrono::steady_clock::now();
+
+	std::unique_lock lock(m_Mutex);
+
+	if (m_Jobs.empty() && !m_Busy)
+		return 0.0;
+
+	LOG_INFO("Waiting for {} pending cache write(s)...", m_Jobs.size() + (m_Busy ? 1 : 0));
+
+	m_Idle.wait(lock, [this] { return m_Jobs.empty() && !m_Busy; });
+
+	auto waitedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	m_Stats.waitMs += waitedMs;
+
+	return waitedMs;
+}
+
+CacheWriterStats CacheWriter::GetStats() const
+{
+	std::lock_guard lock(m_Mutex);
+	return m_Stats;
+}
+
+void CacheWriter::Run()
+{
+#ifdef _OPENMP
+	// The solver keeps every core, parallel regions of the writes run on this thread alone
+	omp_set_num_threads(1);
+#endif
+
+	std::unique_lock lock(m_Mutex);
+
+	while (true)
+	{
+		m_JobAvailable.wait(lock, [this] { return m_Stop || !m_Jobs.empty(); });
+
+		if (m_Jobs.empty())
+			return;
+
+		Job job = std::move(m_Jobs.front());
+		m_Jobs.pop_front();
+		m_Busy = true;
+
+		lock.unlock();
+
+		auto start = std::chrono::steady_clock::now();
+
+		try
+		{
+			job.run();
+		}
+		catch (const std::exception& e)
+		{
+			LOG_ERROR("Cache write '{}' failed: {}", job.name, e.what());
+		}
+
+		auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		LOG_TRACE("Cache write '{}' finished in {:.2f} ms", job.name, elapsed);
+
+		lock.lock();
+
+		m_Busy = false;
+		m_Stats.jobs++;
+		m_Stats.writeMs += elapsed;
+
+		if (m_Jobs.empty())
+			m_Idle.notify_all();
+	}
+}
+
+} // namespace fem::cache
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace fem::cache
+{
+
+struct CacheWriterStats
+{
+	size_t jobs = 0;
+	double writeMs = 0.0; // Spent in the jobs on the writer thread
+	double waitMs = 0.0;  // Callers blocked in Wait, the part of writeMs that did not overlap other work
+};
+
+/// <summary>
+/// Runs cache writes on one background thread in submission order, so a symbolic analysis or factor
+/// saved after a system always finds its entry. Jobs must own their data or only read data that stays
+/// unchanged until Wait returns. The destructor waits for outstanding jobs
+/// </summary>
+class CacheWriter
+{
+public:
+	CacheWriter() = default;
+	~CacheWriter();
+
+	CacheWriter(const CacheWriter&) = delete;
+	CacheWriter& operator=(const CacheWriter&) = delete;
+
+	void Submit(std::string name, std::function<void()> job);
+
+	/// <summary>
+	/// Blocks until every submitted job has finished, returns the time spent blocked in ms
+	/// </summary>
+	double Wait();
+
+	CacheWriterStats GetStats() const;
+
+private:
+	struct Job
+	{
+		std::string name;
+		std::function<void()> run;
+	};
+
+	void Run();
+
+	std::thread m_Thread; // Started by the first submission
+	mutable std::mutex m_Mutex;
+	std::condition_variable m_JobAvailable;
+	std::condition_variable m_Idle;
+	std::deque<Job> m_Jobs;
+	bool m_Busy = false;
+	bool m_Stop = false;
+	CacheWriterStats m_Stats;
+};
+
+} // namespace fem::cache
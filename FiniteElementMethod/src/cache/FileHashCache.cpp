@@ -0,0 +1,182 @@
+#include "FileHashCache.h"
+
+#include "HashUtils.h"
+#include "JsonFile.h"
+
+#include "logger/logger.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <mutex>
+#include <unordered_map>
+
+#include <nlohmann/json.hpp>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/stat.h>
+#endif
+
+namespace fem::cache
+{
+
+namespace fs = std::filesystem;
+
+namespace
+{
+
+struct MemoEntry
+{
+	uint64_t size;
+	int64_t modifiedTime;
+	uint64_t inode;
+	std::string hash;
+};
+
+std::mutex s_Mutex;
+std::unordered_map<std::string, MemoEntry> s_Memo; // By absolute path
+
+}
+
+std::optional<std::string> FileHashCache::GetFileHash(const std::string& cacheRoot, const std::string& filename)
+{
+	auto stat = Stat(filename);
+	if (!stat)
+	{
+		LOG_ERROR("File not found for hashing: {}", filename);
+		return std::nullopt;
+	}
+
+	std::error_code ec;
+	const std::string path = fs::absolute(filename, ec).lexically_normal().string();
+
+	std::lock_guard lock(s_Mutex);
+
+	if (auto it = s_Memo.find(path); it != s_Memo.end())
+	{
+		const auto& entry = it->second;
+		if (FileStat{ entry.size, entry.modifiedTime, entry.inode } == *stat)
+			return entry.hash;
+	}
+
+	const std::string indexPath = GetIndexPath(cacheRoot);
+	auto index = JsonFile::Read(indexPath);
+
+	if (auto it = index.find(path); it != index.end())
+	{
+		try
+		{
+			FileStat indexed{
+				.size = it->at("size").get<uint64_t>(),
+				.modifiedTime = it->at("modified_time").get<int64_t>(),
+				.inode = it->at("inode").get<uint64_t>()
+			};
+
+			if (indexed == *stat)
+			{
+				auto hash = it->at("hash").get<std::string>();
+				s_Memo[path] = MemoEntry{ stat->size, stat->modifiedTime, stat->inode, hash };
+
+				LOG_TRACE("File unchanged since it was last hashed: {}", filename);
+				return hash;
+			}
+		}
+		catch (const nlohmann::json::exception& e)
+		{
+			LOG_WARN("Ignoring malformed file hash entry {}: {}", path, e.what());
+		}
+	}
+
+	auto hash = HashUtils::ComputeFileHash(filename);
+	if (!hash)
+	{
+		return std::nullopt;
+	}
+
+	// A file modified while it was hashed must not be indexed under its old stat
+	if (Stat(filename) != stat)
+	{
+		LOG_WARN("File changed while it was hashed: {}", filename);
+		return hash;
+	}
+
+	s_Memo[path] = MemoEntry{ stat->size, stat->modifiedTime, stat->inode, *hash };
+
+	// Other processes may share the cache root and index their own files meanwhile, the entry is added under the lock
+	JsonFile::Update(indexPath, [&](nlohmann::json& index)
+		{
+			index[path] = {
+				{ "size",          stat->size },
+				{ "modified_time", stat->modifiedTime },
+				{ "inode",         stat->inode },
+				{ "hash",          *hash }
+			};
+		});
+
+	return hash;
+}
+
+std::optional<std::string> FileHashCache::GetCombinedHash(const std::string& cacheRoot, const std::vector<std::string>& filenames)
+{
+	std::vector<std::string> sortedFiles = filenames;
+	std::ranges::sort(sortedFiles);
+
+	std::vector<std::string> hashes;
+	hashes.reserve(sortedFiles.size());
+
+	for (const auto& filename : sortedFiles)
+	{
+		auto hash = GetFileHash(cacheRoot, filename);
+		if (!hash)
+		{
+			return std::nullopt;
+		}
+
+		hashes.push_back(std::move(*hash));
+	}
+
+	return HashUtils::CombineHashes(hashes);
+}
+
+std::optional<FileHashCache::FileStat> FileHashCache::Stat(const std::string& filename)
+{
+	std::error_code ec;
+
+	FileStat stat;
+	stat.size = fs::file_size(filename, ec);
+	if (ec)
+		return std::nullopt;
+
+	stat.modifiedTime = fs::last_write_time(filename, ec).time_since_epoch().count();
+	if (ec)
+		return std::nullopt;
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(filename.c_str(), 0, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file != INVALID_HANDLE_VALUE)
+	{
+		BY_HANDLE_FILE_INFORMATION info;
+		if (GetFileInformationByHandle(file, &info))
+			stat.inode = (static_cast<uint64_t>(info.nFileIndexHigh) << 32) | info.nFileIndexLow;
+
+		CloseHandle(file);
+	}
+#else
+	struct stat info;
+	if (::stat(filename.c_str(), &info) == 0)
+		stat.inode = static_cast<uint64_t>(info.st_ino);
+#endif
+
+	return stat;
+}
+
+std::string FileHashCache::GetIndexPath(const std::string& cacheRoot)
+{
+	return cacheRoot + "/file_hashes.json";
+}
+
+} // namespace fem::cache
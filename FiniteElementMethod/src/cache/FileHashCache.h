@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace fem::cache
+{
+
+/// <summary>
+/// Content hashes of input files keyed by their size, modification time and inode. Each file is hashed
+/// at most once per process, and not at all while the index under the cache root still matches its stat
+/// </summary>
+class FileHashCache
+{
+public:
+	static std::optional<std::string> GetFileHash(const std::string& cacheRoot, const std::string& filename);
+
+	/// <summary>
+	/// Same key as HashUtils::ComputeMultiFileHash, built from the cached file hashes
+	/// </summary>
+	static std::optional<std::string> GetCombinedHash(const std::string& cacheRoot, const std::vector<std::string>& filenames);
+
+private:
+	struct FileStat
+	{
+		uint64_t size = 0;
+		int64_t modifiedTime = 0; // Ticks of the filesystem clock
+		uint64_t inode = 0;       // File index on Windows
+
+		bool operator==(const FileStat&) const = default;
+	};
+
+	static std::optional<FileStat> Stat(const std::string& filename);
+	static std::string GetIndexPath(const std::string& cacheRoot);
+
+	FileHashCache() = delete;
+};
+
+} // namespace fem::cache
@@ -0,0 +1,153 @@
+#include "FileLock.h"
+
+#include "logger/logger.h"
+
+#include <utility>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
+namespace fem::cache
+{
+
+FileLock::~FileLock()
+{
+	Unlock();
+}
+
+FileLock::FileLock(FileLock&& other) noexcept
+{
+	*this = std::move(other);
+}
+
+FileLock& FileLock::operator=(FileLock&& other) noexcept
+{
+	if (this != &other)
+	{
+		Unlock();
+
+#ifdef _WIN32
+		m_File = std::exchange(other.m_File, nullptr);
+#else
+		m_Fd = std::exchange(other.m_Fd, -1);
+#endif
+	}
+
+	return *this;
+}
+
+#ifdef _WIN32
+
+bool FileLock::Lock(const std::string& filename, Mode mode, bool wait)
+{
+	Unlock();
+
+	HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+		nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		LOG_ERROR("Failed to open lock file: {}", filename);
+		return false;
+	}
+
+	DWORD flags = 0;
+	if (mode == Mode::Exclusive)
+		flags |= LOCKFILE_EXCLUSIVE_LOCK;
+	if (!wait)
+		flags |= LOCKFILE_FAIL_IMMEDIATELY;
+
+	OVERLAPPED overlapped{};
+	if (!LockFileEx(file, flags, 0, MAXDWORD, MAXDWORD, &overlapped))
+	{
+		if (wait)
+			LOG_ERROR("Failed to lock file: {}", filename);
+
+		CloseHandle(file);
+		return false;
+	}
+
+	m_File = file;
+	return true;
+}
+
+void FileLock::Unlock()
+{
+	if (!m_File)
+		return;
+
+	OVERLAPPED overlapped{};
+	UnlockFileEx(m_File, 0, MAXDWORD, MAXDWORD, &overlapped);
+	CloseHandle(m_File);
+
+	m_File = nullptr;
+}
+
+bool FileLock::IsLocked() const
+{
+	return m_File != nullptr;
+}
+
+#else
+
+bool FileLock::Lock(const std::string& filename, Mode mode, bool wait)
+{
+	Unlock();
+
+	int fd = ::open(filename.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0666);
+	if (fd < 0)
+	{
+		LOG_ERROR("Failed to open lock file: {}", filename);
+		return false;
+	}
+
+	int operation = mode == Mode::Exclusive ? LOCK_EX : LOCK_SH;
+	if (!wait)
+		operation |= LOCK_NB;
+
+	// flock locks belong to the open file, so two locks of one process on the same file also exclude each other
+	int result;
+	do
+	{
+		result = ::flock(fd, operation);
+	} while (result != 0 && errno == EINTR);
+
+	if (result != 0)
+	{
+		if (wait)
+			LOG_ERROR("Failed to lock file: {}", filename);
+
+		::close(fd);
+		return false;
+	}
+
+	m_Fd = fd;
+	return true;
+}
+
+void FileLock::Unlock()
+{
+	if (m_Fd < 0)
+		return;
+
+	::flock(m_Fd, LOCK_UN);
+	::close(m_Fd);
+
+	m_Fd = -1;
+}
+
+bool FileLock::IsLocked() const
+{
+	return m_Fd >= 0;
+}
+
+#endif
+
+} // namespace fem::cache
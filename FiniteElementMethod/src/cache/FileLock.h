@@ -0,0 +1,46 @@
+#pragma once
+
+#include <string>
+
+namespace fem::cache
+{
+
+/// <summary>
+/// Advisory lock on a file, created when missing. Shared locks are held by readers of a cache entry and
+/// exclusive ones by the process replacing, updating or evicting it. Released on destruction
+/// </summary>
+class FileLock
+{
+public:
+	enum class Mode
+	{
+		Shared,
+		Exclusive,
+	};
+
+	FileLock() = default;
+	~FileLock();
+
+	FileLock(const FileLock&) = delete;
+	FileLock& operator=(const FileLock&) = delete;
+
+	FileLock(FileLock&& other) noexcept;
+	FileLock& operator=(FileLock&& other) noexcept;
+
+	/// <summary>
+	/// Waits until the lock is granted, unless wait is false
+	/// </summary>
+	bool Lock(const std::string& filename, Mode mode, bool wait = true);
+	void Unlock();
+
+	bool IsLocked() const;
+
+private:
+#ifdef _WIN32
+	void* m_File = nullptr;
+#else
+	int m_Fd = -1;
+#endif
+};
+
+} // namespace fem::cache
@@ -0,0 +1,63 @@
+#include "GeneratedMeshCache.h"
+
+#include "FileHashCache.h"
+#include "HashUtils.h"
+#include "StagingPath.h"
+
+#include "logger/logger.h"
+
+#include <filesystem>
+#include <format>
+
+namespace fem::cache
+{
+
+namespace fs = std::filesystem;
+
+std::optional<std::string> GeneratedMeshCache::GetMeshPath(const std::string& cacheRoot, const std::string& geoFile, const std::string& settings)
+{
+	auto geoHash = FileHashCache::GetFileHash(cacheRoot, geoFile);
+	if (!geoHash)
+	{
+		return std::nullopt;
+	}
+
+	auto hash = HashUtils::CombineHashes({ *geoHash, HashUtils::ComputeStringHash(settings) });
+
+	return std::format("{}/meshes/{}.msh", cacheRoot, hash.substr(0, 16));
+}
+
+std::string GeneratedMeshCache::GetStagingPath(const std::string& meshPath)
+{
+	const auto directory = fs::path(meshPath).parent_path().string();
+
+	std::error_code ec;
+	fs::create_directories(directory, ec);
+
+	return StagingPath::Make(directory, "tmp", ".msh");
+}
+
+bool GeneratedMeshCache::Publish(const std::string& stagingPath, const std::string& meshPath)
+{
+	std::error_code ec;
+	fs::rename(stagingPath, meshPath, ec);
+
+	if (!ec)
+	{
+		return true;
+	}
+
+	// Windows does not replace a file another process has open, which then is the same mesh
+	if (fs::exists(meshPath))
+	{
+		fs::remove(stagingPath, ec);
+		return true;
+	}
+
+	LOG_ERROR("Failed to publish generated mesh {}: {}", meshPath, ec.message());
+	fs::remove(stagingPath, ec);
+
+	return false;
+}
+
+} // namespace fem::cache
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <optional>
+#include <string>
+
+namespace fem::cache
+{
+
+/// <summary>
+/// Meshes gmsh generated from .geo files, kept under the cache root by the content hash of the .geo and the
+/// settings of the run that meshed it. Files the .geo includes or merges are not part of the key
+/// </summary>
+class GeneratedMeshCache
+{
+public:
+	/// <summary>
+	/// Where the mesh of geoFile meshed with these settings is published, std::nullopt when the .geo cannot be hashed
+	/// </summary>
+	static std::optional<std::string> GetMeshPath(const std::string& cacheRoot, const std::string& geoFile, const std::string& settings);
+
+	/// <summary>
+	/// Unique file next to meshPath for gmsh to write, the extension is kept as gmsh picks the format from it
+	/// </summary>
+	static std::string GetStagingPath(const std::string& meshPath);
+
+	/// <summary>
+	/// Renames the written mesh into place. Concurrent runs meshing the same .geo each publish a complete file
+	/// </summary>
+	static bool Publish(const std::string& stagingPath, const std::string& meshPath);
+
+private:
+	GeneratedMeshCache() = delete;
+};
+
+} // namespace fem::cache
@@ -1,7 +1,11 @@
 #include "HashUtils.h"
 
+#include "MappedFile.h"
+
 #include "logger/logger.h"
 
+#include <algorithm>
+#include <array>
 #include <fstream>
 #include <filesystem>
 #include <xxhash.h>
@@ -15,74 +19,80 @@ namespace fs = std::filesystem;
 
 std::optional<std::string> HashUtils::ComputeFileHash(const std::string& filename)
 {
-	if (!fs::exists(filename))
+	std::error_code ec;
+	const auto size = fs::file_size(filename, ec);
+
+	if (ec)
 	{
 		LOG_ERROR("File not found for hashing: {}", filename);
 		return std::nullopt;
 	}
 
-	std::ifstream file(filename, std::ios::binary);
-	if (!file.is_open())
+	MappedFile file;
+	if (size > 0 && !file.Open(filename))
 	{
 		LOG_ERROR("Cannot open file for hashing: {}", filename);
 		return std::nullopt;
 	}
 
-	XXH64_state_t* state = XXH64_createState();
-	XXH64_reset(state, 0);
-
-	constexpr size_t bufferSize = 8192;
-	std::vector<char> buffer(bufferSize);
+	// The segment size is fixed, so the hash does not depend on the thread count
+	const std::ptrdiff_t segments = static_cast<std::ptrdiff_t>((size + HASH_SEGMENT_BYTES - 1) / HASH_SEGMENT_BYTES);
+	std::vector<XXH128_hash_t> digests(segments);
 
-	while (file.read(buffer.data(), bufferSize) || file.gcount() > 0)
+#pragma omp parallel for schedule(dynamic, 1)
+	for (std::ptrdiff_t i = 0; i < segments; ++i)
 	{
-		XXH64_update(state, buffer.data(), file.gcount());
+		const size_t offset = static_cast<size_t>(i) * HASH_SEGMENT_BYTES;
+		digests[i] = XXH3_128bits(file.GetData() + offset, std::min<size_t>(HASH_SEGMENT_BYTES, size - offset));
 	}
 
-	uint64_t hash = XXH64_digest(state);
-	XXH64_freeState(state);
+	XXH3_state_t* state = XXH3_createState();
+	XXH3_128bits_reset(state);
 
-	return std::format("{:016x}", hash);
+	const uint64_t length = size;
+	XXH3_128bits_update(state, &length, sizeof(length));
+	XXH3_128bits_update(state, digests.data(), digests.size() * sizeof(XXH128_hash_t));
+
+	XXH128_hash_t hash = XXH3_128bits_digest(state);
+	XXH3_freeState(state);
+
+	return std::format("{:016x}{:016x}", hash.high64, hash.low64);
 }
 
 std::optional<std::string> HashUtils::ComputeMultiFileHash(const std::vector<std::string>& filenames)
 {
-	XXH64_state_t* state = XXH64_createState();
-	XXH64_reset(state, 0);
-
 	std::vector<std::string> sortedFiles = filenames;
 	std::ranges::sort(sortedFiles);
 
+	std::vector<std::string> hashes;
+	hashes.reserve(sortedFiles.size());
+
 	for (const auto& filename : sortedFiles)
 	{
-		if (!fs::exists(filename))
+		auto hash = ComputeFileHash(filename);
+		if (!hash)
 		{
-			LOG_ERROR("File not found for multi-hash: {}", filename);
-			XXH64_freeState(state);
 			return std::nullopt;
 		}
 
-		std::ifstream file(filename, std::ios::binary);
-		if (!file.is_open())
-		{
-			LOG_ERROR("Cannot open file for multi-hash: {}", filename);
-			XXH64_freeState(state);
-			return std::nullopt;
-		}
+		hashes.push_back(std::move(*hash));
+	}
 
-		constexpr size_t bufferSize = 8192;
-		std::vector<char> buffer(bufferSize);
+	return CombineHashes(hashes);
+}
 
-		while (file.read(buffer.data(), bufferSize) || file.gcount() > 0)
-		{
-			XXH64_update(state, buffer.data(), file.gcount());
-		}
-	}
+std::string HashUtils::CombineHashes(const std::vector<std::string>& hashes)
+{
+	std::string joined;
 
-	uint64_t hash = XXH64_digest(state);
-	XXH64_freeState(state);
+	for (const auto& hash : hashes)
+	{
+		joined += hash;
+		joined += '\n';
+	}
 
-	return std::format("{:016x}", hash);
+	XXH128_hash_t hash = XXH3_128bits(joined.data(), joined.size());
+	return std::format("{:016x}{:016x}", hash.high64, hash.low64);
 }
 
 std::string HashUtils::ComputeStringHash(const std::string& content)
@@ -100,4 +110,45 @@ std::optional<std::string> HashUtils::ValidateAndHash(const std::string& filenam
 	return ComputeFileHash(filename);
 }
 
+std::string HashUtils::ComputeSparsityPatternHash(const SpMat& A)
+{
+	return ComputeSparseHash(A, false);
+}
+
+std::string HashUtils::ComputeMatrixHash(const SpMat& A)
+{
+	return ComputeSparseHash(A, true);
+}
+
+std::string HashUtils::ComputeSparseHash(const SpMat& A, bool includeValues)
+{
+	XXH64_state_t* state = XXH64_createState();
+	XXH64_reset(state, 0);
+
+	const std::array<int64_t, 3> shape{ A.rows(), A.cols(), A.IsRowMajor ? 1 : 0 };
+	XXH64_update(state, shape.data(), sizeof(shape));
+
+	const auto* outer = A.outerIndexPtr();
+	const auto* inner = A.innerIndexPtr();
+	const auto* values = A.valuePtr();
+	const auto* innerNonZeros = A.innerNonZeroPtr();
+
+	// One outer vector at a time, so compressed and uncompressed storage of a matrix agree
+	for (Eigen::Index j = 0; j < A.outerSize(); ++j)
+	{
+		const auto count = innerNonZeros ? innerNonZeros[j] : outer[j + 1] - outer[j];
+
+		XXH64_update(state, &count, sizeof(count));
+		XXH64_update(state, inner + outer[j], static_cast<size_t>(count) * sizeof(*inner));
+
+		if (includeValues)
+			XXH64_update(state, values + outer[j], static_cast<size_t>(count) * sizeof(*values));
+	}
+
+	uint64_t hash = XXH64_digest(state);
+	XXH64_freeState(state);
+
+	return std::format("{:016x}", hash);
+}
+
 } // namespace fem::cache
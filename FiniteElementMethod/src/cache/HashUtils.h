@@ -1,5 +1,7 @@
 #pragma once
 
+#include "math/math.h"
+
 #include <string>
 #include <optional>
 #include <vector>
@@ -10,15 +12,40 @@ namespace fem::cache
 class HashUtils
 {
 public:
+	static constexpr size_t HASH_SEGMENT_BYTES = 64 * 1024 * 1024;
+
+	/// <summary>
+	/// XXH3-128 of the mapped file, hashed in independent segments on all threads and combined with the file size
+	/// </summary>
 	static std::optional<std::string> ComputeFileHash(const std::string& filename);
 
+	/// <summary>
+	/// Combined hash of the files in name order, see CombineHashes
+	/// </summary>
 	static std::optional<std::string> ComputeMultiFileHash(const std::vector<std::string>& filenames);
 
+	/// <summary>
+	/// Order-sensitive XXH3-128 of already computed hashes
+	/// </summary>
+	static std::string CombineHashes(const std::vector<std::string>& hashes);
+
 	static std::string ComputeStringHash(const std::string& content);
 
 	static std::optional<std::string> ValidateAndHash(const std::string& filename);
 
+	/// <summary>
+	/// Hash of the dimensions and nonzero positions of A, values are ignored
+	/// </summary>
+	static std::string ComputeSparsityPatternHash(const SpMat& A);
+
+	/// <summary>
+	/// Hash of the dimensions, nonzero positions and values of A
+	/// </summary>
+	static std::string ComputeMatrixHash(const SpMat& A);
+
 private:
+	static std::string ComputeSparseHash(const SpMat& A, bool includeValues);
+
 	HashUtils() = delete;
 };
 
@@ -0,0 +1,91 @@
+#include "JsonFile.h"
+
+#include "FileLock.h"
+
+#include "logger/logger.h"
+
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <random>
+
+namespace fem::cache
+{
+
+namespace fs = std::filesystem;
+
+nlohmann::json JsonFile::Read(const std::string& filename)
+{
+	std::ifstream file(filename);
+	if (!file.is_open())
+		return nlohmann::json::object();
+
+	try
+	{
+		nlohmann::json j;
+		file >> j;
+
+		if (j.is_object())
+			return j;
+	}
+	catch (const nlohmann::json::exception& e)
+	{
+		LOG_WARN("Ignoring malformed {}: {}", filename, e.what());
+	}
+
+	return nlohmann::json::object();
+}
+
+bool JsonFile::Update(const std::string& filename, const std::function<void(nlohmann::json&)>& update)
+{
+	std::error_code ec;
+	fs::create_directories(fs::path(filename).parent_path(), ec);
+
+	FileLock lock;
+	if (!lock.Lock(filename + ".lock", FileLock::Mode::Exclusive))
+	{
+		LOG_WARN("Failed to lock {}", filename);
+		return false;
+	}
+
+	auto content = Read(filename);
+
+	try
+	{
+		update(content);
+	}
+	catch (const nlohmann::json::exception& e)
+	{
+		LOG_WARN("Failed to update {}: {}", filename, e.what());
+		return false;
+	}
+
+	std::random_device device;
+	const std::string tempPath = std::format("{}.{:08x}", filename, device());
+
+	bool written = false;
+	{
+		std::ofstream file(tempPath);
+		written = file.is_open() && (file << content.dump(2)).good();
+	}
+
+	if (!written)
+	{
+		LOG_WARN("Failed to write {}", filename);
+		fs::remove(tempPath, ec);
+		return false;
+	}
+
+	fs::rename(tempPath, filename, ec);
+
+	if (ec)
+	{
+		LOG_WARN("Failed to replace {}: {}", filename, ec.message());
+		fs::remove(tempPath, ec);
+		return false;
+	}
+
+	return true;
+}
+
+} // namespace fem::cache
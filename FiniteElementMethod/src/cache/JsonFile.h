@@ -0,0 +1,32 @@
+#pragma once
+
+#include <functional>
+#include <string>
+
+#include <nlohmann/json.hpp>
+
+namespace fem::cache
+{
+
+/// <summary>
+/// JSON object files under the cache root, updated by every process that shares it
+/// </summary>
+class JsonFile
+{
+public:
+	/// <summary>
+	/// Stored object, empty when the file is missing or malformed
+	/// </summary>
+	static nlohmann::json Read(const std::string& filename);
+
+	/// <summary>
+	/// Read-modify-write under an exclusive lock, the file is replaced with a rename so readers never see
+	/// a partial write and concurrent updates are not lost
+	/// </summary>
+	static bool Update(const std::string& filename, const std::function<void(nlohmann::json&)>& update);
+
+private:
+	JsonFile() = delete;
+};
+
+} // namespace fem::cache
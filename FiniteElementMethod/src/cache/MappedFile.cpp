@@ -0,0 +1,160 @@
+#include "MappedFile.h"
+
+#include "logger/logger.h"
+
+#include <utility>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fem::cache
+{
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+{
+	*this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+	if (this != &other)
+	{
+		Close();
+
+		m_Data = std::exchange(other.m_Data, nullptr);
+		m_Size = std::exchange(other.m_Size, 0);
+
+#ifdef _WIN32
+		m_File = std::exchange(other.m_File, nullptr);
+		m_Mapping = std::exchange(other.m_Mapping, nullptr);
+#endif
+	}
+
+	return *this;
+}
+
+#ifdef _WIN32
+
+bool MappedFile::Open(const std::string& filename)
+{
+	Close();
+
+	HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		LOG_ERROR("Failed to open file for mapping: {}", filename);
+		return false;
+	}
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+	{
+		LOG_ERROR("Cannot map empty file: {}", filename);
+		CloseHandle(file);
+		return false;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!mapping)
+	{
+		LOG_ERROR("Failed to create file mapping: {}", filename);
+		CloseHandle(file);
+		return false;
+	}
+
+	void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!view)
+	{
+		LOG_ERROR("Failed to map view of file: {}", filename);
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+
+	m_File = file;
+	m_Mapping = mapping;
+	m_Data = static_cast<const std::byte*>(view);
+	m_Size = static_cast<size_t>(size.QuadPart);
+
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (m_Data)
+		UnmapViewOfFile(m_Data);
+
+	if (m_Mapping)
+		CloseHandle(m_Mapping);
+
+	if (m_File)
+		CloseHandle(m_File);
+
+	m_Data = nullptr;
+	m_Size = 0;
+	m_File = nullptr;
+	m_Mapping = nullptr;
+}
+
+#else
+
+bool MappedFile::Open(const std::string& filename)
+{
+	Close();
+
+	int fd = ::open(filename.c_str(), O_RDONLY);
+	if (fd < 0)
+	{
+		LOG_ERROR("Failed to open file for mapping: {}", filename);
+		return false;
+	}
+
+	struct stat info;
+	if (::fstat(fd, &info) != 0 || info.st_size == 0)
+	{
+		LOG_ERROR("Cannot map empty file: {}", filename);
+		::close(fd);
+		return false;
+	}
+
+	void* data = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+
+	// The mapping stays valid after the descriptor is closed
+	::close(fd);
+
+	if (data == MAP_FAILED)
+	{
+		LOG_ERROR("Failed to map file: {}", filename);
+		return false;
+	}
+
+	m_Data = static_cast<const std::byte*>(data);
+	m_Size = static_cast<size_t>(info.st_size);
+
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (m_Data)
+		::munmap(const_cast<std::byte*>(m_Data), m_Size);
+
+	m_Data = nullptr;
+	m_Size = 0;
+}
+
+#endif
+
+} // namespace fem::cache
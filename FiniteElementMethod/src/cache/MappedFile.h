@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace fem::cache
+{
+
+/// <summary>
+/// Read-only mapping of a whole file, the pages are shared with the page cache and every other process mapping it
+/// </summary>
+class MappedFile
+{
+public:
+	MappedFile() = default;
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	MappedFile(MappedFile&& other) noexcept;
+	MappedFile& operator=(MappedFile&& other) noexcept;
+
+	bool Open(const std::string& filename);
+	void Close();
+
+	const std::byte* GetData() const { return m_Data; }
+	size_t GetSize() const { return m_Size; }
+	bool IsOpen() const { return m_Data != nullptr; }
+
+private:
+	const std::byte* m_Data = nullptr;
+	size_t m_Size = 0;
+
+#ifdef _WIN32
+	void* m_File = nullptr;
+	void* m_Mapping = nullptr;
+#endif
+};
+
+} // namespace fem::cache
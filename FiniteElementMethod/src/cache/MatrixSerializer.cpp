@@ -1,16 +1,38 @@
 #include "MatrixSerializer.h"
 
+#include "BinaryFormat.h"
+#include "SparseCodec.h"
+
 #include "logger/logger.h"
 
+#include <array>
 #include <filesystem>
+#include <format>
 #include <fstream>
+#include <optional>
+
+#include <xxhash.h>
 
 namespace fem::cache
 {
 
 namespace fs = std::filesystem;
 
-bool MatrixSerializer::SaveSparseMatrix(const std::string& filename, const SpMat& matrix)
+namespace
+{
+
+struct Section
+{
+	const void* data;
+	size_t size;
+};
+
+uint64_t AlignUp(uint64_t offset)
+{
+	return (offset + BINARY_ALIGNMENT - 1) / BINARY_ALIGNMENT * BINARY_ALIGNMENT;
+}
+
+bool WriteBinary(const std::string& filename, BinaryHeader header, const std::vector<Section>& sections)
 {
 	fs::create_directories(fs::path(filename).parent_path());
 
@@ -21,107 +43,546 @@ bool MatrixSerializer::SaveSparseMatrix(const std::string& filename, const SpMat
 		return false;
 	}
 
-	Eigen::Index rows = matrix.rows();
-	Eigen::Index cols = matrix.cols();
-	Eigen::Index nnz = matrix.nonZeros();
+	XXH3_state_t* state = XXH3_createState();
+	XXH3_64bits_reset(state);
+
+	uint64_t offset = sizeof(BinaryHeader);
+
+	for (size_t i = 0; i < sections.size(); ++i)
+	{
+		header.sectionOffsets[i] = offset;
+		header.sectionSizes[i] = sections[i].size;
+		XXH3_64bits_update(state, sections[i].data, sections[i].size);
+
+		offset = AlignUp(offset + sections[i].size);
+	}
+
+	header.checksum = XXH3_64bits_digest(state);
+	XXH3_freeState(state);
+
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+	const std::array<char, BINARY_ALIGNMENT> zeros{};
+	uint64_t position = sizeof(BinaryHeader);
+
+	for (size_t i = 0; i < sections.size(); ++i)
+	{
+		file.write(zeros.data(), header.sectionOffsets[i] - position);
+		file.write(static_cast<const char*>(sections[i].data), sections[i].size);
+		position = header.sectionOffsets[i] + sections[i].size;
+	}
+
+	if (!file)
+	{
+		LOG_ERROR("Failed to write file: {}", filename);
+		return false;
+	}
+
+	return true;
+}
+
+/// <summary>
+/// Maps the file and checks that the header and section bounds describe a file of the expected kind
+/// </summary>
+const BinaryHeader* MapBinary(const std::string& filename, MappedFile& file, BinaryKind kind, bool verifyChecksum)
+{
+	if (!fs::exists(filename))
+	{
+		LOG_TRACE("Cache file not found: {}", filename);
+		return nullptr;
+	}
+
+	if (!file.Open(filename))
+	{
+		return nullptr;
+	}
+
+	if (file.GetSize() < sizeof(BinaryHeader))
+	{
+		LOG_WARN("Truncated cache file: {}", filename);
+		return nullptr;
+	}
+
+	const auto* header = reinterpret_cast<const BinaryHeader*>(file.GetData());
+
+	if (header->magic != BINARY_MAGIC || header->version != BINARY_VERSION)
+	{
+		LOG_WARN("Cache file has an unsupported format, it will be rebuilt: {}", filename);
+		return nullptr;
+	}
+
+	if (header->kind != kind)
+	{
+		LOG_ERROR("Cache file holds a different kind of data: {}", filename);
+		return nullptr;
+	}
+
+	for (size_t i = 0; i < std::size(header->sectionOffsets); ++i)
+	{
+		if (header->sectionOffsets[i] % BINARY_ALIGNMENT != 0
+			|| header->sectionSizes[i] > file.GetSize()
+			|| header->sectionOffsets[i] > file.GetSize() - header->sectionSizes[i])
+		{
+			LOG_ERROR("Truncated or corrupted cache file: {}", filename);
+			return nullptr;
+		}
+	}
+
+	if (verifyChecksum)
+	{
+		XXH3_state_t* state = XXH3_createState();
+		XXH3_64bits_reset(state);
+
+		for (size_t i = 0; i < std::size(header->sectionOffsets); ++i)
+			XXH3_64bits_update(state, file.GetData() + header->sectionOffsets[i], header->sectionSizes[i]);
+
+		uint64_t checksum = XXH3_64bits_digest(state);
+		XXH3_freeState(state);
+
+		if (checksum != header->checksum)
+		{
+			LOG_ERROR("Checksum mismatch in cache file: {}", filename);
+			return nullptr;
+		}
+	}
+
+	return header;
+}
+
+template<typename T>
+const T* SectionData(const MappedFile& file, const BinaryHeader& header, size_t section)
+{
+	return reinterpret_cast<const T*>(file.GetData() + header.sectionOffsets[section]);
+}
+
+template<typename SparseMatrix>
+bool WriteSparseMatrix(const std::string& filename, const SparseMatrix& matrix)
+{
+	using StorageIndex = typename SparseMatrix::StorageIndex;
+	using Scalar = typename SparseMatrix::Scalar;
+
+	// The layout stores the compressed arrays only
+	if (!matrix.isCompressed())
+	{
+		SparseMatrix compressed = matrix;
+		compressed.makeCompressed();
+		return WriteSparseMatrix(filename, compressed);
+	}
+
+	BinaryHeader header;
+	header.kind = BinaryKind::SparseMatrix;
+	header.indexWidth = sizeof(StorageIndex);
+	header.scalarWidth = sizeof(Scalar);
+	header.storageOrder = SparseMatrix::IsRowMajor ? 1 : 0;
+	header.rows = matrix.rows();
+	header.cols = matrix.cols();
+	header.count = matrix.nonZeros();
 
-	file.write(reinterpret_cast<const char*>(&rows), sizeof(rows));
-	file.write(reinterpret_cast<const char*>(&cols), sizeof(cols));
-	file.write(reinterpret_cast<const char*>(&nnz), sizeof(nnz));
+	const size_t nnz = static_cast<size_t>(matrix.nonZeros());
 
-	file.write(reinterpret_cast<const char*>(matrix.outerIndexPtr()), (cols + 1) * sizeof(SpMat::StorageIndex));
-	file.write(reinterpret_cast<const char*>(matrix.innerIndexPtr()), nnz * sizeof(SpMat::StorageIndex));
-	file.write(reinterpret_cast<const char*>(matrix.valuePtr()), nnz * sizeof(SpMat::Scalar));
+	bool written = WriteBinary(filename, header, {
+		{ matrix.outerIndexPtr(), (matrix.outerSize() + 1) * sizeof(StorageIndex) },
+		{ matrix.innerIndexPtr(), nnz * sizeof(StorageIndex) },
+		{ matrix.valuePtr(), nnz * sizeof(Scalar) },
+	});
 
-	file.close();
+	if (!written)
+	{
+		return false;
+	}
 
 	LOG_TRACE("Matrix saved: {} ({}x{}, {} nonzeros, {:.2f} MB)",
-		filename, rows, cols, nnz,
+		filename, header.rows, header.cols, header.count,
 		fs::file_size(filename) / (1024.0 * 1024.0));
 
 	return true;
 }
 
+template<typename SparseMatrix>
+std::optional<Eigen::Map<const SparseMatrix>> MapSparseArrays(const std::string& filename, MappedFile& file, bool verifyChecksum)
+{
+	using StorageIndex = typename SparseMatrix::StorageIndex;
+	using Scalar = typename SparseMatrix::Scalar;
+
+	const auto* header = MapBinary(filename, file, BinaryKind::SparseMatrix, verifyChecksum);
+	if (!header)
+	{
+		return std::nullopt;
+	}
+
+	if (header->indexWidth != sizeof(StorageIndex) || header->scalarWidth != sizeof(Scalar))
+	{
+		LOG_WARN("Matrix file uses {}-byte indices and {}-byte values, expected {} and {}: {}",
+			header->indexWidth, header->scalarWidth, sizeof(StorageIndex), sizeof(Scalar), filename);
+		return std::nullopt;
+	}
+
+	if (header->storageOrder != (SparseMatrix::IsRowMajor ? 1 : 0))
+	{
+		LOG_WARN("Matrix file was written in the other storage order: {}", filename);
+		return std::nullopt;
+	}
+
+	const auto outerSize = SparseMatrix::IsRowMajor ? header->rows : header->cols;
+
+	if (header->sectionSizes[0] != (outerSize + 1) * sizeof(StorageIndex)
+		|| header->sectionSizes[1] != header->count * sizeof(StorageIndex)
+		|| header->sectionSizes[2] != header->count * sizeof(Scalar))
+	{
+		LOG_ERROR("Matrix file sections do not match its dimensions: {}", filename);
+		return std::nullopt;
+	}
+
+	return Eigen::Map<const SparseMatrix>(
+		header->rows, header->cols, header->count,
+		SectionData<StorageIndex>(file, *header, 0),
+		SectionData<StorageIndex>(file, *header, 1),
+		SectionData<Scalar>(file, *header, 2));
+}
+
+template<typename SparseMatrix>
+bool ReadSparseMatrix(const std::string& filename, SparseMatrix& matrix)
+{
+	MappedFile file;
+
+	// Every page is read by the copy anyway, so the checksum costs little extra
+	auto view = MapSparseArrays<SparseMatrix>(filename, file, true);
+	if (!view)
+	{
+		return false;
+	}
+
+	matrix = *view;
+
+	LOG_TRACE("Matrix loaded: {} ({}x{}, {} nonzeros)",
+		filename, matrix.rows(), matrix.cols(), matrix.nonZeros());
+
+	return true;
+}
+
+template<typename T>
+bool WriteArray(const std::string& filename, BinaryKind kind, const T* data, size_t size)
+{
+	BinaryHeader header;
+	header.kind = kind;
+	header.rows = static_cast<int64_t>(size);
+	header.cols = 1;
+	header.count = static_cast<int64_t>(size);
+
+	if (kind == BinaryKind::Indices)
+		header.indexWidth = sizeof(T);
+	else
+		header.scalarWidth = sizeof(T);
+
+	return WriteBinary(filename, header, { { data, size * sizeof(T) } });
+}
+
+template<typename T>
+const T* MapArray(const std::string& filename, MappedFile& file, BinaryKind kind, bool verifyChecksum, size_t& size)
+{
+	const auto* header = MapBinary(filename, file, kind, verifyChecksum);
+	if (!header)
+	{
+		return nullptr;
+	}
+
+	const auto width = kind == BinaryKind::Indices ? header->indexWidth : header->scalarWidth;
+
+	if (width != sizeof(T) || header->count < 0 || header->sectionSizes[0] != header->count * sizeof(T))
+	{
+		LOG_ERROR("Array file does not match its header: {}", filename);
+		return nullptr;
+	}
+
+	size = static_cast<size_t>(header->count);
+	return SectionData<T>(file, *header, 0);
+}
+
+}
+
+bool MatrixSerializer::SaveSparseMatrix(const std::string& filename, const SpMat& matrix)
+{
+	return WriteSparseMatrix(filename, matrix);
+}
+
 bool MatrixSerializer::LoadSparseMatrix(const std::string& filename, SpMat& matrix)
 {
-	if (!fs::exists(filename))
+	return ReadSparseMatrix(filename, matrix);
+}
+
+bool MatrixSerializer::SaveFactor(const std::string& filename, const CscMat& factor)
+{
+	return WriteSparseMatrix(filename, factor);
+}
+
+bool MatrixSerializer::LoadFactor(const std::string& filename, CscMat& factor)
+{
+	return ReadSparseMatrix(filename, factor);
+}
+
+bool MatrixSerializer::SaveVector(const std::string& filename, const Vec& vector)
+{
+	if (!WriteArray(filename, BinaryKind::Vector, vector.data(), static_cast<size_t>(vector.size())))
 	{
-		LOG_TRACE("Matrix file not found: {}", filename);
 		return false;
 	}
 
-	std::ifstream file(filename, std::ios::binary);
-	if (!file.is_open())
+	LOG_TRACE("Vector saved: {} ({} elements, {:.2f} KB)",
+		filename, vector.size(), fs::file_size(filename) / 1024.0);
+
+	return true;
+}
+
+bool MatrixSerializer::LoadVector(const std::string& filename, Vec& vector)
+{
+	MappedFile file;
+	size_t size = 0;
+
+	const auto* data = MapArray<double>(filename, file, BinaryKind::Vector, true, size);
+	if (!data)
 	{
-		LOG_ERROR("Failed to open file for reading: {}", filename);
 		return false;
 	}
 
-	Eigen::Index rows, cols, nnz;
-	file.read(reinterpret_cast<char*>(&rows), sizeof(rows));
-	file.read(reinterpret_cast<char*>(&cols), sizeof(cols));
-	file.read(reinterpret_cast<char*>(&nnz), sizeof(nnz));
+	vector = VecView(data, static_cast<Eigen::Index>(size));
 
-	matrix.resize(rows, cols);
-	matrix.resizeNonZeros(nnz);
+	LOG_TRACE("Vector loaded: {} ({} elements)", filename, size);
 
-	file.read(reinterpret_cast<char*>(matrix.outerIndexPtr()), (cols + 1) * sizeof(SpMat::StorageIndex));
-	file.read(reinterpret_cast<char*>(matrix.innerIndexPtr()), nnz * sizeof(SpMat::StorageIndex));
-	file.read(reinterpret_cast<char*>(matrix.valuePtr()), nnz * sizeof(SpMat::Scalar));
+	return true;
+}
 
-	file.close();
+bool MatrixSerializer::SaveIndices(const std::string& filename, const std::vector<int>& indices)
+{
+	if (!WriteArray(filename, BinaryKind::Indices, indices.data(), indices.size()))
+	{
+		return false;
+	}
 
-	LOG_TRACE("Matrix loaded: {} ({}x{}, {} nonzeros)",
+	LOG_TRACE("Indices saved: {} ({} elements, {:.2f} KB)",
+		filename, indices.size(), fs::file_size(filename) / 1024.0);
+
+	return true;
+}
+
+bool MatrixSerializer::LoadIndices(const std::string& filename, std::vector<int>& indices)
+{
+	MappedFile file;
+	size_t size = 0;
+
+	const auto* data = MapArray<int>(filename, file, BinaryKind::Indices, true, size);
+	if (!data)
+	{
+		return false;
+	}
+
+	indices.assign(data, data + size);
+
+	LOG_TRACE("Indices loaded: {} ({} elements)", filename, size);
+
+	return true;
+}
+
+bool MatrixSerializer::MapSparseMatrix(const std::string& filename, MappedSparseMatrix& matrix, bool verifyChecksum)
+{
+	auto view = MapSparseArrays<SpMat>(filename, matrix.file, verifyChecksum);
+	if (!view)
+	{
+		matrix.file.Close();
+		return false;
+	}
+
+	matrix.rows = view->rows();
+	matrix.cols = view->cols();
+	matrix.nonZeros = view->nonZeros();
+	matrix.outer = view->outerIndexPtr();
+	matrix.inner = view->innerIndexPtr();
+	matrix.values = view->valuePtr();
+
+	LOG_TRACE("Matrix mapped: {} ({}x{}, {} nonzeros)",
+		filename, matrix.rows, matrix.cols, matrix.nonZeros);
+
+	return true;
+}
+
+bool MatrixSerializer::MapVector(const std::string& filename, MappedVector& vector, bool verifyChecksum)
+{
+	size_t size = 0;
+
+	vector.data = MapArray<double>(filename, vector.file, BinaryKind::Vector, verifyChecksum, size);
+	if (!vector.data)
+	{
+		vector.file.Close();
+		return false;
+	}
+
+	vector.size = static_cast<Eigen::Index>(size);
+
+	LOG_TRACE("Vector mapped: {} ({} elements)", filename, size);
+
+	return true;
+}
+
+bool MatrixSerializer::SaveCompressedPattern(const std::string& filename, const SpMat& matrix)
+{
+	if (!matrix.isCompressed())
+	{
+		SpMat compressed = matrix;
+		compressed.makeCompressed();
+		return SaveCompressedPattern(filename, compressed);
+	}
+
+	auto encoded = SparseCodec::EncodePattern(matrix);
+
+	BinaryHeader header;
+	header.kind = BinaryKind::Pattern;
+	header.codec = BinaryCodec::DeltaVarint;
+	header.blockSize = SparseCodec::PATTERN_BLOCK_SIZE;
+	header.indexWidth = sizeof(SpMat::StorageIndex);
+	header.storageOrder = SpMat::IsRowMajor ? 1 : 0;
+	header.rows = matrix.rows();
+	header.cols = matrix.cols();
+	header.count = matrix.nonZeros();
+
+	bool written = WriteBinary(filename, header, {
+		{ encoded.offsets.data(), encoded.offsets.size() * sizeof(uint64_t) },
+		{ encoded.bytes.data(), encoded.bytes.size() },
+		{ encoded.firstNonZero.data(), encoded.firstNonZero.size() * sizeof(int64_t) },
+	});
+
+	if (!written)
+	{
+		return false;
+	}
+
+	LOG_TRACE("Pattern saved: {} ({}x{}, {} nonzeros, {:.2f} bytes per index)",
+		filename, header.rows, header.cols, header.count,
+		header.count > 0 ? static_cast<double>(encoded.bytes.size()) / header.count : 0.0);
+
+	return true;
+}
+
+bool MatrixSerializer::LoadCompressedPattern(const std::string& filename, SpMat& matrix)
+{
+	MappedFile file;
+
+	const auto* header = MapBinary(filename, file, BinaryKind::Pattern, true);
+	if (!header)
+	{
+		return false;
+	}
+
+	if (header->codec != BinaryCodec::DeltaVarint || header->blockSize != SparseCodec::PATTERN_BLOCK_SIZE
+		|| header->indexWidth != sizeof(SpMat::StorageIndex) || header->storageOrder != (SpMat::IsRowMajor ? 1 : 0))
+	{
+		LOG_WARN("Pattern file was written with other coding parameters: {}", filename);
+		return false;
+	}
+
+	const size_t blocks = header->sectionSizes[0] / sizeof(uint64_t) - 1;
+	const auto* offsets = SectionData<uint64_t>(file, *header, 0);
+
+	if (header->sectionSizes[0] < sizeof(uint64_t) || header->sectionSizes[2] != blocks * sizeof(int64_t) || offsets[blocks] != header->sectionSizes[1])
+	{
+		LOG_ERROR("Pattern file sections do not match its block table: {}", filename);
+		return false;
+	}
+
+	matrix.resize(header->rows, header->cols);
+	matrix.resizeNonZeros(header->count);
+
+	if (!SparseCodec::DecodePattern(offsets, SectionData<int64_t>(file, *header, 2), SectionData<uint8_t>(file, *header, 1), blocks, matrix))
+	{
+		LOG_ERROR("Corrupted pattern file: {}", filename);
+		return false;
+	}
+
+	LOG_TRACE("Pattern loaded: {} ({}x{}, {} nonzeros)",
 		filename, matrix.rows(), matrix.cols(), matrix.nonZeros());
 
 	return true;
 }
 
-bool MatrixSerializer::SaveVector(const std::string& filename, const Vec& vector)
+bool MatrixSerializer::SaveCompressedValues(const std::string& filename, const SpMat& matrix)
 {
-	fs::create_directories(fs::path(filename).parent_path());
+	if (!matrix.isCompressed())
+	{
+		SpMat compressed = matrix;
+		compressed.makeCompressed();
+		return SaveCompressedValues(filename, compressed);
+	}
 
-	std::ofstream file(filename, std::ios::binary);
-	if (!file.is_open())
+	const size_t nnz = static_cast<size_t>(matrix.nonZeros());
+	auto encoded = SparseCodec::EncodeValues(matrix.valuePtr(), nnz);
+
+	if (encoded.offsets.empty())
 	{
-		LOG_ERROR("Failed to open file for writing: {}", filename);
+		LOG_ERROR("Failed to compress matrix values: {}", filename);
 		return false;
 	}
 
-	size_t size = vector.size();
-	file.write(reinterpret_cast<const char*>(&size), sizeof(size));
-	file.write(reinterpret_cast<const char*>(vector.data()), size * sizeof(double));
+	BinaryHeader header;
+	header.kind = BinaryKind::Values;
+	header.codec = BinaryCodec::ShuffleZstd;
+	header.blockSize = SparseCodec::VALUE_BLOCK_SIZE;
+	header.scalarWidth = sizeof(double);
+	header.rows = matrix.rows();
+	header.cols = matrix.cols();
+	header.count = matrix.nonZeros();
+
+	bool written = WriteBinary(filename, header, {
+		{ encoded.offsets.data(), encoded.offsets.size() * sizeof(uint64_t) },
+		{ encoded.bytes.data(), encoded.bytes.size() },
+	});
+
+	if (!written)
+	{
+		return false;
+	}
 
-	file.close();
-	LOG_TRACE("Vector saved: {} ({} elements, {:.2f} KB)",
-		filename, size, fs::file_size(filename) / 1024.0);
+	LOG_TRACE("Values saved: {} ({} nonzeros, {:.1f}% of raw)",
+		filename, nnz, nnz > 0 ? 100.0 * encoded.bytes.size() / (nnz * sizeof(double)) : 0.0);
 
 	return true;
 }
 
-bool MatrixSerializer::LoadVector(const std::string& filename, Vec& vector)
+bool MatrixSerializer::LoadCompressedValues(const std::string& filename, SpMat& matrix)
 {
-	if (!fs::exists(filename))
+	MappedFile file;
+
+	const auto* header = MapBinary(filename, file, BinaryKind::Values, true);
+	if (!header)
 	{
-		LOG_TRACE("Vector file not found: {}", filename);
 		return false;
 	}
 
-	std::ifstream file(filename, std::ios::binary);
-	if (!file.is_open())
+	if (header->codec != BinaryCodec::ShuffleZstd || header->blockSize != SparseCodec::VALUE_BLOCK_SIZE || header->scalarWidth != sizeof(double))
 	{
-		LOG_ERROR("Failed to open file for reading: {}", filename);
+		LOG_WARN("Values file was written with other coding parameters: {}", filename);
 		return false;
 	}
 
-	size_t size;
-	file.read(reinterpret_cast<char*>(&size), sizeof(size));
+	if (header->rows != matrix.rows() || header->cols != matrix.cols() || header->count != matrix.nonZeros())
+	{
+		LOG_ERROR("Values file does not match the pattern it is loaded into: {}", filename);
+		return false;
+	}
 
-	vector.resize(size);
-	file.read(reinterpret_cast<char*>(vector.data()), size * sizeof(double));
+	const size_t blocks = header->sectionSizes[0] / sizeof(uint64_t) - 1;
+	const auto* offsets = SectionData<uint64_t>(file, *header, 0);
 
-	file.close();
-	LOG_TRACE("Vector loaded: {} ({} elements)", filename, size);
+	if (header->sectionSizes[0] < sizeof(uint64_t) || offsets[blocks] != header->sectionSizes[1])
+	{
+		LOG_ERROR("Values file sections do not match its block table: {}", filename);
+		return false;
+	}
+
+	if (!SparseCodec::DecodeValues(offsets, SectionData<uint8_t>(file, *header, 1), blocks, matrix.valuePtr(), static_cast<size_t>(header->count)))
+	{
+		LOG_ERROR("Corrupted values file: {}", filename);
+		return false;
+	}
+
+	LOG_TRACE("Values loaded: {} ({} nonzeros)", filename, header->count);
 
 	return true;
 }
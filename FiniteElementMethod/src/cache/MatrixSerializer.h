@@ -1,23 +1,101 @@
 #pragma once
 
+#include "MappedFile.h"
+
 #include "math/math.h"
 
 #include <string>
+#include <vector>
 
 #include <Eigen/Sparse>
 
 namespace fem::cache
 {
 
+/// <summary>
+/// Sparse matrix read straight from the pages of a mapped cache file, valid while the mapping lives
+/// </summary>
+struct MappedSparseMatrix
+{
+	MappedFile file;
+	SpMat decoded; // Owns the arrays instead of the mapping when the cache entry is compressed
+	Eigen::Index rows = 0;
+	Eigen::Index cols = 0;
+	Eigen::Index nonZeros = 0;
+	const SpMat::StorageIndex* outer = nullptr;
+	const SpMat::StorageIndex* inner = nullptr;
+	const double* values = nullptr;
+
+	SpMatView View() const
+	{
+		// Eigen 3.4 SparseMatrix has no move constructor, pointers into decoded would dangle once this object moves
+		if (!file.IsOpen())
+			return SpMatView(rows, cols, nonZeros, decoded.outerIndexPtr(), decoded.innerIndexPtr(), decoded.valuePtr());
+
+		return SpMatView(rows, cols, nonZeros, outer, inner, values);
+	}
+
+	void Adopt(SpMat&& matrix)
+	{
+		file.Close();
+		decoded.swap(matrix); // Eigen sparse matrices have no move assignment
+		decoded.makeCompressed();
+
+		rows = decoded.rows();
+		cols = decoded.cols();
+		nonZeros = decoded.nonZeros();
+		outer = nullptr;
+		inner = nullptr;
+		values = nullptr;
+	}
+};
+
+struct MappedVector
+{
+	MappedFile file;
+	Eigen::Index size = 0;
+	const double* data = nullptr;
+
+	VecView View() const { return VecView(data, size); }
+};
+
+/// <summary>
+/// Reads and writes the versioned layout of BinaryFormat.h. Loads map the file and copy once into owning storage,
+/// Map* keeps the mapping and exposes it through Eigen::Map without any copy
+/// </summary>
 class MatrixSerializer
 {
 public:
 	static bool SaveSparseMatrix(const std::string& filename, const SpMat& matrix);
 	static bool LoadSparseMatrix(const std::string& filename, SpMat& matrix);
 
+	/// <summary>
+	/// Same layout as a system matrix, but always column-major like the Cholesky factors
+	/// </summary>
+	static bool SaveFactor(const std::string& filename, const CscMat& factor);
+	static bool LoadFactor(const std::string& filename, CscMat& factor);
+
 	static bool SaveVector(const std::string& filename, const Vec& vector);
 	static bool LoadVector(const std::string& filename, Vec& vector);
 
+	static bool SaveIndices(const std::string& filename, const std::vector<int>& indices);
+	static bool LoadIndices(const std::string& filename, std::vector<int>& indices);
+
+	/// <summary>
+	/// Fails on files of another version, index width or storage order, the caller then rebuilds them
+	/// </summary>
+	static bool MapSparseMatrix(const std::string& filename, MappedSparseMatrix& matrix, bool verifyChecksum = false);
+	static bool MapVector(const std::string& filename, MappedVector& vector, bool verifyChecksum = false);
+
+	/// <summary>
+	/// Compressed form, see SparseCodec. The pattern is stored once for all matrices that share it,
+	/// LoadCompressedPattern sizes the matrix and fills its indices, LoadCompressedValues then fills its values
+	/// </summary>
+	static bool SaveCompressedPattern(const std::string& filename, const SpMat& matrix);
+	static bool LoadCompressedPattern(const std::string& filename, SpMat& matrix);
+	static bool SaveCompressedValues(const std::string& filename, const SpMat& matrix);
+	static bool LoadCompressedValues(const std::string& filename, SpMat& matrix);
+
 	static bool SaveSparseMatrices(const std::string& directory, const std::string& prefix, const std::vector<std::pair<std::string, const SpMat*>>& matrices);
 	static bool LoadSparseMatrices(const std::string& directory, const std::string& prefix, std::vector<std::pair<std::string, SpMat*>>& matrices);
 
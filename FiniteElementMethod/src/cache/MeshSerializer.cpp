@@ -0,0 +1,426 @@
+#include "MeshSerializer.h"
+
+#include "BinaryFormat.h"
+#include "MappedFile.h"
+
+#include "logger/logger.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <vector>
+
+#include <xxhash.h>
+
+namespace fem::cache
+{
+
+namespace fs = std::filesystem;
+
+using namespace mesh::model;
+
+namespace
+{
+
+struct Section
+{
+	const void* data;
+	size_t size;
+};
+
+uint64_t AlignUp(uint64_t offset)
+{
+	return (offset + BINARY_ALIGNMENT - 1) / BINARY_ALIGNMENT * BINARY_ALIGNMENT;
+}
+
+template<typename T>
+Section MakeSection(const std::vector<T>& values)
+{
+	return { values.data(), values.size() * sizeof(T) };
+}
+
+template<typename T>
+const T* SectionData(const MappedFile& file, const MeshBinaryHeader& header, MeshSection section)
+{
+	return reinterpret_cast<const T*>(file.GetData() + header.sectionOffsets[static_cast<size_t>(section)]);
+}
+
+template<typename T>
+bool SectionHolds(const MeshBinaryHeader& header, MeshSection section, uint64_t count)
+{
+	return header.sectionSizes[static_cast<size_t>(section)] == count * sizeof(T);
+}
+
+}
+
+bool MeshSerializer::SaveMesh(const std::string& filename, const Mesh& mesh)
+{
+	const auto& nodes = mesh.GetNodes();
+	const auto& quads = mesh.GetQuads();
+	const auto& lines = mesh.GetLines();
+	const auto& groups = mesh.GetPhysicalGroups();
+
+	constexpr size_t maxIndex = std::numeric_limits<uint32_t>::max();
+
+	if (nodes.size() > maxIndex || lines.size() > maxIndex)
+	{
+		LOG_WARN("Mesh too large for the binary mesh cache: {} nodes, {} lines", nodes.size(), lines.size());
+		return false;
+	}
+
+	std::vector<uint64_t> nodeIds(nodes.size());
+	std::vector<double> x(nodes.size());
+	std::vector<double> y(nodes.size());
+
+	std::vector<uint64_t> quadIds(quads.size());
+	std::vector<uint32_t> quadNodes(4 * quads.size());
+
+	std::vector<uint64_t> lineIds(lines.size());
+	std::vector<uint32_t> lineNodes(2 * lines.size());
+
+	std::atomic<bool> failed = false;
+
+#pragma omp parallel
+	{
+#pragma omp for nowait
+		for (std::ptrdiff_t i = 0; i < static_cast<std::ptrdiff_t>(nodes.size()); ++i)
+		{
+			nodeIds[i] = nodes[i].id;
+			x[i] = nodes[i].x;
+			y[i] = nodes[i].y;
+		}
+
+		// Lookups of tags the mesh does not contain throw, which must not escape the parallel region
+#pragma omp for nowait
+		for (std::ptrdiff_t i = 0; i < static_cast<std::ptrdiff_t>(quads.size()); ++i)
+		{
+			quadIds[i] = quads[i].id;
+
+			try
+			{
+				for (size_t k = 0; k < 4; ++k)
+					quadNodes[4 * i + k] = static_cast<uint32_t>(mesh.GetNodeLocalId(quads[i].nodeIDs[k]));
+			}
+			catch (const std::out_of_range&)
+			{
+				failed = true;
+			}
+		}
+
+#pragma omp for nowait
+		for (std::ptrdiff_t i = 0; i < static_cast<std::ptrdiff_t>(lines.size()); ++i)
+		{
+			lineIds[i] = lines[i].id;
+
+			try
+			{
+				for (size_t k = 0; k < 2; ++k)
+					lineNodes[2 * i + k] = static_cast<uint32_t>(mesh.GetNodeLocalId(lines[i].nodeIDs[k]));
+			}
+			catch (const std::out_of_range&)
+			{
+				failed = true;
+			}
+		}
+	}
+
+	std::vector<MeshGroupRecord> groupRecords(groups.size());
+	std::vector<char> groupNames;
+	std::vector<uint32_t> groupLines;
+
+	try
+	{
+		for (size_t g = 0; g < groups.size(); ++g)
+		{
+			auto& record = groupRecords[g];
+			record.tag = groups[g].tag;
+			record.dimension = groups[g].dimension;
+			record.nameOffset = groupNames.size();
+			record.nameLength = groups[g].name.size();
+			record.lineOffset = groupLines.size();
+			record.lineCount = groups[g].lineIDs.size();
+
+			groupNames.insert(groupNames.end(), groups[g].name.begin(), groups[g].name.end());
+
+			for (size_t lineId : groups[g].lineIDs)
+				groupLines.push_back(static_cast<uint32_t>(mesh.GetLineLocalId(lineId)));
+		}
+	}
+	catch (const std::out_of_range&)
+	{
+		failed = true;
+	}
+
+	if (failed)
+	{
+		LOG_WARN("Mesh references nodes or lines it does not contain, it is not cached");
+		return false;
+	}
+
+	MeshBinaryHeader header;
+	header.nodes = nodes.size();
+	header.quads = quads.size();
+	header.lines = lines.size();
+	header.groups = groups.size();
+
+	const std::array<Section, MESH_SECTION_COUNT> sections = {
+		MakeSection(nodeIds),
+		MakeSection(x),
+		MakeSection(y),
+		MakeSection(quadIds),
+		MakeSection(quadNodes),
+		MakeSection(lineIds),
+		MakeSection(lineNodes),
+		MakeSection(groupRecords),
+		MakeSection(groupNames),
+		MakeSection(groupLines),
+	};
+
+	XXH3_state_t* state = XXH3_createState();
+	XXH3_64bits_reset(state);
+
+	uint64_t offset = sizeof(MeshBinaryHeader);
+
+	for (size_t i = 0; i < sections.size(); ++i)
+	{
+		header.sectionOffsets[i] = offset;
+		header.sectionSizes[i] = sections[i].size;
+		XXH3_64bits_update(state, sections[i].data, sections[i].size);
+
+		offset = AlignUp(offset + sections[i].size);
+	}
+
+	header.checksum = XXH3_64bits_digest(state);
+	XXH3_freeState(state);
+
+	fs::create_directories(fs::path(filename).parent_path());
+
+	std::ofstream file(filename, std::ios::binary);
+	if (!file.is_open())
+	{
+		LOG_ERROR("Failed to open file for writing: {}", filename);
+		return false;
+	}
+
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+	const std::array<char, BINARY_ALIGNMENT> zeros{};
+	uint64_t position = sizeof(MeshBinaryHeader);
+
+	for (size_t i = 0; i < sections.size(); ++i)
+	{
+		file.write(zeros.data(), header.sectionOffsets[i] - position);
+		file.write(static_cast<const char*>(sections[i].data), sections[i].size);
+		position = header.sectionOffsets[i] + sections[i].size;
+	}
+
+	if (!file)
+	{
+		LOG_ERROR("Failed to write file: {}", filename);
+		return false;
+	}
+
+	LOG_TRACE("Mesh saved: {} ({} nodes, {} quads, {} lines, {:.2f} MB)",
+		filename, header.nodes, header.quads, header.lines,
+		position / (1024.0 * 1024.0));
+
+	return true;
+}
+
+std::optional<Mesh> MeshSerializer::LoadMesh(const std::string& filename, bool verifyChecksum)
+{
+	if (!fs::exists(filename))
+	{
+		LOG_TRACE("Cache file not found: {}", filename);
+		return std::nullopt;
+	}
+
+	MappedFile file;
+	if (!file.Open(filename))
+	{
+		return std::nullopt;
+	}
+
+	if (file.GetSize() < sizeof(MeshBinaryHeader))
+	{
+		LOG_WARN("Truncated cache file: {}", filename);
+		return std::nullopt;
+	}
+
+	const auto& header = *reinterpret_cast<const MeshBinaryHeader*>(file.GetData());
+
+	if (header.magic != BINARY_MAGIC || header.version != BINARY_VERSION)
+	{
+		LOG_WARN("Cache file has an unsupported format, it will be rebuilt: {}", filename);
+		return std::nullopt;
+	}
+
+	if (header.kind != BinaryKind::Mesh)
+	{
+		LOG_ERROR("Cache file holds a different kind of data: {}", filename);
+		return std::nullopt;
+	}
+
+	for (size_t i = 0; i < MESH_SECTION_COUNT; ++i)
+	{
+		if (header.sectionOffsets[i] % BINARY_ALIGNMENT != 0
+			|| header.sectionSizes[i] > file.GetSize()
+			|| header.sectionOffsets[i] > file.GetSize() - header.sectionSizes[i])
+		{
+			LOG_ERROR("Truncated or corrupted cache file: {}", filename);
+			return std::nullopt;
+		}
+	}
+
+	using enum MeshSection;
+
+	if (!SectionHolds<uint64_t>(header, NodeIds, header.nodes)
+		|| !SectionHolds<double>(header, X, header.nodes)
+		|| !SectionHolds<double>(header, Y, header.nodes)
+		|| !SectionHolds<uint64_t>(header, QuadIds, header.quads)
+		|| !SectionHolds<uint32_t>(header, QuadNodes, 4 * header.quads)
+		|| !SectionHolds<uint64_t>(header, LineIds, header.lines)
+		|| !SectionHolds<uint32_t>(header, LineNodes, 2 * header.lines)
+		|| !SectionHolds<MeshGroupRecord>(header, Groups, header.groups))
+	{
+		LOG_ERROR("Mesh file sections do not match its counts: {}", filename);
+		return std::nullopt;
+	}
+
+	if (verifyChecksum)
+	{
+		XXH3_state_t* state = XXH3_createState();
+		XXH3_64bits_reset(state);
+
+		for (size_t i = 0; i < MESH_SECTION_COUNT; ++i)
+			XXH3_64bits_update(state, file.GetData() + header.sectionOffsets[i], header.sectionSizes[i]);
+
+		uint64_t checksum = XXH3_64bits_digest(state);
+		XXH3_freeState(state);
+
+		if (checksum != header.checksum)
+		{
+			LOG_ERROR("Checksum mismatch in cache file: {}", filename);
+			return std::nullopt;
+		}
+	}
+
+	const auto* nodeIds = SectionData<uint64_t>(file, header, NodeIds);
+	const auto* x = SectionData<double>(file, header, X);
+	const auto* y = SectionData<double>(file, header, Y);
+	const auto* quadIds = SectionData<uint64_t>(file, header, QuadIds);
+	const auto* quadNodes = SectionData<uint32_t>(file, header, QuadNodes);
+	const auto* lineIds = SectionData<uint64_t>(file, header, LineIds);
+	const auto* lineNodes = SectionData<uint32_t>(file, header, LineNodes);
+	const auto* groupRecords = SectionData<MeshGroupRecord>(file, header, Groups);
+	const auto* groupNames = SectionData<char>(file, header, GroupNames);
+	const auto* groupLines = SectionData<uint32_t>(file, header, GroupLines);
+
+	const uint64_t groupNamesSize = header.sectionSizes[static_cast<size_t>(GroupNames)];
+	const uint64_t groupLinesCount = header.sectionSizes[static_cast<size_t>(GroupLines)] / sizeof(uint32_t);
+
+	std::vector<Node> nodes(header.nodes);
+	std::vector<Quad> quads(header.quads);
+	std::vector<Line> lines(header.lines);
+
+	std::atomic<bool> failed = false;
+
+#pragma omp parallel
+	{
+#pragma omp for nowait
+		for (std::ptrdiff_t i = 0; i < static_cast<std::ptrdiff_t>(header.nodes); ++i)
+		{
+			nodes[i].id = nodeIds[i];
+			nodes[i].x = x[i];
+			nodes[i].y = y[i];
+		}
+
+		// Connectivity holds local indices, converted back to the tags the rest of the code works with
+#pragma omp for nowait
+		for (std::ptrdiff_t i = 0; i < static_cast<std::ptrdiff_t>(header.quads); ++i)
+		{
+			quads[i].id = quadIds[i];
+
+			for (size_t k = 0; k < 4; ++k)
+			{
+				const uint32_t local = quadNodes[4 * i + k];
+
+				if (local >= header.nodes)
+				{
+					failed = true;
+					break;
+				}
+
+				quads[i].nodeIDs[k] = nodeIds[local];
+			}
+		}
+
+#pragma omp for nowait
+		for (std::ptrdiff_t i = 0; i < static_cast<std::ptrdiff_t>(header.lines); ++i)
+		{
+			lines[i].id = lineIds[i];
+
+			for (size_t k = 0; k < 2; ++k)
+			{
+				const uint32_t local = lineNodes[2 * i + k];
+
+				if (local >= header.nodes)
+				{
+					failed = true;
+					break;
+				}
+
+				lines[i].nodeIDs[k] = nodeIds[local];
+			}
+		}
+	}
+
+	std::vector<PhysicalGroup> groups(header.groups);
+
+	for (size_t g = 0; g < groups.size() && !failed; ++g)
+	{
+		const auto& record = groupRecords[g];
+
+		if (record.nameOffset > groupNamesSize || record.nameLength > groupNamesSize - record.nameOffset
+			|| record.lineOffset > groupLinesCount || record.lineCount > groupLinesCount - record.lineOffset)
+		{
+			failed = true;
+			break;
+		}
+
+		auto& group = groups[g];
+		group.tag = record.tag;
+		group.dimension = record.dimension;
+		group.name.assign(groupNames + record.nameOffset, record.nameLength);
+		group.lineIDs.resize(record.lineCount);
+
+		for (size_t k = 0; k < record.lineCount; ++k)
+		{
+			const uint32_t local = groupLines[record.lineOffset + k];
+
+			if (local >= header.lines)
+			{
+				failed = true;
+				break;
+			}
+
+			group.lineIDs[k] = lineIds[local];
+		}
+	}
+
+	if (failed)
+	{
+		LOG_ERROR("Mesh file references entities out of range: {}", filename);
+		return std::nullopt;
+	}
+
+	LOG_TRACE("Mesh loaded: {} ({} nodes, {} quads, {} lines, {} physical groups)",
+		filename, header.nodes, header.quads, header.lines, header.groups);
+
+	return Mesh(std::move(nodes), std::move(quads), std::move(lines), std::move(groups));
+}
+
+} // namespace fem::cache
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "mesh/model/Mesh.h"
+
+#include <optional>
+#include <string>
+
+namespace fem::cache
+{
+
+/// <summary>
+/// Binary mesh stored with a cache entry, so a run that hits the cache never opens gmsh.
+/// Coordinates are kept as separate arrays and connectivity as local 32-bit indices
+/// </summary>
+class MeshSerializer
+{
+public:
+	/// <summary>
+	/// Fails for meshes with more entities than 32-bit local indices can address
+	/// </summary>
+	static bool SaveMesh(const std::string& filename, const mesh::model::Mesh& mesh);
+
+	/// <summary>
+	/// Maps the file and rebuilds the mesh with its original gmsh tags
+	/// </summary>
+	static std::optional<mesh::model::Mesh> LoadMesh(const std::string& filename, bool verifyChecksum = true);
+
+private:
+	MeshSerializer() = delete;
+};
+
+} // namespace fem::cache
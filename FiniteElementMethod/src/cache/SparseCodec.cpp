@@ -0,0 +1,283 @@
+#include "SparseCodec.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#include <zstd.h>
+
+namespace fem::cache
+{
+
+namespace
+{
+
+void WriteVarint(std::vector<uint8_t>& out, uint64_t value)
+{
+	while (value >= 0x80)
+	{
+		out.push_back(static_cast<uint8_t>(value) | 0x80);
+		value >>= 7;
+	}
+
+	out.push_back(static_cast<uint8_t>(value));
+}
+
+bool ReadVarint(const uint8_t*& pos, const uint8_t* end, uint64_t& value)
+{
+	value = 0;
+
+	for (int shift = 0; shift < 64 && pos < end; shift += 7)
+	{
+		const uint8_t byte = *pos++;
+		value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+
+		if (!(byte & 0x80))
+			return true;
+	}
+
+	return false;
+}
+
+uint64_t ZigZag(int64_t value)
+{
+	return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t UnZigZag(uint64_t value)
+{
+	return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+EncodedBlocks Concatenate(std::vector<std::vector<uint8_t>>& blocks)
+{
+	EncodedBlocks encoded;
+	encoded.offsets.reserve(blocks.size() + 1);
+	encoded.offsets.push_back(0);
+
+	for (const auto& block : blocks)
+		encoded.offsets.push_back(encoded.offsets.back() + block.size());
+
+	encoded.bytes.resize(encoded.offsets.back());
+
+	for (size_t b = 0; b < blocks.size(); ++b)
+	{
+		std::copy(blocks[b].begin(), blocks[b].end(), encoded.bytes.begin() + encoded.offsets[b]);
+		blocks[b] = {};
+	}
+
+	return encoded;
+}
+
+}
+
+EncodedBlocks SparseCodec::EncodePattern(const SpMat& matrix)
+{
+	const auto* outer = matrix.outerIndexPtr();
+	const auto* inner = matrix.innerIndexPtr();
+
+	const Eigen::Index outerSize = matrix.outerSize();
+	const Eigen::Index blockCount = (outerSize + PATTERN_BLOCK_SIZE - 1) / PATTERN_BLOCK_SIZE;
+
+	std::vector<std::vector<uint8_t>> blocks(blockCount);
+
+#pragma omp parallel for schedule(dynamic, 1)
+	for (Eigen::Index b = 0; b < blockCount; ++b)
+	{
+		auto& out = blocks[b];
+		const Eigen::Index first = b * PATTERN_BLOCK_SIZE;
+		const Eigen::Index last = std::min<Eigen::Index>(first + PATTERN_BLOCK_SIZE, outerSize);
+
+		out.reserve(static_cast<size_t>(outer[last] - outer[first]) + (last - first));
+
+		for (Eigen::Index j = first; j < last; ++j)
+		{
+			WriteVarint(out, static_cast<uint64_t>(outer[j + 1] - outer[j]));
+
+			// Stencils sit around the diagonal, so the first index is coded relative to the outer index
+			int64_t previous = j;
+
+			for (auto k = outer[j]; k < outer[j + 1]; ++k)
+			{
+				WriteVarint(out, ZigZag(inner[k] - previous));
+				previous = inner[k];
+			}
+		}
+	}
+
+	auto encoded = Concatenate(blocks);
+
+	encoded.firstNonZero.resize(blockCount);
+
+	for (Eigen::Index b = 0; b < blockCount; ++b)
+		encoded.firstNonZero[b] = outer[b * PATTERN_BLOCK_SIZE];
+
+	return encoded;
+}
+
+bool SparseCodec::DecodePattern(const uint64_t* offsets, const int64_t* firstNonZero, const uint8_t* bytes, size_t blocks, SpMat& matrix)
+{
+	auto* outer = matrix.outerIndexPtr();
+	auto* inner = matrix.innerIndexPtr();
+
+	const Eigen::Index outerSize = matrix.outerSize();
+	const Eigen::Index innerSize = matrix.innerSize();
+	const int64_t nonZeros = static_cast<int64_t>(matrix.data().size()); // nonZeros() reads the outer indices being decoded
+
+	if (static_cast<Eigen::Index>(blocks) != (outerSize + PATTERN_BLOCK_SIZE - 1) / PATTERN_BLOCK_SIZE)
+		return false;
+
+	std::atomic<bool> failed = false;
+
+#pragma omp parallel for schedule(dynamic, 1)
+	for (Eigen::Index b = 0; b < static_cast<Eigen::Index>(blocks); ++b)
+	{
+		const int64_t blockEnd = b + 1 < static_cast<Eigen::Index>(blocks) ? firstNonZero[b + 1] : nonZeros;
+
+		// With offsets[blocks] checked by the caller, ascending offsets keep every block inside the payload
+		if (offsets[b] > offsets[b + 1] || firstNonZero[b] < 0 || firstNonZero[b] > blockEnd || blockEnd > nonZeros)
+		{
+			failed = true;
+			continue;
+		}
+
+		const uint8_t* pos = bytes + offsets[b];
+		const uint8_t* end = bytes + offsets[b + 1];
+
+		const Eigen::Index first = b * PATTERN_BLOCK_SIZE;
+		const Eigen::Index last = std::min<Eigen::Index>(first + PATTERN_BLOCK_SIZE, outerSize);
+
+		int64_t k = firstNonZero[b];
+
+		for (Eigen::Index j = first; j < last && !failed; ++j)
+		{
+			outer[j] = static_cast<SpMat::StorageIndex>(k);
+
+			uint64_t length = 0;
+			if (!ReadVarint(pos, end, length) || k + static_cast<int64_t>(length) > blockEnd)
+			{
+				failed = true;
+				break;
+			}
+
+			int64_t previous = j;
+
+			for (uint64_t n = 0; n < length; ++n)
+			{
+				uint64_t delta = 0;
+				if (!ReadVarint(pos, end, delta))
+				{
+					failed = true;
+					break;
+				}
+
+				previous += UnZigZag(delta);
+
+				if (previous < 0 || previous >= innerSize)
+				{
+					failed = true;
+					break;
+				}
+
+				inner[k++] = static_cast<SpMat::StorageIndex>(previous);
+			}
+		}
+
+		if (k != blockEnd || pos != end)
+			failed = true;
+	}
+
+	outer[outerSize] = static_cast<SpMat::StorageIndex>(nonZeros);
+
+	return !failed;
+}
+
+EncodedBlocks SparseCodec::EncodeValues(const double* values, size_t count)
+{
+	const size_t blockCount = (count + VALUE_BLOCK_SIZE - 1) / VALUE_BLOCK_SIZE;
+
+	std::vector<std::vector<uint8_t>> blocks(blockCount);
+	std::atomic<bool> failed = false;
+
+#pragma omp parallel for schedule(dynamic, 1)
+	for (std::ptrdiff_t b = 0; b < static_cast<std::ptrdiff_t>(blockCount); ++b)
+	{
+		const size_t first = b * VALUE_BLOCK_SIZE;
+		const size_t n = std::min<size_t>(VALUE_BLOCK_SIZE, count - first);
+		const auto* source = reinterpret_cast<const uint8_t*>(values + first);
+
+		std::vector<uint8_t> shuffled(n * sizeof(double));
+
+		for (size_t i = 0; i < n; ++i)
+			for (size_t p = 0; p < sizeof(double); ++p)
+				shuffled[p * n + i] = source[i * sizeof(double) + p];
+
+		auto& out = blocks[b];
+		out.resize(ZSTD_compressBound(shuffled.size()));
+
+		const size_t size = ZSTD_compress(out.data(), out.size(), shuffled.data(), shuffled.size(), ZSTD_LEVEL);
+
+		if (ZSTD_isError(size))
+			failed = true;
+		else
+			out.resize(size);
+	}
+
+	if (failed)
+		return {};
+
+	return Concatenate(blocks);
+}
+
+bool SparseCodec::DecodeValues(const uint64_t* offsets, const uint8_t* bytes, size_t blocks, double* values, size_t count)
+{
+	if (blocks != (count + VALUE_BLOCK_SIZE - 1) / VALUE_BLOCK_SIZE)
+		return false;
+
+	std::atomic<bool> failed = false;
+
+#pragma omp parallel for schedule(dynamic, 1)
+	for (std::ptrdiff_t b = 0; b < static_cast<std::ptrdiff_t>(blocks); ++b)
+	{
+		const size_t first = b * VALUE_BLOCK_SIZE;
+		const size_t n = std::min<size_t>(VALUE_BLOCK_SIZE, count - first);
+
+		if (offsets[b] > offsets[b + 1])
+		{
+			failed = true;
+			continue;
+		}
+
+		std::vector<uint8_t> shuffled(n * sizeof(double));
+
+		const size_t size = ZSTD_decompress(shuffled.data(), shuffled.size(), bytes + offsets[b], offsets[b + 1] - offsets[b]);
+
+		if (ZSTD_isError(size) || size != shuffled.size())
+		{
+			failed = true;
+			continue;
+		}
+
+		auto* target = reinterpret_cast<uint8_t*>(values + first);
+
+		for (size_t i = 0; i < n; ++i)
+			for (size_t p = 0; p < sizeof(double); ++p)
+				target[i * sizeof(double) + p] = shuffled[p * n + i];
+	}
+
+	return !failed;
+}
+
+bool SparseCodec::SamePattern(const SpMat& a, const SpMat& b)
+{
+	if (a.rows() != b.rows() || a.cols() != b.cols() || a.nonZeros() != b.nonZeros())
+		return false;
+
+	if (!a.isCompressed() || !b.isCompressed())
+		return false;
+
+	return std::equal(a.outerIndexPtr(), a.outerIndexPtr() + a.outerSize() + 1, b.outerIndexPtr())
+		&& std::equal(a.innerIndexPtr(), a.innerIndexPtr() + a.nonZeros(), b.innerIndexPtr());
+}
+
+} // namespace fem::cache
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "math/math.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace fem::cache
+{
+
+/// <summary>
+/// Independently coded blocks laid out back to back, offsets has one entry more than there are blocks
+/// </summary>
+struct EncodedBlocks
+{
+	std::vector<uint64_t> offsets;
+	std::vector<uint8_t> bytes;
+	std::vector<int64_t> firstNonZero; // Pattern blocks only, so every block knows where its outer vectors start
+};
+
+/// <summary>
+/// Compressed form of the cache matrices. Blocks are coded and decoded in parallel
+/// </summary>
+class SparseCodec
+{
+public:
+	static constexpr uint32_t PATTERN_BLOCK_SIZE = 1 << 16; // Outer vectors
+	static constexpr uint32_t VALUE_BLOCK_SIZE = 1 << 18;   // Values, 2 MB of doubles
+	static constexpr int ZSTD_LEVEL = 1;
+
+	/// <summary>
+	/// Row lengths and zigzag deltas of the column indices as varints, a 2D quad mesh takes about one byte per nonzero
+	/// </summary>
+	static EncodedBlocks EncodePattern(const SpMat& matrix);
+
+	/// <summary>
+	/// Fills the outer and inner indices of a matrix already sized to the stored dimensions and nonzeros
+	/// </summary>
+	static bool DecodePattern(const uint64_t* offsets, const int64_t* firstNonZero, const uint8_t* bytes, size_t blocks, SpMat& matrix);
+
+	/// <summary>
+	/// Byte planes of each block are grouped before zstd, so the mostly equal sign and exponent bytes compress well
+	/// </summary>
+	static EncodedBlocks EncodeValues(const double* values, size_t count);
+
+	static bool DecodeValues(const uint64_t* offsets, const uint8_t* bytes, size_t blocks, double* values, size_t count);
+
+	/// <summary>
+	/// True when both matrices have the same dimensions and nonzero positions, values are ignored
+	/// </summary>
+	static bool SamePattern(const SpMat& a, const SpMat& b);
+
+private:
+	SparseCodec() = delete;
+};
+
+} // namespace fem::cache
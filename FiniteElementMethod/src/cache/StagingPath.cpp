@@ -0,0 +1,24 @@
+#include "StagingPath.h"
+
+#include <cstdint>
+#include <format>
+#include <random>
+
+namespace fem::cache
+{
+
+std::string StagingPath::Make(const std::string& directory, std::string_view prefix, std::string_view extension)
+{
+	// Random rather than process ids, which repeat across the nodes sharing the cache
+	std::random_device device;
+	const uint64_t id = (static_cast<uint64_t>(device()) << 32) | device();
+
+	return std::format("{}/.{}-{:016x}{}", directory, prefix, id, extension);
+}
+
+bool StagingPath::Is(const std::filesystem::path& path)
+{
+	return path.filename().string().starts_with(".");
+}
+
+} // namespace fem::cache
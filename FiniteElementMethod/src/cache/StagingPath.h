@@ -0,0 +1,30 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+namespace fem::cache
+{
+
+/// <summary>
+/// Hidden names under the cache root for entries and files that are written first and renamed into place
+/// </summary>
+class StagingPath
+{
+public:
+	/// <summary>
+	/// Unique "directory/.prefix-id" followed by extension, which is kept for writers that pick the format from it
+	/// </summary>
+	static std::string Make(const std::string& directory, std::string_view prefix, std::string_view extension = "");
+
+	/// <summary>
+	/// Whether path was made by Make - an unfinished write or a retired entry, never a published one
+	/// </summary>
+	static bool Is(const std::filesystem::path& path);
+
+private:
+	StagingPath() = delete;
+};
+
+} // namespace fem::cache
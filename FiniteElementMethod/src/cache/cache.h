@@ -1,5 +1,15 @@
 #pragma once
 
+#include "BinaryFormat.h"
+#include "CacheKey.h"
 #include "CacheManager.h"
+#include "CacheWriter.h"
+#include "FileHashCache.h"
+#include "FileLock.h"
+#include "GeneratedMeshCache.h"
 #include "HashUtils.h"
+#include "JsonFile.h"
+#include "MappedFile.h"
 #include "MatrixSerializer.h"
+#include "MeshSerializer.h"
+#include "StagingPath.h"
@@ -4,6 +4,7 @@
 #include "solver/solver.h"
 
 #include <exception>
+#include <filesystem>
 #include <format>
 #include <iostream>
 #include <print>
@@ -29,8 +30,38 @@ std::expected<core::ApplicationOptions, CliError> CliParser::Parse(int argc, con
 			cxxopts::value<std::size_t>())
 		("s,solver", GenerateSolverHelpText(),
 			cxxopts::value<std::string>()->default_value("cholesky"))
+		("p,preconditioner", GeneratePreconditionerHelpText(),
+			cxxopts::value<std::string>()->default_value("jacobi"))
+		("ordering", GenerateOrderingHelpText(),
+			cxxopts::value<std::string>()->default_value("default"))
+		("memory-budget", "Memory budget in MB for cholesky factors, Pardiso factorizes out-of-core above it and the sequential solver stops before factorizing (default: unlimited)",
+			cxxopts::value<std::size_t>())
+		("ooc-dir", "Scratch directory for out-of-core factorization (default: working directory)",
+			cxxopts::value<std::string>())
+		("autotune", "Benchmark solver/preconditioner/ordering combinations on the assembled matrix and use the fastest (decision cached per sparsity pattern)")
+		("smoother", GenerateSmootherHelpText(),
+			cxxopts::value<std::string>()->default_value("chebyshev"))
+		("tolerance", "Relative residual tolerance for iterative and mixed precision solvers",
+			cxxopts::value<double>()->default_value("1e-10"))
+		("max-iterations", "Iteration limit for iterative solvers (default: matrix size)",
+			cxxopts::value<std::size_t>())
+		("recycle-size", "Approximate eigenvectors kept between solves by the deflated PCG solver",
+			cxxopts::value<std::size_t>()->default_value("8"))
+		("max-refinement", "Refinement step limit for the mixed precision solver",
+			cxxopts::value<std::size_t>()->default_value("10"))
+		("subdomains", "Subdomain count for the Schwarz preconditioner (default: one per thread)",
+			cxxopts::value<std::size_t>())
+		("overlap", "Overlap layers around each Schwarz subdomain",
+			cxxopts::value<std::size_t>()->default_value("1"))
+		("spmv", GenerateSpmvHelpText(),
+			cxxopts::value<std::string>()->default_value("auto"))
 		("no-cache", "Disable matrix caching")
-		("build-matrix-only", "Build stiffness matrix and exit without solving");
+		("compress-cache", "Store cached systems compressed (shared varint-coded pattern, zstd values) instead of raw memory-mappable arrays")
+		("cache-max-size", "Size cap in MB of the cache directory, least recently used entries are evicted above it (default: unlimited)",
+			cxxopts::value<std::size_t>())
+		("build-matrix-only", "Build stiffness matrix and exit without solving")
+		("low-memory", "Free triplets, partial load vectors and the mesh as soon as each stage is done, and let the solver own H and C")
+		("plan", "Estimate memory and time from the mesh counts and exit without assembling (written as JSON to --metrics when given)");
 
 	cxxopts::ParseResult result;
 	try
@@ -70,12 +101,21 @@ std::expected<core::ApplicationOptions, CliError> CliParser::Parse(int argc, con
 	if (auto res = ExtractSolverType(result, &config); !res)
 		return std::unexpected(res.error());
 
+	if (auto res = ExtractIterativeOptions(result, &config); !res)
+		return std::unexpected(res.error());
+
 	if (auto res = ExtractCacheEnabled(result, &config); !res)
 		return std::unexpected(res.error());
 
 	if (auto res = ExtractBuildMatrixOnly(result, &config); !res)
 		return std::unexpected(res.error());
 
+	if (auto res = ExtractPlanOnly(result, &config); !res)
+		return std::unexpected(res.error());
+
+	if (auto res = ExtractLowMemory(result, &config); !res)
+		return std::unexpected(res.error());
+
 	return config;
 }
 
@@ -92,6 +132,57 @@ std::string CliParser::GenerateSolverHelpText()
 	return fmt::format("Linear solver: {}", fmt::join(names, ", "));
 }
 
+std::string CliParser::GeneratePreconditionerHelpText()
+{
+	using namespace solver::linear;
+
+	std::vector<std::string_view> names;
+	names.reserve(PRECONDITIONERS.size());
+
+	for (const auto& preconditioner : PRECONDITIONERS)
+		names.push_back(preconditioner.name);
+
+	return fmt::format("Preconditioner for pcg solver: {}", fmt::join(names, ", "));
+}
+
+std::string CliParser::GenerateOrderingHelpText()
+{
+	using namespace solver::linear;
+
+	std::vector<std::string_view> names;
+	names.reserve(ORDERINGS.size());
+
+	for (const auto& ordering : ORDERINGS)
+		if (IsOrderingAvailable(ordering.type))
+			names.push_back(ordering.name);
+
+	return fmt::format("Fill-reducing ordering for cholesky solvers: {}", fmt::join(names, ", "));
+}
+
+std::string CliParser::GenerateSmootherHelpText()
+{
+	using namespace solver::linear;
+
+	std::vector<std::string_view> names;
+	names.reserve(SMOOTHERS.size());
+
+	for (const auto& smoother : SMOOTHERS)
+		names.push_back(smoother.name);
+
+	return fmt::format("Multigrid smoother for amg/gmg solver or preconditioner: {}", fmt::join(names, ", "));
+}
+
+std::string CliParser::GenerateSpmvHelpText()
+{
+	std::vector<std::string_view> names;
+	names.reserve(math::SPMV_BACKENDS.size());
+
+	for (const auto& backend : math::SPMV_BACKENDS)
+		names.push_back(backend.name);
+
+	return fmt::format("Sparse matrix-vector backend for iterative solvers and transient steps: {}", fmt::join(names, ", "));
+}
+
 std::expected<void, CliError> CliParser::ExtractConfigFilePath(const cxxopts::ParseResult& result, core::ApplicationOptions* config)
 {
 	if (!result.count("input"))
@@ -154,6 +245,122 @@ std::expected<void, CliError> CliParser::ExtractSolverType(const cxxopts::ParseR
 
 	config->LinearSolverType = *solverType;
 
+	if (result.count("autotune"))
+		config->autotune = true;
+
+	return {};
+}
+
+std::expected<void, CliError> CliParser::ExtractIterativeOptions(const cxxopts::ParseResult& result, core::ApplicationOptions* config)
+{
+	auto& options = config->linearSolverOptions;
+
+	std::string preconditionerStr = result["preconditioner"].as<std::string>();
+	auto preconditioner = solver::linear::ParsePreconditionerType(preconditionerStr);
+
+	if (!preconditioner)
+		return std::unexpected(
+			CliError{
+				CliErrorCode::InvalidValue,
+				std::format("Invalid preconditioner '{}'", preconditionerStr)
+			}
+		);
+
+	options.preconditioner = *preconditioner;
+
+	std::string smootherStr = result["smoother"].as<std::string>();
+	auto smoother = solver::linear::ParseSmootherType(smootherStr);
+
+	if (!smoother)
+		return std::unexpected(
+			CliError{
+				CliErrorCode::InvalidValue,
+				std::format("Invalid smoother '{}'", smootherStr)
+			}
+		);
+
+	options.smoother = *smoother;
+
+	std::string orderingStr = result["ordering"].as<std::string>();
+	auto ordering = solver::linear::ParseOrderingType(orderingStr);
+
+	if (!ordering)
+		return std::unexpected(
+			CliError{
+				CliErrorCode::InvalidValue,
+				std::format("Invalid ordering '{}'", orderingStr)
+			}
+		);
+
+	if (!solver::linear::IsOrderingAvailable(*ordering))
+		return std::unexpected(
+			CliError{
+				CliErrorCode::InvalidValue,
+				std::format("Ordering '{}' is not available in this build", orderingStr)
+			}
+		);
+
+	options.ordering = *ordering;
+
+	if (result.count("memory-budget"))
+	{
+		options.memoryBudgetMb = result["memory-budget"].as<std::size_t>();
+
+		if (options.memoryBudgetMb == 0)
+			return std::unexpected(
+				CliError{
+					CliErrorCode::InvalidValue,
+					"Memory budget must be positive"
+				}
+			);
+	}
+
+	if (result.count("ooc-dir"))
+	{
+		options.outOfCoreDirectory = result["ooc-dir"].as<std::string>();
+
+		if (!std::filesystem::is_directory(options.outOfCoreDirectory))
+			return std::unexpected(
+				CliError{
+					CliErrorCode::InvalidValue,
+					std::format("Out-of-core directory '{}' does not exist", options.outOfCoreDirectory.string())
+				}
+			);
+	}
+
+	options.tolerance = result["tolerance"].as<double>();
+
+	if (options.tolerance <= 0.0)
+		return std::unexpected(
+			CliError{
+				CliErrorCode::InvalidValue,
+				std::format("Tolerance must be positive, got {}", options.tolerance)
+			}
+		);
+
+	if (result.count("max-iterations"))
+		options.maxIterations = result["max-iterations"].as<std::size_t>();
+
+	std::string spmvStr = result["spmv"].as<std::string>();
+	auto spmv = math::ParseSpmvBackend(spmvStr);
+
+	if (!spmv)
+		return std::unexpected(
+			CliError{
+				CliErrorCode::InvalidValue,
+				std::format("Invalid SpMV backend '{}'", spmvStr)
+			}
+		);
+
+	options.spmvBackend = *spmv;
+
+	if (result.count("subdomains"))
+		options.subdomains = result["subdomains"].as<std::size_t>();
+
+	options.overlap = result["overlap"].as<std::size_t>();
+	options.recycleSize = result["recycle-size"].as<std::size_t>();
+	options.maxRefinementIterations = result["max-refinement"].as<std::size_t>();
+
 	return {};
 }
 
@@ -162,6 +369,12 @@ std::expected<void, CliError> CliParser::ExtractCacheEnabled(const cxxopts::Pars
 	if (result.count("no-cache"))
 		config->useCache = false;
 
+	if (result.count("compress-cache"))
+		config->compressCache = true;
+
+	if (result.count("cache-max-size"))
+		config->cacheMaxSizeMb = result["cache-max-size"].as<std::size_t>();
+
 	return {};
 }
 
@@ -173,4 +386,20 @@ std::expected<void, CliError> CliParser::ExtractBuildMatrixOnly(const cxxopts::P
 	return {};
 }
 
+std::expected<void, CliError> CliParser::ExtractPlanOnly(const cxxopts::ParseResult& result, core::ApplicationOptions* config)
+{
+	if (result.count("plan"))
+		config->planOnly = true;
+
+	return {};
+}
+
+std::expected<void, CliError> CliParser::ExtractLowMemory(const cxxopts::ParseResult& result, core::ApplicationOptions* config)
+{
+	if (result.count("low-memory"))
+		config->lowMemory = true;
+
+	return {};
+}
+
 } // namespace fem::cli
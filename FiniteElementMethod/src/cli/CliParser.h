@@ -21,14 +21,21 @@ public:
 
 private:
 	static std::string GenerateSolverHelpText();
+	static std::string GeneratePreconditionerHelpText();
+	static std::string GenerateOrderingHelpText();
+	static std::string GenerateSmootherHelpText();
+	static std::string GenerateSpmvHelpText();
 
 	static std::expected<void, CliError> ExtractConfigFilePath(const cxxopts::ParseResult& result, core::ApplicationOptions* config);
 	static std::expected<void, CliError> ExtractMetricsFilePath(const cxxopts::ParseResult& result, core::ApplicationOptions* config);
 	static std::expected<void, CliError> ExtractExportMtxPath(const cxxopts::ParseResult& result, core::ApplicationOptions* config);
 	static std::expected<void, CliError> ExtractThreadsNumber(const cxxopts::ParseResult& result, core::ApplicationOptions* config);
 	static std::expected<void, CliError> ExtractSolverType(const cxxopts::ParseResult& result, core::ApplicationOptions* config);
+	static std::expected<void, CliError> ExtractIterativeOptions(const cxxopts::ParseResult& result, core::ApplicationOptions* config);
 	static std::expected<void, CliError> ExtractCacheEnabled(const cxxopts::ParseResult& result, core::ApplicationOptions* config);
 	static std::expected<void, CliError> ExtractBuildMatrixOnly(const cxxopts::ParseResult& result, core::ApplicationOptions* config);
+	static std::expected<void, CliError> ExtractPlanOnly(const cxxopts::ParseResult& result, core::ApplicationOptions* config);
+	static std::expected<void, CliError> ExtractLowMemory(const cxxopts::ParseResult& result, core::ApplicationOptions* config);
 };
 
 } // namespace fem::cli
@@ -92,6 +92,12 @@ inline void PrintCompileConfig()
 	std::println("  MKL: Disabled");
 #endif
 
+#ifdef FEM_USE_MPI
+	std::println("  MPI: Enabled");
+#else
+	std::println("  MPI: Disabled");
+#endif
+
 #ifdef EIGEN_VECTORIZE
 #ifdef EIGEN_VECTORIZE_AVX512
 	std::println("  SIMD: AVX-512");
@@ -11,29 +11,53 @@ class GmshConfig
 {
 public:
 
+	/// <summary>
+	/// Called by the mesh providers before their first gmsh call, runs served from the cache never start gmsh
+	/// </summary>
 	static void Initialize()
 	{
+		if (s_Initialized)
+			return;
+
 		LOG_INFO("Initializing gmsh");
 		gmsh::initialize();
+
+		s_Initialized = true;
 	}
 
 	static void Finalize()
 	{
+		if (!s_Initialized)
+			return;
+
 		LOG_INFO("Finalizing gmsh");
 		gmsh::finalize();
+
+		s_Initialized = false;
+	}
+
+	/// <summary>
+	/// Surfaces are meshed concurrently only by gmsh builds with OpenMP, others ignore the options
+	/// </summary>
+	static void SetNumThreads(int nThreads)
+	{
+		gmsh::option::setNumber("General.NumThreads", nThreads);
+		gmsh::option::setNumber("Mesh.MaxNumThreads2D", nThreads);
+
+		LOG_INFO("Gmsh: Set to {} threads", nThreads);
 	}
 
 	static void PrintInfo()
 	{
 		LOG_INFO("Gmsh Configuration:");
-
-		std::string ver;
-		gmsh::option::getString("General.Version", ver);
-		LOG_INFO("  Gmsh version: {}", ver);
+		LOG_INFO("  Gmsh version: {}", GMSH_API_VERSION);
+		LOG_INFO("  Initialized: {}", s_Initialized ? "yes" : "no (started on first use)");
 	}
 
 private:
 	GmshConfig() = delete;
+
+	inline static bool s_Initialized = false;
 };
 
 } // namespace fem::config
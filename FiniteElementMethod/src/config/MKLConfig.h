@@ -3,6 +3,10 @@
 #include "CompileConfig.h"
 #include "logger/logger.h"
 
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+
 #ifdef EIGEN_USE_MKL_ALL
 #include <mkl.h>
 #endif
@@ -94,6 +98,19 @@ public:
 		}
 	}
 
+	/// <summary>
+	/// Pardiso reads its out-of-core settings from the environment when the factorization starts.
+	/// Scratch files are prefixed with directory/fem_pardiso and deleted on release
+	/// </summary>
+	static void SetPardisoOutOfCore(const std::filesystem::path& directory, size_t maxCoreSizeMb)
+	{
+		const auto prefix = (directory.empty() ? std::filesystem::current_path() : directory) / "fem_pardiso";
+
+		SetEnvironment("MKL_PARDISO_OOC_PATH", prefix.string());
+		SetEnvironment("MKL_PARDISO_OOC_MAX_CORE_SIZE", std::to_string(maxCoreSizeMb));
+		SetEnvironment("MKL_PARDISO_OOC_KEEP_FILE", "0");
+	}
+
 	static void PrintInfo()
 	{
 		LOG_INFO("MKL Configuration:");
@@ -117,6 +134,15 @@ public:
 
 private:
 	MKLConfig() = delete;
+
+	static void SetEnvironment(const char* name, const std::string& value)
+	{
+#ifdef _WIN32
+		_putenv_s(name, value.c_str());
+#else
+		setenv(name, value.c_str(), 1);
+#endif
+	}
 };
 
 } // namespace fem::config
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "logger/logger.h"
+
+#ifdef FEM_USE_MPI
+#include <mpi.h>
+#endif
+
+namespace fem::config
+{
+
+class MPIConfig
+{
+public:
+	static constexpr bool IsEnabled()
+	{
+#ifdef FEM_USE_MPI
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	/// <summary>
+	/// Must run before anything else touches MPI. OpenMP regions only call MPI from the
+	/// master thread, so funneled support is enough
+	/// </summary>
+	static void Initialize()
+	{
+#ifdef FEM_USE_MPI
+		int initialized = 0;
+		MPI_Initialized(&initialized);
+
+		if (!initialized)
+		{
+			int provided = 0;
+			MPI_Init_thread(nullptr, nullptr, MPI_THREAD_FUNNELED, &provided);
+		}
+
+		MPI_Comm_rank(MPI_COMM_WORLD, &s_Rank);
+		MPI_Comm_size(MPI_COMM_WORLD, &s_Size);
+#endif
+	}
+
+	static void Finalize()
+	{
+#ifdef FEM_USE_MPI
+		int finalized = 0;
+		MPI_Finalized(&finalized);
+
+		if (!finalized)
+			MPI_Finalize();
+#endif
+	}
+
+	static int GetRank() { return s_Rank; }
+	static int GetSize() { return s_Size; }
+
+	static bool IsRoot() { return s_Rank == 0; }
+	static bool IsDistributed() { return s_Size > 1; }
+
+	static void PrintInfo()
+	{
+		LOG_INFO("MPI Configuration:");
+
+		if constexpr (IsEnabled())
+		{
+#ifdef FEM_USE_MPI
+			int major = 0, minor = 0;
+			MPI_Get_version(&major, &minor);
+			LOG_INFO("  Status: Enabled (MPI {}.{})", major, minor);
+#endif
+			LOG_INFO("  Ranks: {}", s_Size);
+		}
+		else
+		{
+			LOG_INFO("  Status: Disabled");
+		}
+	}
+
+private:
+	MPIConfig() = delete;
+
+	inline static int s_Rank = 0;
+	inline static int s_Size = 1;
+};
+
+} // namespace fem::config
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "domain/domain.h"
+#include "mesh/model/StructuredMeshSpec.h"
 
 #include <optional>
 #include <vector>
@@ -11,6 +12,7 @@ namespace fem::config
 struct ProblemConfig
 {
 	std::filesystem::path meshPath;
+	std::optional<mesh::model::StructuredMeshSpec> structuredMesh; // Generated in process instead of read from meshPath
 	domain::model::ProblemType problemType;
 	std::optional<domain::model::TransientConfig> transientConfig;
 	domain::model::Material material;
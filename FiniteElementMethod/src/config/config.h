@@ -4,6 +4,7 @@
 #include "EigenConfig.h"
 #include "GmshConfig.h"
 #include "MKLConfig.h"
+#include "MPIConfig.h"
 #include "OMPConfig.h"
 #include "ProblemConfig.h"
 #include "SIMDConfig.h"
@@ -3,6 +3,7 @@
 #include "domain/domain.h"
 #include "fileio/fileio.h"
 
+#include <array>
 #include <format>
 #include <fstream>
 
@@ -56,9 +57,14 @@ std::expected<ProblemConfig, ConfigLoaderError> ConfigLoader::Parse(const std::s
 			return std::unexpected(res.error());
 
 		if (config.problemType == domain::model::ProblemType::Transient)
+		{
 			if (auto res = ExtractTransientParams(json, &config); !res)
 				return std::unexpected(res.error());
 
+			if (auto res = ExtractSteadyStateCriterion(json, &config); !res)
+				return std::unexpected(res.error());
+		}
+
 		if (auto res = ExtractMaterial(json, &config); !res)
 			return std::unexpected(res.error());
 
@@ -89,6 +95,19 @@ std::expected<ProblemConfig, ConfigLoaderError> ConfigLoader::Parse(const std::s
 
 std::expected<void, ConfigLoaderError> ConfigLoader::ExtractMesh(const nlohmann::json& json, ProblemConfig* config)
 {
+	if (HasField(json, "/mesh"))
+	{
+		if (HasField(json, "/mesh_path"))
+			return std::unexpected(
+				ConfigLoaderError{
+					ConfigLoaderErrorCode::InvalidValue,
+					"Only one of 'mesh_path' and 'mesh' can be given"
+				}
+			);
+
+		return ExtractStructuredMesh(json, config);
+	}
+
 	auto meshPath = GetRequiredField<std::string>(json, "/mesh_path");
 	if (!meshPath)
 		return std::unexpected(meshPath.error());
@@ -98,6 +117,83 @@ std::expected<void, ConfigLoaderError> ConfigLoader::ExtractMesh(const nlohmann:
 	return {};
 }
 
+std::expected<void, ConfigLoaderError> ConfigLoader::ExtractStructuredMesh(const nlohmann::json& json, ProblemConfig* config)
+{
+	auto generator = GetRequiredField<std::string>(json, "/mesh/generator");
+	if (!generator)
+		return std::unexpected(generator.error());
+
+	if (*generator != "structured")
+		return std::unexpected(
+			ConfigLoaderError{
+				ConfigLoaderErrorCode::InvalidValue,
+				std::format("Invalid mesh generator: {}", *generator)
+			}
+		);
+
+	mesh::model::StructuredMeshSpec spec;
+
+	if (auto res = ExtractGridAxis(json, "/mesh/x", &spec.x); !res)
+		return std::unexpected(res.error());
+
+	if (auto res = ExtractGridAxis(json, "/mesh/y", &spec.y); !res)
+		return std::unexpected(res.error());
+
+	// Sides left out keep their default names, a single name covers all blocks along the side
+	constexpr std::array<std::string_view, 4> sides{ "bottom", "right", "top", "left" };
+
+	for (std::size_t side = 0; side < sides.size(); ++side)
+	{
+		const std::string path = std::format("/mesh/boundaries/{}", sides[side]);
+
+		if (!HasField(json, path))
+			continue;
+
+		auto names = GetRequiredArrayField<std::string>(json, path, 1);
+		if (!names)
+			return std::unexpected(names.error());
+
+		spec.boundaryNames[side] = std::move(*names);
+	}
+
+	// Block counts and values are checked by the generator
+	config->structuredMesh = std::move(spec);
+
+	return {};
+}
+
+std::expected<void, ConfigLoaderError> ConfigLoader::ExtractGridAxis(const nlohmann::json& json, const std::string& path, mesh::model::GridAxis* axis)
+{
+	auto points = GetRequiredField<std::vector<double>>(json, path + "/points");
+	if (!points)
+		return std::unexpected(points.error());
+
+	const std::size_t blocks = points->size() > 1 ? points->size() - 1 : 0;
+
+	auto divisions = GetRequiredArrayField<size_t>(json, path + "/divisions", blocks);
+	if (!divisions)
+		return std::unexpected(divisions.error());
+
+	std::vector<double> progression(blocks, 1.0);
+
+	if (HasField(json, path + "/progression"))
+	{
+		auto value = GetRequiredArrayField<double>(json, path + "/progression", blocks);
+		if (!value)
+			return std::unexpected(value.error());
+
+		progression = std::move(*value);
+	}
+
+	*axis = mesh::model::GridAxis{
+		.points = std::move(*points),
+		.divisions = std::move(*divisions),
+		.progression = std::move(progression)
+	};
+
+	return {};
+}
+
 std::expected<void, ConfigLoaderError> ConfigLoader::ExtractProblemType(const nlohmann::json& json, ProblemConfig* config)
 {
 	auto problemTypeStr = GetRequiredField<std::string>(json, "/problem/type");
@@ -181,6 +277,49 @@ std::expected<void, ConfigLoaderError> ConfigLoader::ExtractTransientParams(cons
 	return {};
 }
 
+std::expected<void, ConfigLoaderError> ConfigLoader::ExtractSteadyStateCriterion(const nlohmann::json& json, ProblemConfig* config)
+{
+	if (!HasField(json, "/problem/steady_state"))
+		return {};
+
+	auto tolerance = GetRequiredField<double>(json, "/problem/steady_state/tolerance");
+	if (!tolerance)
+		return std::unexpected(tolerance.error());
+
+	auto consecutiveSteps = GetRequiredField<size_t>(json, "/problem/steady_state/consecutive_steps");
+	if (!consecutiveSteps)
+		return std::unexpected(consecutiveSteps.error());
+
+	auto fillRemainingHistory = GetOptionalField<bool>(json, "/problem/steady_state/fill_remaining_history", false);
+	if (!fillRemainingHistory)
+		return std::unexpected(fillRemainingHistory.error());
+
+	// TODO: Create validator
+	if (*tolerance <= 0.0)
+		return std::unexpected(
+			ConfigLoaderError{
+				ConfigLoaderErrorCode::InvalidValue,
+				"Steady state tolerance must be positive"
+			}
+		);
+
+	if (*consecutiveSteps == 0)
+		return std::unexpected(
+			ConfigLoaderError{
+				ConfigLoaderErrorCode::InvalidValue,
+				"Steady state consecutive steps must be positive"
+			}
+		);
+
+	config->transientConfig->steadyStateCriterion = domain::model::SteadyStateCriterion{
+		.tolerance = *tolerance,
+		.consecutiveSteps = *consecutiveSteps,
+		.fillRemainingHistory = *fillRemainingHistory,
+	};
+
+	return {};
+}
+
 std::expected<void, ConfigLoaderError> ConfigLoader::ExtractMaterial(const nlohmann::json& json, ProblemConfig* config)
 {
 	auto name = GetRequiredField<std::string>(json, "/material/name");
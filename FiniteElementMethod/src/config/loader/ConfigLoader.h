@@ -7,6 +7,7 @@
 
 #include <expected>
 #include <filesystem>
+#include <vector>
 
 #include "nlohmann/json.hpp"
 
@@ -22,12 +23,47 @@ private:
 	static std::expected<ProblemConfig, ConfigLoaderError> Parse(const std::string& jsonContent);
 
 	static std::expected<void, ConfigLoaderError> ExtractMesh(const nlohmann::json& json, ProblemConfig* config);
+	static std::expected<void, ConfigLoaderError> ExtractStructuredMesh(const nlohmann::json& json, ProblemConfig* config);
+	static std::expected<void, ConfigLoaderError> ExtractGridAxis(const nlohmann::json& json, const std::string& path, mesh::model::GridAxis* axis);
 	static std::expected<void, ConfigLoaderError> ExtractProblemType(const nlohmann::json& json, ProblemConfig* config);
 	static std::expected<void, ConfigLoaderError> ExtractTransientParams(const nlohmann::json& json, ProblemConfig* config);
+	static std::expected<void, ConfigLoaderError> ExtractSteadyStateCriterion(const nlohmann::json& json, ProblemConfig* config);
 	static std::expected<void, ConfigLoaderError> ExtractMaterial(const nlohmann::json& json, ProblemConfig* config);
 	static std::expected<void, ConfigLoaderError> ExtractBoundaryCondition(const nlohmann::json& json, ProblemConfig* config);
 
 private:
+	static bool HasField(const nlohmann::json& json, const std::string& path)
+	{
+		return json.contains(nlohmann::json::json_pointer(path));
+	}
+
+	template<typename T>
+	static std::expected<T, ConfigLoaderError> GetOptionalField(const nlohmann::json& json, const std::string& path, const T& defaultValue)
+	{
+		if (!HasField(json, path))
+			return defaultValue;
+
+		return GetRequiredField<T>(json, path);
+	}
+
+	/// <summary>
+	/// Accepts a single value in place of an array, it is then repeated count times
+	/// </summary>
+	template<typename T>
+	static std::expected<std::vector<T>, ConfigLoaderError> GetRequiredArrayField(const nlohmann::json& json, const std::string& path, std::size_t count)
+	{
+		if (HasField(json, path) && !json.at(nlohmann::json::json_pointer(path)).is_array())
+		{
+			auto value = GetRequiredField<T>(json, path);
+			if (!value)
+				return std::unexpected(value.error());
+
+			return std::vector<T>(count, *value);
+		}
+
+		return GetRequiredField<std::vector<T>>(json, path);
+	}
+
 	template<typename T>
 	static std::expected<T, ConfigLoaderError> GetRequiredField(const nlohmann::json& json, const std::string& path)
 	{
@@ -2,12 +2,17 @@
 
 #include "cache/cache.h"
 #include "config/config.h"
+#include "distributed/distributed.h"
 #include "domain/domain.h"
 #include "fileio/fileio.h"
 #include "logger/logger.h"
 #include "mesh/mesh.h"
+#include "metrics/metrics.h"
+#include "planner/planner.h"
 #include "solver/solver.h"
 
+#include <algorithm>
+#include <array>
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
@@ -36,15 +41,17 @@ void Application::Initialize()
 	if (m_Initialized)
 		return;
 
-	fem::logger::Log::Init(m_Options.logLevel);
+	config::MPIConfig::Initialize();
 
+	// Ranks other than 0 only report problems
+	fem::logger::Log::Init(config::MPIConfig::IsRoot() ? m_Options.logLevel : spdlog::level::warn);
 
-	size_t nThreads = std::thread::hardware_concurrency();
+	// Ranks share the host, split the cores between them
+	size_t nThreads = std::max<size_t>(1, std::thread::hardware_concurrency() / config::MPIConfig::GetSize());
 
 	if (m_Options.numberOfThreads.has_value())
 		nThreads = m_Options.numberOfThreads.value();
 
-	config::GmshConfig::Initialize();
 	config::OMPConfig::SetNumThreads(nThreads);
 	config::MKLConfig::SetDynamic(false);
 	config::MKLConfig::SetNumThreads(nThreads);
@@ -63,6 +70,7 @@ void Application::TearDown() noexcept
 	LOG_INFO("Application shutting down...");
 
 	config::GmshConfig::Finalize();
+	config::MPIConfig::Finalize();
 
 	m_Initialized = false;
 }
@@ -80,6 +88,7 @@ ExitCode Application::Execute()
 	config::GmshConfig::PrintInfo();
 	config::OMPConfig::PrintInfo();
 	config::MKLConfig::PrintInfo();
+	config::MPIConfig::PrintInfo();
 	config::SIMDConfig::PrintInfo();
 	config::EigenConfig::PrintInfo();
 
@@ -93,8 +102,15 @@ ExitCode Application::Execute()
 
 	const auto& config = *parsedConfig;
 
-	mesh::provider::MeshProvider provider{};
-	const auto& meshResult = provider.LoadMesh(config.meshPath);
+	if (m_Options.planOnly)
+		return Plan(config);
+
+	metrics::MemoryStages memoryStages;
+
+	const auto cacheKey = GetCacheKey(config);
+
+	bool meshFromCache = false;
+	auto meshResult = LoadMesh(config, cacheKey, meshFromCache);
 
 	if (!meshResult)
 	{
@@ -102,26 +118,57 @@ ExitCode Application::Execute()
 		return MeshError;
 	}
 
-	const auto& mesh = *meshResult;
+	auto& mesh = *meshResult;
+	memoryStages.Record("mesh");
+
+	if (config::MPIConfig::IsDistributed())
+		return ExecuteDistributed(config, mesh);
 
 	SpMat H, C;
 	Vec P;
+	std::optional<cache::CacheManager::MappedSystemCache> mappedSystem;
 	std::optional<domain::AssemblyStats> assemblyStats;
 
+	// Declared after the mesh and the system, so its destructor waits for writes still reading them
+	cache::CacheWriter cacheWriter;
+
 	bool cacheHit = false;
 
 	if (m_Options.useCache)
 	{
-		auto cachedSystem = cache::CacheManager::LoadSystem(cache::CACHE_ROOT, parsedConfig->meshPath.string(), m_Options.configFilePath.string(), true);
+		auto cachedSystem = cache::CacheManager::MapSystem(cache::CACHE_ROOT, cacheKey, true);
 
 		if (cachedSystem)
 		{
-			H = std::move(cachedSystem->H);
-			C = std::move(cachedSystem->C);
-			P = std::move(cachedSystem->P);
-
-			LOG_INFO("System loaded from cache");
+			// A transient solve reads H and C in place, the export, the autotuner and the steady solvers need owning copies
+			bool solveInPlace = config.problemType == domain::model::ProblemType::Transient
+				&& !m_Options.autotune
+				&& !m_Options.exportMtxPath.has_value();
+
+			if (solveInPlace)
+			{
+				mappedSystem = std::move(cachedSystem);
+			}
+			else
+			{
+				H = cachedSystem->H.View();
+				P = cachedSystem->P.View();
+
+				if (cachedSystem->hasCapacity)
+					C = cachedSystem->C.View();
+			}
+
+			LOG_INFO("System loaded from cache{}", solveInPlace ? " (memory-mapped)" : "");
 			cacheHit = true;
+
+			// Entries written before meshes were cached, or whose mesh failed to load, get it attached now
+			if (!meshFromCache && !config.structuredMesh)
+			{
+				cacheWriter.Submit("mesh", [&mesh, cacheKey]
+				{
+					cache::CacheManager::SaveMesh(cache::CACHE_ROOT, cacheKey, mesh);
+				});
+			}
 		}
 	}
 	else
@@ -138,9 +185,9 @@ ExitCode Application::Execute()
 			config.boundaryCondition // TODO: Use vector of BCs
 		);
 
-		domain::GlobalMatrixBuilder matrixBuilder(mesh, elementBuilder);
+		domain::GlobalMatrixBuilder matrixBuilder(mesh, elementBuilder, m_Options.lowMemory);
 
-		const auto& buildResult = matrixBuilder.Build();
+		auto buildResult = matrixBuilder.Build();
 
 		if (!buildResult)
 		{
@@ -148,17 +195,30 @@ ExitCode Application::Execute()
 			return DomainError;
 		}
 
-		H = buildResult->matrices.H;
-		C = buildResult->matrices.C;
-		P = buildResult->matrices.P;
+		// Eigen sparse matrices have no move assignment, swap takes the arrays without copying
+		H.swap(buildResult->matrices.H);
+		C.swap(buildResult->matrices.C);
+		P.swap(buildResult->matrices.P);
 		assemblyStats = buildResult->stats;
 
+		// Serialized while the solver runs, nothing modifies the mesh, H, C and P until the writer is waited for
 		if (m_Options.useCache)
 		{
-			cache::CacheManager::SaveTransientSystem(cache::CACHE_ROOT, H, C, P, parsedConfig->meshPath.string(), m_Options.configFilePath.string());
+			cacheWriter.Submit("system", [this, &H, &C, &P, &mesh, cacheKey, saveMesh = !config.structuredMesh]
+			{
+				bool saved = cache::CacheManager::SaveTransientSystem(cache::CACHE_ROOT, H, C, P, cacheKey, m_Options.compressCache);
+
+				// Generated grids are not stored, they are rebuilt faster than they load
+				if (saved && saveMesh)
+					cache::CacheManager::SaveMesh(cache::CACHE_ROOT, cacheKey, mesh);
+
+				EnforceCacheSizeLimit();
+			});
 		}
 	}
 
+	memoryStages.Record(cacheHit ? "cache load" : "assembly");
+
 	if (m_Options.exportMtxPath.has_value())
 	{
 		const auto& exportDir = m_Options.exportMtxPath.value();
@@ -193,6 +253,12 @@ ExitCode Application::Execute()
 		{
 			LOG_ERROR("  Failed to save P vector");
 		}
+
+		// Same layout as the cache, SolverStandalone maps these instead of parsing the text files
+		if (cache::MatrixSerializer::SaveSparseMatrix((exportDir / "H.bin").string(), H) && cache::MatrixSerializer::SaveVector((exportDir / "P.bin").string(), P))
+			LOG_INFO("  Saved binary H and P for memory-mapped loading");
+		else
+			LOG_ERROR("  Failed to save binary H and P");
 	}
 
 	if (m_Options.buildMatrixOnly)
@@ -204,6 +270,7 @@ ExitCode Application::Execute()
 	auto solverConfig = solver::FEMSolverConfig{
 		.problemType = config.problemType,
 		.linearSolver = m_Options.LinearSolverType,
+		.linearSolverOptions = m_Options.linearSolverOptions,
 	};
 
 	if (config.problemType == domain::model::ProblemType::Transient)
@@ -211,8 +278,252 @@ ExitCode Application::Execute()
 		solverConfig.transientConfig = config.transientConfig;
 	}
 
+	// The autotuner only considers GMG when the mesh happens to be structured
+	if (m_Options.UsesGeometricMultigrid() || m_Options.autotune)
+	{
+		auto grid = mesh::model::StructuredGrid::Detect(mesh);
+
+		if (grid)
+		{
+			LOG_INFO("Structured grid detected: {} x {} nodes", grid->nx, grid->ny);
+			solverConfig.linearSolverOptions.structuredGrid = std::make_shared<const mesh::model::StructuredGrid>(std::move(*grid));
+		}
+		else if (m_Options.UsesGeometricMultigrid())
+		{
+			LOG_ERROR("Geometric multigrid requires a structured (transfinite quad) mesh: {}", cacheKey.meshFile);
+			return SolverError;
+		}
+	}
+
+	if (m_Options.UsesDomainDecomposition() || m_Options.autotune)
+	{
+		auto partStart = Now();
+
+		const size_t parts = solver::linear::SchwarzPreconditioner::ResolveSubdomains(m_Options.linearSolverOptions.subdomains);
+		auto partition = mesh::partition::CoordinateBisection::Partition(mesh, parts);
+
+		auto partEnd = Now();
+
+		auto sizes = partition.GetPartSizes();
+		auto [smallest, largest] = std::minmax_element(sizes.begin(), sizes.end());
+
+		LOG_INFO("Mesh partitioned into {} subdomains ({}..{} nodes) in {:.2f} ms", partition.parts, *smallest, *largest, ElapsedMs(partStart, partEnd));
+		solverConfig.linearSolverOptions.partition = std::make_shared<const mesh::partition::MeshPartition>(std::move(partition));
+	}
+
+	if (m_Options.autotune)
+	{
+		auto tuned = Autotune(H, C, P, config, solverConfig);
+
+		if (!tuned)
+		{
+			LOG_ERROR(tuned.error().ToString());
+			return SolverError;
+		}
+	}
+
+	auto symbolicAnalysis = AttachSymbolicAnalysis(config, solverConfig);
+
+	std::string matrixHash;
+	auto factor = AttachCholeskyFactor(H, config, solverConfig, matrixHash);
+
+	// Low memory mode releases the mesh and hands H and C over to the solver, pending writes have to be done with them first
+	if (m_Options.lowMemory)
+		cacheWriter.Wait();
+
+	// Past this point the mesh only serves the VTK export of the history
+	if (m_Options.lowMemory)
+	{
+		if (config.transientConfig && config.transientConfig->saveHistory)
+		{
+			mesh.Compact();
+			LOG_INFO("Low memory: mesh compacted for the solution export");
+		}
+		else
+		{
+			mesh = mesh::model::Mesh();
+			LOG_INFO("Low memory: mesh released before solving");
+		}
+
+		memoryStages.Record("mesh release");
+	}
+
 	auto solver = solver::FEMSolver();
-	auto solution = solver.Solve(H, C, P, solverConfig);
+	auto solution = mappedSystem
+		? solver.Solve(mappedSystem->H.View(), mappedSystem->C.View(), mappedSystem->P.View(), solverConfig)
+		: m_Options.lowMemory
+		? solver.Solve(std::move(H), std::move(C), P, solverConfig)
+		: solver.Solve(H, C, P, solverConfig);
+
+	memoryStages.Record("solve");
+
+	if (!solution)
+	{
+		LOG_ERROR(solution.error().ToString());
+		return SolverError;
+	}
+
+	if (symbolicAnalysis)
+		StoreSymbolicAnalysis(config, *symbolicAnalysis, cacheWriter);
+
+	if (factor)
+		StoreCholeskyFactor(config, *factor, matrixHash, cacheWriter);
+
+	// Only the part of the writes that did not overlap the solve is spent here
+	cacheWriter.Wait();
+
+	std::optional<cache::CacheWriterStats> cacheWriterStats;
+
+	if (auto stats = cacheWriter.GetStats(); stats.jobs > 0)
+	{
+		LOG_INFO("Cache writes: {} job(s), {:.2f} ms in the background, {:.2f} ms waited for", stats.jobs, stats.writeMs, stats.waitMs);
+		cacheWriterStats = stats;
+	}
+
+	// Calibrates the cost coefficients of plan mode on this machine
+	if (m_Options.useCache)
+	{
+		if (assemblyStats)
+			planner::MachineProfile::RecordAssembly(cache::CACHE_ROOT, *assemblyStats);
+
+		planner::MachineProfile::RecordSolve(cache::CACHE_ROOT, solverConfig.linearSolver, solution->stats);
+	}
+
+	if (m_Options.metricsFilePath.has_value())
+	{
+		fileio::FullMetrics metrics{
+			.solverName = std::string(solver::linear::LinearSolverTypeToString(solverConfig.linearSolver)),
+			.solverStats = solution->stats,
+			.assemblyStats = assemblyStats,
+			.cacheWriterStats = cacheWriterStats,
+			.memoryStages = memoryStages.GetStages()
+		};
+
+		auto metricsExported = fileio::StatsExporter::Export(m_Options.metricsFilePath.value(), metrics);
+
+		if (!metricsExported)
+		{
+			LOG_ERROR(metricsExported.error());
+			return MetricsExportError;
+		}
+	}
+
+	if (m_Options.useCache)
+	{
+		cache::CacheManager::PrintCacheInfo(cache::CACHE_ROOT, cacheKey);
+	}
+
+	auto exported = ExportSolution(config, mesh, *solution);
+
+	memoryStages.Record("export");
+	memoryStages.Print();
+
+	return exported;
+}
+
+ExitCode Application::Plan(const config::ProblemConfig& config) const
+{
+	using enum ExitCode;
+
+	LOG_INFO("Plan mode - estimating resources without assembling");
+
+	if (m_Options.autotune)
+		LOG_WARN("Autotune picks the solver on the assembled matrix - planning for {}", solver::linear::LinearSolverTypeToString(m_Options.LinearSolverType));
+
+	auto provider = CreateMeshProvider();
+	const auto& metadata = config.structuredMesh
+		? provider.LoadMetadata(*config.structuredMesh)
+		: provider.LoadMetadata(config.meshPath);
+
+	if (!metadata)
+	{
+		LOG_ERROR(metadata.error().ToString());
+		return MeshError;
+	}
+
+	const auto profile = planner::MachineProfile::Load(cache::CACHE_ROOT);
+	const auto plan = planner::RunPlanner::Estimate(*metadata, config, m_Options.LinearSolverType, m_Options.linearSolverOptions, profile, m_Options.lowMemory);
+
+	planner::RunPlanner::Print(plan);
+
+	if (m_Options.metricsFilePath.has_value() && config::MPIConfig::IsRoot())
+	{
+		auto exported = planner::RunPlanner::ExportJSON(m_Options.metricsFilePath.value(), plan);
+
+		if (!exported)
+		{
+			LOG_ERROR(exported.error());
+			return MetricsExportError;
+		}
+	}
+
+	return Success;
+}
+
+ExitCode Application::ExecuteDistributed(const config::ProblemConfig& config, const mesh::model::Mesh& mesh)
+{
+	using enum ExitCode;
+
+	const auto ranks = static_cast<size_t>(config::MPIConfig::GetSize());
+
+	LOG_INFO("Running distributed on {} ranks", ranks);
+
+	if (m_Options.useCache)
+		LOG_WARN("Cache is not used in distributed runs - each rank assembles only its own rows");
+
+	if (m_Options.autotune)
+		LOG_WARN("Autotune is not supported in distributed runs - using PCG with the requested preconditioner");
+
+	if (m_Options.exportMtxPath.has_value())
+		LOG_WARN("Matrix Market export is not available in distributed runs");
+
+	// Deterministic, so every rank computes the same partition without a broadcast
+	auto partStart = Now();
+
+	auto partition = mesh::partition::CoordinateBisection::Partition(mesh, ranks);
+
+	auto partEnd = Now();
+	double partitionTime = ElapsedMs(partStart, partEnd);
+
+	auto sizes = partition.GetPartSizes();
+	auto [smallest, largest] = std::minmax_element(sizes.begin(), sizes.end());
+
+	LOG_INFO("Mesh partitioned across {} ranks ({}..{} nodes) in {:.2f} ms", ranks, *smallest, *largest, partitionTime);
+
+	domain::ElementMatrixBuilder elementBuilder(
+		config.material,
+		config.boundaryCondition // TODO: Use vector of BCs
+	);
+
+	distributed::DistributedAssembler assembler(mesh, elementBuilder, partition);
+
+	auto buildResult = assembler.Build();
+
+	if (!buildResult)
+	{
+		LOG_ERROR(buildResult.error());
+		return DomainError;
+	}
+
+	if (m_Options.buildMatrixOnly)
+	{
+		LOG_INFO("Build matrix only mode - skipping solver");
+		return Success;
+	}
+
+	auto solverConfig = solver::FEMSolverConfig{
+		.problemType = config.problemType,
+		.linearSolver = m_Options.LinearSolverType,
+		.linearSolverOptions = m_Options.linearSolverOptions,
+	};
+
+	if (config.problemType == domain::model::ProblemType::Transient)
+	{
+		solverConfig.transientConfig = config.transientConfig;
+	}
+
+	auto rankStats = buildResult->rankStats;
+	auto solution = distributed::DistributedFEMSolver::Solve(buildResult->system, solverConfig, rankStats);
 
 	if (!solution)
 	{
@@ -220,12 +531,68 @@ ExitCode Application::Execute()
 		return SolverError;
 	}
 
+	// Collectives - every rank takes part before rank 0 writes the results
+	auto perRank = distributed::Communicator::GatherToRoot(std::span<const distributed::RankStats>(&rankStats, 1));
+
+	auto assemblyStats = buildResult->stats;
+
+	std::array<double, 5> assemblyTimes{
+		assemblyStats.elementAssemblyTimeMs,
+		assemblyStats.boundaryAssemblyTimeMs,
+		assemblyStats.mergeTimeMs,
+		assemblyStats.tripletToSparseTimeMs,
+		assemblyStats.totalAssemblyTimeMs
+	};
+
+	std::array<double, 6> assemblyCounts{
+		static_cast<double>(assemblyStats.elementCount),
+		static_cast<double>(assemblyStats.boundaryElementCount),
+		static_cast<double>(assemblyStats.tripletsHCount),
+		static_cast<double>(assemblyStats.tripletsCCount),
+		static_cast<double>(assemblyStats.tripletsMemoryBytes),
+		static_cast<double>(assemblyStats.sparseMatrixMemoryBytes)
+	};
+
+	// Slowest rank sets the wall time, sizes add up
+	distributed::Communicator::MaxAll(assemblyTimes);
+	distributed::Communicator::SumAll(assemblyCounts);
+
+	if (!config::MPIConfig::IsRoot())
+		return Success;
+
+	assemblyStats.elementAssemblyTimeMs = assemblyTimes[0];
+	assemblyStats.boundaryAssemblyTimeMs = assemblyTimes[1];
+	assemblyStats.mergeTimeMs = assemblyTimes[2];
+	assemblyStats.tripletToSparseTimeMs = assemblyTimes[3];
+	assemblyStats.totalAssemblyTimeMs = assemblyTimes[4];
+	assemblyStats.elementCount = static_cast<size_t>(assemblyCounts[0]);
+	assemblyStats.boundaryElementCount = static_cast<size_t>(assemblyCounts[1]);
+	assemblyStats.tripletsHCount = static_cast<size_t>(assemblyCounts[2]);
+	assemblyStats.tripletsCCount = static_cast<size_t>(assemblyCounts[3]);
+	assemblyStats.tripletsMemoryBytes = static_cast<size_t>(assemblyCounts[4]);
+	assemblyStats.sparseMatrixMemoryBytes = static_cast<size_t>(assemblyCounts[5]);
+
+	distributed::DistributedStats distributedStats{
+		.ranks = ranks,
+		.partitionTimeMs = partitionTime,
+		.perRank = std::move(perRank)
+	};
+
+	LOG_INFO("Distributed run: assembly imbalance {:.2f}, solve imbalance {:.2f}", distributedStats.getAssemblyImbalance(), distributedStats.getSolveImbalance());
+
+	for (const auto& rs : distributedStats.perRank)
+	{
+		LOG_INFO("  Rank {}: {} nodes, {} ghosts, assembly {:.2f} ms (+{:.2f} ms exchange), solve {:.2f} ms (halo {:.2f} ms)",
+			rs.rank, rs.ownedNodes, rs.ghostNodes, rs.assemblyTimeMs, rs.exchangeTimeMs, rs.solveTimeMs, rs.haloTimeMs);
+	}
+
 	if (m_Options.metricsFilePath.has_value())
 	{
 		fileio::FullMetrics metrics{
-			.solverName = std::string(solver::linear::LinearSolverTypeToString(m_Options.LinearSolverType)),
+			.solverName = "distributed-pcg",
 			.solverStats = solution->stats,
-			.assemblyStats = assemblyStats
+			.assemblyStats = assemblyStats,
+			.distributedStats = std::move(distributedStats)
 		};
 
 		auto metricsExported = fileio::StatsExporter::Export(m_Options.metricsFilePath.value(), metrics);
@@ -237,24 +604,233 @@ ExitCode Application::Execute()
 		}
 	}
 
+	return ExportSolution(config, mesh, *solution);
+}
+
+std::expected<void, solver::SolverError> Application::Autotune(const SpMat& H, const SpMat& C, const Vec& P, const config::ProblemConfig& config, solver::FEMSolverConfig& solverConfig) const
+{
+	// Tune on the matrix the solver will actually see: H for steady runs, H + C/dt with the
+	// first step right-hand side for transient ones
+	SpMat A = H;
+	Vec b = P;
+	std::size_t expectedSolves = 1;
+
+	if (config.problemType == domain::model::ProblemType::Transient && config.transientConfig)
+	{
+		const auto& transient = *config.transientConfig;
+		const double dt = transient.timeStep;
+
+		A = H + C / dt;
+		b = (C / dt) * Vec::Constant(P.size(), transient.initialTemperature) + P;
+		expectedSolves = std::max<std::size_t>(1, static_cast<std::size_t>(transient.totalTime / dt));
+	}
+
+	const auto key = solver::linear::SolverAutotuner::MakeDecisionKey(
+		cache::HashUtils::ComputeSparsityPatternHash(A),
+		expectedSolves,
+		config::OMPConfig::GetMaxThreads());
+
+	auto start = Now();
+
+	auto result = m_Options.useCache
+		? solver::linear::SolverAutotuner::Resolve(cache::CACHE_ROOT, key, A, b, solverConfig.linearSolverOptions, expectedSolves)
+		: solver::linear::SolverAutotuner::Tune(A, b, solverConfig.linearSolverOptions, expectedSolves);
+
+	if (!result)
+		return std::unexpected(result.error());
+
+	LOG_INFO("Autotune finished in {:.2f} ms, using {}", ElapsedMs(start, Now()), result->best.ToString());
+
+	solverConfig.linearSolver = result->best.solver;
+	solverConfig.linearSolverOptions = result->best.ApplyTo(solverConfig.linearSolverOptions);
+
+	return {};
+}
+
+void Application::EnforceCacheSizeLimit() const
+{
+	if (m_Options.cacheMaxSizeMb == 0)
+		return;
+
+	cache::CacheManager::EnforceSizeLimit(cache::CACHE_ROOT, static_cast<uint64_t>(m_Options.cacheMaxSizeMb) * 1024 * 1024);
+}
+
+std::expected<mesh::model::Mesh, mesh::provider::MeshProviderError> Application::LoadMesh(const config::ProblemConfig& config, const cache::CacheKey& cacheKey, bool& fromCache) const
+{
+	fromCache = false;
+
+	auto provider = CreateMeshProvider();
+
+	// Generating the grid is cheaper than reading it back from the cache
+	if (config.structuredMesh)
+		return provider.LoadMesh(*config.structuredMesh);
+
+	// Distributed runs do not use the cache
+	if (m_Options.useCache && !config::MPIConfig::IsDistributed())
+	{
+		if (auto cached = cache::CacheManager::LoadMesh(cache::CACHE_ROOT, cacheKey))
+		{
+			fromCache = true;
+			return std::move(*cached);
+		}
+	}
+
+	return provider.LoadMesh(config.meshPath);
+}
+
+mesh::provider::MeshProvider Application::CreateMeshProvider() const
+{
 	if (m_Options.useCache)
+		return mesh::provider::MeshProvider(cache::CACHE_ROOT);
+
+	return mesh::provider::MeshProvider{};
+}
+
+cache::CacheKey Application::GetCacheKey(const config::ProblemConfig& config) const
+{
+	return cache::CacheKey::FromConfig(config, m_Options.configFilePath.string());
+}
+
+std::shared_ptr<solver::linear::SymbolicAnalysisCache> Application::AttachSymbolicAnalysis(const config::ProblemConfig& config, solver::FEMSolverConfig& solverConfig) const
+{
+	const bool isCholesky = solverConfig.linearSolver == solver::linear::LinearSolverType::SimplicialLDLT
+		|| solverConfig.linearSolver == solver::linear::LinearSolverType::SimplicialLLT;
+
+	if (!m_Options.useCache || !isCholesky)
+		return nullptr;
+
+	auto symbolicAnalysis = std::make_shared<solver::linear::SymbolicAnalysisCache>();
+
+	if (auto cached = cache::CacheManager::LoadSymbolicAnalysis(cache::CACHE_ROOT, GetCacheKey(config)))
 	{
-		cache::CacheManager::PrintCacheInfo(cache::CACHE_ROOT, parsedConfig->meshPath.string(), m_Options.configFilePath.string());
+		symbolicAnalysis->loaded = solver::linear::SymbolicAnalysis{
+			.signature = std::move(cached->signature),
+			.rows = cached->rows,
+			.nonZeros = cached->nonZeros,
+			.permutation = std::move(cached->permutation),
+			.analysisTimeMs = cached->analysisTimeMs
+		};
+	}
+
+	solverConfig.linearSolverOptions.symbolicAnalysis = symbolicAnalysis;
+	return symbolicAnalysis;
+}
+
+void Application::StoreSymbolicAnalysis(const config::ProblemConfig& config, const solver::linear::SymbolicAnalysisCache& symbolicAnalysis, cache::CacheWriter& cacheWriter) const
+{
+	auto cacheKey = GetCacheKey(config);
+
+	if (symbolicAnalysis.loadedHits > 0)
+	{
+		const double savedMs = symbolicAnalysis.GetSavedMs();
+
+		LOG_INFO("Cached ordering reused in {} solve(s), first analysis {:.2f} ms faster", symbolicAnalysis.loadedHits, savedMs);
+
+		cacheWriter.Submit("symbolic reuse", [cacheKey = std::move(cacheKey), savedMs]
+		{
+			cache::CacheManager::RecordSymbolicReuse(cache::CACHE_ROOT, cacheKey, savedMs);
+		});
+
+		return;
 	}
 
+	if (!symbolicAnalysis.computed)
+		return;
+
+	const auto& computed = *symbolicAnalysis.computed;
+
+	cache::CacheManager::SymbolicCache symbolic{
+		.signature = computed.signature,
+		.rows = computed.rows,
+		.nonZeros = computed.nonZeros,
+		.permutation = computed.permutation,
+		.analysisTimeMs = computed.analysisTimeMs
+	};
+
+	cacheWriter.Submit("symbolic analysis", [cacheKey = std::move(cacheKey), symbolic = std::move(symbolic)]
+	{
+		cache::CacheManager::SaveSymbolicAnalysis(cache::CACHE_ROOT, cacheKey, symbolic);
+	});
+}
+
+std::shared_ptr<solver::linear::CholeskyFactorCache> Application::AttachCholeskyFactor(const SpMat& H, const config::ProblemConfig& config, solver::FEMSolverConfig& solverConfig, std::string& matrixHash) const
+{
+	// Pardiso keeps its factors internal, only the simplicial solvers can hand them out. Transient
+	// runs factorize C/dt + H rather than H, which the cache does not describe
+	const bool isCholesky = solverConfig.linearSolver == solver::linear::LinearSolverType::SimplicialLDLT
+		|| solverConfig.linearSolver == solver::linear::LinearSolverType::SimplicialLLT;
+
+	if (!config::UseSequentialSolver || !m_Options.useCache || !isCholesky || config.problemType != domain::model::ProblemType::Steady)
+		return nullptr;
+
+	matrixHash = cache::HashUtils::ComputeMatrixHash(H);
+
+	auto factor = std::make_shared<solver::linear::CholeskyFactorCache>();
+
+	if (auto cached = cache::CacheManager::LoadFactor(cache::CACHE_ROOT, GetCacheKey(config), matrixHash))
+	{
+		// Eigen sparse matrices have no move constructor, the factors are swapped in rather than copied
+		auto& loaded = factor->loaded.emplace();
+		loaded.signature = std::move(cached->signature);
+		loaded.L.swap(cached->L);
+		loaded.D.swap(cached->D);
+		loaded.permutation = std::move(cached->permutation);
+		loaded.factorizationTimeMs = cached->factorizationTimeMs;
+	}
+
+	solverConfig.linearSolverOptions.factor = factor;
+	return factor;
+}
+
+void Application::StoreCholeskyFactor(const config::ProblemConfig& config, const solver::linear::CholeskyFactorCache& factor, const std::string& matrixHash, cache::CacheWriter& cacheWriter) const
+{
+	if (factor.loadedHits > 0)
+	{
+		LOG_INFO("Cached Cholesky factors reused, factorization of {:.2f} ms skipped", factor.loaded->factorizationTimeMs);
+		return;
+	}
+
+	if (!factor.computed)
+		return;
+
+	const auto& computed = *factor.computed;
+
+	// The one copy, the solver result that owns the factors is released before the writer is done. Built in
+	// place and shared so that neither the capture nor the job wrapper copies the factors again
+	auto snapshot = std::make_shared<cache::CacheManager::FactorCache>();
+	snapshot->signature = computed.signature;
+	snapshot->matrixHash = matrixHash;
+	snapshot->L = computed.L;
+	snapshot->D = computed.D;
+	snapshot->permutation = computed.permutation;
+	snapshot->factorizationTimeMs = computed.factorizationTimeMs;
+
+	cacheWriter.Submit("cholesky factors", [this, cacheKey = GetCacheKey(config), cached = std::shared_ptr<const cache::CacheManager::FactorCache>(std::move(snapshot))]
+	{
+		cache::CacheManager::SaveFactor(cache::CACHE_ROOT, cacheKey, *cached);
+
+		// Factors can outgrow the system they were computed for
+		EnforceCacheSizeLimit();
+	});
+}
+
+ExitCode Application::ExportSolution(const config::ProblemConfig& config, const mesh::model::Mesh& mesh, const solver::FEMSolverResult& solution)
+{
+	using enum ExitCode;
+
 	// TODO: Extract output paths to config
 
-	if (!parsedConfig->transientConfig->saveHistory)
+	if (!config.transientConfig || !config.transientConfig->saveHistory)
 	{
 		return Success;
 	}
 
-	if (solution->isSteady())
+	if (solution.isSteady())
 	{
 		fs::path vtkPath = "output/solution.vtk";
 		fs::create_directories(vtkPath.parent_path());
 
-		auto vtkResult = fileio::VTKExporter::ExportSteady(vtkPath, mesh, solution->getFinalSolution());
+		auto vtkResult = fileio::VTKExporter::ExportSteady(vtkPath, mesh, solution.getFinalSolution());
 		if (!vtkResult)
 		{
 			LOG_ERROR(vtkResult.error().ToString());
@@ -263,7 +839,7 @@ ExitCode Application::Execute()
 	}
 	else
 	{
-		const auto& transient = solution->getTransient();
+		const auto& transient = solution.getTransient();
 		fs::path outputDir = "output";
 
 		auto vtkResult = fileio::VTKExporter::ExportTransient(
@@ -3,6 +3,23 @@
 #include "ApplicationOptions.h"
 #include "ExitCode.h"
 
+#include "cache/CacheKey.h"
+#include "cache/CacheWriter.h"
+#include "config/ProblemConfig.h"
+#include "mesh/model/Mesh.h"
+#include "mesh/provider/MeshProvider.h"
+#include "mesh/provider/MeshProviderError.h"
+#include "solver/FEMSolverConfig.h"
+#include "solver/FEMSolverResult.h"
+#include "solver/SolverError.h"
+#include "solver/linear/cholesky/CholeskyFactor.h"
+#include "solver/linear/cholesky/SymbolicAnalysis.h"
+
+#include "math/math.h"
+
+#include <expected>
+#include <memory>
+
 namespace fem::core
 {
 
@@ -18,6 +35,24 @@ private:
 	void Initialize();
 	void TearDown() noexcept;
 
+	ExitCode Plan(const config::ProblemConfig& config) const;
+	ExitCode ExecuteDistributed(const config::ProblemConfig& config, const mesh::model::Mesh& mesh);
+	std::expected<void, solver::SolverError> Autotune(const SpMat& H, const SpMat& C, const Vec& P, const config::ProblemConfig& config, solver::FEMSolverConfig& solverConfig) const;
+	cache::CacheKey GetCacheKey(const config::ProblemConfig& config) const;
+
+	/// <summary>
+	/// Binary mesh of the cache entry when there is one, gmsh otherwise
+	/// </summary>
+	std::expected<mesh::model::Mesh, mesh::provider::MeshProviderError> LoadMesh(const config::ProblemConfig& config, const cache::CacheKey& cacheKey, bool& fromCache) const;
+	mesh::provider::MeshProvider CreateMeshProvider() const;
+	void EnforceCacheSizeLimit() const;
+	std::shared_ptr<solver::linear::SymbolicAnalysisCache> AttachSymbolicAnalysis(const config::ProblemConfig& config, solver::FEMSolverConfig& solverConfig) const;
+	void StoreSymbolicAnalysis(const config::ProblemConfig& config, const solver::linear::SymbolicAnalysisCache& symbolicAnalysis, cache::CacheWriter& cacheWriter) const;
+	std::shared_ptr<solver::linear::CholeskyFactorCache> AttachCholeskyFactor(const SpMat& H, const config::ProblemConfig& config, solver::FEMSolverConfig& solverConfig, std::string& matrixHash) const;
+	void StoreCholeskyFactor(const config::ProblemConfig& config, const solver::linear::CholeskyFactorCache& factor, const std::string& matrixHash, cache::CacheWriter& cacheWriter) const;
+
+	ExitCode ExportSolution(const config::ProblemConfig& config, const mesh::model::Mesh& mesh, const solver::FEMSolverResult& solution);
+
 private:
 	bool m_Initialized = false;
 	ApplicationOptions m_Options;
@@ -15,13 +15,42 @@ struct ApplicationOptions
 {
 	bool showHelp = false;
 	bool useCache = true;
+	bool compressCache = false; // Smaller cache entries that are decoded on load instead of memory-mapped
+	std::size_t cacheMaxSizeMb = 0; // Least recently used entries are evicted above it, 0 keeps every entry
 	bool buildMatrixOnly = false;
+	bool planOnly = false; // Estimate resources from the mesh counts instead of running
+	bool lowMemory = false; // Release each stage's intermediates before the next one starts
+	bool autotune = false; // Pick solver, preconditioner and ordering by benchmarking them on the matrix
 	spdlog::level::level_enum logLevel = spdlog::level::info;
 	std::filesystem::path configFilePath;
 	std::optional<std::filesystem::path> metricsFilePath;
 	std::optional<std::filesystem::path> exportMtxPath;
 	std::optional<std::size_t> numberOfThreads;
 	solver::linear::LinearSolverType LinearSolverType = solver::linear::LinearSolverType::SimplicialLDLT;
+	solver::linear::LinearSolverOptions linearSolverOptions;
+
+	/// <summary>
+	/// Geometric multigrid needs the structured grid layout of the mesh
+	/// </summary>
+	bool UsesGeometricMultigrid() const
+	{
+		const bool isPcg = LinearSolverType == solver::linear::LinearSolverType::ConjugateGradient
+			|| LinearSolverType == solver::linear::LinearSolverType::DeflatedConjugateGradient;
+
+		return LinearSolverType == solver::linear::LinearSolverType::GeometricMultigrid
+			|| (isPcg && linearSolverOptions.preconditioner == solver::linear::PreconditionerType::GMG);
+	}
+
+	/// <summary>
+	/// Schwarz preconditioning needs the mesh node partition
+	/// </summary>
+	bool UsesDomainDecomposition() const
+	{
+		const bool isPcg = LinearSolverType == solver::linear::LinearSolverType::ConjugateGradient
+			|| LinearSolverType == solver::linear::LinearSolverType::DeflatedConjugateGradient;
+
+		return isPcg && linearSolverOptions.preconditioner == solver::linear::PreconditionerType::Schwarz;
+	}
 
 	std::string ToString() const
 	{
@@ -30,13 +59,65 @@ struct ApplicationOptions
 		oss << "Application Configuration:\n";
 		oss << "  Show Help: " << (showHelp ? "Yes" : "No") << "\n";
 		oss << "  Use Cache: " << (useCache ? "Yes" : "No") << "\n";
+		oss << "  Compress Cache: " << (compressCache ? "Yes" : "No") << "\n";
+		oss << "  Cache Max Size: " << (cacheMaxSizeMb > 0 ? std::to_string(cacheMaxSizeMb) + " MB" : "unlimited") << "\n";
 		oss << "  Build Matrix Only: " << (buildMatrixOnly ? "Yes" : "No") << "\n";
+		oss << "  Plan Only: " << (planOnly ? "Yes" : "No") << "\n";
+		oss << "  Low Memory: " << (lowMemory ? "Yes" : "No") << "\n";
 		oss << "  Log Level: " << spdlog::level::to_string_view(logLevel).data() << "\n";
 		oss << "  Config File: " << (configFilePath.empty() ? "<not set>" : configFilePath.string()) << "\n";
 		oss << "  Metrics File: " << (metricsFilePath.has_value() ? metricsFilePath->string() : "<not set>") << "\n";
 		oss << "  Export MTX: " << (exportMtxPath.has_value() ? exportMtxPath->string() : "<not set>") << "\n";
 		oss << "  Number of Threads: " << (numberOfThreads.has_value() ? std::to_string(numberOfThreads.value()) : "auto") << "\n";
-		oss << "  Linear Solver: " << solver::linear::LinearSolverTypeToString(LinearSolverType);
+		oss << "  Linear Solver: " << (autotune ? "autotune" : solver::linear::LinearSolverTypeToString(LinearSolverType)) << "\n";
+		oss << "  SpMV Backend: " << math::SpmvBackendToString(linearSolverOptions.spmvBackend);
+
+		const bool isPcg = LinearSolverType == solver::linear::LinearSolverType::ConjugateGradient
+			|| LinearSolverType == solver::linear::LinearSolverType::DeflatedConjugateGradient;
+		const bool isDeflated = LinearSolverType == solver::linear::LinearSolverType::DeflatedConjugateGradient;
+		const bool isMultigrid = LinearSolverType == solver::linear::LinearSolverType::AlgebraicMultigrid
+			|| LinearSolverType == solver::linear::LinearSolverType::GeometricMultigrid;
+		const bool isMixed = LinearSolverType == solver::linear::LinearSolverType::MixedPrecisionLDLT;
+		const bool isCholesky = LinearSolverType == solver::linear::LinearSolverType::SimplicialLDLT
+			|| LinearSolverType == solver::linear::LinearSolverType::SimplicialLLT;
+		const bool usesMultigrid = isMultigrid || (isPcg && (linearSolverOptions.preconditioner == solver::linear::PreconditionerType::AMG
+			|| linearSolverOptions.preconditioner == solver::linear::PreconditionerType::GMG));
+
+		if (autotune)
+			return oss.str();
+
+		if (isCholesky)
+		{
+			oss << "\n  Ordering: " << solver::linear::OrderingTypeToString(linearSolverOptions.ordering);
+			oss << "\n  Memory Budget: " << (linearSolverOptions.memoryBudgetMb > 0 ? std::to_string(linearSolverOptions.memoryBudgetMb) + " MB" : "unlimited");
+
+			if (!linearSolverOptions.outOfCoreDirectory.empty())
+				oss << "\n  Out-of-Core Directory: " << linearSolverOptions.outOfCoreDirectory.string();
+		}
+
+		if (isPcg)
+			oss << "\n  Preconditioner: " << solver::linear::PreconditionerTypeToString(linearSolverOptions.preconditioner);
+
+		if (UsesDomainDecomposition())
+		{
+			oss << "\n  Subdomains: " << (linearSolverOptions.subdomains > 0 ? std::to_string(linearSolverOptions.subdomains) : "auto");
+			oss << "\n  Overlap: " << linearSolverOptions.overlap;
+		}
+
+		if (usesMultigrid)
+			oss << "\n  Smoother: " << solver::linear::SmootherTypeToString(linearSolverOptions.smoother);
+
+		if (isPcg || isMultigrid || isMixed)
+			oss << "\n  Tolerance: " << linearSolverOptions.tolerance;
+
+		if (isDeflated)
+			oss << "\n  Recycle Size: " << linearSolverOptions.recycleSize;
+
+		if (isMixed)
+			oss << "\n  Max Refinement: " << linearSolverOptions.maxRefinementIterations;
+
+		if (isPcg || isMultigrid)
+			oss << "\n  Max Iterations: " << (linearSolverOptions.maxIterations > 0 ? std::to_string(linearSolverOptions.maxIterations) : "auto");
 
 		return oss.str();
 	}
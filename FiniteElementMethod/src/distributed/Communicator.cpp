@@ -0,0 +1,199 @@
+#include "Communicator.h"
+
+#include "config/MPIConfig.h"
+
+#include <cstring>
+#include <numeric>
+
+#ifdef FEM_USE_MPI
+#include <mpi.h>
+#endif
+
+namespace fem::distributed
+{
+
+namespace
+{
+
+std::vector<int> Displacements(const std::vector<int>& counts)
+{
+	std::vector<int> displacements(counts.size(), 0);
+
+	if (!counts.empty())
+		std::exclusive_scan(counts.begin(), counts.end(), displacements.begin(), 0);
+
+	return displacements;
+}
+
+#ifdef FEM_USE_MPI
+
+/// <summary>
+/// Contiguous byte type of one item, keeps MPI counts in items rather than bytes so large
+/// messages do not overflow int
+/// </summary>
+class ItemType
+{
+public:
+	explicit ItemType(std::size_t itemSize)
+	{
+		MPI_Type_contiguous(static_cast<int>(itemSize), MPI_BYTE, &m_Type);
+		MPI_Type_commit(&m_Type);
+	}
+
+	~ItemType()
+	{
+		MPI_Type_free(&m_Type);
+	}
+
+	ItemType(const ItemType&) = delete;
+	ItemType& operator=(const ItemType&) = delete;
+
+	operator MPI_Datatype() const { return m_Type; }
+
+private:
+	MPI_Datatype m_Type;
+};
+
+#endif
+
+}
+
+double Communicator::SumAll(double value)
+{
+	SumAll(std::span<double>(&value, 1));
+	return value;
+}
+
+double Communicator::MaxAll(double value)
+{
+	MaxAll(std::span<double>(&value, 1));
+	return value;
+}
+
+void Communicator::SumAll(std::span<double> values)
+{
+#ifdef FEM_USE_MPI
+	if (config::MPIConfig::IsDistributed())
+		MPI_Allreduce(MPI_IN_PLACE, values.data(), static_cast<int>(values.size()), MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+#endif
+}
+
+void Communicator::MaxAll(std::span<double> values)
+{
+#ifdef FEM_USE_MPI
+	if (config::MPIConfig::IsDistributed())
+		MPI_Allreduce(MPI_IN_PLACE, values.data(), static_cast<int>(values.size()), MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+#endif
+}
+
+void Communicator::Barrier()
+{
+#ifdef FEM_USE_MPI
+	if (config::MPIConfig::IsDistributed())
+		MPI_Barrier(MPI_COMM_WORLD);
+#endif
+}
+
+void Communicator::ExchangeWithNeighbours(std::span<const int> ranks, std::span<const std::span<const double>> send, std::span<const std::span<double>> recv)
+{
+#ifdef FEM_USE_MPI
+	constexpr int HaloTag = 17;
+
+	std::vector<MPI_Request> requests;
+	requests.reserve(2 * ranks.size());
+
+	for (std::size_t i = 0; i < ranks.size(); ++i)
+	{
+		if (recv[i].empty())
+			continue;
+
+		MPI_Irecv(recv[i].data(), static_cast<int>(recv[i].size()), MPI_DOUBLE, ranks[i], HaloTag, MPI_COMM_WORLD, &requests.emplace_back());
+	}
+
+	for (std::size_t i = 0; i < ranks.size(); ++i)
+	{
+		if (send[i].empty())
+			continue;
+
+		MPI_Isend(send[i].data(), static_cast<int>(send[i].size()), MPI_DOUBLE, ranks[i], HaloTag, MPI_COMM_WORLD, &requests.emplace_back());
+	}
+
+	MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+#else
+	// A single rank has no neighbours
+	(void)ranks;
+	(void)send;
+	(void)recv;
+#endif
+}
+
+std::vector<int> Communicator::ExchangeCounts(const std::vector<int>& sendCounts)
+{
+#ifdef FEM_USE_MPI
+	if (config::MPIConfig::IsDistributed())
+	{
+		std::vector<int> recvCounts(sendCounts.size(), 0);
+		MPI_Alltoall(sendCounts.data(), 1, MPI_INT, recvCounts.data(), 1, MPI_INT, MPI_COMM_WORLD);
+		return recvCounts;
+	}
+#endif
+
+	return sendCounts;
+}
+
+std::vector<int> Communicator::GatherCounts(int count)
+{
+#ifdef FEM_USE_MPI
+	if (config::MPIConfig::IsDistributed())
+	{
+		std::vector<int> counts(config::MPIConfig::IsRoot() ? config::MPIConfig::GetSize() : 0, 0);
+		MPI_Gather(&count, 1, MPI_INT, counts.data(), 1, MPI_INT, 0, MPI_COMM_WORLD);
+		return counts;
+	}
+#endif
+
+	return { count };
+}
+
+void Communicator::AllToAllBytes(const void* send, const std::vector<int>& sendCounts, void* recv, const std::vector<int>& recvCounts, std::size_t itemSize)
+{
+#ifdef FEM_USE_MPI
+	if (config::MPIConfig::IsDistributed())
+	{
+		ItemType type(itemSize);
+
+		auto sendDisplacements = Displacements(sendCounts);
+		auto recvDisplacements = Displacements(recvCounts);
+
+		MPI_Alltoallv(
+			send, sendCounts.data(), sendDisplacements.data(), type,
+			recv, recvCounts.data(), recvDisplacements.data(), type,
+			MPI_COMM_WORLD);
+
+		return;
+	}
+#endif
+
+	if (!sendCounts.empty() && sendCounts[0] > 0)
+		std::memcpy(recv, send, static_cast<std::size_t>(sendCounts[0]) * itemSize);
+}
+
+void Communicator::GatherBytes(const void* send, int count, void* recv, const std::vector<int>& recvCounts, std::size_t itemSize)
+{
+#ifdef FEM_USE_MPI
+	if (config::MPIConfig::IsDistributed())
+	{
+		ItemType type(itemSize);
+
+		auto displacements = Displacements(recvCounts);
+
+		MPI_Gatherv(send, count, type, recv, recvCounts.data(), displacements.data(), type, 0, MPI_COMM_WORLD);
+		return;
+	}
+#endif
+
+	if (count > 0)
+		std::memcpy(recv, send, static_cast<std::size_t>(count) * itemSize);
+}
+
+} // namespace fem::distributed
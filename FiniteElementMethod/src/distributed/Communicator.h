@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace fem::distributed
+{
+
+/// <summary>
+/// Collectives over all ranks, the only place that calls MPI directly. Without FEM_USE_MPI
+/// (or with a single rank) every operation degenerates to a local copy, so the distributed
+/// code path also runs in a serial build
+/// </summary>
+class Communicator
+{
+public:
+	Communicator() = delete;
+
+	static double SumAll(double value);
+	static double MaxAll(double value);
+
+	/// <summary>
+	/// Element-wise sum / max over all ranks, in place. Batches several reductions into one message
+	/// </summary>
+	static void SumAll(std::span<double> values);
+	static void MaxAll(std::span<double> values);
+
+	static void Barrier();
+
+	/// <summary>
+	/// Sends send[offset(r) .. offset(r) + sendCounts[r]) to rank r and returns what the other ranks
+	/// sent here, ordered by source rank. recvCounts receives the number of items from each rank
+	/// </summary>
+	template<typename T>
+	static std::vector<T> AllToAll(const std::vector<T>& send, const std::vector<int>& sendCounts, std::vector<int>& recvCounts)
+	{
+		static_assert(std::is_trivially_copyable_v<T>);
+
+		recvCounts = ExchangeCounts(sendCounts);
+
+		std::size_t total = 0;
+		for (int count : recvCounts)
+			total += static_cast<std::size_t>(count);
+
+		std::vector<T> recv(total);
+		AllToAllBytes(send.data(), sendCounts, recv.data(), recvCounts, sizeof(T));
+		return recv;
+	}
+
+	/// <summary>
+	/// Concatenation of every rank's items on rank 0 (ordered by rank), empty elsewhere
+	/// </summary>
+	template<typename T>
+	static std::vector<T> GatherToRoot(std::span<const T> items, std::vector<int>* counts = nullptr)
+	{
+		static_assert(std::is_trivially_copyable_v<T>);
+
+		std::vector<int> itemCounts = GatherCounts(static_cast<int>(items.size()));
+
+		std::size_t total = 0;
+		for (int count : itemCounts)
+			total += static_cast<std::size_t>(count);
+
+		std::vector<T> out(total);
+		GatherBytes(items.data(), static_cast<int>(items.size()), out.data(), itemCounts, sizeof(T));
+
+		if (counts)
+			*counts = std::move(itemCounts);
+
+		return out;
+	}
+
+	/// <summary>
+	/// Point-to-point exchange with a fixed set of neighbours: send[i] goes to ranks[i] while recv[i]
+	/// is filled from ranks[i]. Blocks until all messages have completed
+	/// </summary>
+	static void ExchangeWithNeighbours(std::span<const int> ranks, std::span<const std::span<const double>> send, std::span<const std::span<double>> recv);
+
+private:
+	static std::vector<int> ExchangeCounts(const std::vector<int>& sendCounts);
+	static std::vector<int> GatherCounts(int count);
+
+	static void AllToAllBytes(const void* send, const std::vector<int>& sendCounts, void* recv, const std::vector<int>& recvCounts, std::size_t itemSize);
+	static void GatherBytes(const void* send, int count, void* recv, const std::vector<int>& recvCounts, std::size_t itemSize);
+};
+
+} // namespace fem::distributed
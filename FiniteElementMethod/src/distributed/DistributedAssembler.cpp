@@ -0,0 +1,304 @@
+#include "DistributedAssembler.h"
+
+#include "Communicator.h"
+
+#include "config/MPIConfig.h"
+#include "logger/logger.h"
+#include "utils/utils.h"
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <omp.h>
+
+namespace fem::distributed
+{
+
+std::expected<DistributedBuildResult, int> DistributedAssembler::Build() const
+{
+	const int rank = config::MPIConfig::GetRank();
+
+	LOG_INFO("Calculating distributed H, C matrices and P vector on {} ranks", config::MPIConfig::GetSize());
+
+	auto totalStart = Now();
+
+	DistributedBuildResult out;
+	auto& stats = out.stats;
+	auto& rankStats = out.rankStats;
+	auto& system = out.system;
+
+	rankStats.rank = rank;
+
+	const auto& nodePart = m_Partition.nodePart;
+	const auto numberOfNodes = m_Mesh.GetNodesCount();
+	const auto& quads = m_Mesh.GetQuads();
+	const auto& lines = m_Mesh.GetLines();
+
+	auto ownerOf = [&](std::size_t gmshId)
+	{
+		return static_cast<int>(nodePart[m_Mesh.GetNodeLocalId(gmshId)]);
+	};
+
+	std::vector<int> ownedQuads;
+	std::vector<int> ownedLines;
+
+	for (size_t i = 0; i < quads.size(); ++i)
+		if (ownerOf(quads[i].nodeIDs[0]) == rank)
+			ownedQuads.push_back(static_cast<int>(i));
+
+	for (size_t i = 0; i < lines.size(); ++i)
+		if (ownerOf(lines[i].nodeIDs[0]) == rank)
+			ownedLines.push_back(static_cast<int>(i));
+
+	stats.elementCount = ownedQuads.size();
+	stats.boundaryElementCount = ownedLines.size();
+
+	std::vector<Contribution> contributions;
+	std::vector<LoadContribution> loads;
+	contributions.reserve(ownedQuads.size() * 16 + ownedLines.size() * 4);
+	loads.reserve(ownedQuads.size() * 4 + ownedLines.size() * 2);
+
+	std::atomic<bool> hasError{ false };
+	const int totalElements = static_cast<int>(ownedQuads.size());
+
+	auto elementStart = Now();
+
+#pragma omp parallel
+	{
+		std::vector<Contribution> localContributions;
+		std::vector<LoadContribution> localLoads;
+
+#pragma omp for schedule(dynamic, 128) nowait
+		for (int i = 0; i < totalElements; i++)
+		{
+			if (hasError.load(std::memory_order_relaxed)) continue;
+
+			const auto& element = quads[ownedQuads[i]];
+			auto res = m_Builder.BuildQuadMatrices(m_Mesh, element);
+
+			if (!res)
+			{
+				hasError.store(true, std::memory_order_relaxed);
+				LOG_ERROR("Failed to build matrices for element {}", ownedQuads[i]);
+				continue;
+			}
+
+			std::array<int, 4> nodeIds{};
+			for (int localNode = 0; localNode < 4; ++localNode)
+				nodeIds[localNode] = static_cast<int>(m_Mesh.GetNodeLocalId(element.nodeIDs[localNode]));
+
+			for (int iLocal = 0; iLocal < 4; ++iLocal)
+			{
+				for (int jLocal = 0; jLocal < 4; ++jLocal)
+					localContributions.push_back({ nodeIds[iLocal], nodeIds[jLocal], res->H(iLocal, jLocal), res->C(iLocal, jLocal) });
+
+				localLoads.push_back({ nodeIds[iLocal], res->P(iLocal) });
+			}
+		}
+
+#pragma omp critical(merge_contributions)
+		{
+			contributions.insert(contributions.end(), localContributions.begin(), localContributions.end());
+			loads.insert(loads.end(), localLoads.begin(), localLoads.end());
+		}
+	}
+
+	auto elementEnd = Now();
+	stats.elementAssemblyTimeMs = ElapsedMs(elementStart, elementEnd);
+
+	for (int lineIndex : ownedLines)
+	{
+		const auto& line = lines[lineIndex];
+		const auto& res = m_Builder.BuildLineBoundaryMatrices(m_Mesh, line);
+
+		if (!res)
+		{
+			hasError.store(true, std::memory_order_relaxed);
+			LOG_ERROR("Failed to build matrices for boundary line {}", lineIndex);
+			continue;
+		}
+
+		std::array<int, 2> nodeIds{};
+		for (int localNode = 0; localNode < 2; ++localNode)
+			nodeIds[localNode] = static_cast<int>(m_Mesh.GetNodeLocalId(line.nodeIDs[localNode]));
+
+		for (int iLocal = 0; iLocal < 2; ++iLocal)
+		{
+			for (int jLocal = 0; jLocal < 2; ++jLocal)
+				contributions.push_back({ nodeIds[iLocal], nodeIds[jLocal], res->H(iLocal, jLocal), 0.0 });
+
+			loads.push_back({ nodeIds[iLocal], res->P(iLocal) });
+		}
+	}
+
+	auto boundaryEnd = Now();
+	stats.boundaryAssemblyTimeMs = ElapsedMs(elementEnd, boundaryEnd);
+
+	// Agree on failure before anyone enters the exchange, otherwise healthy ranks would wait forever
+	if (Communicator::MaxAll(hasError.load() ? 1.0 : 0.0) > 0.0)
+	{
+		LOG_ERROR("Distributed assembly failed");
+		return std::unexpected(-1);
+	}
+
+	rankStats.assemblyTimeMs = stats.getComputationTimeMs();
+
+	auto exchangeStart = Now();
+
+	size_t sent = 0, received = 0;
+	ShipToOwners(contributions, m_Partition, sent, received);
+	rankStats.sentContributions += sent;
+	rankStats.receivedContributions += received;
+
+	ShipToOwners(loads, m_Partition, sent, received);
+	rankStats.sentContributions += sent;
+	rankStats.receivedContributions += received;
+
+	auto exchangeEnd = Now();
+	stats.mergeTimeMs = ElapsedMs(exchangeStart, exchangeEnd);
+	rankStats.exchangeTimeMs = stats.mergeTimeMs;
+
+	// Owned rows first in mesh order, then ghost columns grouped by owner
+	auto localStart = Now();
+
+	system.globalSize = numberOfNodes;
+
+	std::vector<int> ownedIndex(numberOfNodes, -1);
+	for (size_t node = 0; node < numberOfNodes; ++node)
+	{
+		if (static_cast<int>(nodePart[node]) == rank)
+		{
+			ownedIndex[node] = static_cast<int>(system.ownedNodes.size());
+			system.ownedNodes.push_back(static_cast<int>(node));
+		}
+	}
+
+	std::vector<int> columnIndex = ownedIndex;
+	constexpr int GhostMark = -2;
+
+	for (const auto& item : contributions)
+	{
+		if (columnIndex[item.col] == -1)
+		{
+			columnIndex[item.col] = GhostMark;
+			system.ghostNodes.push_back(item.col);
+		}
+	}
+
+	std::sort(system.ghostNodes.begin(), system.ghostNodes.end(), [&](int a, int b)
+		{
+			return std::pair(nodePart[a], a) < std::pair(nodePart[b], b);
+		});
+
+	const auto ownedCount = static_cast<int>(system.ownedNodes.size());
+	for (size_t k = 0; k < system.ghostNodes.size(); ++k)
+		columnIndex[system.ghostNodes[k]] = ownedCount + static_cast<int>(k);
+
+	domain::TripletsVector tripletsH;
+	domain::TripletsVector tripletsC;
+	tripletsH.reserve(contributions.size());
+	tripletsC.reserve(contributions.size());
+
+	for (const auto& item : contributions)
+	{
+		const int row = ownedIndex[item.row];
+		const int col = columnIndex[item.col];
+
+		tripletsH.emplace_back(row, col, item.h);
+
+		if (item.c != 0.0)
+			tripletsC.emplace_back(row, col, item.c);
+	}
+
+	stats.tripletsHCount = tripletsH.size();
+	stats.tripletsCCount = tripletsC.size();
+	stats.tripletsMemoryBytes = (tripletsH.capacity() + tripletsC.capacity()) * sizeof(Triplet)
+		+ contributions.capacity() * sizeof(Contribution);
+
+	contributions.clear();
+	contributions.shrink_to_fit();
+
+	auto tripletStart = Now();
+
+	const auto localColumns = static_cast<Eigen::Index>(system.GetLocalColumns());
+	system.H.resize(ownedCount, localColumns);
+	system.C.resize(ownedCount, localColumns);
+	system.H.setFromTriplets(tripletsH.begin(), tripletsH.end());
+	system.C.setFromTriplets(tripletsC.begin(), tripletsC.end());
+
+	stats.tripletToSparseTimeMs = ElapsedMs(tripletStart, Now());
+
+	system.P = Vec::Zero(ownedCount);
+	for (const auto& load : loads)
+		system.P[ownedIndex[load.row]] += load.p;
+
+	system.halo = HaloExchange::Build(system.ownedNodes.size(), system.ghostNodes, m_Partition, ownedIndex);
+
+	rankStats.localMatrixTimeMs = ElapsedMs(localStart, Now());
+
+	const size_t nnzH = system.H.nonZeros();
+	const size_t nnzC = system.C.nonZeros();
+	stats.sparseMatrixMemoryBytes =
+		(nnzH + nnzC) * (sizeof(double) + sizeof(int)) +
+		2 * (ownedCount + 1) * sizeof(int) +
+		ownedCount * sizeof(double);
+
+	stats.totalAssemblyTimeMs = ElapsedMs(totalStart, Now());
+
+	rankStats.ownedNodes = system.GetOwnedCount();
+	rankStats.ghostNodes = system.GetGhostCount();
+	rankStats.ownedElements = ownedQuads.size() + ownedLines.size();
+	rankStats.neighbours = system.halo.GetNeighbourCount();
+
+	LOG_INFO("Rank {}: {} owned nodes, {} ghosts from {} neighbours, {} elements",
+		rank, rankStats.ownedNodes, rankStats.ghostNodes, rankStats.neighbours, rankStats.ownedElements);
+	LOG_INFO("  Local H: {} x {}, nnz = {} (C: nnz = {})", system.H.rows(), system.H.cols(), nnzH, nnzC);
+	LOG_INFO("  Element assembly: {:.2f} ms, boundary: {:.2f} ms", stats.elementAssemblyTimeMs, stats.boundaryAssemblyTimeMs);
+	LOG_INFO("  Exchange: {:.2f} ms ({} sent, {} received)", stats.mergeTimeMs, rankStats.sentContributions, rankStats.receivedContributions);
+	LOG_INFO("  Local matrices: {:.2f} ms, total: {:.2f} ms", rankStats.localMatrixTimeMs, stats.totalAssemblyTimeMs);
+
+	return out;
+}
+
+template<typename T>
+void DistributedAssembler::ShipToOwners(std::vector<T>& contributions, const mesh::partition::MeshPartition& partition, std::size_t& sent, std::size_t& received)
+{
+	const int size = config::MPIConfig::GetSize();
+	const int rank = config::MPIConfig::GetRank();
+
+	std::vector<int> sendCounts(size, 0);
+	for (const auto& item : contributions)
+		++sendCounts[partition.nodePart[item.row]];
+
+	const size_t kept = static_cast<size_t>(sendCounts[rank]);
+	sendCounts[rank] = 0;
+
+	std::vector<int> offsets(size, 0);
+	std::exclusive_scan(sendCounts.begin(), sendCounts.end(), offsets.begin(), 0);
+
+	// Compact our own rows to the front, bucket the rest by owner
+	std::vector<T> outgoing(contributions.size() - kept);
+	size_t keptSize = 0;
+
+	for (const auto& item : contributions)
+	{
+		const int owner = static_cast<int>(partition.nodePart[item.row]);
+
+		if (owner == rank)
+			contributions[keptSize++] = item;
+		else
+			outgoing[offsets[owner]++] = item;
+	}
+
+	contributions.resize(keptSize);
+
+	std::vector<int> recvCounts;
+	auto incoming = Communicator::AllToAll(outgoing, sendCounts, recvCounts);
+
+	sent = outgoing.size();
+	received = incoming.size();
+
+	contributions.insert(contributions.end(), incoming.begin(), incoming.end());
+}
+
+} // namespace fem::distributed
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "DistributedStats.h"
+#include "DistributedSystem.h"
+
+#include "domain/domain.h"
+#include "mesh/mesh.h"
+
+#include <expected>
+
+namespace fem::distributed
+{
+
+struct DistributedBuildResult
+{
+	DistributedSystem system;
+	domain::AssemblyStats stats; // This rank only
+	RankStats rankStats;
+};
+
+/// <summary>
+/// Assembles H, C and P across ranks. Each element is integrated by the rank owning its first
+/// node; contributions to rows owned elsewhere are shipped to their owners in one all-to-all, so
+/// every rank ends up with complete rows for its nodes and no rank ever holds the global matrix
+/// </summary>
+class DistributedAssembler
+{
+public:
+	DistributedAssembler(const mesh::model::Mesh& mesh, const domain::ElementMatrixBuilder& builder, const mesh::partition::MeshPartition& partition)
+		: m_Mesh(mesh), m_Builder(builder), m_Partition(partition) {};
+
+	/// <summary>
+	/// Collective - all ranks must call it and all of them fail if any rank does
+	/// </summary>
+	// TODO: Create custom error
+	std::expected<DistributedBuildResult, int> Build() const;
+
+private:
+	struct Contribution
+	{
+		int row;
+		int col;
+		double h;
+		double c;
+	};
+
+	struct LoadContribution
+	{
+		int row;
+		double p;
+	};
+
+	/// <summary>
+	/// Replaces contributions with the ones whose row this rank owns: the locally produced ones plus
+	/// everything other ranks produced for our rows
+	/// </summary>
+	template<typename T>
+	static void ShipToOwners(std::vector<T>& contributions, const mesh::partition::MeshPartition& partition, std::size_t& sent, std::size_t& received);
+
+private:
+	const mesh::model::Mesh& m_Mesh;
+	const domain::ElementMatrixBuilder& m_Builder;
+	const mesh::partition::MeshPartition& m_Partition;
+};
+
+}
@@ -0,0 +1,218 @@
+#include "DistributedConjugateGradient.h"
+
+#include "Communicator.h"
+
+#include "logger/logger.h"
+#include "metrics/metrics.h"
+#include "solver/linear/preconditioner/PreconditionerFactory.h"
+#include "utils/utils.h"
+
+#include <array>
+#include <cmath>
+
+namespace fem::distributed
+{
+
+using namespace fem::solver;
+using namespace fem::solver::linear;
+
+DistributedConjugateGradient::DistributedConjugateGradient(const LinearSolverOptions& options)
+	: m_Options(LocalOptions(options)),
+	m_Preconditioner(PreconditionerFactory::Create(m_Options.preconditioner, m_Options))
+{
+}
+
+std::string DistributedConjugateGradient::GetName() const
+{
+	return std::format("Distributed PCG (block {})", m_Preconditioner->GetName());
+}
+
+LinearSolverOptions DistributedConjugateGradient::LocalOptions(const LinearSolverOptions& options)
+{
+	LinearSolverOptions local = options;
+
+	// Mesh-wide layouts do not describe the owned block
+	local.partition.reset();
+	local.structuredGrid.reset();
+
+	if (local.preconditioner == PreconditionerType::GMG)
+	{
+		LOG_WARN("Geometric multigrid needs the whole structured grid, using AMG on each rank instead");
+		local.preconditioner = PreconditionerType::AMG;
+	}
+
+	return local;
+}
+
+std::expected<LinearSolverResult, SolverError> DistributedConjugateGradient::SolveWithGuess(const SpMat& A, const HaloExchange& halo, const Vec& b, const Vec& x0)
+{
+	const auto owned = static_cast<Eigen::Index>(halo.GetOwnedCount());
+
+	if (A.rows() != owned || A.cols() != owned + static_cast<Eigen::Index>(halo.GetGhostCount()))
+	{
+		return std::unexpected(
+			SolverError{
+				SolverErrorCode::InvalidInput,
+				std::format("Local matrix ({} x {}) doesn't match the halo layout ({} owned, {} ghosts)", A.rows(), A.cols(), owned, halo.GetGhostCount())
+			}
+		);
+	}
+
+	if (b.size() != owned || x0.size() != owned)
+	{
+		return std::unexpected(
+			SolverError{
+				SolverErrorCode::InvalidInput,
+				std::format("Owned rows ({}) don't match vector sizes (b: {}, x0: {})", owned, b.size(), x0.size())
+			}
+		);
+	}
+
+	auto start = Now();
+
+	LinearSolverStats stats;
+
+	std::array<double, 2> sizes{ static_cast<double>(A.rows()), static_cast<double>(A.nonZeros()) };
+	Communicator::SumAll(sizes);
+	stats.matrixSize = static_cast<size_t>(sizes[0]);
+	stats.matrixNonZeros = static_cast<size_t>(sizes[1]);
+
+	const auto fingerprint = solver::linear::MatrixFingerprint::Of(A);
+
+	// Setup is collective, a block changed on any rank rebuilds on all of them
+	const bool changed = Communicator::MaxAll(fingerprint.SameContent(m_PreconditionedMatrix) ? 0.0 : 1.0) > 0.0;
+
+	if (changed)
+	{
+		auto setupStart = Now();
+
+		m_OwnedBlock = A.leftCols(owned);
+		const bool computed = m_Preconditioner->Compute(m_OwnedBlock);
+
+		// Every rank has to take the same branch
+		if (Communicator::MaxAll(computed ? 0.0 : 1.0) > 0.0)
+		{
+			m_PreconditionedMatrix = {};
+
+			return std::unexpected(
+				SolverError{
+					SolverErrorCode::NumericalInstability,
+					std::format("{} preconditioner setup failed", m_Preconditioner->GetName())
+				}
+			);
+		}
+
+		auto setupEnd = Now();
+		stats.preconditionerSetupTimeMs = ElapsedMs(setupStart, setupEnd);
+	}
+
+	// Kernels may read the arrays of A in place, so they are rebuilt whenever the arrays move
+	if (changed || !fingerprint.SameStorage(m_PreconditionedMatrix))
+		m_Product.emplace(A, m_Options.spmvBackend);
+
+	m_PreconditionedMatrix = fingerprint;
+
+	auto solveStart = Now();
+
+	const size_t maxIterations = m_Options.maxIterations > 0
+		? m_Options.maxIterations
+		: stats.matrixSize;
+
+	// x and p carry ghost entries, everything else lives on owned rows only
+	const Eigen::Index columns = A.cols();
+
+	Vec x(columns);
+	x.head(owned) = x0;
+	halo.Update(x);
+
+	Vec r = m_Product->Residual(b, x);
+	Vec z(owned);
+	Vec p = Vec::Zero(columns);
+	Vec Ap(owned);
+
+	std::array<double, 2> norms{ b.squaredNorm(), r.squaredNorm() };
+	Communicator::SumAll(norms);
+
+	const double bNorm = std::sqrt(norms[0]);
+	const double threshold = m_Options.tolerance * (bNorm > 0.0 ? bNorm : 1.0);
+
+	double rNorm = std::sqrt(norms[1]);
+	size_t iteration = 0;
+
+	if (rNorm > threshold)
+	{
+		m_Preconditioner->Apply(r, z);
+		p.head(owned) = z;
+
+		double rz = Communicator::SumAll(r.dot(z));
+
+		while (iteration < maxIterations)
+		{
+			halo.Update(p);
+			m_Product->Multiply(p, Ap);
+
+			double pAp = Communicator::SumAll(p.head(owned).dot(Ap));
+
+			if (pAp <= 0.0)
+			{
+				return std::unexpected(
+					SolverError{
+						SolverErrorCode::NumericalInstability,
+						std::format("Distributed PCG breakdown at iteration {} - matrix is not positive definite", iteration)
+					}
+				);
+			}
+
+			double alpha = rz / pAp;
+			x.head(owned) += alpha * p.head(owned);
+			r -= alpha * Ap;
+
+			++iteration;
+
+			m_Preconditioner->Apply(r, z);
+
+			// One reduction for both the convergence test and the next step
+			std::array<double, 2> reduced{ r.squaredNorm(), r.dot(z) };
+			Communicator::SumAll(reduced);
+
+			rNorm = std::sqrt(reduced[0]);
+
+			if (rNorm <= threshold)
+				break;
+
+			double beta = reduced[1] / rz;
+			rz = reduced[1];
+
+			p.head(owned) = z + beta * p.head(owned);
+		}
+	}
+
+	auto solveEnd = Now();
+	stats.solveTimeMs = ElapsedMs(solveStart, solveEnd);
+	stats.iterations = iteration;
+
+	if (rNorm > threshold)
+	{
+		return std::unexpected(
+			SolverError{
+				SolverErrorCode::NumericalInstability,
+				std::format("Distributed PCG did not converge in {} iterations (relative residual {:.2e})", iteration, rNorm / (bNorm > 0.0 ? bNorm : 1.0))
+			}
+		);
+	}
+
+	stats.peakMemoryBytes = metrics::MemoryMonitor::GetPeakUsage();
+
+	halo.Update(x);
+	stats.residualNorm = std::sqrt(Communicator::SumAll(m_Product->Residual(b, x).squaredNorm()));
+
+	auto end = Now();
+	stats.elapsedTimeMs = ElapsedMs(start, end);
+
+	return LinearSolverResult{
+		.solution = x.head(owned),
+		.stats = stats
+	};
+}
+
+} // namespace fem::distributed
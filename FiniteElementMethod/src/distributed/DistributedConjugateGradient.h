@@ -0,0 +1,49 @@
+#pragma once
+
+#include "HaloExchange.h"
+
+#include "math/math.h"
+#include "solver/SolverError.h"
+#include "solver/linear/LinearSolverOptions.h"
+#include "solver/linear/LinearSolverResult.h"
+#include "solver/linear/MatrixFingerprint.h"
+#include "solver/linear/preconditioner/IPreconditioner.h"
+
+#include <expected>
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace fem::distributed
+{
+
+/// <summary>
+/// Preconditioned conjugate gradient over row-distributed vectors. Products refresh the halo
+/// before the local SpMV and every dot product is one all-reduce, so each rank only ever touches
+/// its owned rows. Preconditioning is block Jacobi: any of the shared-memory preconditioners
+/// (Jacobi, IC, AMG, Schwarz, ...) applied to the rank's owned diagonal block
+/// </summary>
+class DistributedConjugateGradient
+{
+public:
+	explicit DistributedConjugateGradient(const solver::linear::LinearSolverOptions& options);
+
+	/// <summary>
+	/// A is owned x (owned + ghost), b and x0 are owned. Collective - all ranks must call it
+	/// </summary>
+	std::expected<solver::linear::LinearSolverResult, solver::SolverError> SolveWithGuess(const SpMat& A, const HaloExchange& halo, const Vec& b, const Vec& x0);
+
+	std::string GetName() const;
+
+private:
+	static solver::linear::LinearSolverOptions LocalOptions(const solver::linear::LinearSolverOptions& options);
+
+private:
+	solver::linear::LinearSolverOptions m_Options;
+	std::unique_ptr<solver::linear::IPreconditioner> m_Preconditioner;
+	solver::linear::MatrixFingerprint m_PreconditionedMatrix;
+	std::optional<math::SpmvEngine> m_Product; // Built together with the preconditioner
+	SpMat m_OwnedBlock;
+};
+
+} // namespace fem::distributed
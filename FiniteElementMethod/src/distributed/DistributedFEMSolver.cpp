@@ -0,0 +1,357 @@
+#include "DistributedFEMSolver.h"
+
+#include "Communicator.h"
+#include "DistributedConjugateGradient.h"
+
+#include "config/MPIConfig.h"
+#include "logger/logger.h"
+#include "metrics/metrics.h"
+#include "utils/utils.h"
+
+#include <array>
+#include <limits>
+#include <span>
+
+namespace fem::distributed
+{
+
+using namespace fem::solver;
+
+namespace
+{
+
+/// <summary>
+/// Global [min, max] of a distributed vector, ranks without rows do not take part
+/// </summary>
+std::pair<double, double> GlobalRange(const Vec& owned)
+{
+	constexpr double lowest = std::numeric_limits<double>::lowest();
+
+	std::array<double, 2> range{
+		owned.size() > 0 ? -owned.minCoeff() : lowest,
+		owned.size() > 0 ? owned.maxCoeff() : lowest
+	};
+
+	Communicator::MaxAll(range);
+	return { -range[0], range[1] };
+}
+
+}
+
+std::expected<FEMSolverResult, SolverError> DistributedFEMSolver::Solve(const DistributedSystem& system, const FEMSolverConfig& config, RankStats& rankStats)
+{
+	using enum domain::model::ProblemType;
+
+	if (config.linearSolver != linear::LinearSolverType::ConjugateGradient)
+		LOG_WARN("{} is not available across ranks, using distributed PCG", linear::LinearSolverTypeToString(config.linearSolver));
+
+	switch (config.problemType)
+	{
+	case Steady:
+		return SolveSteady(system, config.linearSolverOptions, rankStats);
+
+	case Transient:
+		if (!config.transientConfig)
+			return std::unexpected(
+				SolverError{
+					SolverErrorCode::InvalidInput,
+					"Transient config is required for transient problems"
+				}
+			);
+
+		return SolveTransient(system, *config.transientConfig, config.linearSolverOptions, rankStats);
+	}
+
+	return std::unexpected(
+		SolverError{
+			SolverErrorCode::InvalidInput,
+			"Unknown problem type"
+		}
+	);
+}
+
+std::expected<FEMSolverResult, SolverError> DistributedFEMSolver::SolveSteady(const DistributedSystem& system, const linear::LinearSolverOptions& solverOptions, RankStats& rankStats)
+{
+	LOG_INFO("Solving Steady - State Problem on {} ranks", config::MPIConfig::GetSize());
+
+	DistributedConjugateGradient linearSolver(solverOptions);
+	LOG_INFO("  Linear solver:    {}", linearSolver.GetName());
+
+	auto startTime = Now();
+	auto result = linearSolver.SolveWithGuess(system.H, system.halo, system.P, Vec::Zero(system.GetOwnedCount()));
+	auto endTime = Now();
+
+	if (!result)
+		return std::unexpected(result.error());
+
+	double totalTime = ElapsedMs(startTime, endTime);
+
+	const auto& stats = result->stats;
+
+	rankStats.solveTimeMs = stats.elapsedTimeMs;
+	rankStats.haloTimeMs = system.halo.GetElapsedMs();
+	rankStats.iterations = stats.iterations;
+	rankStats.peakMemoryBytes = metrics::MemoryMonitor::GetPeakUsage();
+
+	auto [minT, maxT] = GlobalRange(result->solution);
+
+	auto femStats = FEMSolverStats::FromLinearSolverStats(stats, totalTime);
+	femStats.peakMemoryBytes = static_cast<size_t>(Communicator::SumAll(static_cast<double>(rankStats.peakMemoryBytes))); // All ranks share the host
+
+	LOG_INFO("Steady Analysis Complete:");
+	LOG_INFO("  Total solver time:  {:.2f} ms", stats.elapsedTimeMs);
+	LOG_INFO("  Preconditioner:     {:.2f} ms", stats.preconditionerSetupTimeMs);
+	LOG_INFO("  Iterations:         {}", stats.iterations);
+	LOG_INFO("  Halo exchange:      {:.2f} ms", rankStats.haloTimeMs);
+	LOG_INFO("  Peak memory:        {:.2f} MB (all ranks)", femStats.getPeakMemoryMB());
+	LOG_INFO("  Residual norm:      {:.2e}", stats.residualNorm);
+	LOG_INFO("  Solution range:     T_min = {:.2f} K, T_max = {:.2f} K", minT, maxT);
+
+	return FEMSolverResult{
+		.solution = SteadySolution{
+			.solution = GatherToRoot(system, result->solution)
+		},
+		.stats = femStats,
+	};
+}
+
+std::expected<FEMSolverResult, SolverError> DistributedFEMSolver::SolveTransient(const DistributedSystem& system, const domain::model::TransientConfig& config, const linear::LinearSolverOptions& solverOptions, RankStats& rankStats)
+{
+	LOG_INFO("Solving Transient Problem on {} ranks", config::MPIConfig::GetSize());
+
+	if (config.timeStep <= 0.0 || config.totalTime <= 0.0)
+		return std::unexpected(
+			SolverError{
+				SolverErrorCode::InvalidInput,
+				std::format("Time step and total time must be positive")
+			});
+
+	bool saveHistory = config.saveHistory;
+	size_t saveStride = 0;
+
+	if (saveHistory)
+	{
+		if (!config.saveStride.has_value() || *config.saveStride == 0)
+			return std::unexpected(SolverError{
+					SolverErrorCode::InvalidInput,
+					"Save stride must be provided and positive when save history is true"
+				});
+
+		saveStride = *config.saveStride;
+	}
+
+	double dt = config.timeStep;
+	std::size_t numSteps = static_cast<std::size_t>(config.totalTime / dt);
+	size_t progressStep = std::max<size_t>(1, numSteps / 10);
+
+	const auto owned = static_cast<Eigen::Index>(system.GetOwnedCount());
+	const auto& halo = system.halo;
+
+	LOG_INFO("Configuration:");
+	LOG_INFO("  Total time:       {:.3f} s", config.totalTime);
+	LOG_INFO("  Time step:        {:.6f} s", config.timeStep);
+	LOG_INFO("  Number of steps:  {}", numSteps);
+	LOG_INFO("  System size:      {} nodes ({} on this rank)", system.globalSize, owned);
+	LOG_INFO("  Initial temp:     {:.2f} K", config.initialTemperature);
+
+	if (saveHistory)
+		LOG_INFO("  Save stride:      every {} steps", saveStride);
+
+	const auto& steadyCriterion = config.steadyStateCriterion;
+
+	if (steadyCriterion)
+		LOG_INFO("  Steady state:     max |dT|/dt < {:.3e} K/s for {} steps", steadyCriterion->tolerance, steadyCriterion->consecutiveSteps);
+
+	DistributedConjugateGradient linearSolver(solverOptions);
+	LOG_INFO("  Linear solver:    {}", linearSolver.GetName());
+
+	auto setupStart = Now();
+
+	SpMat A = system.H + system.C / dt;
+	SpMat massOverDt = system.C / dt;
+	math::SpmvEngine massProduct(massOverDt, solverOptions.spmvBackend);
+
+	// Carries ghost entries for the mass product
+	Vec T_current = Vec::Constant(system.GetLocalColumns(), config.initialTemperature);
+
+	auto setupEnd = Now();
+	double setupTime = ElapsedMs(setupStart, setupEnd);
+
+	LOG_INFO("  Setup time:       {:.2f} ms", setupTime);
+
+	std::vector<Vec> temperatures;
+	std::vector<double> timeSteps;
+
+	if (saveHistory)
+	{
+		temperatures.push_back(GatherToRoot(system, T_current.head(owned)));
+		timeSteps.push_back(0.0);
+	}
+
+	auto totalStart = Now();
+
+	double totalSolverTime = 0.0;
+	double totalSolveTime = 0.0;
+	double totalPreconditionerTime = 0.0;
+	size_t totalIterations = 0;
+	double minResidual = std::numeric_limits<double>::max();
+	double maxResidual = 0.0;
+
+	size_t stepsPerformed = 0;
+	size_t stepsBelowTolerance = 0;
+	std::optional<SteadyStateStats> steadyState;
+
+	Vec b(owned);
+
+	for (size_t step = 0; step < numSteps; ++step)
+	{
+		double currentTime = step * dt;
+
+		halo.Update(T_current);
+		massProduct.Multiply(T_current, b);
+		b += system.P;
+
+		auto result = linearSolver.SolveWithGuess(A, halo, b, T_current.head(owned));
+
+		if (!result)
+			return std::unexpected(result.error());
+
+		const auto& stats = result->stats;
+
+		totalSolverTime += stats.elapsedTimeMs;
+		totalSolveTime += stats.solveTimeMs;
+		totalPreconditionerTime += stats.preconditionerSetupTimeMs;
+		totalIterations += stats.iterations;
+		minResidual = std::min(minResidual, stats.residualNorm);
+		maxResidual = std::max(maxResidual, stats.residualNorm);
+
+		double changeRate = 0.0;
+
+		if (steadyCriterion)
+		{
+			double localChange = owned > 0 ? (result->solution - T_current.head(owned)).cwiseAbs().maxCoeff() : 0.0;
+			changeRate = Communicator::MaxAll(localChange) / dt;
+			stepsBelowTolerance = changeRate < steadyCriterion->tolerance ? stepsBelowTolerance + 1 : 0;
+		}
+
+		T_current.head(owned) = result->solution;
+		stepsPerformed = step + 1;
+
+		bool steadyReached = steadyCriterion && stepsBelowTolerance >= steadyCriterion->consecutiveSteps;
+
+		if (saveHistory && (step % saveStride == 0 || step == numSteps - 1 || steadyReached))
+		{
+			temperatures.push_back(GatherToRoot(system, T_current.head(owned)));
+			timeSteps.push_back(currentTime + dt);
+		}
+
+		if (steadyReached)
+		{
+			steadyState = SteadyStateStats{
+				.step = stepsPerformed,
+				.time = currentTime + dt,
+				.changeRate = changeRate,
+				.skippedSteps = numSteps - stepsPerformed
+			};
+
+			LOG_INFO("Steady state reached at t = {:.3f}s (step {}/{}), max |dT|/dt = {:.3e} K/s",
+				currentTime + dt, stepsPerformed, numSteps, changeRate);
+
+			break;
+		}
+
+		if (step == 0 || step % progressStep == 0 || step == numSteps - 1)
+		{
+			auto [minT, maxT] = GlobalRange(T_current.head(owned));
+			double pct = 100.0 * (step + 1) / numSteps;
+			LOG_INFO("Progress: {:.1f}% ({}/{}) - t = {:.3f}s, T_range = [{:.2f}, {:.2f}] K",
+				pct, step + 1, numSteps, currentTime + dt, minT, maxT);
+		}
+	}
+
+	if (steadyState && saveHistory && steadyCriterion->fillRemainingHistory)
+	{
+		for (size_t step = stepsPerformed; step < numSteps; ++step)
+		{
+			if (step % saveStride == 0 || step == numSteps - 1)
+			{
+				temperatures.push_back(temperatures.back());
+				timeSteps.push_back((step + 1) * dt);
+			}
+		}
+	}
+
+	auto totalEnd = Now();
+	double totalTime = ElapsedMs(totalStart, totalEnd);
+
+	rankStats.solveTimeMs = totalSolverTime;
+	rankStats.haloTimeMs = halo.GetElapsedMs();
+	rankStats.iterations = totalIterations;
+	rankStats.peakMemoryBytes = metrics::MemoryMonitor::GetPeakUsage();
+
+	FEMSolverStats stats{
+		.solveTimeMs = totalSolveTime,
+		.totalSolverTimeMs = totalSolverTime,
+		.totalTimeMs = totalTime,
+		.setupTimeMs = setupTime,
+		.overheadMs = totalTime - totalSolverTime,
+		.preconditionerSetupTimeMs = totalPreconditionerTime,
+		.peakMemoryBytes = static_cast<size_t>(Communicator::SumAll(static_cast<double>(rankStats.peakMemoryBytes))), // All ranks share the host
+		.residualNorm = maxResidual,
+		.minResidual = minResidual,
+		.maxResidual = maxResidual,
+		.matrixSize = system.globalSize,
+		.matrixNonZeros = static_cast<size_t>(Communicator::SumAll(static_cast<double>(A.nonZeros()))),
+		.linearSolveCount = stepsPerformed,
+		.totalIterations = totalIterations,
+		.steadyState = steadyState
+	};
+
+	auto [minT, maxT] = GlobalRange(T_current.head(owned));
+
+	LOG_INFO("Transient Analysis Complete:");
+	LOG_INFO("  Total time:         {:.2f} ms", stats.totalTimeMs);
+	LOG_INFO("  Total solver time:  {:.2f} ms", stats.totalSolverTimeMs);
+	LOG_INFO("  Loop overhead:      {:.2f} ms ({:.1f}%)", stats.overheadMs, stats.getOverheadPercent());
+	LOG_INFO("  Avg solve:          {:.2f} ms/step", stats.getAvgSolveMs());
+	LOG_INFO("  Avg per step:       {:.2f} ms", stats.getAvgPerStepMs());
+	LOG_INFO("  Preconditioner:     {:.2f} ms", stats.preconditionerSetupTimeMs);
+	LOG_INFO("  Avg iterations:     {:.1f} /step", stats.getAvgIterations());
+	LOG_INFO("  Halo exchange:      {:.2f} ms", rankStats.haloTimeMs);
+	LOG_INFO("  Peak memory:        {:.2f} MB (all ranks)", stats.getPeakMemoryMB());
+	LOG_INFO("  Residual range:     [{:.2e}, {:.2e}]", stats.minResidual, stats.maxResidual);
+	LOG_INFO("  Final temperature:  T_min = {:.2f} K, T_max = {:.2f} K", minT, maxT);
+
+	if (steadyState)
+		LOG_INFO("  Steady state:       t = {:.3f} s, {} steps skipped", steadyState->time, steadyState->skippedSteps);
+
+	if (saveHistory)
+		LOG_INFO("  History saved:      {} snapshots", temperatures.size());
+
+	return FEMSolverResult{
+		.solution = TransientSolution{
+			.finalSolution = GatherToRoot(system, T_current.head(owned)),
+			.temperatures = std::move(temperatures),
+			.timeSteps = std::move(timeSteps),
+			.saveStride = saveStride
+		},
+		.stats = stats
+	};
+}
+
+Vec DistributedFEMSolver::GatherToRoot(const DistributedSystem& system, const Vec& owned)
+{
+	auto rows = Communicator::GatherToRoot(std::span<const int>(system.ownedNodes));
+	auto values = Communicator::GatherToRoot(std::span<const double>(owned.data(), owned.size()));
+
+	if (!config::MPIConfig::IsRoot())
+		return {};
+
+	Vec global(system.globalSize);
+	for (size_t i = 0; i < rows.size(); ++i)
+		global[rows[i]] = values[i];
+
+	return global;
+}
+
+} // namespace fem::distributed
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "DistributedStats.h"
+#include "DistributedSystem.h"
+
+#include "solver/FEMSolverConfig.h"
+#include "solver/FEMSolverResult.h"
+#include "solver/SolverError.h"
+
+#include <expected>
+
+namespace fem::distributed
+{
+
+/// <summary>
+/// FEMSolver counterpart for a row-distributed system. All ranks must call Solve; solutions
+/// (final state and saved history) are gathered in mesh node order on rank 0 and left empty on
+/// the other ranks. Linear systems always go through the distributed PCG
+/// </summary>
+class DistributedFEMSolver
+{
+public:
+	DistributedFEMSolver() = delete;
+
+	static std::expected<solver::FEMSolverResult, solver::SolverError> Solve(const DistributedSystem& system, const solver::FEMSolverConfig& config, RankStats& rankStats);
+
+private:
+	static std::expected<solver::FEMSolverResult, solver::SolverError> SolveSteady(const DistributedSystem& system, const solver::linear::LinearSolverOptions& solverOptions, RankStats& rankStats);
+	static std::expected<solver::FEMSolverResult, solver::SolverError> SolveTransient(const DistributedSystem& system, const domain::model::TransientConfig& config, const solver::linear::LinearSolverOptions& solverOptions, RankStats& rankStats);
+
+	/// <summary>
+	/// Global vector in mesh node order on rank 0, empty elsewhere
+	/// </summary>
+	static Vec GatherToRoot(const DistributedSystem& system, const Vec& owned);
+};
+
+} // namespace fem::distributed
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace fem::distributed
+{
+
+/// <summary>
+/// Work done by one rank. Trivially copyable so it can be gathered to rank 0 as raw bytes
+/// </summary>
+struct RankStats
+{
+	int rank = 0;
+
+	// Layout
+	std::size_t ownedNodes = 0;
+	std::size_t ghostNodes = 0;
+	std::size_t ownedElements = 0; // Quads and boundary lines integrated on this rank
+	std::size_t neighbours = 0;
+
+	// Assembly
+	double assemblyTimeMs = 0.0;  // Element and boundary integration of owned elements
+	double exchangeTimeMs = 0.0;  // Shipping contributions to rows owned by other ranks
+	double localMatrixTimeMs = 0.0;
+	std::size_t sentContributions = 0;
+	std::size_t receivedContributions = 0;
+
+	// Solve
+	double solveTimeMs = 0.0; // Linear solves, halo updates included
+	double haloTimeMs = 0.0;  // Halo updates only (matrix products and right-hand sides)
+	std::size_t iterations = 0;
+
+	std::size_t peakMemoryBytes = 0;
+};
+
+struct DistributedStats
+{
+	std::size_t ranks = 1;
+	double partitionTimeMs = 0.0;
+	std::vector<RankStats> perRank;
+
+	/// <summary>
+	/// Slowest rank over the average, 1.0 is a perfect balance
+	/// </summary>
+	double getSolveImbalance() const
+	{
+		return Imbalance(&RankStats::solveTimeMs);
+	}
+
+	double getAssemblyImbalance() const
+	{
+		return Imbalance(&RankStats::assemblyTimeMs);
+	}
+
+private:
+	double Imbalance(double RankStats::* field) const
+	{
+		if (perRank.empty()) return 1.0;
+
+		double sum = 0.0, max = 0.0;
+		for (const auto& rank : perRank)
+		{
+			sum += rank.*field;
+			max = std::max(max, rank.*field);
+		}
+
+		return sum > 0.0 ? max * perRank.size() / sum : 1.0;
+	}
+};
+
+} // namespace fem::distributed
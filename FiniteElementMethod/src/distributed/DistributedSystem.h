@@ -0,0 +1,35 @@
+#pragma once
+
+#include "HaloExchange.h"
+
+#include "math/math.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace fem::distributed
+{
+
+/// <summary>
+/// This rank's slice of the global system. Rows are the owned mesh nodes, columns are
+/// [owned | ghost] so a halo-updated vector multiplies the local matrices directly
+/// </summary>
+struct DistributedSystem
+{
+	std::size_t globalSize = 0;
+
+	std::vector<int> ownedNodes; // Local mesh node index (= global matrix row) of each owned row, ascending
+	std::vector<int> ghostNodes; // Local mesh node index of each ghost column, grouped by owner rank
+
+	SpMat H; // owned x (owned + ghost)
+	SpMat C; // owned x (owned + ghost)
+	Vec P;   // owned
+
+	HaloExchange halo;
+
+	std::size_t GetOwnedCount() const { return ownedNodes.size(); }
+	std::size_t GetGhostCount() const { return ghostNodes.size(); }
+	std::size_t GetLocalColumns() const { return ownedNodes.size() + ghostNodes.size(); }
+};
+
+} // namespace fem::distributed
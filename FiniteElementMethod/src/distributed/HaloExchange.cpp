@@ -0,0 +1,88 @@
+#include "HaloExchange.h"
+
+#include "Communicator.h"
+
+#include "config/MPIConfig.h"
+#include "utils/utils.h"
+
+#include <algorithm>
+#include <span>
+
+namespace fem::distributed
+{
+
+HaloExchange HaloExchange::Build(std::size_t ownedCount, const std::vector<int>& ghostNodes, const mesh::partition::MeshPartition& partition, const std::vector<int>& ownedIndex)
+{
+	const int size = config::MPIConfig::GetSize();
+
+	HaloExchange halo;
+	halo.m_OwnedCount = ownedCount;
+	halo.m_GhostCount = ghostNodes.size();
+
+	// Ask every owner for the ghosts it holds, in our ghost order
+	std::vector<int> requestCounts(size, 0);
+	for (int node : ghostNodes)
+		++requestCounts[partition.nodePart[node]];
+
+	std::vector<int> servedCounts;
+	auto requested = Communicator::AllToAll(ghostNodes, requestCounts, servedCounts);
+
+	for (int& node : requested)
+		node = ownedIndex[node];
+
+	int sendOffset = 0;
+	int recvOffset = 0;
+
+	for (int rank = 0; rank < size; ++rank)
+	{
+		if (requestCounts[rank] == 0 && servedCounts[rank] == 0)
+			continue;
+
+		halo.m_Ranks.push_back(rank);
+		halo.m_SendOffsets.push_back(sendOffset);
+		halo.m_RecvOffsets.push_back(recvOffset);
+
+		sendOffset += servedCounts[rank];
+		recvOffset += requestCounts[rank];
+	}
+
+	halo.m_SendOffsets.push_back(sendOffset);
+	halo.m_RecvOffsets.push_back(recvOffset);
+
+	halo.m_SendRows = std::move(requested);
+	halo.m_SendBuffer.resize(halo.m_SendRows.size());
+
+	return halo;
+}
+
+void HaloExchange::Update(Vec& x) const
+{
+	if (m_Ranks.empty())
+		return;
+
+	auto start = Now();
+
+	const auto sendRows = static_cast<Eigen::Index>(m_SendRows.size());
+
+	for (Eigen::Index i = 0; i < sendRows; ++i)
+		m_SendBuffer[i] = x[m_SendRows[i]];
+
+	double* ghosts = x.data() + m_OwnedCount;
+
+	std::vector<std::span<const double>> send;
+	std::vector<std::span<double>> recv;
+	send.reserve(m_Ranks.size());
+	recv.reserve(m_Ranks.size());
+
+	for (std::size_t i = 0; i < m_Ranks.size(); ++i)
+	{
+		send.emplace_back(m_SendBuffer.data() + m_SendOffsets[i], m_SendOffsets[i + 1] - m_SendOffsets[i]);
+		recv.emplace_back(ghosts + m_RecvOffsets[i], m_RecvOffsets[i + 1] - m_RecvOffsets[i]);
+	}
+
+	Communicator::ExchangeWithNeighbours(m_Ranks, send, recv);
+
+	m_ElapsedMs += ElapsedMs(start, Now());
+}
+
+} // namespace fem::distributed
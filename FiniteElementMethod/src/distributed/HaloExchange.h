@@ -0,0 +1,53 @@
+#pragma once
+
+#include "math/math.h"
+#include "mesh/partition/MeshPartition.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace fem::distributed
+{
+
+/// <summary>
+/// Refreshes the ghost entries of a distributed vector. Vectors are laid out as [owned | ghost]:
+/// ghost values are copies of rows owned by neighbouring ranks, needed by the local rows of the
+/// matrix. Ghosts are grouped by owner rank so each neighbour fills one contiguous block
+/// </summary>
+class HaloExchange
+{
+public:
+	HaloExchange() = default;
+
+	/// <summary>
+	/// ghostNodes must be grouped by owner rank in ascending order. ownedIndex maps a mesh node to
+	/// its owned row on this rank (-1 when owned elsewhere). Collective - all ranks must call it
+	/// </summary>
+	static HaloExchange Build(std::size_t ownedCount, const std::vector<int>& ghostNodes, const mesh::partition::MeshPartition& partition, const std::vector<int>& ownedIndex);
+
+	/// <summary>
+	/// Overwrites x.tail(ghosts) with the owners' current values. Collective among neighbours
+	/// </summary>
+	void Update(Vec& x) const;
+
+	std::size_t GetOwnedCount() const { return m_OwnedCount; }
+	std::size_t GetGhostCount() const { return m_GhostCount; }
+	std::size_t GetNeighbourCount() const { return m_Ranks.size(); }
+	std::size_t GetSendCount() const { return m_SendRows.size(); }
+
+	double GetElapsedMs() const { return m_ElapsedMs; }
+
+private:
+	std::size_t m_OwnedCount = 0;
+	std::size_t m_GhostCount = 0;
+
+	std::vector<int> m_Ranks;       // Neighbour ranks, ascending
+	std::vector<int> m_SendOffsets; // Per neighbour range into m_SendRows
+	std::vector<int> m_SendRows;    // Owned rows packed for each neighbour, in the order it expects them
+	std::vector<int> m_RecvOffsets; // Per neighbour range into the ghost block
+
+	mutable std::vector<double> m_SendBuffer;
+	mutable double m_ElapsedMs = 0.0; // Accumulated time spent in Update
+};
+
+} // namespace fem::distributed
@@ -0,0 +1,9 @@
+#pragma once
+
+#include "Communicator.h"
+#include "DistributedAssembler.h"
+#include "DistributedConjugateGradient.h"
+#include "DistributedFEMSolver.h"
+#include "DistributedStats.h"
+#include "DistributedSystem.h"
+#include "HaloExchange.h"
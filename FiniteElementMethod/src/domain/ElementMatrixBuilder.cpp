@@ -12,7 +12,7 @@ namespace fem::domain
 
 std::expected<ElementMatrices, int> ElementMatrixBuilder::BuildQuadMatrices(const mesh::model::Mesh& mesh, const mesh::model::Quad& quad) const
 {
-	constexpr auto schema = integration::IntegrationSchema::Gauss3;
+	constexpr auto schema = QUAD_SCHEMA;
 
 	LOG_TRACE(
 		"Assembling element matrices for quad id={} nodes=[{}, {}, {}, {}] using Gauss{}",
@@ -108,7 +108,7 @@ std::expected<ElementMatrices, int> ElementMatrixBuilder::BuildQuadMatrices(cons
 
 std::expected<BoundaryMatrices, int> ElementMatrixBuilder::BuildLineBoundaryMatrices(const mesh::model::Mesh& mesh, const mesh::model::Line& line) const
 {
-	auto schema = integration::IntegrationSchema::Gauss2;
+	constexpr auto schema = LINE_SCHEMA;
 
 	LOG_TRACE(
 		"Building boundary matrices for line nodes=[{}, {}] using Gauss{}",
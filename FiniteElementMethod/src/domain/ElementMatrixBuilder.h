@@ -3,6 +3,7 @@
 #include "BoundaryMatrices.h"
 #include "model/BoundaryCondition.h"
 #include "ElementMatrices.h"
+#include "integration/IntegrationSchema.h"
 #include "model/Material.h"
 
 #include "logger/logger.h"
@@ -16,6 +17,10 @@ namespace fem::domain
 class ElementMatrixBuilder
 {
 public:
+	// Part of the cache key, changing either invalidates cached systems
+	static constexpr auto QUAD_SCHEMA = integration::IntegrationSchema::Gauss3;
+	static constexpr auto LINE_SCHEMA = integration::IntegrationSchema::Gauss2;
+
 	ElementMatrixBuilder(const model::Material& material, const model::BoundaryCondition& bc) : m_Material(material), m_BoundaryCondition(bc)
 	{
 		LOG_INFO("Initialized with material = {}", material.name);
@@ -105,16 +105,25 @@ std::expected<GlobalMatrixBuildResult, int> fem::domain::GlobalMatrixBuilder::Bu
 			tripletsH.insert(tripletsH.end(), localTripletsH.begin(), localTripletsH.end());
 		}
 
+		if (m_ReleaseIntermediates)
+			TripletsVector().swap(localTripletsH);
+
 #pragma omp critical(merge_C)
 		{
 			tripletsC.insert(tripletsC.end(), localTripletsC.begin(), localTripletsC.end());
 		}
 
+		if (m_ReleaseIntermediates)
+			TripletsVector().swap(localTripletsC);
+
 #pragma omp critical(merge_P)
 		{
 			globalP += localP;
 		}
 
+		if (m_ReleaseIntermediates)
+			localP.resize(0);
+
 #pragma omp single
 		{
 			stats.mergeTimeMs = ElapsedMs(mergeStart, Now());
@@ -180,13 +189,20 @@ std::expected<GlobalMatrixBuildResult, int> fem::domain::GlobalMatrixBuilder::Bu
 	GlobalMatrices out;
 	out.H.resize(numberOfNodes, numberOfNodes);
 	out.C.resize(numberOfNodes, numberOfNodes);
-	out.P = globalP;
+	out.P = std::move(globalP);
 
 	auto tripletStart = Now();
 
 	out.H.setFromTriplets(tripletsH.begin(), tripletsH.end());
+
+	if (m_ReleaseIntermediates)
+		TripletsVector().swap(tripletsH);
+
 	out.C.setFromTriplets(tripletsC.begin(), tripletsC.end());
 
+	if (m_ReleaseIntermediates)
+		TripletsVector().swap(tripletsC);
+
 	auto tripletEnd = Now();
 	stats.tripletToSparseTimeMs = ElapsedMs(tripletStart, tripletEnd);
 
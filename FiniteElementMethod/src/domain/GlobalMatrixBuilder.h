@@ -20,7 +20,12 @@ struct GlobalMatrixBuildResult
 class GlobalMatrixBuilder
 {
 public:
-	GlobalMatrixBuilder(const mesh::model::Mesh& mesh, const ElementMatrixBuilder& builder) : m_Mesh(mesh), m_Builder(builder) {};
+	/// <summary>
+	/// releaseIntermediates frees every triplet list and partial load vector as soon as it is merged,
+	/// lowering the assembly peak at the cost of reallocations in later builds
+	/// </summary>
+	GlobalMatrixBuilder(const mesh::model::Mesh& mesh, const ElementMatrixBuilder& builder, bool releaseIntermediates = false)
+		: m_Mesh(mesh), m_Builder(builder), m_ReleaseIntermediates(releaseIntermediates) {};
 
 	// TODO: Create custom error
 	std::expected<GlobalMatrixBuildResult, int> Build() const;
@@ -32,6 +37,7 @@ private:
 private:
 	const mesh::model::Mesh& m_Mesh;
 	const ElementMatrixBuilder& m_Builder;
+	bool m_ReleaseIntermediates;
 };
 
 }
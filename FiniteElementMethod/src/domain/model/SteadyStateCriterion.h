@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstddef>
+
+namespace fem::domain::model
+{
+
+struct SteadyStateCriterion
+{
+	double tolerance;                  // Max |dT|/dt [K/s] considered as steady
+	std::size_t consecutiveSteps;      // Steps in a row below tolerance required to stop
+	bool fillRemainingHistory = false; // Repeat final state for skipped history frames
+};
+
+} // namespace fem::domain::model
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "SteadyStateCriterion.h"
+
 #include "math/math.h"
 
 #include <optional>
@@ -14,6 +16,7 @@ struct TransientConfig
 	bool saveHistory;
 	std::optional<size_t> saveStride;
 	double initialTemperature; // TODO: Change to vector of initial conditions
+	std::optional<SteadyStateCriterion> steadyStateCriterion;
 };
 
 } // namespace fem::domain::model
@@ -4,4 +4,5 @@
 #include "BoundaryConditionType.h"
 #include "Material.h"
 #include "ProblemType.h"
+#include "SteadyStateCriterion.h"
 #include "TransientConfig.h"
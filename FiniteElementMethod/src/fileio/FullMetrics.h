@@ -1,10 +1,14 @@
 #pragma once
 
+#include "cache/CacheWriter.h"
+#include "distributed/DistributedStats.h"
 #include "domain/AssemblyStats.h"
+#include "metrics/MemoryStages.h"
 #include "solver/FEMSolverStats.h"
 
 #include <optional>
 #include <string>
+#include <vector>
 
 namespace fem::fileio
 {
@@ -14,6 +18,9 @@ struct FullMetrics
 	std::string solverName;
 	solver::FEMSolverStats solverStats;
 	std::optional<domain::AssemblyStats> assemblyStats;
+	std::optional<cache::CacheWriterStats> cacheWriterStats; // Runs that wrote to the cache
+	std::optional<distributed::DistributedStats> distributedStats; // MPI runs only, gathered on rank 0
+	std::vector<metrics::MemoryStage> memoryStages;
 };
 
 } // namespace fem::fileio
@@ -4,6 +4,7 @@
 #include "config/CompileConfig.h"
 #include "logger/logger.h"
 
+#include <algorithm>
 #include <format>
 #include <nlohmann/json.hpp>
 
@@ -88,15 +89,70 @@ std::expected<void, std::string> StatsExporter::ExportJSON(const fs::path& path,
 	json["timing"]["totalMs"] = ss.totalTimeMs;
 	json["timing"]["linearSolveCount"] = ss.linearSolveCount;
 
+	if (ss.analysisTimeMs > 0.0)
+	{
+		json["timing"]["solver"]["analysisMs"] = ss.analysisTimeMs;
+		json["timing"]["solver"]["reusedOrderingCount"] = ss.reusedOrderingCount;
+	}
+
 	// Memory
 	json["memory"]["solver"]["peakMB"] = ss.getPeakMemoryMB();
 	json["memory"]["solver"]["peakBytes"] = ss.peakMemoryBytes;
 
+	if (ss.predictedFactorBytes > 0)
+	{
+		json["memory"]["solver"]["predictedFactorMB"] = BytesToMiB(ss.predictedFactorBytes);
+		json["memory"]["solver"]["outOfCoreCount"] = ss.outOfCoreCount;
+	}
+
+	for (const auto& stage : metrics.memoryStages)
+	{
+		json["memory"]["stages"].push_back({
+			{ "name",         stage.name },
+			{ "currentBytes", stage.currentBytes },
+			{ "peakBytes",    stage.peakBytes }
+			});
+	}
+
 	// Residuals
 	json["residual"]["norm"] = ss.residualNorm;
 	json["residual"]["min"] = ss.minResidual;
 	json["residual"]["max"] = ss.maxResidual;
 
+	// Iterative solver
+	if (ss.totalIterations > 0)
+	{
+		json["iterative"]["totalIterations"] = ss.totalIterations;
+		json["iterative"]["avgIterations"] = ss.getAvgIterations();
+		json["iterative"]["preconditionerSetupMs"] = ss.preconditionerSetupTimeMs;
+
+		if (ss.recycledSubspaceBytes > 0)
+		{
+			json["iterative"]["recycledVectors"] = ss.recycledVectors;
+			json["iterative"]["recycledSubspaceMB"] = BytesToMiB(ss.recycledSubspaceBytes);
+		}
+	}
+
+	// Mixed precision refinement
+	if (ss.totalRefinementIterations > 0 || ss.precisionFallbackCount > 0)
+	{
+		json["mixedPrecision"]["totalRefinementIterations"] = ss.totalRefinementIterations;
+		json["mixedPrecision"]["avgRefinementIterations"] = ss.getAvgRefinementIterations();
+		json["mixedPrecision"]["fallbackCount"] = ss.precisionFallbackCount;
+	}
+
+	// Steady state detection
+	if (ss.steadyState.has_value())
+	{
+		const auto& steady = *ss.steadyState;
+
+		json["transient"]["steadyState"]["reached"] = true;
+		json["transient"]["steadyState"]["step"] = steady.step;
+		json["transient"]["steadyState"]["timeS"] = steady.time;
+		json["transient"]["steadyState"]["changeRate"] = steady.changeRate;
+		json["transient"]["steadyState"]["skippedSteps"] = steady.skippedSteps;
+	}
+
 	// Assembly stats
 	if (metrics.assemblyStats.has_value())
 	{
@@ -124,6 +180,56 @@ std::expected<void, std::string> StatsExporter::ExportJSON(const fs::path& path,
 		json["assembly"]["memory"]["sparseMatrixBytes"] = as.sparseMatrixMemoryBytes;
 	}
 
+	// Cache writes overlapped with the solve
+	if (metrics.cacheWriterStats.has_value())
+	{
+		const auto& cs = *metrics.cacheWriterStats;
+
+		json["cache"]["writes"] = cs.jobs;
+		json["cache"]["writeMs"] = cs.writeMs;
+		json["cache"]["waitMs"] = cs.waitMs;
+		json["cache"]["overlappedMs"] = std::max(0.0, cs.writeMs - cs.waitMs);
+	}
+
+	// Distributed run
+	if (metrics.distributedStats.has_value())
+	{
+		const auto& ds = *metrics.distributedStats;
+
+		json["distributed"]["ranks"] = ds.ranks;
+		json["distributed"]["partitionMs"] = ds.partitionTimeMs;
+		json["distributed"]["assemblyImbalance"] = ds.getAssemblyImbalance();
+		json["distributed"]["solveImbalance"] = ds.getSolveImbalance();
+
+		auto& perRank = json["distributed"]["perRank"];
+		perRank = nlohmann::json::array();
+
+		for (const auto& rs : ds.perRank)
+		{
+			nlohmann::json entry;
+
+			entry["rank"] = rs.rank;
+			entry["ownedNodes"] = rs.ownedNodes;
+			entry["ghostNodes"] = rs.ghostNodes;
+			entry["ownedElements"] = rs.ownedElements;
+			entry["neighbours"] = rs.neighbours;
+
+			entry["assembly"]["integrationMs"] = rs.assemblyTimeMs;
+			entry["assembly"]["exchangeMs"] = rs.exchangeTimeMs;
+			entry["assembly"]["localMatrixMs"] = rs.localMatrixTimeMs;
+			entry["assembly"]["sentContributions"] = rs.sentContributions;
+			entry["assembly"]["receivedContributions"] = rs.receivedContributions;
+
+			entry["solve"]["totalMs"] = rs.solveTimeMs;
+			entry["solve"]["haloMs"] = rs.haloTimeMs;
+			entry["solve"]["iterations"] = rs.iterations;
+
+			entry["memory"]["peakMB"] = BytesToMiB(rs.peakMemoryBytes);
+
+			perRank.push_back(std::move(entry));
+		}
+	}
+
 	FileService writer;
 	auto wr = writer.Write(path, json.dump(2));
 
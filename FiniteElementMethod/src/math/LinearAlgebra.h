@@ -19,6 +19,20 @@ using Vec3 = Eigen::Vector3d;
 using Vec4 = Eigen::Vector4d;
 
 using SpMat = Eigen::SparseMatrix<double, config::StorageOrder>;
+using CsrMat = Eigen::SparseMatrix<double, Eigen::RowMajor>; // Fixed CSR layout for row-parallel kernels
+using CscMat = Eigen::SparseMatrix<double, Eigen::ColMajor>; // Fixed CSC layout of sparse Cholesky factors
 using Triplet = Eigen::Triplet<double>;
 
+// Non-owning views, e.g. of memory-mapped cache files
+using SpMatView = Eigen::Map<const SpMat>;
+using VecView = Eigen::Map<const Vec>;
+
+// Binds owning matrices and views alike without copying them
+using SpMatRef = Eigen::Ref<const SpMat>;
+using VecRef = Eigen::Ref<const Vec>;
+
+// Single precision copies for mixed-precision factorizations
+using SpMatF = Eigen::SparseMatrix<float, config::StorageOrder>;
+using VecF = Eigen::VectorXf;
+
 }
@@ -0,0 +1,133 @@
+#include "SparseOps.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include <omp.h>
+
+namespace fem::math
+{
+
+CsrMat SparseOps::Multiply(const CsrMat& A, const CsrMat& B)
+{
+	using StorageIndex = CsrMat::StorageIndex;
+
+	eigen_assert(A.isCompressed() && B.isCompressed());
+	eigen_assert(A.cols() == B.rows());
+
+	const Eigen::Index rows = A.rows();
+	const Eigen::Index cols = B.cols();
+
+	const StorageIndex* aOuter = A.outerIndexPtr();
+	const StorageIndex* aInner = A.innerIndexPtr();
+	const double* aValues = A.valuePtr();
+
+	const StorageIndex* bOuter = B.outerIndexPtr();
+	const StorageIndex* bInner = B.innerIndexPtr();
+	const double* bValues = B.valuePtr();
+
+	std::vector<StorageIndex> rowStart(rows + 1, 0);
+
+	// Symbolic pass - count distinct columns per output row
+#pragma omp parallel
+	{
+		std::vector<Eigen::Index> marker(cols, -1);
+
+#pragma omp for schedule(dynamic, 256)
+		for (Eigen::Index i = 0; i < rows; ++i)
+		{
+			StorageIndex count = 0;
+
+			for (StorageIndex ka = aOuter[i]; ka < aOuter[i + 1]; ++ka)
+			{
+				StorageIndex k = aInner[ka];
+
+				for (StorageIndex kb = bOuter[k]; kb < bOuter[k + 1]; ++kb)
+				{
+					StorageIndex j = bInner[kb];
+
+					if (marker[j] != i)
+					{
+						marker[j] = i;
+						++count;
+					}
+				}
+			}
+
+			rowStart[i + 1] = count;
+		}
+	}
+
+	for (Eigen::Index i = 0; i < rows; ++i)
+		rowStart[i + 1] += rowStart[i];
+
+	CsrMat C(rows, cols);
+	C.makeCompressed();
+	C.resizeNonZeros(rowStart[rows]);
+
+	std::copy(rowStart.begin(), rowStart.end(), C.outerIndexPtr());
+
+	StorageIndex* cInner = C.innerIndexPtr();
+	double* cValues = C.valuePtr();
+
+	// Numeric pass - accumulate into the slots reserved above, then sort each row by column
+#pragma omp parallel
+	{
+		std::vector<Eigen::Index> marker(cols, -1);
+		std::vector<StorageIndex> position(cols, 0);
+		std::vector<std::pair<StorageIndex, double>> row;
+
+#pragma omp for schedule(dynamic, 256)
+		for (Eigen::Index i = 0; i < rows; ++i)
+		{
+			const StorageIndex begin = rowStart[i];
+			StorageIndex end = begin;
+
+			for (StorageIndex ka = aOuter[i]; ka < aOuter[i + 1]; ++ka)
+			{
+				StorageIndex k = aInner[ka];
+				double aik = aValues[ka];
+
+				for (StorageIndex kb = bOuter[k]; kb < bOuter[k + 1]; ++kb)
+				{
+					StorageIndex j = bInner[kb];
+
+					if (marker[j] != i)
+					{
+						marker[j] = i;
+						position[j] = end;
+						cInner[end] = j;
+						cValues[end] = aik * bValues[kb];
+						++end;
+					}
+					else
+					{
+						cValues[position[j]] += aik * bValues[kb];
+					}
+				}
+			}
+
+			row.clear();
+
+			for (StorageIndex p = begin; p < end; ++p)
+				row.emplace_back(cInner[p], cValues[p]);
+
+			std::sort(row.begin(), row.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+			for (StorageIndex p = begin; p < end; ++p)
+			{
+				cInner[p] = row[p - begin].first;
+				cValues[p] = row[p - begin].second;
+			}
+		}
+	}
+
+	return C;
+}
+
+CsrMat SparseOps::TripleProduct(const CsrMat& R, const CsrMat& A, const CsrMat& P)
+{
+	return Multiply(R, Multiply(A, P));
+}
+
+} // namespace fem::math
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "LinearAlgebra.h"
+
+namespace fem::math
+{
+
+/// <summary>
+/// Sparse kernels that Eigen runs sequentially, parallelized over rows with OpenMP
+/// </summary>
+class SparseOps
+{
+public:
+	SparseOps() = delete;
+
+	/// <summary>
+	/// C = A * B. Two passes (symbolic row counts, then numeric fill) so rows are written without locking
+	/// </summary>
+	static CsrMat Multiply(const CsrMat& A, const CsrMat& B);
+
+	/// <summary>
+	/// C = R * A * P (Galerkin coarse operator)
+	/// </summary>
+	static CsrMat TripleProduct(const CsrMat& R, const CsrMat& A, const CsrMat& P);
+};
+
+} // namespace fem::math
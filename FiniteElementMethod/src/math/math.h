@@ -1,3 +1,5 @@
 #pragma once
 
 #include "LinearAlgebra.h"
+#include "SparseOps.h"
+#include "spmv/spmv.h"
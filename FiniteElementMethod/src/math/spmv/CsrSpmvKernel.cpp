@@ -0,0 +1,99 @@
+#include "CsrSpmvKernel.h"
+
+#include <algorithm>
+#include <omp.h>
+
+namespace fem::math
+{
+
+static_assert(sizeof(CsrMat::StorageIndex) == sizeof(std::int32_t), "CSR kernel expects 32-bit sparse indices");
+
+CsrSpmvKernel::CsrSpmvKernel(const SpMat& A)
+	: m_Rows(A.rows())
+{
+	if constexpr (SpMat::IsRowMajor)
+	{
+		if (A.isCompressed())
+		{
+			m_RowPtr = A.outerIndexPtr();
+			m_ColIdx = A.innerIndexPtr();
+			m_Values = A.valuePtr();
+		}
+	}
+
+	if (m_RowPtr == nullptr)
+	{
+		m_Copy = A;
+		m_Copy.makeCompressed();
+
+		m_RowPtr = m_Copy.outerIndexPtr();
+		m_ColIdx = m_Copy.innerIndexPtr();
+		m_Values = m_Copy.valuePtr();
+	}
+
+	// A few partitions per thread absorbs rows of uneven cost without dynamic scheduling
+	const Eigen::Index partitions = std::max<Eigen::Index>(1, std::min<Eigen::Index>(m_Rows, 4 * omp_get_max_threads()));
+	const std::int64_t nonZeros = m_RowPtr[m_Rows];
+
+	m_Partitions.resize(partitions + 1);
+	m_Partitions[0] = 0;
+
+	for (Eigen::Index k = 1; k < partitions; ++k)
+	{
+		const std::int64_t target = nonZeros * k / partitions;
+		m_Partitions[k] = std::lower_bound(m_RowPtr + m_Partitions[k - 1], m_RowPtr + m_Rows, target) - m_RowPtr;
+	}
+
+	m_Partitions[partitions] = m_Rows;
+}
+
+void CsrSpmvKernel::Multiply(const Vec& x, Vec& y) const
+{
+	y.resize(m_Rows);
+	Run<false>(nullptr, x, y);
+}
+
+void CsrSpmvKernel::Residual(const Vec& b, const Vec& x, Vec& r) const
+{
+	r.resize(m_Rows);
+	Run<true>(&b, x, r);
+}
+
+template<bool Residual>
+void CsrSpmvKernel::Run(const Vec* b, const Vec& x, Vec& y) const
+{
+	const double* xData = x.data();
+	double* yData = y.data();
+
+	const Eigen::Index partitions = static_cast<Eigen::Index>(m_Partitions.size()) - 1;
+
+#pragma omp parallel for schedule(static)
+	for (Eigen::Index p = 0; p < partitions; ++p)
+	{
+		for (Eigen::Index i = m_Partitions[p]; i < m_Partitions[p + 1]; ++i)
+		{
+			double sum = 0.0;
+
+			for (std::int32_t k = m_RowPtr[i]; k < m_RowPtr[i + 1]; ++k)
+				sum += m_Values[k] * xData[m_ColIdx[k]];
+
+			if constexpr (Residual)
+				yData[i] = (*b)[i] - sum;
+			else
+				yData[i] = sum;
+		}
+	}
+}
+
+size_t CsrSpmvKernel::GetMemoryBytes() const
+{
+	size_t bytes = m_Partitions.size() * sizeof(Eigen::Index);
+
+	if (m_Copy.nonZeros() > 0)
+		bytes += static_cast<size_t>(m_Copy.nonZeros()) * (sizeof(double) + sizeof(std::int32_t))
+			+ static_cast<size_t>(m_Copy.rows() + 1) * sizeof(std::int32_t);
+
+	return bytes;
+}
+
+} // namespace fem::math
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "ISpmvKernel.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace fem::math
+{
+
+/// <summary>
+/// Row-parallel CSR product. A compressed row-major matrix is used in place; anything else is copied
+/// once. Rows are split into chunks of equal nonzero count so threads get balanced work
+/// </summary>
+class CsrSpmvKernel : public ISpmvKernel
+{
+public:
+	explicit CsrSpmvKernel(const SpMat& A);
+
+	void Multiply(const Vec& x, Vec& y) const override;
+
+	void Residual(const Vec& b, const Vec& x, Vec& r) const override;
+
+	SpmvBackend GetBackend() const override
+	{
+		return SpmvBackend::Csr;
+	}
+
+	size_t GetMemoryBytes() const override;
+
+private:
+	template<bool Residual>
+	void Run(const Vec* b, const Vec& x, Vec& y) const;
+
+	CsrMat m_Copy; // Empty when A is already compressed CSR
+
+	Eigen::Index m_Rows = 0;
+	const std::int32_t* m_RowPtr = nullptr;
+	const std::int32_t* m_ColIdx = nullptr;
+	const double* m_Values = nullptr;
+
+	std::vector<Eigen::Index> m_Partitions; // Row ranges [p_k, p_k+1) of about equal nonzeros
+};
+
+} // namespace fem::math
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "ISpmvKernel.h"
+
+namespace fem::math
+{
+
+/// <summary>
+/// Eigen's own product, kept as the reference and the fallback. Reads the arrays of A in place like the
+/// CSR kernel, but holds no reference to the matrix object, which callers may move or destroy
+/// </summary>
+class EigenSpmvKernel : public ISpmvKernel
+{
+public:
+	explicit EigenSpmvKernel(const SpMat& A)
+		: m_A(A.rows(), A.cols(), A.nonZeros(), A.outerIndexPtr(), A.innerIndexPtr(), A.valuePtr(), A.innerNonZeroPtr())
+	{
+	}
+
+	void Multiply(const Vec& x, Vec& y) const override
+	{
+		y.noalias() = m_A * x;
+	}
+
+	SpmvBackend GetBackend() const override
+	{
+		return SpmvBackend::Eigen;
+	}
+
+	size_t GetMemoryBytes() const override
+	{
+		return 0;
+	}
+
+private:
+	SpMatView m_A;
+};
+
+} // namespace fem::math
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "SpmvBackend.h"
+
+#include "math/LinearAlgebra.h"
+
+#include <cstddef>
+
+namespace fem::math
+{
+
+/// <summary>
+/// One storage format and kernel for y = A x. Kernels keep whatever copy of A their format needs
+/// </summary>
+class ISpmvKernel
+{
+public:
+	virtual ~ISpmvKernel() = default;
+
+	virtual void Multiply(const Vec& x, Vec& y) const = 0;
+
+	/// <summary>
+	/// r = b - A x, kernels may fuse the subtraction into the product
+	/// </summary>
+	virtual void Residual(const Vec& b, const Vec& x, Vec& r) const
+	{
+		Multiply(x, r);
+		r = b - r;
+	}
+
+	virtual SpmvBackend GetBackend() const = 0;
+
+	/// <summary>
+	/// Extra memory held by the kernel beyond the source matrix
+	/// </summary>
+	virtual size_t GetMemoryBytes() const = 0;
+};
+
+} // namespace fem::math
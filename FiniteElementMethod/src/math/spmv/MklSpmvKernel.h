@@ -0,0 +1,51 @@
+#pragma once
+
+#include "ISpmvKernel.h"
+
+#ifdef EIGEN_USE_MKL_ALL
+
+#include <mkl_spblas.h>
+
+namespace fem::math
+{
+
+/// <summary>
+/// MKL inspector-executor product. mkl_sparse_optimize analyses the matrix once for the expected
+/// number of products and picks MKL's internal format and threading for it
+/// </summary>
+class MklSpmvKernel : public ISpmvKernel
+{
+public:
+	MklSpmvKernel(const SpMat& A, int expectedCalls);
+	~MklSpmvKernel() override;
+
+	MklSpmvKernel(const MklSpmvKernel&) = delete;
+	MklSpmvKernel& operator=(const MklSpmvKernel&) = delete;
+
+	/// <summary>
+	/// False when MKL rejected the matrix, the kernel must not be used then
+	/// </summary>
+	bool IsValid() const
+	{
+		return m_Valid;
+	}
+
+	void Multiply(const Vec& x, Vec& y) const override;
+
+	SpmvBackend GetBackend() const override
+	{
+		return SpmvBackend::MklInspectorExecutor;
+	}
+
+	size_t GetMemoryBytes() const override;
+
+private:
+	CsrMat m_Csr; // MKL keeps pointers into these arrays
+	sparse_matrix_t m_Handle = nullptr;
+	matrix_descr m_Descriptor{};
+	bool m_Valid = false;
+};
+
+} // namespace fem::math
+
+#endif
@@ -0,0 +1,168 @@
+#include "SellCSigmaSpmvKernel.h"
+
+#include <algorithm>
+#include <numeric>
+#include <omp.h>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace fem::math
+{
+
+namespace
+{
+
+// Packing needs row access - row-major builds use A directly, column-major ones a temporary CSR copy
+const CsrMat& AsCsr(const CsrMat& A, [[maybe_unused]] CsrMat& copy)
+{
+	return A;
+}
+
+template<typename Matrix>
+const CsrMat& AsCsr(const Matrix& A, CsrMat& copy)
+{
+	copy = A;
+	return copy;
+}
+
+} // namespace
+
+SellCSigmaSpmvKernel::SellCSigmaSpmvKernel(const SpMat& A)
+	: m_Rows(A.rows()),
+	m_NonZeros(A.nonZeros())
+{
+	CsrMat copy;
+	const CsrMat& csr = AsCsr(A, copy);
+
+	const Eigen::Index chunks = (m_Rows + ChunkHeight - 1) / ChunkHeight;
+
+	std::vector<std::int32_t> rowLength(m_Rows);
+
+	for (Eigen::Index i = 0; i < m_Rows; ++i)
+		rowLength[i] = static_cast<std::int32_t>(csr.innerVector(i).nonZeros());
+
+	m_Permutation.resize(m_Rows);
+	std::iota(m_Permutation.begin(), m_Permutation.end(), 0);
+
+	for (Eigen::Index start = 0; start < m_Rows; start += Sigma)
+	{
+		auto first = m_Permutation.begin() + start;
+		auto last = m_Permutation.begin() + std::min(start + Sigma, m_Rows);
+
+		std::stable_sort(first, last, [&](std::int32_t a, std::int32_t b) { return rowLength[a] > rowLength[b]; });
+	}
+
+	m_ChunkStart.resize(chunks + 1);
+	m_ChunkWidth.resize(chunks);
+	m_ChunkStart[0] = 0;
+
+	for (Eigen::Index c = 0; c < chunks; ++c)
+	{
+		std::int32_t width = 0;
+
+		for (Eigen::Index lane = 0; lane < ChunkHeight && c * ChunkHeight + lane < m_Rows; ++lane)
+			width = std::max(width, rowLength[m_Permutation[c * ChunkHeight + lane]]);
+
+		m_ChunkWidth[c] = width;
+		m_ChunkStart[c + 1] = m_ChunkStart[c] + static_cast<std::int64_t>(width) * ChunkHeight;
+	}
+
+	// Padding multiplies x[0] by zero, which keeps the kernels free of masks
+	m_Columns.assign(m_ChunkStart[chunks], 0);
+	m_Values.assign(m_ChunkStart[chunks], 0.0);
+
+#pragma omp parallel for schedule(static)
+	for (Eigen::Index c = 0; c < chunks; ++c)
+	{
+		for (Eigen::Index lane = 0; lane < ChunkHeight && c * ChunkHeight + lane < m_Rows; ++lane)
+		{
+			Eigen::Index j = 0;
+
+			for (CsrMat::InnerIterator it(csr, m_Permutation[c * ChunkHeight + lane]); it; ++it, ++j)
+			{
+				const std::int64_t position = m_ChunkStart[c] + j * ChunkHeight + lane;
+				m_Columns[position] = static_cast<std::int32_t>(it.col());
+				m_Values[position] = it.value();
+			}
+		}
+	}
+}
+
+void SellCSigmaSpmvKernel::Multiply(const Vec& x, Vec& y) const
+{
+	y.resize(m_Rows);
+
+	const double* xData = x.data();
+	double* yData = y.data();
+
+	const Eigen::Index chunks = static_cast<Eigen::Index>(m_ChunkWidth.size());
+
+#pragma omp parallel for schedule(static)
+	for (Eigen::Index c = 0; c < chunks; ++c)
+	{
+		const double* values = m_Values.data() + m_ChunkStart[c];
+		const std::int32_t* columns = m_Columns.data() + m_ChunkStart[c];
+		const std::int32_t width = m_ChunkWidth[c];
+
+		alignas(64) double sum[ChunkHeight];
+
+#if defined(__AVX512F__)
+		__m512d acc = _mm512_setzero_pd();
+
+		for (std::int32_t j = 0; j < width; ++j)
+		{
+			__m256i index = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(columns + j * ChunkHeight));
+			__m512d xv = _mm512_i32gather_pd(index, xData, sizeof(double));
+			acc = _mm512_fmadd_pd(_mm512_loadu_pd(values + j * ChunkHeight), xv, acc);
+		}
+
+		_mm512_store_pd(sum, acc);
+#elif defined(__AVX2__)
+		__m256d low = _mm256_setzero_pd();
+		__m256d high = _mm256_setzero_pd();
+
+		for (std::int32_t j = 0; j < width; ++j)
+		{
+			const std::int32_t* column = columns + j * ChunkHeight;
+			const double* value = values + j * ChunkHeight;
+
+			__m256d xLow = _mm256_i32gather_pd(xData, _mm_loadu_si128(reinterpret_cast<const __m128i*>(column)), sizeof(double));
+			__m256d xHigh = _mm256_i32gather_pd(xData, _mm_loadu_si128(reinterpret_cast<const __m128i*>(column + 4)), sizeof(double));
+
+			low = _mm256_add_pd(low, _mm256_mul_pd(_mm256_loadu_pd(value), xLow));
+			high = _mm256_add_pd(high, _mm256_mul_pd(_mm256_loadu_pd(value + 4), xHigh));
+		}
+
+		_mm256_store_pd(sum, low);
+		_mm256_store_pd(sum + 4, high);
+#else
+		std::fill(sum, sum + ChunkHeight, 0.0);
+
+		for (std::int32_t j = 0; j < width; ++j)
+			for (Eigen::Index lane = 0; lane < ChunkHeight; ++lane)
+				sum[lane] += values[j * ChunkHeight + lane] * xData[columns[j * ChunkHeight + lane]];
+#endif
+
+		for (Eigen::Index lane = 0; lane < ChunkHeight && c * ChunkHeight + lane < m_Rows; ++lane)
+			yData[m_Permutation[c * ChunkHeight + lane]] = sum[lane];
+	}
+}
+
+size_t SellCSigmaSpmvKernel::GetMemoryBytes() const
+{
+	return m_Values.size() * sizeof(double)
+		+ m_Columns.size() * sizeof(std::int32_t)
+		+ m_ChunkStart.size() * sizeof(std::int64_t)
+		+ m_ChunkWidth.size() * sizeof(std::int32_t)
+		+ m_Permutation.size() * sizeof(std::int32_t);
+}
+
+double SellCSigmaSpmvKernel::GetFillRatio() const
+{
+	if (m_NonZeros == 0) return 1.0;
+	return static_cast<double>(m_Values.size()) / static_cast<double>(m_NonZeros);
+}
+
+} // namespace fem::math
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "ISpmvKernel.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace fem::math
+{
+
+/// <summary>
+/// SELL-C-sigma: rows are sorted by length inside windows of Sigma rows, packed into chunks of
+/// ChunkHeight rows and stored column by column so one SIMD register covers a whole chunk.
+/// Sorting keeps zero padding small on meshes with varying node valence
+/// </summary>
+class SellCSigmaSpmvKernel : public ISpmvKernel
+{
+public:
+	inline static constexpr Eigen::Index ChunkHeight = 8; // One AVX-512 register, two AVX2 registers of doubles
+	inline static constexpr Eigen::Index Sigma = 32 * ChunkHeight;
+
+	explicit SellCSigmaSpmvKernel(const SpMat& A);
+
+	void Multiply(const Vec& x, Vec& y) const override;
+
+	SpmvBackend GetBackend() const override
+	{
+		return SpmvBackend::SellCSigma;
+	}
+
+	size_t GetMemoryBytes() const override;
+
+	/// <summary>
+	/// Stored entries including padding divided by nonzeros
+	/// </summary>
+	double GetFillRatio() const;
+
+private:
+	Eigen::Index m_Rows = 0;
+	Eigen::Index m_NonZeros = 0;
+
+	std::vector<std::int64_t> m_ChunkStart;  // Offset of each chunk in values / columns
+	std::vector<std::int32_t> m_ChunkWidth;  // Longest row of each chunk
+	std::vector<std::int32_t> m_Columns;
+	std::vector<double> m_Values;
+	std::vector<std::int32_t> m_Permutation; // Sorted position -> original row
+};
+
+} // namespace fem::math
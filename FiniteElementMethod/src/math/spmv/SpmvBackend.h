@@ -0,0 +1,58 @@
+#pragma once
+
+#include <array>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace fem::math
+{
+
+enum class SpmvBackend : int
+{
+	Auto = 0,
+	Eigen,
+	Csr,
+	SellCSigma,
+	MklInspectorExecutor,
+};
+
+struct SpmvBackendInfo
+{
+	SpmvBackend backend;
+	std::string name;
+	std::string description;
+};
+
+inline static const std::array<SpmvBackendInfo, 5> SPMV_BACKENDS = { {
+	{ SpmvBackend::Auto,                 "auto",  "Time every available backend once per matrix and keep the fastest (default)" },
+	{ SpmvBackend::Eigen,                "eigen", "Eigen generic sparse * dense product" },
+	{ SpmvBackend::Csr,                  "csr",   "Row-parallel CSR with 32-bit indices, rows split by nonzeros" },
+	{ SpmvBackend::SellCSigma,           "sell",  "SELL-C-sigma with AVX2/AVX-512 gathers when compiled in" },
+	{ SpmvBackend::MklInspectorExecutor, "mkl",   "MKL inspector-executor (only when built with MKL)" }
+} };
+
+inline std::optional<SpmvBackend> ParseSpmvBackend(std::string_view str)
+{
+	using enum SpmvBackend;
+
+	if (str == "auto") return Auto;
+	else if (str == "eigen") return Eigen;
+	else if (str == "csr") return Csr;
+	else if (str == "sell") return SellCSigma;
+	else if (str == "mkl") return MklInspectorExecutor;
+
+	return std::nullopt;
+}
+
+inline std::string_view SpmvBackendToString(SpmvBackend backend)
+{
+	for (const auto& info : SPMV_BACKENDS)
+		if (info.backend == backend)
+			return info.name;
+
+	std::unreachable();
+}
+
+} // namespace fem::math
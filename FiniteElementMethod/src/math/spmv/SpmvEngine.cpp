@@ -0,0 +1,112 @@
+#include "SpmvEngine.h"
+
+#include "CsrSpmvKernel.h"
+#include "EigenSpmvKernel.h"
+#include "MklSpmvKernel.h"
+#include "SellCSigmaSpmvKernel.h"
+
+#include "logger/logger.h"
+#include "utils/utils.h"
+
+#include <limits>
+#include <string>
+
+namespace fem::math
+{
+
+SpmvEngine::SpmvEngine(const SpMat& A, SpmvBackend backend)
+	: m_Kernel(backend == SpmvBackend::Auto ? Autotune(A) : Create(A, backend))
+{
+}
+
+std::unique_ptr<ISpmvKernel> SpmvEngine::Create(const SpMat& A, SpmvBackend backend)
+{
+	using enum SpmvBackend;
+
+	switch (backend)
+	{
+	case Eigen:
+		return std::make_unique<EigenSpmvKernel>(A);
+
+	case Csr:
+		return std::make_unique<CsrSpmvKernel>(A);
+
+	case SellCSigma:
+		return std::make_unique<SellCSigmaSpmvKernel>(A);
+
+	case MklInspectorExecutor:
+	{
+#ifdef EIGEN_USE_MKL_ALL
+		auto kernel = std::make_unique<MklSpmvKernel>(A, ExpectedCalls);
+
+		if (kernel->IsValid())
+			return kernel;
+#endif
+		LOG_WARN("MKL SpMV backend unavailable, using CSR");
+		return std::make_unique<CsrSpmvKernel>(A);
+	}
+
+	case Auto:
+		return Autotune(A);
+
+	default:
+		LOG_ERROR("Unknown SpMV backend: {}", SpmvBackendToString(backend));
+		std::unreachable();
+	}
+}
+
+std::unique_ptr<ISpmvKernel> SpmvEngine::Autotune(const SpMat& A)
+{
+	std::unique_ptr<ISpmvKernel> best;
+	double bestMs = std::numeric_limits<double>::max();
+	std::string summary;
+
+	Vec x = Vec::Ones(A.cols());
+	Vec y(A.rows());
+
+	for (const auto& info : SPMV_BACKENDS)
+	{
+		if (info.backend == SpmvBackend::Auto)
+			continue;
+
+#ifndef EIGEN_USE_MKL_ALL
+		if (info.backend == SpmvBackend::MklInspectorExecutor)
+			continue;
+#endif
+
+		auto setupStart = Now();
+		auto kernel = Create(A, info.backend);
+		auto setupEnd = Now();
+
+		// Fallback kernels are timed under their own name
+		if (kernel->GetBackend() != info.backend)
+			continue;
+
+		kernel->Multiply(x, y);
+
+		double kernelMs = std::numeric_limits<double>::max();
+
+		for (int repetition = 0; repetition < AutotuneRepetitions; ++repetition)
+		{
+			auto start = Now();
+			kernel->Multiply(x, y);
+			auto end = Now();
+
+			kernelMs = std::min(kernelMs, ElapsedMs(start, end));
+		}
+
+		summary += std::format(" {}={:.3f}ms(setup {:.1f}ms)", info.name, kernelMs, ElapsedMs(setupStart, setupEnd));
+
+		if (kernelMs < bestMs)
+		{
+			bestMs = kernelMs;
+			best = std::move(kernel);
+		}
+	}
+
+	LOG_INFO("SpMV autotune ({} rows, {} nnz):{} -> {}", A.rows(), A.nonZeros(), summary, SpmvBackendToString(best->GetBackend()));
+
+	return best;
+}
+
+} // namespace fem::math
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "ISpmvKernel.h"
+#include "SpmvBackend.h"
+
+#include "math/LinearAlgebra.h"
+
+#include <memory>
+
+namespace fem::math
+{
+
+/// <summary>
+/// y = A x through a backend picked once per matrix. Auto times every backend compiled in and keeps
+/// the fastest, so repeated products (time stepping, Krylov iterations) run on the best format for
+/// this matrix and machine. Backends may read the arrays of A in place - the arrays must outlive the engine
+/// </summary>
+class SpmvEngine
+{
+public:
+	explicit SpmvEngine(const SpMat& A, SpmvBackend backend = SpmvBackend::Auto);
+
+	void Multiply(const Vec& x, Vec& y) const
+	{
+		m_Kernel->Multiply(x, y);
+	}
+
+	/// <summary>
+	/// r = b - A x
+	/// </summary>
+	void Residual(const Vec& b, const Vec& x, Vec& r) const
+	{
+		m_Kernel->Residual(b, x, r);
+	}
+
+	Vec Residual(const Vec& b, const Vec& x) const
+	{
+		Vec r;
+		m_Kernel->Residual(b, x, r);
+		return r;
+	}
+
+	SpmvBackend GetBackend() const
+	{
+		return m_Kernel->GetBackend();
+	}
+
+	size_t GetMemoryBytes() const
+	{
+		return m_Kernel->GetMemoryBytes();
+	}
+
+private:
+	static std::unique_ptr<ISpmvKernel> Create(const SpMat& A, SpmvBackend backend);
+	static std::unique_ptr<ISpmvKernel> Autotune(const SpMat& A);
+
+	std::unique_ptr<ISpmvKernel> m_Kernel;
+
+	inline static constexpr int AutotuneRepetitions = 10;
+	inline static constexpr int ExpectedCalls = 1000; // Hint for backends that optimize for a call count
+};
+
+} // namespace fem::math
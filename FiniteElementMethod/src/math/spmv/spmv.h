@@ -0,0 +1,9 @@
+#pragma once
+
+#include "CsrSpmvKernel.h"
+#include "EigenSpmvKernel.h"
+#include "ISpmvKernel.h"
+#include "MklSpmvKernel.h"
+#include "SellCSigmaSpmvKernel.h"
+#include "SpmvBackend.h"
+#include "SpmvEngine.h"
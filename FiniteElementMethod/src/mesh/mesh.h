@@ -1,4 +1,5 @@
 #pragma once
 
 #include "model/model.h"
+#include "partition/partition.h"
 #include "provider/provider.h"
@@ -10,6 +10,35 @@ Mesh::Mesh(size_t numberOfNodes, size_t numberOfCells, size_t numberOfLines)
 	m_Lines.reserve(numberOfLines);
 }
 
+Mesh::Mesh(std::vector<Node> nodes, std::vector<Quad> quads, std::vector<Line> lines, std::vector<PhysicalGroup> physicalGroups)
+	: m_Nodes(std::move(nodes))
+	, m_Quads(std::move(quads))
+	, m_Lines(std::move(lines))
+	, m_PhysicalGroups(std::move(physicalGroups))
+{
+	bool contiguous = !m_Nodes.empty();
+
+	for (std::size_t i = 0; i < m_Nodes.size() && contiguous; ++i)
+		contiguous = m_Nodes[i].id == m_Nodes.front().id + i;
+
+	if (contiguous)
+	{
+		m_FirstNodeId = m_Nodes.front().id;
+	}
+	else
+	{
+		m_NodeIndexByGmshId.reserve(m_Nodes.size());
+
+		for (std::size_t i = 0; i < m_Nodes.size(); ++i)
+			m_NodeIndexByGmshId[m_Nodes[i].id] = i;
+	}
+
+	m_LineIndexByGmshId.reserve(m_Lines.size());
+
+	for (std::size_t i = 0; i < m_Lines.size(); ++i)
+		m_LineIndexByGmshId[m_Lines[i].id] = i;
+}
+
 std::optional<PhysicalGroup> Mesh::GetPhysicalGroupByName(const std::string_view& name) const
 {
 	for (const auto& group : m_PhysicalGroups)
@@ -19,4 +48,26 @@ std::optional<PhysicalGroup> Mesh::GetPhysicalGroupByName(const std::string_view
 	return std::nullopt;
 }
 
+void Mesh::Compact()
+{
+	std::vector<Line>().swap(m_Lines);
+	std::vector<PhysicalGroup>().swap(m_PhysicalGroups);
+	std::unordered_map<std::size_t, std::size_t>().swap(m_LineIndexByGmshId);
+
+	m_Nodes.shrink_to_fit();
+	m_Quads.shrink_to_fit();
+
+	if (m_Nodes.empty() || m_FirstNodeId)
+		return;
+
+	const std::size_t firstId = m_Nodes.front().id;
+
+	for (std::size_t i = 0; i < m_Nodes.size(); ++i)
+		if (m_Nodes[i].id != firstId + i)
+			return;
+
+	std::unordered_map<std::size_t, std::size_t>().swap(m_NodeIndexByGmshId);
+	m_FirstNodeId = firstId;
+}
+
 }
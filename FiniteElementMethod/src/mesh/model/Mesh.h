@@ -20,6 +20,11 @@ public:
 	Mesh() = default;
 	Mesh(size_t numberOfNodes, size_t numberOfCells, size_t numberOfLines);
 
+	/// <summary>
+	/// Takes over complete entity arrays, the id lookups are built once instead of per added entity
+	/// </summary>
+	Mesh(std::vector<Node> nodes, std::vector<Quad> quads, std::vector<Line> lines, std::vector<PhysicalGroup> physicalGroups);
+
 	inline void AddNode(const Node& node)
 	{
 		std::size_t localID = m_Nodes.size();
@@ -38,11 +43,11 @@ public:
 	inline const std::vector<Node>& GetNodes() const { return m_Nodes; }
 	inline const std::vector<Quad>& GetQuads() const { return m_Quads; }
 	inline const std::vector<Line>& GetLines() const { return m_Lines; }
+	inline const std::vector<PhysicalGroup>& GetPhysicalGroups() const { return m_PhysicalGroups; }
 
 	inline const Node& GetNode(const std::size_t id) const
 	{
-		const auto& index = m_NodeIndexByGmshId.at(id);
-		return m_Nodes.at(index);
+		return m_Nodes.at(GetNodeLocalId(id));
 	}
 
 	inline const Line& GetLine(const std::size_t id) const
@@ -53,9 +58,17 @@ public:
 
 	inline const std::size_t GetNodeLocalId(std::size_t gmshId) const
 	{
+		if (m_FirstNodeId)
+			return gmshId - *m_FirstNodeId;
+
 		return m_NodeIndexByGmshId.at(gmshId);
 	}
 
+	inline const std::size_t GetLineLocalId(std::size_t gmshId) const
+	{
+		return m_LineIndexByGmshId.at(gmshId);
+	}
+
 	inline const std::size_t GetNodesCount() const
 	{
 		return m_Nodes.size();
@@ -63,6 +76,12 @@ public:
 
 	std::optional<PhysicalGroup> GetPhysicalGroupByName(const std::string_view& name) const;
 
+	/// <summary>
+	/// Keeps only what the solution export needs: lines and physical groups are dropped, and the
+	/// node id lookup becomes an offset when gmsh numbered the nodes contiguously
+	/// </summary>
+	void Compact();
+
 private:
 	std::vector<Node> m_Nodes;
 	std::vector<Quad> m_Quads;
@@ -71,6 +90,8 @@ private:
 
 	std::unordered_map<std::size_t, std::size_t> m_NodeIndexByGmshId;
 	std::unordered_map<std::size_t, std::size_t> m_LineIndexByGmshId;
+
+	std::optional<std::size_t> m_FirstNodeId; // Set when node ids are contiguous, by Compact or the bulk constructor
 };
 
 }
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstddef>
+
+namespace fem::mesh::model
+{
+
+/// <summary>
+/// Entity counts of a mesh file, enough to size the system without reading coordinates or connectivity
+/// </summary>
+struct MeshMetadata
+{
+	std::size_t nodes = 0;
+	std::size_t quads = 0;
+	std::size_t lines = 0;
+};
+
+}
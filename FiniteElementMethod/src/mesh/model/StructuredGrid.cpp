@@ -0,0 +1,92 @@
+#include "StructuredGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace fem::mesh::model
+{
+
+namespace
+{
+
+std::vector<double> UniqueCoordinates(std::vector<double> values, double tolerance)
+{
+	std::sort(values.begin(), values.end());
+
+	std::vector<double> unique;
+
+	for (double value : values)
+		if (unique.empty() || value - unique.back() > tolerance)
+			unique.push_back(value);
+
+	return unique;
+}
+
+std::optional<std::size_t> FindCoordinate(const std::vector<double>& lines, double value, double tolerance)
+{
+	auto it = std::lower_bound(lines.begin(), lines.end(), value - tolerance);
+
+	if (it == lines.end() || std::abs(*it - value) > tolerance)
+		return std::nullopt;
+
+	return static_cast<std::size_t>(it - lines.begin());
+}
+
+} // namespace
+
+std::optional<StructuredGrid> StructuredGrid::Detect(const Mesh& mesh)
+{
+	const auto& nodes = mesh.GetNodes();
+
+	if (nodes.size() < 4)
+		return std::nullopt;
+
+	std::vector<double> xs, ys;
+	xs.reserve(nodes.size());
+	ys.reserve(nodes.size());
+
+	for (const auto& node : nodes)
+	{
+		xs.push_back(node.x);
+		ys.push_back(node.y);
+	}
+
+	auto [minX, maxX] = std::minmax_element(xs.begin(), xs.end());
+	auto [minY, maxY] = std::minmax_element(ys.begin(), ys.end());
+
+	const double extent = std::max(*maxX - *minX, *maxY - *minY);
+	const double tolerance = 1e-9 * extent;
+
+	StructuredGrid grid;
+	grid.x = UniqueCoordinates(std::move(xs), tolerance);
+	grid.y = UniqueCoordinates(std::move(ys), tolerance);
+	grid.nx = grid.x.size();
+	grid.ny = grid.y.size();
+
+	if (grid.nx < 2 || grid.ny < 2 || grid.nx * grid.ny != nodes.size())
+		return std::nullopt;
+
+	constexpr std::size_t Unassigned = std::numeric_limits<std::size_t>::max();
+	grid.nodeIndex.assign(nodes.size(), Unassigned);
+
+	for (std::size_t n = 0; n < nodes.size(); ++n)
+	{
+		auto i = FindCoordinate(grid.x, nodes[n].x, tolerance);
+		auto j = FindCoordinate(grid.y, nodes[n].y, tolerance);
+
+		if (!i || !j)
+			return std::nullopt;
+
+		auto& slot = grid.nodeIndex[*j * grid.nx + *i];
+
+		if (slot != Unassigned)
+			return std::nullopt;
+
+		slot = n;
+	}
+
+	return grid;
+}
+
+}
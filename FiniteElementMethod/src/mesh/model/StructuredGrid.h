@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Mesh.h"
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace fem::mesh::model
+{
+
+/// <summary>
+/// Tensor-product view of a mesh whose nodes lie on nx x ny grid lines (transfinite rectangles).
+/// Line spacing may be graded, only the tensor-product structure is required
+/// </summary>
+struct StructuredGrid
+{
+	std::size_t nx = 0;
+	std::size_t ny = 0;
+
+	std::vector<double> x; // Grid line coordinates, ascending
+	std::vector<double> y;
+
+	std::vector<std::size_t> nodeIndex; // Local node index of grid point (i, j) stored at j * nx + i
+
+	inline std::size_t GetNodeIndex(std::size_t i, std::size_t j) const
+	{
+		return nodeIndex[j * nx + i];
+	}
+
+	/// <summary>
+	/// Returns std::nullopt when the mesh nodes do not form a full tensor-product grid
+	/// </summary>
+	static std::optional<StructuredGrid> Detect(const Mesh& mesh);
+};
+
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <format>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace fem::mesh::model
+{
+
+/// <summary>
+/// Grid lines along one axis, split into blocks at the given points. Each block has its own division
+/// count and progression, the ratio between consecutive element sizes as in gmsh 'Using Progression'
+/// </summary>
+struct GridAxis
+{
+	std::vector<double> points;         // Block boundaries, ascending
+	std::vector<std::size_t> divisions; // Elements per block
+	std::vector<double> progression;    // Per block, 1 is uniform
+
+	inline std::size_t GetBlocksCount() const { return divisions.size(); }
+	inline std::size_t GetElementsCount() const { return std::accumulate(divisions.begin(), divisions.end(), std::size_t{ 0 }); }
+};
+
+enum class BoundarySide : int
+{
+	Bottom = 0,
+	Right,
+	Top,
+	Left,
+};
+
+/// <summary>
+/// Multi-block transfinite rectangle generated in process instead of meshed by gmsh. The blocks form
+/// a tensor product of the axis blocks, so grid lines stay conforming across block interfaces
+/// </summary>
+struct StructuredMeshSpec
+{
+	GridAxis x;
+	GridAxis y;
+
+	// Physical group names per side, one for the whole side or one per block along it. Segments sharing
+	// a name form one group, an empty name leaves the segment out of any group
+	std::array<std::vector<std::string>, 4> boundaryNames{ {
+		{ "Bottom" },
+		{ "Right" },
+		{ "Top" },
+		{ "Left" },
+	} };
+
+	inline const std::vector<std::string>& GetBoundaryNames(BoundarySide side) const
+	{
+		return boundaryNames[static_cast<std::size_t>(side)];
+	}
+
+	inline std::string Describe() const
+	{
+		return std::format("structured {} x {} grid ({} x {} blocks)", x.GetElementsCount(), y.GetElementsCount(), x.GetBlocksCount(), y.GetBlocksCount());
+	}
+};
+
+}
@@ -2,6 +2,9 @@
 
 #include "Line.h"
 #include "Mesh.h"
+#include "MeshMetadata.h"
 #include "Node.h"
 #include "Quad.h"
 #include "PhysicalGroup.h"
+#include "StructuredGrid.h"
+#include "StructuredMeshSpec.h"
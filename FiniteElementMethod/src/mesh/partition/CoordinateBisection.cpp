@@ -0,0 +1,79 @@
+#include "CoordinateBisection.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace fem::mesh::partition
+{
+
+MeshPartition CoordinateBisection::Partition(const model::Mesh& mesh, std::size_t parts)
+{
+	const auto& nodes = mesh.GetNodes();
+	const std::size_t n = nodes.size();
+
+	parts = std::clamp<std::size_t>(parts, 1, std::max<std::size_t>(n, 1));
+
+	MeshPartition partition{
+		.parts = parts,
+		.nodePart = std::vector<std::uint32_t>(n, 0)
+	};
+
+	std::vector<std::size_t> order(n);
+	std::iota(order.begin(), order.end(), 0);
+
+	struct Range
+	{
+		std::size_t begin;
+		std::size_t end;
+		std::size_t firstPart;
+		std::size_t parts;
+	};
+
+	std::vector<Range> stack{ { 0, n, 0, parts } };
+
+	while (!stack.empty())
+	{
+		Range range = stack.back();
+		stack.pop_back();
+
+		if (range.parts == 1)
+		{
+			for (std::size_t k = range.begin; k < range.end; ++k)
+				partition.nodePart[order[k]] = static_cast<std::uint32_t>(range.firstPart);
+
+			continue;
+		}
+
+		double minX = std::numeric_limits<double>::max(), maxX = std::numeric_limits<double>::lowest();
+		double minY = std::numeric_limits<double>::max(), maxY = std::numeric_limits<double>::lowest();
+
+		for (std::size_t k = range.begin; k < range.end; ++k)
+		{
+			const auto& node = nodes[order[k]];
+			minX = std::min(minX, node.x);
+			maxX = std::max(maxX, node.x);
+			minY = std::min(minY, node.y);
+			maxY = std::max(maxY, node.y);
+		}
+
+		const bool splitX = maxX - minX >= maxY - minY;
+
+		// Left side gets floor(parts / 2) parts and a proportional share of the nodes
+		const std::size_t leftParts = range.parts / 2;
+		const std::size_t middle = range.begin + (range.end - range.begin) * leftParts / range.parts;
+
+		std::nth_element(order.begin() + range.begin, order.begin() + middle, order.begin() + range.end,
+			[&](std::size_t a, std::size_t b)
+			{
+				return splitX ? nodes[a].x < nodes[b].x : nodes[a].y < nodes[b].y;
+			});
+
+		stack.push_back({ range.begin, middle, range.firstPart, leftParts });
+		stack.push_back({ middle, range.end, range.firstPart + leftParts, range.parts - leftParts });
+	}
+
+	return partition;
+}
+
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "MeshPartition.h"
+
+#include "mesh/model/Mesh.h"
+
+#include <cstddef>
+
+namespace fem::mesh::partition
+{
+
+/// <summary>
+/// Recursive coordinate bisection: splits the node set across its longer bounding box side at
+/// the median until the requested number of parts is reached. Part sizes differ by at most one
+/// node and any part count is supported, not only powers of two
+/// </summary>
+class CoordinateBisection
+{
+public:
+	CoordinateBisection() = delete;
+
+	static MeshPartition Partition(const model::Mesh& mesh, std::size_t parts);
+};
+
+}
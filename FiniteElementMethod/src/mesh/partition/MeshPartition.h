@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace fem::mesh::partition
+{
+
+/// <summary>
+/// Non-overlapping split of the mesh nodes into subdomains
+/// </summary>
+struct MeshPartition
+{
+	std::size_t parts = 0;
+	std::vector<std::uint32_t> nodePart; // Subdomain of each node, indexed by local node index (= matrix row)
+
+	std::vector<std::size_t> GetPartSizes() const
+	{
+		std::vector<std::size_t> sizes(parts, 0);
+
+		for (auto part : nodePart)
+			++sizes[part];
+
+		return sizes;
+	}
+};
+
+}
@@ -0,0 +1,4 @@
+#pragma once
+
+#include "CoordinateBisection.h"
+#include "MeshPartition.h"
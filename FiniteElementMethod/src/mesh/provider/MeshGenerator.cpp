@@ -1,16 +1,24 @@
 #include "MeshGenerator.h"
 
+#include "cache/GeneratedMeshCache.h"
+#include "config/GmshConfig.h"
+#include "config/OMPConfig.h"
 #include "logger/logger.h"
 
 #include "gmsh.h"
 
+#include <format>
+
 namespace fem::mesh::provider
 {
 
-std::expected<model::Mesh, MeshProviderError> MeshGenerator::GenerateFromGeo(const fs::path& path) const
+MeshGenerator::MeshGenerator(std::string cacheRoot)
+	: m_CacheRoot(std::move(cacheRoot))
 {
-	LOG_INFO("Generating mesh from .geo file using gmsh");
+}
 
+std::expected<model::Mesh, MeshProviderError> MeshGenerator::GenerateFromGeo(const fs::path& path) const
+{
 	auto mshPath = GenerateMshWithGmsh(path);
 
 	if (!mshPath)
@@ -21,6 +29,18 @@ std::expected<model::Mesh, MeshProviderError> MeshGenerator::GenerateFromGeo(con
 	return m_Loader.Load(*mshPath);
 }
 
+std::expected<model::MeshMetadata, MeshProviderError> MeshGenerator::GenerateMetadataFromGeo(const fs::path& path) const
+{
+	auto mshPath = GenerateMshWithGmsh(path);
+
+	if (!mshPath)
+	{
+		return std::unexpected(mshPath.error());
+	}
+
+	return m_Loader.LoadMetadata(*mshPath);
+}
+
 std::expected<fs::path, MeshProviderError> MeshGenerator::GenerateMshWithGmsh(const fs::path& path) const
 {
 	std::error_code ec;
@@ -30,20 +50,89 @@ std::expected<fs::path, MeshProviderError> MeshGenerator::GenerateMshWithGmsh(co
 		return std::unexpected(MeshProviderError{ MeshProviderErrorCode::InputPathNotFound, ec.message() });
 	}
 
-	fs::path resultPath = path;
-	resultPath.replace_extension(".msh");
+	std::optional<std::string> cachedPath;
+
+	if (m_CacheRoot)
+	{
+		cachedPath = cache::GeneratedMeshCache::GetMeshPath(*m_CacheRoot, path.string(), GetSettings());
+
+		if (!cachedPath)
+			LOG_WARN("Failed to hash {}, generating the mesh without the cache", path.string());
+	}
+
+	if (!cachedPath)
+	{
+		fs::path resultPath = path;
+		resultPath.replace_extension(".msh");
+
+		if (auto res = RunGmsh(path, resultPath, false); !res)
+			return std::unexpected(res.error());
+
+		return resultPath;
+	}
+
+	if (fs::exists(*cachedPath, ec))
+	{
+		LOG_INFO("Generated mesh found in cache, skipping gmsh: {}", *cachedPath);
+		return fs::path(*cachedPath);
+	}
+
+	const std::string stagingPath = cache::GeneratedMeshCache::GetStagingPath(*cachedPath);
+
+	if (auto res = RunGmsh(path, stagingPath, true); !res)
+	{
+		fs::remove(stagingPath, ec);
+		return std::unexpected(res.error());
+	}
+
+	if (!cache::GeneratedMeshCache::Publish(stagingPath, *cachedPath))
+	{
+		return std::unexpected(MeshProviderError{ MeshProviderErrorCode::OutputWriteFailed, *cachedPath });
+	}
 
+	LOG_INFO("Generated mesh cached: {}", *cachedPath);
+
+	return fs::path(*cachedPath);
+}
+
+std::expected<void, MeshProviderError> MeshGenerator::RunGmsh(const fs::path& path, const fs::path& resultPath, bool cacheFormat) const
+{
+	LOG_INFO("Generating mesh from .geo file using gmsh");
+
+	std::error_code ec;
 	Stage stage = Stage::Open;
 
 	try
 	{
+		config::GmshConfig::Initialize();
+		config::GmshConfig::SetNumThreads(config::OMPConfig::GetMaxThreads());
 		gmsh::open(path.string());
 
 		stage = Stage::Generate;
 		gmsh::model::mesh::generate(2);
 
 		stage = Stage::Write;
-		gmsh::write(resultPath.string());
+
+		if (!cacheFormat)
+		{
+			gmsh::write(resultPath.string());
+		}
+		else
+		{
+			// Binary MSH 4.1 is what the built-in reader parses fastest, whatever the .geo asked for. Options
+			// outlive the model, so later writes outside the cache get the previous format back
+			double version = 0.0;
+			double binary = 0.0;
+			gmsh::option::getNumber("Mesh.MshFileVersion", version);
+			gmsh::option::getNumber("Mesh.Binary", binary);
+
+			gmsh::option::setNumber("Mesh.MshFileVersion", 4.1);
+			gmsh::option::setNumber("Mesh.Binary", 1);
+			gmsh::write(resultPath.string());
+
+			gmsh::option::setNumber("Mesh.MshFileVersion", version);
+			gmsh::option::setNumber("Mesh.Binary", binary);
+		}
 	}
 	catch (const std::bad_alloc& ex)
 	{
@@ -77,7 +166,12 @@ std::expected<fs::path, MeshProviderError> MeshGenerator::GenerateMshWithGmsh(co
 		return std::unexpected(MeshProviderError{ MeshProviderErrorCode::ResultMissing, ec.message() });
 	}
 
-	return resultPath;
+	return {};
+}
+
+std::string MeshGenerator::GetSettings()
+{
+	return std::format("gmsh={}\ndimension=2\nformat=msh4.1\nbinary=1\n", GMSH_API_VERSION);
 }
 
 }
@@ -7,6 +7,8 @@
 
 #include <expected>
 #include <filesystem>
+#include <optional>
+#include <string>
 
 namespace fem::mesh::provider
 {
@@ -16,12 +18,35 @@ namespace fs = std::filesystem;
 class MeshGenerator
 {
 public:
+	MeshGenerator() = default;
+
+	/// <summary>
+	/// Generated meshes are kept under the cache root and reused while the .geo and the settings are unchanged
+	/// </summary>
+	explicit MeshGenerator(std::string cacheRoot);
+
 	std::expected<model::Mesh, MeshProviderError> GenerateFromGeo(const fs::path& path) const;
 
+	/// <summary>
+	/// The mesh still has to be generated, but only its counts are read back
+	/// </summary>
+	std::expected<model::MeshMetadata, MeshProviderError> GenerateMetadataFromGeo(const fs::path& path) const;
+
 private:
 	MeshLoader m_Loader;
+	std::optional<std::string> m_CacheRoot; // Meshes are written next to the .geo without it
 
 	std::expected<fs::path, MeshProviderError> GenerateMshWithGmsh(const fs::path& path) const;
+
+	/// <summary>
+	/// Meshes written for the cache are always binary MSH 4.1, others keep the format the .geo and gmsh defaults ask for
+	/// </summary>
+	std::expected<void, MeshProviderError> RunGmsh(const fs::path& path, const fs::path& resultPath, bool cacheFormat) const;
+
+	/// <summary>
+	/// Everything besides the .geo content that the written mesh depends on
+	/// </summary>
+	static std::string GetSettings();
 };
 
 enum class Stage : int
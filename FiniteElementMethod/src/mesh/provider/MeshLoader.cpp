@@ -2,6 +2,7 @@
 
 #include "GmshTypes.h"
 
+#include "config/GmshConfig.h"
 #include "logger/logger.h"
 
 #include "gmsh.h"
@@ -10,6 +11,32 @@ namespace fem::mesh::provider
 {
 
 std::expected<model::Mesh, MeshProviderError> MeshLoader::Load(const fs::path& path) const
+{
+	auto mesh = m_Reader.Read(path);
+
+	if (mesh || mesh.error().code != MeshProviderErrorCode::MeshFormatUnsupported)
+	{
+		return mesh;
+	}
+
+	LOG_WARN("{} - falling back to gmsh", mesh.error().message);
+	return LoadWithGmsh(path);
+}
+
+std::expected<model::MeshMetadata, MeshProviderError> MeshLoader::LoadMetadata(const fs::path& path) const
+{
+	auto metadata = m_Reader.ReadMetadata(path);
+
+	if (metadata || metadata.error().code != MeshProviderErrorCode::MeshFormatUnsupported)
+	{
+		return metadata;
+	}
+
+	LOG_WARN("{} - falling back to gmsh", metadata.error().message);
+	return LoadMetadataWithGmsh(path);
+}
+
+std::expected<model::Mesh, MeshProviderError> MeshLoader::LoadWithGmsh(const fs::path& path) const
 {
 	LOG_INFO("Loading mesh using gmsh from: {}", path.string());
 
@@ -25,6 +52,7 @@ std::expected<model::Mesh, MeshProviderError> MeshLoader::Load(const fs::path& p
 
 	try
 	{
+		config::GmshConfig::Initialize();
 		gmsh::open(path.string());
 
 		gmsh::model::mesh::getNodes(nodeTags, nodeCoords, nodeParams);
@@ -168,6 +196,46 @@ std::expected<model::Mesh, MeshProviderError> MeshLoader::Load(const fs::path& p
 	return mesh;
 }
 
+std::expected<model::MeshMetadata, MeshProviderError> MeshLoader::LoadMetadataWithGmsh(const fs::path& path) const
+{
+	LOG_INFO("Reading mesh metadata using gmsh from: {}", path.string());
+
+	model::MeshMetadata metadata;
+
+	try
+	{
+		config::GmshConfig::Initialize();
+		gmsh::open(path.string());
+
+		double nodes = 0.0;
+		double quads = 0.0;
+
+		gmsh::option::getNumber("Mesh.NbNodes", nodes);
+		gmsh::option::getNumber("Mesh.NbQuadrangles", quads);
+
+		std::vector<std::size_t> lineTags;
+		std::vector<std::size_t> lineNodeTags;
+
+		gmsh::model::mesh::getElementsByType(std::to_underlying(GmshElementType::Line2), lineTags, lineNodeTags);
+
+		metadata.nodes = static_cast<std::size_t>(nodes);
+		metadata.quads = static_cast<std::size_t>(quads);
+		metadata.lines = lineTags.size();
+	}
+	catch (const std::exception& ex)
+	{
+		return std::unexpected(MeshProviderError{ MeshProviderErrorCode::GmshOpenFailed, ex.what() });
+	}
+	catch (...)
+	{
+		return std::unexpected(MeshProviderError{ MeshProviderErrorCode::Unknown, "" });
+	}
+
+	LOG_INFO("Mesh contains: {} nodes, {} quads, {} lines", metadata.nodes, metadata.quads, metadata.lines);
+
+	return metadata;
+}
+
 inline static bool isLine(int t)
 {
 	return t == std::to_underlying(GmshElementType::Line2);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "MeshProviderError.h"
+#include "MshReader.h"
 
 #include "mesh/model/model.h"
 
@@ -15,7 +16,22 @@ namespace fs = std::filesystem;
 class MeshLoader
 {
 public:
+	/// <summary>
+	/// MSH 4.1 files are read by the built-in reader, gmsh only opens files it does not support
+	/// </summary>
 	std::expected<model::Mesh, MeshProviderError> Load(const fs::path& path) const;
+
+	std::expected<model::MeshMetadata, MeshProviderError> LoadMetadata(const fs::path& path) const;
+
+private:
+	MshReader m_Reader;
+
+	std::expected<model::Mesh, MeshProviderError> LoadWithGmsh(const fs::path& path) const;
+
+	/// <summary>
+	/// Counts nodes, quads and lines through gmsh statistics, only the boundary lines are transferred
+	/// </summary>
+	std::expected<model::MeshMetadata, MeshProviderError> LoadMetadataWithGmsh(const fs::path& path) const;
 };
 
 inline static bool isLine(int t);
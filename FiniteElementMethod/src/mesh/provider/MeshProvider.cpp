@@ -5,6 +5,11 @@
 namespace fem::mesh::provider
 {
 
+MeshProvider::MeshProvider(std::string cacheRoot)
+	: m_Generator(std::move(cacheRoot))
+{
+}
+
 std::expected<model::Mesh, MeshProviderError> MeshProvider::LoadMesh(const fs::path& path) const
 {
 	const auto ext = path.extension().string();
@@ -21,4 +26,30 @@ std::expected<model::Mesh, MeshProviderError> MeshProvider::LoadMesh(const fs::p
 	return std::unexpected(MeshProviderError{ MeshProviderErrorCode::ExtensionNotSupported, std::format("Provided extension: {}", ext)});
 }
 
+std::expected<model::MeshMetadata, MeshProviderError> MeshProvider::LoadMetadata(const fs::path& path) const
+{
+	const auto ext = path.extension().string();
+
+	if (ext == ".msh")
+	{
+		return m_Loader.LoadMetadata(path);
+	}
+	else if (ext == ".geo")
+	{
+		return m_Generator.GenerateMetadataFromGeo(path);
+	}
+
+	return std::unexpected(MeshProviderError{ MeshProviderErrorCode::ExtensionNotSupported, std::format("Provided extension: {}", ext)});
+}
+
+std::expected<model::Mesh, MeshProviderError> MeshProvider::LoadMesh(const model::StructuredMeshSpec& spec) const
+{
+	return m_StructuredGenerator.Generate(spec);
+}
+
+std::expected<model::MeshMetadata, MeshProviderError> MeshProvider::LoadMetadata(const model::StructuredMeshSpec& spec) const
+{
+	return m_StructuredGenerator.GenerateMetadata(spec);
+}
+
 }
@@ -3,11 +3,13 @@
 #include "MeshLoader.h"
 #include "MeshGenerator.h"
 #include "MeshProviderError.h"
+#include "StructuredMeshGenerator.h"
 
 #include "mesh/model/model.h"
 
 #include <expected>
 #include <filesystem>
+#include <string>
 
 namespace fem::mesh::provider
 {
@@ -19,11 +21,21 @@ class MeshProvider
 public:
 	MeshProvider() = default;
 
+	/// <summary>
+	/// Meshes gmsh generates from .geo files are cached under the cache root
+	/// </summary>
+	explicit MeshProvider(std::string cacheRoot);
+
 	std::expected<model::Mesh, MeshProviderError> LoadMesh(const fs::path& path) const;
+	std::expected<model::MeshMetadata, MeshProviderError> LoadMetadata(const fs::path& path) const;
+
+	std::expected<model::Mesh, MeshProviderError> LoadMesh(const model::StructuredMeshSpec& spec) const;
+	std::expected<model::MeshMetadata, MeshProviderError> LoadMetadata(const model::StructuredMeshSpec& spec) const;
 
 private:
 	MeshLoader m_Loader;
 	MeshGenerator m_Generator;
+	StructuredMeshGenerator m_StructuredGenerator;
 };
 
 }
@@ -17,6 +17,9 @@ enum class MeshProviderErrorCode : int
 	GmshWriteFailed,
 	IoError,
 	ResultMissing,
+	MeshFormatUnsupported,
+	MeshParseFailed,
+	MeshSpecInvalid,
 	Unknown,
 };
 
@@ -60,6 +63,15 @@ struct MeshProviderError
 		case ResultMissing:
 			msg += "Expected mesh output file is missing after generation.\n";
 			break;
+		case MeshFormatUnsupported:
+			msg += "Mesh file format is not supported by the built-in reader.\n";
+			break;
+		case MeshParseFailed:
+			msg += "Mesh file is malformed.\n";
+			break;
+		case MeshSpecInvalid:
+			msg += "Structured mesh specification is invalid.\n";
+			break;
 		case Unknown:
 			msg += "Unknown error.\n";
 			break;
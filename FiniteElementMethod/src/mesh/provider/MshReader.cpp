@@ -0,0 +1,1068 @@
+#include "MshReader.h"
+
+#include "GmshTypes.h"
+
+#include "cache/MappedFile.h"
+#include "logger/logger.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <map>
+#include <numeric>
+#include <optional>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace fem::mesh::provider
+{
+
+namespace
+{
+
+constexpr size_t CHUNK_SIZE = size_t{ 1 } << 20; // Bytes of ASCII data per parse task
+constexpr uint64_t TASK_SIZE = uint64_t{ 1 } << 16; // Entries of binary data per parse task
+
+constexpr int QUAD_TYPE = std::to_underlying(GmshElementType::Quad4);
+constexpr int LINE_TYPE = std::to_underlying(GmshElementType::Line2);
+
+std::unexpected<MeshProviderError> Unsupported(std::string message)
+{
+	return std::unexpected(MeshProviderError{ MeshProviderErrorCode::MeshFormatUnsupported, std::move(message) });
+}
+
+std::unexpected<MeshProviderError> Malformed(std::string message)
+{
+	return std::unexpected(MeshProviderError{ MeshProviderErrorCode::MeshParseFailed, std::move(message) });
+}
+
+/// <summary>
+/// Nodes of the fixed-size gmsh element types, binary blocks of other types cannot be skipped
+/// </summary>
+int GetNodesPerElement(int type)
+{
+	static constexpr std::array<int, 34> counts = {
+		0, 2, 3, 4, 4, 8, 6, 5, 3, 6, 9, 10, 27, 18, 14, 1, 8,
+		20, 15, 13, 9, 10, 12, 15, 15, 21, 4, 5, 6, 20, 35, 56, 22, 28
+	};
+
+	return type > 0 && type < static_cast<int>(counts.size()) ? counts[type] : 0;
+}
+
+struct Cursor
+{
+	const char* pos;
+	const char* end;
+
+	bool AtEnd() const { return pos >= end; }
+
+	void SkipSpaces()
+	{
+		while (pos < end && (*pos == ' ' || *pos == '\t' || *pos == '\r'))
+			++pos;
+	}
+
+	void SkipWhitespace()
+	{
+		while (pos < end && (*pos == ' ' || *pos == '\t' || *pos == '\r' || *pos == '\n'))
+			++pos;
+	}
+
+	bool SkipLine()
+	{
+		const auto* newline = static_cast<const char*>(std::memchr(pos, '\n', end - pos));
+		pos = newline ? newline + 1 : end;
+		return newline != nullptr;
+	}
+
+	bool Skip(uint64_t bytes)
+	{
+		if (bytes > static_cast<uint64_t>(end - pos))
+			return false;
+
+		pos += bytes;
+		return true;
+	}
+
+	/// <summary>
+	/// Rest of the current line without the line break
+	/// </summary>
+	std::string_view Line()
+	{
+		const char* begin = pos;
+		SkipLine();
+
+		std::string_view line(begin, pos - begin);
+		while (!line.empty() && (line.back() == '\n' || line.back() == '\r'))
+			line.remove_suffix(1);
+
+		return line;
+	}
+
+	/// <summary>
+	/// Number on the current line
+	/// </summary>
+	template<typename T>
+	bool Field(T& value)
+	{
+		SkipSpaces();
+
+		auto [next, ec] = std::from_chars(pos, end, value);
+		if (ec != std::errc{})
+			return false;
+
+		pos = next;
+		return true;
+	}
+
+	/// <summary>
+	/// Number anywhere after the current position
+	/// </summary>
+	template<typename T>
+	bool Token(T& value)
+	{
+		SkipWhitespace();
+		return Field(value);
+	}
+
+	template<typename T>
+	bool Load(T& value)
+	{
+		if (static_cast<size_t>(end - pos) < sizeof(T))
+			return false;
+
+		std::memcpy(&value, pos, sizeof(T));
+		pos += sizeof(T);
+		return true;
+	}
+};
+
+/// <summary>
+/// Same fields read from text or from the binary layout, where tags are int and counts size_t
+/// </summary>
+template<bool Binary>
+struct FieldReader
+{
+	static bool Int(Cursor& cursor, int& value)
+	{
+		if constexpr (Binary) return cursor.Load(value);
+		else return cursor.Token(value);
+	}
+
+	static bool Size(Cursor& cursor, uint64_t& value)
+	{
+		if constexpr (Binary) return cursor.Load(value);
+		else return cursor.Token(value);
+	}
+
+	static bool SkipDoubles(Cursor& cursor, uint64_t count)
+	{
+		if constexpr (Binary)
+		{
+			return count <= static_cast<uint64_t>(cursor.end - cursor.pos) / sizeof(double)
+				&& cursor.Skip(count * sizeof(double));
+		}
+		else
+		{
+			double value = 0.0;
+
+			for (uint64_t i = 0; i < count; ++i)
+				if (!cursor.Token(value))
+					return false;
+
+			return true;
+		}
+	}
+};
+
+/// <summary>
+/// Newline counts of fixed-size chunks of a text file. Lines can be located without scanning everything
+/// before them, and the lines of a range can be visited in parallel, chunk by chunk
+/// </summary>
+class LineIndex
+{
+public:
+	LineIndex(const char* begin, const char* end)
+		: m_Begin(begin), m_End(end)
+	{
+		const auto chunks = static_cast<std::ptrdiff_t>((end - begin + CHUNK_SIZE - 1) / CHUNK_SIZE);
+		m_LinesBefore.assign(chunks + 1, 0);
+
+#pragma omp parallel for schedule(static)
+		for (std::ptrdiff_t c = 0; c < chunks; ++c)
+		{
+			const char* first = begin + c * CHUNK_SIZE;
+			const char* last = std::min<const char*>(first + CHUNK_SIZE, end);
+			m_LinesBefore[c + 1] = static_cast<uint64_t>(std::count(first, last, '\n'));
+		}
+
+		std::partial_sum(m_LinesBefore.begin(), m_LinesBefore.end(), m_LinesBefore.begin());
+	}
+
+	/// <summary>
+	/// Line breaks before position, which is the index of the line starting there
+	/// </summary>
+	uint64_t LineOf(const char* position) const
+	{
+		const size_t chunk = std::min<size_t>((position - m_Begin) / CHUNK_SIZE, m_LinesBefore.size() - 1);
+		return m_LinesBefore[chunk] + static_cast<uint64_t>(std::count(m_Begin + chunk * CHUNK_SIZE, position, '\n'));
+	}
+
+	/// <summary>
+	/// Start of the given line, scanning on from a known position unless whole chunks lie in between
+	/// </summary>
+	const char* Seek(const char* from, uint64_t fromLine, uint64_t line) const
+	{
+		if (line < fromLine || line > m_LinesBefore.back())
+			return nullptr;
+
+		const size_t chunk = (from - m_Begin) / CHUNK_SIZE;
+
+		if (chunk + 1 < m_LinesBefore.size() && m_LinesBefore[chunk + 1] < line)
+		{
+			const auto next = std::lower_bound(m_LinesBefore.begin(), m_LinesBefore.end(), line);
+			const size_t target = (next - m_LinesBefore.begin()) - 1;
+
+			from = m_Begin + target * CHUNK_SIZE;
+			fromLine = m_LinesBefore[target];
+		}
+
+		for (; fromLine < line; ++fromLine)
+		{
+			from = static_cast<const char*>(std::memchr(from, '\n', m_End - from));
+			if (!from)
+				return nullptr;
+
+			++from;
+		}
+
+		return from;
+	}
+
+	/// <summary>
+	/// Calls parse(line, start) for every line starting in [begin, end), chunks in parallel. parse returns
+	/// where it stopped reading, or nullptr to abort
+	/// </summary>
+	template<typename Parse>
+	bool ForEachLine(const char* begin, const char* end, uint64_t beginLine, const Parse& parse) const
+	{
+		if (begin >= end)
+			return true;
+
+		const auto first = static_cast<std::ptrdiff_t>((begin - m_Begin) / CHUNK_SIZE);
+		const auto last = static_cast<std::ptrdiff_t>((end - 1 - m_Begin) / CHUNK_SIZE);
+
+		std::atomic<bool> failed = false;
+
+#pragma omp parallel for schedule(dynamic, 1)
+		for (std::ptrdiff_t c = first; c <= last; ++c)
+		{
+			const char* chunkBegin = m_Begin + c * CHUNK_SIZE;
+			const char* stop = std::min<const char*>(chunkBegin + CHUNK_SIZE, end);
+			const char* pos = std::max(chunkBegin, begin);
+			uint64_t line = m_LinesBefore[c];
+
+			if (pos == begin)
+			{
+				line = beginLine;
+			}
+			else if (pos[-1] != '\n')
+			{
+				// The line running into this chunk is parsed by the previous one
+				pos = static_cast<const char*>(std::memchr(pos, '\n', stop - pos));
+				if (!pos)
+					continue;
+
+				++pos;
+				++line;
+			}
+
+			while (pos < stop && !failed)
+			{
+				const char* parsed = parse(line, pos);
+				if (!parsed)
+				{
+					failed = true;
+					break;
+				}
+
+				pos = static_cast<const char*>(std::memchr(parsed, '\n', m_End - parsed));
+				if (!pos)
+					break;
+
+				++pos;
+				++line;
+			}
+		}
+
+		return !failed;
+	}
+
+private:
+	const char* m_Begin;
+	const char* m_End;
+	std::vector<uint64_t> m_LinesBefore; // Per chunk, plus the total
+};
+
+struct NodeBlock
+{
+	int dim = 0;
+	int tag = 0;
+	int parametric = 0;
+	uint64_t count = 0;
+	const char* data = nullptr; // Binary only
+	uint64_t firstLine = 0;     // ASCII only, node tags are followed by as many coordinate lines
+	size_t output = 0;          // Index of the first node in the mesh
+};
+
+struct ElementBlock
+{
+	int dim = 0;
+	int tag = 0;
+	int type = 0;
+	uint64_t count = 0;
+	const char* data = nullptr;
+	uint64_t firstLine = 0;
+	size_t output = 0; // Index of the first quad or line in the mesh
+};
+
+/// <summary>
+/// Range of the ASCII lines holding the blocks of a section
+/// </summary>
+struct LineRange
+{
+	const char* begin = nullptr;
+	const char* end = nullptr;
+	uint64_t firstLine = 0;
+};
+
+/// <summary>
+/// Ranges of binary blocks small enough to balance across threads
+/// </summary>
+struct Task
+{
+	size_t block;
+	uint64_t first;
+	uint64_t last;
+};
+
+template<typename Block, typename Predicate>
+std::vector<Task> SplitBlocks(const std::vector<Block>& blocks, const Predicate& predicate)
+{
+	std::vector<Task> tasks;
+
+	for (size_t b = 0; b < blocks.size(); ++b)
+	{
+		if (!predicate(blocks[b]))
+			continue;
+
+		for (uint64_t first = 0; first < blocks[b].count; first += TASK_SIZE)
+			tasks.push_back({ b, first, std::min(first + TASK_SIZE, blocks[b].count) });
+	}
+
+	return tasks;
+}
+
+/// <summary>
+/// Sections of a mapped file, located by walking the headers. Node and element data is only parsed by BuildMesh
+/// </summary>
+class MshFile
+{
+public:
+	std::expected<void, MeshProviderError> Open(const fs::path& path)
+	{
+		std::error_code ec;
+		if (!fs::exists(path, ec))
+		{
+			return std::unexpected(MeshProviderError{ MeshProviderErrorCode::InputPathNotFound, path.string() });
+		}
+
+		if (!m_File.Open(path.string()))
+		{
+			return std::unexpected(MeshProviderError{ MeshProviderErrorCode::IoError, std::format("Failed to map {}", path.string()) });
+		}
+
+		const char* data = reinterpret_cast<const char*>(m_File.GetData());
+		Cursor cursor{ data, data + m_File.GetSize() };
+
+		bool hasFormat = false;
+
+		while (true)
+		{
+			cursor.SkipWhitespace();
+
+			if (cursor.AtEnd())
+				break;
+
+			auto header = cursor.Line();
+
+			if (!header.starts_with('$'))
+				return Malformed(std::format("Expected a section, found '{}'", header.substr(0, 32)));
+
+			const std::string name(header.substr(1));
+
+			if (!hasFormat && name != "MeshFormat")
+				return Malformed("File does not start with $MeshFormat");
+
+			std::expected<void, MeshProviderError> section;
+
+			if (name == "MeshFormat")
+			{
+				section = ReadFormat(cursor);
+				hasFormat = true;
+			}
+			else if (name == "PhysicalNames")
+				section = ReadPhysicalNames(cursor);
+			else if (name == "Entities")
+				section = m_Binary ? ReadEntities<true>(cursor) : ReadEntities<false>(cursor);
+			else if (name == "Nodes")
+				section = m_Binary ? ReadNodes<true>(cursor) : ReadNodes<false>(cursor);
+			else if (name == "Elements")
+				section = m_Binary ? ReadElements<true>(cursor) : ReadElements<false>(cursor);
+			else if (name == "PartitionedEntities")
+				return Unsupported("Partitioned meshes are not supported by the built-in reader");
+			else
+				section = SkipSection(cursor, name);
+
+			if (!section)
+				return section;
+
+			cursor.SkipWhitespace();
+
+			if (cursor.Line() != "$End" + name)
+				return Malformed(std::format("Section ${} is not terminated by $End{}", name, name));
+		}
+
+		if (!m_HasNodes || !m_HasElements)
+			return Malformed("File has no $Nodes or $Elements section");
+
+		AssignOutput();
+		return {};
+	}
+
+	model::MeshMetadata GetMetadata() const
+	{
+		return model::MeshMetadata{ .nodes = m_NodeCount, .quads = m_QuadCount, .lines = m_LineCount };
+	}
+
+	bool IsBinary() const { return m_Binary; }
+
+	std::expected<model::Mesh, MeshProviderError> BuildMesh() const
+	{
+		std::vector<model::Node> nodes(m_NodeCount);
+		std::vector<model::Quad> quads(m_QuadCount);
+		std::vector<model::Line> lines(m_LineCount);
+
+		const bool parsed = m_Binary
+			? ParseBinaryNodes(nodes) && ParseBinaryElements(quads, lines)
+			: ParseAsciiNodes(nodes) && ParseAsciiElements(quads, lines);
+
+		if (!parsed)
+			return Malformed("Invalid number in node or element data");
+
+		auto groups = BuildPhysicalGroups(lines);
+
+		return model::Mesh(std::move(nodes), std::move(quads), std::move(lines), std::move(groups));
+	}
+
+private:
+	std::expected<void, MeshProviderError> ReadFormat(Cursor& cursor)
+	{
+		Cursor line{ cursor.pos, cursor.end };
+		auto format = cursor.Line();
+		line.end = line.pos + format.size();
+
+		line.SkipSpaces();
+		const char* versionBegin = line.pos;
+		while (!line.AtEnd() && *line.pos != ' ' && *line.pos != '\t')
+			++line.pos;
+
+		const std::string_view version(versionBegin, line.pos - versionBegin);
+
+		int fileType = 0;
+		int dataSize = 0;
+
+		if (!line.Field(fileType) || !line.Field(dataSize))
+			return Malformed(std::format("Invalid $MeshFormat '{}'", format));
+
+		if (version != "4.1")
+			return Unsupported(std::format("MSH version {} is not supported by the built-in reader", version));
+
+		if (fileType == 1)
+		{
+			if (dataSize != sizeof(uint64_t))
+				return Unsupported(std::format("Binary MSH with {}-byte sizes is not supported by the built-in reader", dataSize));
+
+			int one = 0;
+			if (!cursor.Load(one))
+				return Malformed("Truncated $MeshFormat");
+
+			if (one != 1)
+				return Unsupported("Binary MSH written with a different byte order");
+
+			m_Binary = true;
+		}
+		else if (fileType != 0)
+		{
+			return Malformed(std::format("Invalid MSH file type {}", fileType));
+		}
+
+		return {};
+	}
+
+	std::expected<void, MeshProviderError> ReadPhysicalNames(Cursor& cursor)
+	{
+		uint64_t count = 0;
+		if (!cursor.Token(count))
+			return Malformed("Invalid $PhysicalNames");
+
+		for (uint64_t i = 0; i < count; ++i)
+		{
+			int dim = 0;
+			int tag = 0;
+
+			if (!cursor.Token(dim) || !cursor.Token(tag))
+				return Malformed("Invalid $PhysicalNames");
+
+			auto line = cursor.Line();
+			const auto open = line.find('"');
+			const auto close = line.rfind('"');
+
+			if (open == std::string_view::npos || close == open)
+				return Malformed("Physical name is not quoted");
+
+			// Boundary conditions refer to curve groups only
+			if (dim == 1)
+				m_PhysicalNames[tag] = std::string(line.substr(open + 1, close - open - 1));
+		}
+
+		return {};
+	}
+
+	template<bool Binary>
+	std::expected<void, MeshProviderError> ReadEntities(Cursor& cursor)
+	{
+		using Read = FieldReader<Binary>;
+
+		std::array<uint64_t, 4> counts{};
+
+		for (auto& count : counts)
+			if (!Read::Size(cursor, count))
+				return Malformed("Invalid $Entities header");
+
+		for (int dim = 0; dim < 4; ++dim)
+		{
+			for (uint64_t e = 0; e < counts[dim]; ++e)
+			{
+				int tag = 0;
+				uint64_t physicalCount = 0;
+
+				// Points store their coordinates, other entities a bounding box
+				if (!Read::Int(cursor, tag) || !Read::SkipDoubles(cursor, dim == 0 ? 3 : 6) || !Read::Size(cursor, physicalCount))
+					return Malformed(std::format("Invalid entity {} of dimension {}", tag, dim));
+
+				std::vector<int> physicalTags;
+
+				for (uint64_t p = 0; p < physicalCount; ++p)
+				{
+					int physicalTag = 0;
+					if (!Read::Int(cursor, physicalTag))
+						return Malformed(std::format("Invalid entity {} of dimension {}", tag, dim));
+
+					physicalTags.push_back(physicalTag);
+				}
+
+				if (dim > 0)
+				{
+					uint64_t boundingCount = 0;
+					int boundingTag = 0;
+
+					if (!Read::Size(cursor, boundingCount))
+						return Malformed(std::format("Invalid entity {} of dimension {}", tag, dim));
+
+					for (uint64_t b = 0; b < boundingCount; ++b)
+						if (!Read::Int(cursor, boundingTag))
+							return Malformed(std::format("Invalid entity {} of dimension {}", tag, dim));
+				}
+
+				if (dim == 1 && !physicalTags.empty())
+					m_CurvePhysicalTags[tag] = std::move(physicalTags);
+			}
+		}
+
+		return {};
+	}
+
+	template<bool Binary>
+	std::expected<void, MeshProviderError> ReadNodes(Cursor& cursor)
+	{
+		using Read = FieldReader<Binary>;
+
+		uint64_t blockCount = 0, nodeCount = 0, minTag = 0, maxTag = 0;
+
+		if (!Read::Size(cursor, blockCount) || !Read::Size(cursor, nodeCount) || !Read::Size(cursor, minTag) || !Read::Size(cursor, maxTag))
+			return Malformed("Invalid $Nodes header");
+
+		if constexpr (!Binary)
+		{
+			cursor.SkipLine();
+			m_NodeLines = { cursor.pos, nullptr, Lines().LineOf(cursor.pos) };
+		}
+
+		uint64_t line = m_NodeLines.firstLine;
+		uint64_t total = 0;
+
+		for (uint64_t b = 0; b < blockCount; ++b)
+		{
+			NodeBlock block;
+
+			if (!Read::Int(cursor, block.dim) || !Read::Int(cursor, block.tag) || !Read::Int(cursor, block.parametric) || !Read::Size(cursor, block.count))
+				return Malformed(std::format("Invalid header of node block {}", b));
+
+			if constexpr (Binary)
+			{
+				const uint64_t values = 1 + 3 + (block.parametric ? block.dim : 0); // Tag and coordinates
+				block.data = cursor.pos;
+
+				if (block.count > static_cast<uint64_t>(cursor.end - cursor.pos) / (values * sizeof(uint64_t)) || !cursor.Skip(block.count * values * sizeof(uint64_t)))
+					return Malformed(std::format("Truncated node block {}", b));
+			}
+			else
+			{
+				cursor.SkipLine();
+				block.firstLine = ++line;
+
+				cursor.pos = Lines().Seek(cursor.pos, line, line + 2 * block.count);
+				if (!cursor.pos)
+					return Malformed(std::format("Truncated node block {}", b));
+
+				line += 2 * block.count;
+			}
+
+			total += block.count;
+			m_NodeBlocks.push_back(block);
+		}
+
+		if (total != nodeCount)
+			return Malformed(std::format("Node blocks hold {} nodes, the header declares {}", total, nodeCount));
+
+		m_NodeLines.end = cursor.pos;
+		m_NodeCount = nodeCount;
+		m_HasNodes = true;
+
+		return {};
+	}
+
+	template<bool Binary>
+	std::expected<void, MeshProviderError> ReadElements(Cursor& cursor)
+	{
+		using Read = FieldReader<Binary>;
+
+		uint64_t blockCount = 0, elementCount = 0, minTag = 0, maxTag = 0;
+
+		if (!Read::Size(cursor, blockCount) || !Read::Size(cursor, elementCount) || !Read::Size(cursor, minTag) || !Read::Size(cursor, maxTag))
+			return Malformed("Invalid $Elements header");
+
+		if constexpr (!Binary)
+		{
+			cursor.SkipLine();
+			m_ElementLines = { cursor.pos, nullptr, Lines().LineOf(cursor.pos) };
+		}
+
+		uint64_t line = m_ElementLines.firstLine;
+		uint64_t total = 0;
+
+		for (uint64_t b = 0; b < blockCount; ++b)
+		{
+			ElementBlock block;
+
+			if (!Read::Int(cursor, block.dim) || !Read::Int(cursor, block.tag) || !Read::Int(cursor, block.type) || !Read::Size(cursor, block.count))
+				return Malformed(std::format("Invalid header of element block {}", b));
+
+			if constexpr (Binary)
+			{
+				const int nodes = GetNodesPerElement(block.type);
+				if (nodes == 0)
+					return Unsupported(std::format("Element type {} is not supported by the built-in reader", block.type));
+
+				const uint64_t values = 1 + static_cast<uint64_t>(nodes);
+				block.data = cursor.pos;
+
+				if (block.count > static_cast<uint64_t>(cursor.end - cursor.pos) / (values * sizeof(uint64_t)) || !cursor.Skip(block.count * values * sizeof(uint64_t)))
+					return Malformed(std::format("Truncated element block {}", b));
+			}
+			else
+			{
+				cursor.SkipLine();
+				block.firstLine = ++line;
+
+				cursor.pos = Lines().Seek(cursor.pos, line, line + block.count);
+				if (!cursor.pos)
+					return Malformed(std::format("Truncated element block {}", b));
+
+				line += block.count;
+			}
+
+			if (block.type == QUAD_TYPE)
+				m_QuadCount += block.count;
+			else if (block.type == LINE_TYPE)
+				m_LineCount += block.count;
+
+			total += block.count;
+			m_ElementBlocks.push_back(block);
+		}
+
+		if (total != elementCount)
+			return Malformed(std::format("Element blocks hold {} elements, the header declares {}", total, elementCount));
+
+		m_ElementLines.end = cursor.pos;
+		m_HasElements = true;
+
+		return {};
+	}
+
+	std::expected<void, MeshProviderError> SkipSection(Cursor& cursor, const std::string& name)
+	{
+		const std::string marker = "$End" + name;
+		const auto end = std::string_view(cursor.pos, cursor.end - cursor.pos).find(marker);
+
+		if (end == std::string_view::npos)
+			return Malformed(std::format("Section ${} is not terminated", name));
+
+		LOG_TRACE("Skipping mesh file section ${}", name);
+
+		cursor.pos += end;
+		return {};
+	}
+
+	/// <summary>
+	/// gmsh lists nodes and elements by entity, ordered by dimension and tag. Blocks are placed in the mesh
+	/// the same way, so numbering matches meshes loaded through gmsh
+	/// </summary>
+	void AssignOutput()
+	{
+		auto byEntity = [](const auto& blocks)
+		{
+			std::vector<size_t> order(blocks.size());
+			std::iota(order.begin(), order.end(), size_t{ 0 });
+
+			std::ranges::stable_sort(order, [&](size_t a, size_t b)
+			{
+				return std::tie(blocks[a].dim, blocks[a].tag) < std::tie(blocks[b].dim, blocks[b].tag);
+			});
+
+			return order;
+		};
+
+		size_t nextNode = 0;
+
+		for (size_t b : byEntity(m_NodeBlocks))
+		{
+			m_NodeBlocks[b].output = nextNode;
+			nextNode += m_NodeBlocks[b].count;
+		}
+
+		size_t nextQuad = 0;
+		size_t nextLine = 0;
+
+		for (size_t b : byEntity(m_ElementBlocks))
+		{
+			auto& block = m_ElementBlocks[b];
+
+			if (block.type == QUAD_TYPE)
+			{
+				block.output = nextQuad;
+				nextQuad += block.count;
+			}
+			else if (block.type == LINE_TYPE)
+			{
+				block.output = nextLine;
+				nextLine += block.count;
+			}
+		}
+	}
+
+	bool ParseBinaryNodes(std::vector<model::Node>& nodes) const
+	{
+		const auto tasks = SplitBlocks(m_NodeBlocks, [](const NodeBlock&) { return true; });
+
+#pragma omp parallel for schedule(dynamic, 1)
+		for (std::ptrdiff_t t = 0; t < static_cast<std::ptrdiff_t>(tasks.size()); ++t)
+		{
+			const auto& block = m_NodeBlocks[tasks[t].block];
+			const uint64_t stride = 3 + (block.parametric ? block.dim : 0);
+
+			// All tags of the block come first, then the coordinates of every node
+			const char* tags = block.data;
+			const char* coordinates = block.data + block.count * sizeof(uint64_t);
+
+			for (uint64_t i = tasks[t].first; i < tasks[t].last; ++i)
+			{
+				auto& node = nodes[block.output + i];
+
+				uint64_t tag = 0;
+				std::memcpy(&tag, tags + i * sizeof(uint64_t), sizeof(tag));
+				std::memcpy(&node.x, coordinates + i * stride * sizeof(double), sizeof(double));
+				std::memcpy(&node.y, coordinates + (i * stride + 1) * sizeof(double), sizeof(double));
+
+				node.id = tag;
+			}
+		}
+
+		return true;
+	}
+
+	bool ParseBinaryElements(std::vector<model::Quad>& quads, std::vector<model::Line>& lines) const
+	{
+		const auto tasks = SplitBlocks(m_ElementBlocks, [](const ElementBlock& block)
+		{
+			return block.type == QUAD_TYPE || block.type == LINE_TYPE;
+		});
+
+#pragma omp parallel for schedule(dynamic, 1)
+		for (std::ptrdiff_t t = 0; t < static_cast<std::ptrdiff_t>(tasks.size()); ++t)
+		{
+			const auto& block = m_ElementBlocks[tasks[t].block];
+
+			for (uint64_t i = tasks[t].first; i < tasks[t].last; ++i)
+			{
+				if (block.type == QUAD_TYPE)
+				{
+					std::array<uint64_t, 5> values;
+					std::memcpy(values.data(), block.data + i * sizeof(values), sizeof(values));
+					quads[block.output + i] = model::Quad{ values[0], { values[1], values[2], values[3], values[4] } };
+				}
+				else
+				{
+					std::array<uint64_t, 3> values;
+					std::memcpy(values.data(), block.data + i * sizeof(values), sizeof(values));
+					lines[block.output + i] = model::Line{ values[0], { values[1], values[2] } };
+				}
+			}
+		}
+
+		return true;
+	}
+
+	bool ParseAsciiNodes(std::vector<model::Node>& nodes) const
+	{
+		std::vector<uint64_t> firstLines;
+		for (const auto& block : m_NodeBlocks)
+			firstLines.push_back(block.firstLine);
+
+		return Lines().ForEachLine(m_NodeLines.begin, m_NodeLines.end, m_NodeLines.firstLine, [&](uint64_t line, const char* pos) -> const char*
+		{
+			const auto next = std::upper_bound(firstLines.begin(), firstLines.end(), line);
+			if (next == firstLines.begin())
+				return pos;
+
+			const auto& block = m_NodeBlocks[next - firstLines.begin() - 1];
+			const uint64_t offset = line - block.firstLine;
+
+			Cursor cursor{ pos, m_NodeLines.end };
+
+			if (offset < block.count)
+			{
+				uint64_t tag = 0;
+				if (!cursor.Field(tag))
+					return nullptr;
+
+				nodes[block.output + offset].id = tag;
+			}
+			else if (offset < 2 * block.count)
+			{
+				auto& node = nodes[block.output + offset - block.count];
+				if (!cursor.Field(node.x) || !cursor.Field(node.y))
+					return nullptr;
+			}
+
+			return cursor.pos;
+		});
+	}
+
+	bool ParseAsciiElements(std::vector<model::Quad>& quads, std::vector<model::Line>& lines) const
+	{
+		std::vector<uint64_t> firstLines;
+		for (const auto& block : m_ElementBlocks)
+			firstLines.push_back(block.firstLine);
+
+		return Lines().ForEachLine(m_ElementLines.begin, m_ElementLines.end, m_ElementLines.firstLine, [&](uint64_t line, const char* pos) -> const char*
+		{
+			const auto next = std::upper_bound(firstLines.begin(), firstLines.end(), line);
+			if (next == firstLines.begin())
+				return pos;
+
+			const auto& block = m_ElementBlocks[next - firstLines.begin() - 1];
+			const uint64_t offset = line - block.firstLine;
+
+			if (offset >= block.count)
+				return pos;
+
+			Cursor cursor{ pos, m_ElementLines.end };
+
+			if (block.type == QUAD_TYPE)
+			{
+				auto& quad = quads[block.output + offset];
+
+				if (!cursor.Field(quad.id))
+					return nullptr;
+
+				for (auto& node : quad.nodeIDs)
+					if (!cursor.Field(node))
+						return nullptr;
+			}
+			else if (block.type == LINE_TYPE)
+			{
+				auto& element = lines[block.output + offset];
+
+				if (!cursor.Field(element.id))
+					return nullptr;
+
+				for (auto& node : element.nodeIDs)
+					if (!cursor.Field(node))
+						return nullptr;
+			}
+
+			return cursor.pos;
+		});
+	}
+
+	/// <summary>
+	/// Curve groups as gmsh reports them: ordered by tag, with the lines of their curves in curve order
+	/// </summary>
+	std::vector<model::PhysicalGroup> BuildPhysicalGroups(const std::vector<model::Line>& lines) const
+	{
+		std::map<int, std::vector<int>> curvesByGroup;
+
+		for (const auto& [curve, tags] : m_CurvePhysicalTags)
+			for (int tag : tags)
+				curvesByGroup[tag].push_back(curve);
+
+		std::map<int, std::vector<const ElementBlock*>> lineBlocksByCurve;
+
+		for (const auto& block : m_ElementBlocks)
+			if (block.dim == 1 && block.type == LINE_TYPE)
+				lineBlocksByCurve[block.tag].push_back(&block);
+
+		std::vector<model::PhysicalGroup> groups;
+
+		for (const auto& [tag, curves] : curvesByGroup)
+		{
+			model::PhysicalGroup group;
+			group.tag = tag;
+			group.dimension = 1;
+
+			if (auto name = m_PhysicalNames.find(tag); name != m_PhysicalNames.end())
+				group.name = name->second;
+
+			for (int curve : curves)
+			{
+				auto blocks = lineBlocksByCurve.find(curve);
+				if (blocks == lineBlocksByCurve.end())
+					continue;
+
+				for (const auto* block : blocks->second)
+					for (uint64_t i = 0; i < block->count; ++i)
+						group.lineIDs.push_back(lines[block->output + i].id);
+			}
+
+			LOG_INFO("Physical group '{}' contains {} lines", group.name, group.lineIDs.size());
+
+			groups.push_back(std::move(group));
+		}
+
+		return groups;
+	}
+
+	const LineIndex& Lines() const
+	{
+		if (!m_Lines)
+		{
+			const char* data = reinterpret_cast<const char*>(m_File.GetData());
+			m_Lines.emplace(data, data + m_File.GetSize());
+		}
+
+		return *m_Lines;
+	}
+
+private:
+	cache::MappedFile m_File;
+	bool m_Binary = false;
+
+	mutable std::optional<LineIndex> m_Lines; // ASCII only, built on first use
+
+	std::map<int, std::string> m_PhysicalNames;            // Of curve groups, by tag
+	std::map<int, std::vector<int>> m_CurvePhysicalTags;   // By curve tag
+
+	std::vector<NodeBlock> m_NodeBlocks;       // In file order
+	std::vector<ElementBlock> m_ElementBlocks;
+	LineRange m_NodeLines;
+	LineRange m_ElementLines;
+
+	size_t m_NodeCount = 0;
+	size_t m_QuadCount = 0;
+	size_t m_LineCount = 0;
+	bool m_HasNodes = false;
+	bool m_HasElements = false;
+};
+
+}
+
+std::expected<model::Mesh, MeshProviderError> MshReader::Read(const fs::path& path) const
+{
+	LOG_INFO("Loading mesh from: {}", path.string());
+
+	auto start = std::chrono::steady_clock::now();
+
+	MshFile file;
+
+	if (auto opened = file.Open(path); !opened)
+	{
+		return std::unexpected(opened.error());
+	}
+
+	const auto metadata = file.GetMetadata();
+
+	LOG_INFO("Found {} nodes", metadata.nodes);
+	LOG_INFO("Mesh contains: {} quads, {} lines", metadata.quads, metadata.lines);
+
+	auto mesh = file.BuildMesh();
+
+	if (!mesh)
+	{
+		return mesh;
+	}
+
+	auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	LOG_INFO("Mesh read in {:.2f} ms (MSH 4.1 {})", elapsed, file.IsBinary() ? "binary" : "ASCII");
+
+	return mesh;
+}
+
+std::expected<model::MeshMetadata, MeshProviderError> MshReader::ReadMetadata(const fs::path& path) const
+{
+	LOG_INFO("Reading mesh metadata from: {}", path.string());
+
+	MshFile file;
+
+	if (auto opened = file.Open(path); !opened)
+	{
+		return std::unexpected(opened.error());
+	}
+
+	const auto metadata = file.GetMetadata();
+
+	LOG_INFO("Mesh contains: {} nodes, {} quads, {} lines", metadata.nodes, metadata.quads, metadata.lines);
+
+	return metadata;
+}
+
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "MeshProviderError.h"
+
+#include "mesh/model/model.h"
+
+#include <expected>
+#include <filesystem>
+
+namespace fem::mesh::provider
+{
+
+namespace fs = std::filesystem;
+
+/// <summary>
+/// Built-in reader of MSH 4.1 ASCII and binary files. The file is memory-mapped and its node and
+/// element blocks are parsed in parallel straight into the mesh arrays, gmsh is not involved
+/// </summary>
+class MshReader
+{
+public:
+	/// <summary>
+	/// Fails with MeshFormatUnsupported for files gmsh can still read, like older versions or partitioned meshes
+	/// </summary>
+	std::expected<model::Mesh, MeshProviderError> Read(const fs::path& path) const;
+
+	/// <summary>
+	/// Counts come from the section and block headers, no node or element data is parsed
+	/// </summary>
+	std::expected<model::MeshMetadata, MeshProviderError> ReadMetadata(const fs::path& path) const;
+};
+
+}
@@ -0,0 +1,268 @@
+#include "StructuredMeshGenerator.h"
+
+#include "logger/logger.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <format>
+#include <new>
+
+namespace fem::mesh::provider
+{
+
+namespace
+{
+
+std::unexpected<MeshProviderError> Invalid(std::string message)
+{
+	return std::unexpected(MeshProviderError{ MeshProviderErrorCode::MeshSpecInvalid, std::move(message) });
+}
+
+std::expected<void, MeshProviderError> ValidateAxis(const model::GridAxis& axis, std::string_view name)
+{
+	if (axis.divisions.empty())
+		return Invalid(std::format("Axis {} has no blocks", name));
+
+	if (axis.points.size() != axis.divisions.size() + 1)
+		return Invalid(std::format("Axis {} needs {} points for {} blocks, got {}", name, axis.divisions.size() + 1, axis.divisions.size(), axis.points.size()));
+
+	if (axis.progression.size() != axis.divisions.size())
+		return Invalid(std::format("Axis {} needs one progression per block", name));
+
+	for (std::size_t b = 0; b < axis.divisions.size(); ++b)
+	{
+		if (!(axis.points[b] < axis.points[b + 1]))
+			return Invalid(std::format("Axis {} points must be strictly ascending", name));
+
+		if (axis.divisions[b] == 0)
+			return Invalid(std::format("Axis {} block {} has no divisions", name, b));
+
+		if (!(axis.progression[b] > 0.0) || !std::isfinite(axis.progression[b]))
+			return Invalid(std::format("Axis {} block {} progression must be positive", name, b));
+	}
+
+	return {};
+}
+
+std::expected<void, MeshProviderError> ValidateSpec(const model::StructuredMeshSpec& spec)
+{
+	if (auto res = ValidateAxis(spec.x, "x"); !res)
+		return res;
+
+	if (auto res = ValidateAxis(spec.y, "y"); !res)
+		return res;
+
+	constexpr std::array<std::string_view, 4> sides{ "bottom", "right", "top", "left" };
+
+	for (std::size_t side = 0; side < sides.size(); ++side)
+	{
+		const auto& names = spec.boundaryNames[side];
+		const auto blocks = (side % 2 == 0) ? spec.x.GetBlocksCount() : spec.y.GetBlocksCount();
+
+		if (names.size() != 1 && names.size() != blocks)
+			return Invalid(std::format("Boundary {} needs one name or one per block ({}), got {}", sides[side], blocks, names.size()));
+	}
+
+	return {};
+}
+
+/// <summary>
+/// Grid line coordinates of all blocks, block boundaries are taken exactly from the points
+/// </summary>
+std::vector<double> BuildAxis(const model::GridAxis& axis)
+{
+	std::vector<double> coords;
+	coords.reserve(axis.GetElementsCount() + 1);
+	coords.push_back(axis.points.front());
+
+	for (std::size_t b = 0; b < axis.GetBlocksCount(); ++b)
+	{
+		const double a = axis.points[b];
+		const double length = axis.points[b + 1] - a;
+		const std::size_t n = axis.divisions[b];
+		const double r = axis.progression[b];
+
+		// Element k has size h * r^k, so the k-th grid line sits at (r^k - 1) / (r^n - 1) of the block
+		const double denominator = std::pow(r, static_cast<double>(n)) - 1.0;
+		const bool uniform = r == 1.0 || denominator == 0.0;
+
+		for (std::size_t k = 1; k < n; ++k)
+		{
+			const double t = uniform
+				? static_cast<double>(k) / static_cast<double>(n)
+				: (std::pow(r, static_cast<double>(k)) - 1.0) / denominator;
+
+			coords.push_back(a + length * t);
+		}
+
+		coords.push_back(axis.points[b + 1]);
+	}
+
+	return coords;
+}
+
+class GroupBuilder
+{
+public:
+	void Add(const std::string& name, std::size_t lineId)
+	{
+		if (name.empty())
+			return;
+
+		auto it = std::ranges::find(m_Groups, name, &model::PhysicalGroup::name);
+
+		if (it == m_Groups.end())
+		{
+			m_Groups.push_back(model::PhysicalGroup{
+				.tag = static_cast<int>(m_Groups.size()) + 1,
+				.dimension = 1,
+				.name = name,
+				.lineIDs = {}
+			});
+
+			it = std::prev(m_Groups.end());
+		}
+
+		it->lineIDs.push_back(lineId);
+	}
+
+	std::vector<model::PhysicalGroup> Take() { return std::move(m_Groups); }
+
+private:
+	std::vector<model::PhysicalGroup> m_Groups;
+};
+
+/// <summary>
+/// Lines of one side in boundary order. edge(k) gives the oriented nodes of the k-th edge along that order,
+/// reversed sides walk their blocks from the last one
+/// </summary>
+template<typename EdgeFn>
+void AddSide(std::vector<model::Line>& lines, GroupBuilder& groups, const std::vector<std::string>& names, const model::GridAxis& axis, bool reversed, EdgeFn edge)
+{
+	const std::size_t blocks = axis.GetBlocksCount();
+	std::size_t k = 0;
+
+	for (std::size_t b = 0; b < blocks; ++b)
+	{
+		const std::size_t block = reversed ? blocks - 1 - b : b;
+		const std::string& name = names.size() == 1 ? names.front() : names[block];
+
+		for (std::size_t e = 0; e < axis.divisions[block]; ++e, ++k)
+		{
+			const std::size_t id = lines.size() + 1;
+			lines.push_back(model::Line{ id, edge(k) });
+			groups.Add(name, id);
+		}
+	}
+}
+
+}
+
+std::expected<model::Mesh, MeshProviderError> StructuredMeshGenerator::Generate(const model::StructuredMeshSpec& spec) const
+{
+	if (auto res = ValidateSpec(spec); !res)
+		return std::unexpected(res.error());
+
+	LOG_INFO("Generating {}", spec.Describe());
+
+	const auto start = std::chrono::steady_clock::now();
+
+	try
+	{
+		const auto x = BuildAxis(spec.x);
+		const auto y = BuildAxis(spec.y);
+
+		const std::size_t ex = x.size() - 1;
+		const std::size_t ey = y.size() - 1;
+		const std::size_t lineCount = 2 * (ex + ey);
+
+		auto nodeId = [nx = x.size()](std::size_t i, std::size_t j)
+		{
+			return j * nx + i + 1;
+		};
+
+		std::vector<model::Node> nodes(x.size() * y.size());
+		std::vector<model::Quad> quads(ex * ey);
+
+#pragma omp parallel
+		{
+#pragma omp for schedule(static) nowait
+			for (std::ptrdiff_t j = 0; j < static_cast<std::ptrdiff_t>(y.size()); ++j)
+			{
+				for (std::size_t i = 0; i < x.size(); ++i)
+				{
+					auto& node = nodes[j * x.size() + i];
+					node.id = nodeId(i, j);
+					node.x = x[i];
+					node.y = y[j];
+				}
+			}
+
+			// Lines are numbered first, quads continue after them as in gmsh output
+#pragma omp for schedule(static) nowait
+			for (std::ptrdiff_t j = 0; j < static_cast<std::ptrdiff_t>(ey); ++j)
+			{
+				for (std::size_t i = 0; i < ex; ++i)
+				{
+					const std::size_t index = j * ex + i;
+					quads[index] = model::Quad{
+						lineCount + index + 1,
+						{ nodeId(i, j), nodeId(i + 1, j), nodeId(i + 1, j + 1), nodeId(i, j + 1) }
+					};
+				}
+			}
+		}
+
+		std::vector<model::Line> lines;
+		lines.reserve(lineCount);
+
+		GroupBuilder groups;
+		using enum model::BoundarySide;
+
+		AddSide(lines, groups, spec.GetBoundaryNames(Bottom), spec.x, false, [&](std::size_t k) {
+			return std::array{ nodeId(k, 0), nodeId(k + 1, 0) };
+		});
+
+		AddSide(lines, groups, spec.GetBoundaryNames(Right), spec.y, false, [&](std::size_t k) {
+			return std::array{ nodeId(ex, k), nodeId(ex, k + 1) };
+		});
+
+		AddSide(lines, groups, spec.GetBoundaryNames(Top), spec.x, true, [&](std::size_t k) {
+			return std::array{ nodeId(ex - k, ey), nodeId(ex - k - 1, ey) };
+		});
+
+		AddSide(lines, groups, spec.GetBoundaryNames(Left), spec.y, true, [&](std::size_t k) {
+			return std::array{ nodeId(0, ey - k), nodeId(0, ey - k - 1) };
+		});
+
+		model::Mesh mesh(std::move(nodes), std::move(quads), std::move(lines), groups.Take());
+
+		const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		LOG_INFO("Structured mesh generated in {:.2f} ms: {} nodes, {} quads, {} boundary lines", elapsed, mesh.GetNodesCount(), mesh.GetQuads().size(), mesh.GetLines().size());
+
+		return mesh;
+	}
+	catch (const std::bad_alloc& ex)
+	{
+		return std::unexpected(MeshProviderError{ MeshProviderErrorCode::OutOfMemory, ex.what() });
+	}
+}
+
+std::expected<model::MeshMetadata, MeshProviderError> StructuredMeshGenerator::GenerateMetadata(const model::StructuredMeshSpec& spec) const
+{
+	if (auto res = ValidateSpec(spec); !res)
+		return std::unexpected(res.error());
+
+	const std::size_t ex = spec.x.GetElementsCount();
+	const std::size_t ey = spec.y.GetElementsCount();
+
+	return model::MeshMetadata{
+		.nodes = (ex + 1) * (ey + 1),
+		.quads = ex * ey,
+		.lines = 2 * (ex + ey)
+	};
+}
+
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "MeshProviderError.h"
+
+#include "mesh/model/model.h"
+
+#include <expected>
+
+namespace fem::mesh::provider
+{
+
+/// <summary>
+/// Builds a multi-block transfinite quad grid straight into the mesh arrays, gmsh and the disk are not involved.
+/// Numbering and boundary orientation follow gmsh: nodes row by row, boundary lines counter-clockwise from the bottom
+/// </summary>
+class StructuredMeshGenerator
+{
+public:
+	std::expected<model::Mesh, MeshProviderError> Generate(const model::StructuredMeshSpec& spec) const;
+
+	/// <summary>
+	/// Counts follow from the division counts alone
+	/// </summary>
+	std::expected<model::MeshMetadata, MeshProviderError> GenerateMetadata(const model::StructuredMeshSpec& spec) const;
+};
+
+}
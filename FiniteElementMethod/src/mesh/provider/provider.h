@@ -5,3 +5,5 @@
 #include "MeshLoader.h"
 #include "MeshProvider.h"
 #include "MeshProviderError.h"
+#include "MshReader.h"
+#include "StructuredMeshGenerator.h"
@@ -48,6 +48,22 @@ size_t MemoryMonitor::GetPeakUsage()
 	}
 }
 
+size_t MemoryMonitor::GetPhysicalMemory()
+{
+	if constexpr (IS_WINDOWS)
+	{
+		return GetWindowsPhysicalMemory();
+	}
+	else if constexpr (IS_LINUX)
+	{
+		return GetLinuxPhysicalMemory();
+	}
+	else
+	{
+		return 0;
+	}
+}
+
 #ifdef _WIN32
 
 size_t MemoryMonitor::GetWindowsCurrentUsage()
@@ -71,6 +87,18 @@ size_t MemoryMonitor::GetWindowsPeakUsage()
 	return 0;
 }
 
+size_t MemoryMonitor::GetWindowsPhysicalMemory()
+{
+	MEMORYSTATUSEX status{};
+	status.dwLength = sizeof(status);
+
+	if (GlobalMemoryStatusEx(&status))
+	{
+		return status.ullTotalPhys;
+	}
+	return 0;
+}
+
 #endif
 
 #ifdef __linux__
@@ -121,6 +149,29 @@ size_t MemoryMonitor::GetLinuxPeakUsage()
 	return 0;
 }
 
+size_t MemoryMonitor::GetLinuxPhysicalMemory()
+{
+	auto fileService = fileio::FileService();
+	const auto& readData = fileService.Read("/proc/meminfo");
+
+	if (!readData) return 0;
+
+	std::istringstream stream(*readData);
+	std::string line;
+
+	while (std::getline(stream, line))
+	{
+		if (line.substr(0, 9) == "MemTotal:")
+		{
+			std::istringstream iss(line.substr(9));
+			size_t mem_kb;
+			iss >> mem_kb;
+			return mem_kb * 1024;
+		}
+	}
+	return 0;
+}
+
 #endif
 
 }
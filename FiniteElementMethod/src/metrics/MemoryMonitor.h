@@ -8,6 +8,7 @@ class MemoryMonitor
 public:
 	static size_t GetCurrentUsage();
 	static size_t GetPeakUsage();
+	static size_t GetPhysicalMemory(); // Installed RAM of the machine, 0 when unknown
 
 	static double ToMB(size_t bytes)
 	{
@@ -17,8 +18,10 @@ public:
 private:
 	static size_t GetWindowsCurrentUsage();
 	static size_t GetWindowsPeakUsage();
+	static size_t GetWindowsPhysicalMemory();
 	static size_t GetLinuxCurrentUsage();
 	static size_t GetLinuxPeakUsage();
+	static size_t GetLinuxPhysicalMemory();
 };
 
 }
@@ -0,0 +1,35 @@
+#include "MemoryStages.h"
+
+#include "MemoryMonitor.h"
+
+#include "logger/logger.h"
+
+namespace fem::metrics
+{
+
+void MemoryStages::Record(std::string_view name)
+{
+	m_Stages.push_back(MemoryStage{
+		.name = std::string(name),
+		.currentBytes = MemoryMonitor::GetCurrentUsage(),
+		.peakBytes = MemoryMonitor::GetPeakUsage()
+		});
+}
+
+void MemoryStages::Print() const
+{
+	LOG_INFO("Memory per stage:");
+
+	size_t previousPeak = 0;
+
+	for (const auto& stage : m_Stages)
+	{
+		LOG_INFO("  {:<20}{:>10.2f} MB current, {:>10.2f} MB peak{}",
+			stage.name + ":", MemoryMonitor::ToMB(stage.currentBytes), MemoryMonitor::ToMB(stage.peakBytes),
+			stage.peakBytes > previousPeak && previousPeak > 0 ? " (raised)" : "");
+
+		previousPeak = stage.peakBytes;
+	}
+}
+
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace fem::metrics
+{
+
+struct MemoryStage
+{
+	std::string name;
+	size_t currentBytes = 0; // Resident when the stage ended
+	size_t peakBytes = 0;    // Process high-water mark when the stage ended
+};
+
+/// <summary>
+/// Memory at the end of each pipeline stage. The process peak only grows, so a stage raised it
+/// when its peak differs from the previous one
+/// </summary>
+class MemoryStages
+{
+public:
+	void Record(std::string_view name);
+
+	void Print() const;
+
+	const std::vector<MemoryStage>& GetStages() const { return m_Stages; }
+
+private:
+	std::vector<MemoryStage> m_Stages;
+};
+
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "solver/linear/LinearSolverType.h"
+
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+namespace fem::planner
+{
+
+/// <summary>
+/// Work units the calibrated coefficients are measured against. The scaling laws are those of a
+/// 2D bilinear mesh: nested dissection fills n log n and factorizes in n^1.5, unpreconditioned
+/// Krylov iteration counts grow with sqrt(n) and multigrid cycles stay constant
+/// </summary>
+struct SolverCoefficients
+{
+	double setupMsPerWork = 0.0;     // Factorization or preconditioner setup, per linear solve
+	double solveMsPerWork = 0.0;     // Substitution or iterations, per linear solve
+	double factorBytesPerFill = 0.0; // Direct solvers only, bytes per n log2 n
+	std::size_t samples = 0;         // Runs the coefficients were calibrated from, 0 = defaults
+};
+
+inline bool IsDirectSolver(solver::linear::LinearSolverType solver)
+{
+	using enum solver::linear::LinearSolverType;
+
+	return solver == SimplicialLDLT || solver == SimplicialLLT || solver == MixedPrecisionLDLT
+		|| solver == SparseLU || solver == SparseQR;
+}
+
+inline double FillUnits(std::size_t n)
+{
+	return n > 1 ? static_cast<double>(n) * std::log2(static_cast<double>(n)) : static_cast<double>(n);
+}
+
+inline double SetupWork(solver::linear::LinearSolverType solver, std::size_t n, std::size_t nonZeros)
+{
+	if (IsDirectSolver(solver))
+		return std::pow(static_cast<double>(n), 1.5);
+
+	return static_cast<double>(nonZeros);
+}
+
+inline double SolveWork(solver::linear::LinearSolverType solver, std::size_t n, std::size_t nonZeros, std::size_t factorBytes)
+{
+	using enum solver::linear::LinearSolverType;
+
+	if (IsDirectSolver(solver))
+		return static_cast<double>(factorBytes);
+
+	if (solver == AlgebraicMultigrid || solver == GeometricMultigrid)
+		return static_cast<double>(nonZeros);
+
+	return static_cast<double>(nonZeros) * std::sqrt(static_cast<double>(n));
+}
+
+/// <summary>
+/// Order-of-magnitude coefficients of a current desktop, used until a run on this machine calibrates them
+/// </summary>
+inline SolverCoefficients DefaultCoefficients(solver::linear::LinearSolverType solver)
+{
+	using enum solver::linear::LinearSolverType;
+
+	switch (solver)
+	{
+	case SimplicialLDLT:
+	case SimplicialLLT:
+		return { .setupMsPerWork = 2e-6, .solveMsPerWork = 2e-7, .factorBytesPerFill = 48.0 };
+	case MixedPrecisionLDLT:
+		return { .setupMsPerWork = 1.2e-6, .solveMsPerWork = 6e-7, .factorBytesPerFill = 32.0 };
+	case SparseLU:
+		return { .setupMsPerWork = 6e-6, .solveMsPerWork = 2e-7, .factorBytesPerFill = 96.0 };
+	case SparseQR:
+		return { .setupMsPerWork = 2e-5, .solveMsPerWork = 2e-7, .factorBytesPerFill = 192.0 };
+	case ConjugateGradient:
+		return { .setupMsPerWork = 1e-6, .solveMsPerWork = 3e-6 };
+	case DeflatedConjugateGradient:
+		return { .setupMsPerWork = 1e-6, .solveMsPerWork = 2e-6 };
+	case AlgebraicMultigrid:
+		return { .setupMsPerWork = 2e-5, .solveMsPerWork = 2e-4 };
+	case GeometricMultigrid:
+		return { .setupMsPerWork = 5e-6, .solveMsPerWork = 1e-4 };
+	}
+
+	std::unreachable();
+}
+
+inline constexpr double DEFAULT_ASSEMBLY_MS_PER_ELEMENT = 5e-4;
+
+} // namespace fem::planner
@@ -0,0 +1,180 @@
+#include "MachineProfile.h"
+
+#include "cache/JsonFile.h"
+#include "config/OMPConfig.h"
+#include "logger/logger.h"
+
+#include <algorithm>
+#include <format>
+
+#include <nlohmann/json.hpp>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace fem::planner
+{
+
+namespace
+{
+
+// Running mean over the first samples, then a moving average that follows hardware or build changes
+constexpr std::size_t MAX_AVERAGED_SAMPLES = 5;
+
+double Blend(double current, double measured, std::size_t samples)
+{
+	if (samples == 0)
+		return measured;
+
+	return current + (measured - current) / static_cast<double>(std::min(samples + 1, MAX_AVERAGED_SAMPLES));
+}
+
+}
+
+SolverCoefficients MachineProfile::GetCoefficients(solver::linear::LinearSolverType solver) const
+{
+	auto it = m_Solvers.find(std::string(solver::linear::LinearSolverTypeToString(solver)));
+
+	if (it == m_Solvers.end())
+		return DefaultCoefficients(solver);
+
+	return it->second;
+}
+
+MachineProfile MachineProfile::Load(const std::string& cacheRoot)
+{
+	return FromJson(GetMachineKey(), cache::JsonFile::Read(GetFilePath(cacheRoot)));
+}
+
+MachineProfile MachineProfile::FromJson(const std::string& key, const nlohmann::json& profiles)
+{
+	MachineProfile profile;
+	profile.key = key;
+
+	auto it = profiles.find(profile.key);
+	if (it == profiles.end())
+		return profile;
+
+	try
+	{
+		profile.assemblyMsPerElement = it->value("assembly_ms_per_element", DEFAULT_ASSEMBLY_MS_PER_ELEMENT);
+		profile.assemblySamples = it->value("assembly_samples", std::size_t{ 0 });
+
+		for (const auto& info : solver::linear::LINEAR_SOLVERS)
+		{
+			const auto name = std::string(info.name);
+
+			if (!it->contains("solvers") || !it->at("solvers").contains(name))
+				continue;
+
+			const auto& entry = it->at("solvers").at(name);
+			const auto defaults = DefaultCoefficients(info.type);
+
+			profile.m_Solvers[name] = SolverCoefficients{
+				.setupMsPerWork = entry.value("setup_ms_per_work", defaults.setupMsPerWork),
+				.solveMsPerWork = entry.value("solve_ms_per_work", defaults.solveMsPerWork),
+				.factorBytesPerFill = entry.value("factor_bytes_per_fill", defaults.factorBytesPerFill),
+				.samples = entry.value("samples", std::size_t{ 0 })
+			};
+		}
+	}
+	catch (const nlohmann::json::exception& e)
+	{
+		LOG_WARN("Ignoring malformed machine profile entry {}: {}", profile.key, e.what());
+		MachineProfile defaults;
+		defaults.key = profile.key;
+		return defaults;
+	}
+
+	return profile;
+}
+
+bool MachineProfile::RecordAssembly(const std::string& cacheRoot, const domain::AssemblyStats& stats)
+{
+	if (stats.elementCount == 0 || stats.totalAssemblyTimeMs <= 0.0)
+		return false;
+
+	const double measured = stats.totalAssemblyTimeMs / static_cast<double>(stats.elementCount);
+
+	// Blended with the stored profile while the file is locked, runs finishing together each add their sample
+	return cache::JsonFile::Update(GetFilePath(cacheRoot), [&](nlohmann::json& profiles)
+		{
+			auto profile = FromJson(GetMachineKey(), profiles);
+			auto& entry = profiles[profile.key];
+
+			entry["assembly_ms_per_element"] = Blend(profile.assemblyMsPerElement, measured, profile.assemblySamples);
+			entry["assembly_samples"] = profile.assemblySamples + 1;
+		});
+}
+
+bool MachineProfile::RecordSolve(const std::string& cacheRoot, solver::linear::LinearSolverType solver, const solver::FEMSolverStats& stats)
+{
+	if (stats.matrixSize == 0 || stats.linearSolveCount == 0)
+		return false;
+
+	// Loaded factors skip the factorization and would calibrate setup towards zero
+	if (stats.factorizationTimeMs <= 0.0 && IsDirectSolver(solver))
+		return false;
+
+	const auto n = stats.matrixSize;
+	const auto nonZeros = stats.matrixNonZeros;
+
+	return cache::JsonFile::Update(GetFilePath(cacheRoot), [&](nlohmann::json& profiles)
+		{
+			auto profile = FromJson(GetMachineKey(), profiles);
+			auto coefficients = profile.GetCoefficients(solver);
+
+			SolverCoefficients measured = coefficients;
+
+			if (IsDirectSolver(solver) && stats.predictedFactorBytes > 0)
+				measured.factorBytesPerFill = static_cast<double>(stats.predictedFactorBytes) / FillUnits(n);
+
+			const auto factorBytes = static_cast<std::size_t>(measured.factorBytesPerFill * FillUnits(n));
+			const double setupMs = (stats.factorizationTimeMs + stats.preconditionerSetupTimeMs) / static_cast<double>(stats.linearSolveCount);
+
+			measured.setupMsPerWork = setupMs / SetupWork(solver, n, nonZeros);
+			measured.solveMsPerWork = stats.getAvgSolveMs() / std::max(SolveWork(solver, n, nonZeros, factorBytes), 1.0);
+
+			const auto samples = coefficients.samples;
+
+			profiles[profile.key]["solvers"][std::string(solver::linear::LinearSolverTypeToString(solver))] = {
+				{ "setup_ms_per_work",     Blend(coefficients.setupMsPerWork, measured.setupMsPerWork, samples) },
+				{ "solve_ms_per_work",     Blend(coefficients.solveMsPerWork, measured.solveMsPerWork, samples) },
+				{ "factor_bytes_per_fill", Blend(coefficients.factorBytesPerFill, measured.factorBytesPerFill, samples) },
+				{ "samples",               samples + 1 }
+			};
+		});
+}
+
+std::string MachineProfile::GetMachineKey()
+{
+	std::string host = "unknown";
+
+#ifdef _WIN32
+	char buffer[MAX_COMPUTERNAME_LENGTH + 1];
+	DWORD size = sizeof(buffer);
+
+	if (GetComputerNameA(buffer, &size))
+		host.assign(buffer, size);
+#else
+	char buffer[256];
+
+	if (gethostname(buffer, sizeof(buffer)) == 0)
+		host = buffer;
+#endif
+
+	return std::format("{}/{}t", host, config::OMPConfig::GetMaxThreads());
+}
+
+std::string MachineProfile::GetFilePath(const std::string& cacheRoot)
+{
+	return cacheRoot + "/machine_profiles.json";
+}
+
+} // namespace fem::planner
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "CostModel.h"
+
+#include "domain/AssemblyStats.h"
+#include "solver/FEMSolverStats.h"
+#include "solver/linear/LinearSolverType.h"
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+
+#include <nlohmann/json_fwd.hpp>
+
+namespace fem::planner
+{
+
+/// <summary>
+/// Cost coefficients of one machine and thread count, calibrated from the measurements of completed
+/// runs and persisted in one JSON file under the cache root. Coefficients never measured keep their defaults
+/// </summary>
+class MachineProfile
+{
+public:
+	std::string key;
+	double assemblyMsPerElement = DEFAULT_ASSEMBLY_MS_PER_ELEMENT;
+	std::size_t assemblySamples = 0;
+
+	SolverCoefficients GetCoefficients(solver::linear::LinearSolverType solver) const;
+
+	bool IsCalibrated(solver::linear::LinearSolverType solver) const
+	{
+		return assemblySamples > 0 && GetCoefficients(solver).samples > 0;
+	}
+
+	static MachineProfile Load(const std::string& cacheRoot);
+
+	static bool RecordAssembly(const std::string& cacheRoot, const domain::AssemblyStats& stats);
+
+	static bool RecordSolve(const std::string& cacheRoot, solver::linear::LinearSolverType solver, const solver::FEMSolverStats& stats);
+
+	/// <summary>
+	/// Host name and OpenMP thread count, coefficients of different thread counts are not comparable
+	/// </summary>
+	static std::string GetMachineKey();
+
+private:
+	std::unordered_map<std::string, SolverCoefficients> m_Solvers; // By solver name
+
+	/// <summary>
+	/// Profile of the machine key in the parsed profiles file, defaults for anything missing or malformed
+	/// </summary>
+	static MachineProfile FromJson(const std::string& key, const nlohmann::json& profiles);
+
+	static std::string GetFilePath(const std::string& cacheRoot);
+};
+
+} // namespace fem::planner
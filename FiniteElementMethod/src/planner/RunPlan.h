@@ -0,0 +1,71 @@
+#pragma once
+
+#include "mesh/model/MeshMetadata.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace fem::planner
+{
+
+/// <summary>
+/// Predicted resources of a run, estimated before the mesh is read or the system assembled
+/// </summary>
+struct RunPlan
+{
+	mesh::model::MeshMetadata mesh;
+	std::string machineKey;
+	std::string solverName;
+	bool calibrated = false; // Coefficients measured on this machine rather than defaults
+
+	// System
+	size_t unknowns = 0;
+	size_t estimatedNonZeros = 0;
+	size_t linearSolves = 1;   // Time steps of a transient run, upper bound when steady state may stop it
+	size_t savedStates = 0;    // Transient history only
+	size_t saveStride = 0;
+
+	// Memory (bytes)
+	size_t meshBytes = 0;
+	size_t tripletBytes = 0;
+	size_t matrixBytes = 0;    // All matrices alive during the solve
+	size_t factorBytes = 0;    // Direct solvers only
+	size_t workspaceBytes = 0; // Solver vectors and preconditioner hierarchies
+	size_t historyBytes = 0;
+	size_t assemblyPeakBytes = 0;
+	size_t solvePeakBytes = 0;
+	size_t ramBytes = 0;       // Physical memory, 0 when unknown
+
+	// Time (ms)
+	double assemblyMs = 0.0;
+	double setupMsPerSolve = 0.0; // Factorization or preconditioner setup
+	double solveMsPerSolve = 0.0;
+
+	std::optional<size_t> minimumSaveStride; // Smallest stride whose history fits in RAM
+	std::vector<std::string> warnings;
+
+	size_t getPeakBytes() const
+	{
+		return std::max(assemblyPeakBytes, solvePeakBytes);
+	}
+
+	double getPerSolveMs() const
+	{
+		return setupMsPerSolve + solveMsPerSolve;
+	}
+
+	double getTotalMs() const
+	{
+		return assemblyMs + linearSolves * getPerSolveMs();
+	}
+
+	bool fitsInRam() const
+	{
+		return ramBytes == 0 || getPeakBytes() <= ramBytes;
+	}
+};
+
+} // namespace fem::planner
@@ -0,0 +1,260 @@
+#include "RunPlanner.h"
+
+#include "fileio/FileService.h"
+#include "logger/logger.h"
+#include "math/math.h"
+#include "mesh/model/model.h"
+#include "metrics/metrics.h"
+#include "utils/utils.h"
+
+#include <format>
+
+#include <nlohmann/json.hpp>
+
+namespace fem::planner
+{
+
+namespace
+{
+
+constexpr size_t MAP_ENTRY_BYTES = 48;   // unordered_map node and bucket of the gmsh id lookups
+constexpr size_t SOLVER_VECTORS = 8;     // Right-hand side, solution and Krylov work vectors
+constexpr double AMG_HIERARCHY_RATIO = 0.6; // Coarse operators and prolongators against the fine matrix
+
+size_t SparseBytes(size_t rows, size_t nonZeros)
+{
+	return nonZeros * (sizeof(double) + sizeof(SpMat::StorageIndex)) + (rows + 1) * sizeof(SpMat::StorageIndex);
+}
+
+size_t WorkspaceBytes(solver::linear::LinearSolverType solver, const solver::linear::LinearSolverOptions& options, size_t n, size_t matrixBytes)
+{
+	using enum solver::linear::LinearSolverType;
+
+	const size_t vector = n * sizeof(double);
+
+	switch (solver)
+	{
+	case DeflatedConjugateGradient:
+		return (SOLVER_VECTORS + 2 * options.recycleSize) * vector;
+	case AlgebraicMultigrid:
+		return SOLVER_VECTORS * vector + static_cast<size_t>(AMG_HIERARCHY_RATIO * matrixBytes);
+	case GeometricMultigrid:
+		return SOLVER_VECTORS * vector * 4 / 3;
+	case ConjugateGradient:
+		if (options.preconditioner == solver::linear::PreconditionerType::AMG)
+			return SOLVER_VECTORS * vector + static_cast<size_t>(AMG_HIERARCHY_RATIO * matrixBytes);
+		return SOLVER_VECTORS * vector;
+	default:
+		return 4 * vector;
+	}
+}
+
+}
+
+RunPlan RunPlanner::Estimate(
+	const mesh::model::MeshMetadata& mesh,
+	const config::ProblemConfig& config,
+	solver::linear::LinearSolverType solver,
+	const solver::linear::LinearSolverOptions& options,
+	const MachineProfile& profile,
+	bool lowMemory)
+{
+	RunPlan plan;
+	plan.mesh = mesh;
+	plan.machineKey = profile.key;
+	plan.solverName = std::string(solver::linear::LinearSolverTypeToString(solver));
+	plan.calibrated = profile.IsCalibrated(solver);
+	plan.ramBytes = metrics::MemoryMonitor::GetPhysicalMemory();
+
+	const size_t n = mesh.nodes;
+	const size_t q = mesh.quads;
+
+	// Euler's formula for a planar quad mesh gives n + q edges; each quad couples its two diagonals too
+	plan.unknowns = n;
+	plan.estimatedNonZeros = q > 0 ? 3 * n + 6 * q : n;
+
+	const bool transient = config.problemType == domain::model::ProblemType::Transient && config.transientConfig;
+
+	if (transient)
+	{
+		const auto& tc = *config.transientConfig;
+		plan.linearSolves = tc.timeStep > 0.0 ? static_cast<size_t>(tc.totalTime / tc.timeStep) : 0;
+
+		if (tc.saveHistory && tc.saveStride.value_or(0) > 0)
+		{
+			plan.saveStride = *tc.saveStride;
+			plan.savedStates = plan.linearSolves / plan.saveStride + 2;
+		}
+	}
+
+	// Memory
+	plan.meshBytes = n * (sizeof(mesh::model::Node) + MAP_ENTRY_BYTES)
+		+ q * sizeof(mesh::model::Quad)
+		+ mesh.lines * (sizeof(mesh::model::Line) + MAP_ENTRY_BYTES);
+
+	// H and C per element, the boundary into H; thread-local buffers coexist with the merged ones
+	plan.tripletBytes = 2 * (32 * q + 4 * mesh.lines) * sizeof(Triplet);
+
+	const size_t matrix = SparseBytes(n, plan.estimatedNonZeros);
+
+	// H and C, the transient loop adds A = H + C/dt and C/dt. Low memory mode hands H and C to the
+	// solver, which frees C before a steady solve and both once the transient matrices exist
+	plan.matrixBytes = (transient ? (lowMemory ? 2 : 4) : (lowMemory ? 1 : 2)) * matrix + n * sizeof(double);
+
+	const auto coefficients = profile.GetCoefficients(solver);
+
+	if (IsDirectSolver(solver))
+		plan.factorBytes = static_cast<size_t>(coefficients.factorBytesPerFill * FillUnits(n));
+
+	plan.workspaceBytes = WorkspaceBytes(solver, options, n, matrix);
+	plan.historyBytes = plan.savedStates * (n * sizeof(double) + sizeof(double));
+
+	plan.assemblyPeakBytes = plan.meshBytes + plan.tripletBytes + 2 * matrix;
+	// Low memory mode keeps only the nodes and quads the history export needs
+	const size_t solveMeshBytes = !lowMemory ? plan.meshBytes
+		: plan.savedStates > 0 ? n * sizeof(mesh::model::Node) + q * sizeof(mesh::model::Quad)
+		: 0;
+
+	plan.solvePeakBytes = solveMeshBytes + plan.matrixBytes + plan.factorBytes + plan.workspaceBytes + plan.historyBytes;
+
+	// Time
+	plan.assemblyMs = profile.assemblyMsPerElement * q;
+	plan.setupMsPerSolve = coefficients.setupMsPerWork * SetupWork(solver, n, plan.estimatedNonZeros);
+	plan.solveMsPerSolve = coefficients.solveMsPerWork * SolveWork(solver, n, plan.estimatedNonZeros, plan.factorBytes);
+
+	if (!plan.calibrated)
+		plan.warnings.push_back(std::format("No completed {} run on {} yet - timings use default coefficients", plan.solverName, plan.machineKey));
+
+	const size_t factorBudget = options.memoryBudgetMb * 1024 * 1024;
+
+	if (factorBudget > 0 && plan.factorBytes > factorBudget)
+	{
+		plan.warnings.push_back(std::format("Factor of {:.2f} MB exceeds the {} MB memory budget - {}",
+			BytesToMiB(plan.factorBytes), options.memoryBudgetMb,
+			config::UseSequentialSolver ? "the sequential solver will stop before factorizing" : "Pardiso will factorize out-of-core"));
+	}
+
+	CheckHistory(plan);
+
+	if (!plan.fitsInRam())
+	{
+		plan.warnings.push_back(std::format("Predicted peak of {:.2f} MB exceeds the {:.2f} MB of RAM",
+			BytesToMiB(plan.getPeakBytes()), BytesToMiB(plan.ramBytes)));
+	}
+
+	return plan;
+}
+
+void RunPlanner::CheckHistory(RunPlan& plan)
+{
+	if (plan.historyBytes == 0 || plan.ramBytes == 0 || plan.fitsInRam())
+		return;
+
+	const size_t withoutHistory = plan.solvePeakBytes - plan.historyBytes;
+	const size_t stateBytes = plan.historyBytes / plan.savedStates;
+
+	// Nothing to gain from the stride when the run does not fit even without history
+	if (std::max(plan.assemblyPeakBytes, withoutHistory) >= plan.ramBytes)
+		return;
+
+	const size_t fittingStates = (plan.ramBytes - withoutHistory) / stateBytes;
+
+	if (fittingStates > 2)
+		plan.minimumSaveStride = (plan.linearSolves + fittingStates - 3) / (fittingStates - 2);
+
+	plan.warnings.push_back(std::format("save_history with save_stride = {} keeps {} states ({:.2f} MB) and does not fit in RAM{}",
+		plan.saveStride, plan.savedStates, BytesToMiB(plan.historyBytes),
+		plan.minimumSaveStride ? std::format(" - use save_stride >= {}", *plan.minimumSaveStride) : " - disable save_history"));
+}
+
+void RunPlanner::Print(const RunPlan& plan)
+{
+	LOG_INFO("=== Run Plan ===");
+	LOG_INFO("  Machine:            {}{}", plan.machineKey, plan.calibrated ? " (calibrated)" : " (default coefficients)");
+	LOG_INFO("  Mesh:               {} nodes, {} quads, {} lines", plan.mesh.nodes, plan.mesh.quads, plan.mesh.lines);
+	LOG_INFO("  System:             {} unknowns, ~{} non-zeros", plan.unknowns, plan.estimatedNonZeros);
+	LOG_INFO("  Linear solver:      {}, {} solves", plan.solverName, plan.linearSolves);
+
+	LOG_INFO("Memory:");
+	LOG_INFO("  Mesh:               {:.2f} MB", BytesToMiB(plan.meshBytes));
+	LOG_INFO("  Triplets:           {:.2f} MB", BytesToMiB(plan.tripletBytes));
+	LOG_INFO("  Matrices:           {:.2f} MB", BytesToMiB(plan.matrixBytes));
+
+	if (plan.factorBytes > 0)
+		LOG_INFO("  Factor:             {:.2f} MB", BytesToMiB(plan.factorBytes));
+
+	LOG_INFO("  Solver workspace:   {:.2f} MB", BytesToMiB(plan.workspaceBytes));
+
+	if (plan.savedStates > 0)
+		LOG_INFO("  History:            {:.2f} MB ({} states, stride {})", BytesToMiB(plan.historyBytes), plan.savedStates, plan.saveStride);
+
+	LOG_INFO("  Peak:               {:.2f} MB (assembly {:.2f} MB, solve {:.2f} MB)",
+		BytesToMiB(plan.getPeakBytes()), BytesToMiB(plan.assemblyPeakBytes), BytesToMiB(plan.solvePeakBytes));
+
+	if (plan.ramBytes > 0)
+		LOG_INFO("  RAM:                {:.2f} MB", BytesToMiB(plan.ramBytes));
+
+	LOG_INFO("Time:");
+	LOG_INFO("  Assembly:           {:.2f} ms", plan.assemblyMs);
+	LOG_INFO("  Setup per solve:    {:.2f} ms", plan.setupMsPerSolve);
+	LOG_INFO("  Solve per solve:    {:.2f} ms", plan.solveMsPerSolve);
+	LOG_INFO("  Total:              {:.2f} s", plan.getTotalMs() / 1000.0);
+
+	for (const auto& warning : plan.warnings)
+		LOG_WARN(warning);
+}
+
+std::expected<void, std::string> RunPlanner::ExportJSON(const fs::path& path, const RunPlan& plan)
+{
+	LOG_INFO("Exporting run plan to {} (JSON)", path.string());
+
+	nlohmann::json json;
+
+	json["machine"] = plan.machineKey;
+	json["calibrated"] = plan.calibrated;
+	json["solver"] = plan.solverName;
+
+	json["mesh"]["nodes"] = plan.mesh.nodes;
+	json["mesh"]["quads"] = plan.mesh.quads;
+	json["mesh"]["lines"] = plan.mesh.lines;
+
+	json["system"]["unknowns"] = plan.unknowns;
+	json["system"]["estimatedNonZeros"] = plan.estimatedNonZeros;
+	json["system"]["linearSolves"] = plan.linearSolves;
+	json["system"]["savedStates"] = plan.savedStates;
+
+	json["memory"]["meshBytes"] = plan.meshBytes;
+	json["memory"]["tripletBytes"] = plan.tripletBytes;
+	json["memory"]["matrixBytes"] = plan.matrixBytes;
+	json["memory"]["factorBytes"] = plan.factorBytes;
+	json["memory"]["workspaceBytes"] = plan.workspaceBytes;
+	json["memory"]["historyBytes"] = plan.historyBytes;
+	json["memory"]["assemblyPeakBytes"] = plan.assemblyPeakBytes;
+	json["memory"]["solvePeakBytes"] = plan.solvePeakBytes;
+	json["memory"]["peakBytes"] = plan.getPeakBytes();
+	json["memory"]["peakMB"] = BytesToMiB(plan.getPeakBytes());
+	json["memory"]["ramBytes"] = plan.ramBytes;
+	json["memory"]["fitsInRam"] = plan.fitsInRam();
+
+	if (plan.minimumSaveStride)
+		json["memory"]["minimumSaveStride"] = *plan.minimumSaveStride;
+
+	json["time"]["assemblyMs"] = plan.assemblyMs;
+	json["time"]["setupMsPerSolve"] = plan.setupMsPerSolve;
+	json["time"]["solveMsPerSolve"] = plan.solveMsPerSolve;
+	json["time"]["totalMs"] = plan.getTotalMs();
+
+	json["warnings"] = plan.warnings;
+
+	fileio::FileService writer;
+	auto wr = writer.Write(path, json.dump(2));
+
+	if (!wr)
+		return std::unexpected(
+			std::format("Failed to export run plan: {}", wr.error().message)
+		);
+
+	return {};
+}
+
+} // namespace fem::planner
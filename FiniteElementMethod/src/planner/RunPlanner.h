@@ -0,0 +1,46 @@
+#pragma once
+
+#include "MachineProfile.h"
+#include "RunPlan.h"
+
+#include "config/ProblemConfig.h"
+#include "mesh/model/MeshMetadata.h"
+#include "solver/linear/LinearSolverOptions.h"
+#include "solver/linear/LinearSolverType.h"
+
+#include <expected>
+#include <filesystem>
+#include <string>
+
+namespace fem::planner
+{
+
+namespace fs = std::filesystem;
+
+/// <summary>
+/// Pre-flight estimate of memory and time from mesh counts alone. The pattern of H follows from
+/// the counts of a planar quad mesh, the factor fill from the calibrated n log n coefficient in
+/// place of a symbolic analysis
+/// </summary>
+class RunPlanner
+{
+public:
+	RunPlanner() = delete;
+
+	static RunPlan Estimate(
+		const mesh::model::MeshMetadata& mesh,
+		const config::ProblemConfig& config,
+		solver::linear::LinearSolverType solver,
+		const solver::linear::LinearSolverOptions& options,
+		const MachineProfile& profile,
+		bool lowMemory = false);
+
+	static void Print(const RunPlan& plan);
+
+	static std::expected<void, std::string> ExportJSON(const fs::path& path, const RunPlan& plan);
+
+private:
+	static void CheckHistory(RunPlan& plan);
+};
+
+} // namespace fem::planner
@@ -0,0 +1,6 @@
+#pragma once
+
+#include "CostModel.h"
+#include "MachineProfile.h"
+#include "RunPlan.h"
+#include "RunPlanner.h"
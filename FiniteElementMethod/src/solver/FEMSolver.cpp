@@ -13,7 +13,7 @@ std::expected<FEMSolverResult, SolverError> FEMSolver::Solve(const SpMat& H, con
 	switch (config.problemType)
 	{
 	case Steady:
-		return SolveSteady(H, P, config.linearSolver);
+		return SolveSteady(H, P, config.linearSolver, config.linearSolverOptions);
 
 	case Transient:
 		if (!config.transientConfig)
@@ -25,7 +25,7 @@ std::expected<FEMSolverResult, SolverError> FEMSolver::Solve(const SpMat& H, con
 
 			);
 
-		return SolveTransient(H, C, P, *config.transientConfig, config.linearSolver);
+		return SolveTransient(H, C, P, *config.transientConfig, config.linearSolver, config.linearSolverOptions);
 	}
 
 	return std::unexpected(
@@ -36,7 +36,42 @@ std::expected<FEMSolverResult, SolverError> FEMSolver::Solve(const SpMat& H, con
 	);
 }
 
-std::expected<FEMSolverResult, SolverError> fem::solver::FEMSolver::SolveSteady(const SpMat& H, const Vec& P, linear::LinearSolverType solverType)
+std::expected<FEMSolverResult, SolverError> FEMSolver::Solve(SpMat&& H, SpMat&& C, const Vec& P, const FEMSolverConfig& config)
+{
+	using enum domain::model::ProblemType;
+
+	if (config.problemType == Steady)
+	{
+		SpMat().swap(C);
+		return SolveSteady(H, P, config.linearSolver, config.linearSolverOptions);
+	}
+
+	if (config.problemType == Transient && config.transientConfig)
+	{
+		return SolveTransient(H, C, P, *config.transientConfig, config.linearSolver, config.linearSolverOptions, [&]()
+			{
+				// Assigning an empty matrix keeps the storage, swapping it out releases it
+				SpMat().swap(H);
+				SpMat().swap(C);
+			});
+	}
+
+	return Solve(H, C, P, config);
+}
+
+std::expected<FEMSolverResult, SolverError> FEMSolver::Solve(const SpMatView& H, const SpMatView& C, const VecView& P, const FEMSolverConfig& config)
+{
+	using enum domain::model::ProblemType;
+
+	if (config.problemType == Transient && config.transientConfig)
+	{
+		return SolveTransient(H, C, P, *config.transientConfig, config.linearSolver, config.linearSolverOptions);
+	}
+
+	return Solve(SpMat(H), SpMat(), Vec(P), config);
+}
+
+std::expected<FEMSolverResult, SolverError> fem::solver::FEMSolver::SolveSteady(const SpMat& H, const Vec& P, linear::LinearSolverType solverType, const linear::LinearSolverOptions& solverOptions)
 {
 	LOG_INFO("Solving Steady - State Problem");
 
@@ -56,7 +91,7 @@ std::expected<FEMSolverResult, SolverError> fem::solver::FEMSolver::SolveSteady(
 			}
 		);
 
-	auto linearSolver = linear::LinearSolverFactory::Create(solverType);
+	auto linearSolver = linear::LinearSolverFactory::Create(solverType, solverOptions);
 
 	auto startTime = Now();
 	auto result = linearSolver->Solve(H, P);
@@ -73,7 +108,35 @@ std::expected<FEMSolverResult, SolverError> fem::solver::FEMSolver::SolveSteady(
 	LOG_INFO("Steady Analysis Complete:");
 	LOG_INFO("  Total solver time:  {:.2f} ms", stats.elapsedTimeMs);
 	LOG_INFO("  Factorization time: {:.2f} ms", stats.factorizationTimeMs);
+
+	if (stats.analysisTimeMs > 0.0)
+		LOG_INFO("  Symbolic analysis:  {:.2f} ms{}", stats.analysisTimeMs, stats.reusedOrdering ? " (reused ordering)" : "");
+
+	if (stats.reusedFactorization)
+		LOG_INFO("  Factors reused:     substitution only");
+
+	if (stats.predictedFactorBytes > 0)
+		LOG_INFO("  Factor memory:      {:.2f} MB predicted{}", BytesToMiB(stats.predictedFactorBytes), stats.outOfCore ? " (out-of-core)" : "");
+
 	LOG_INFO("  Solve time:         {:.2f} ms", stats.solveTimeMs);
+
+	if (stats.iterations > 0)
+	{
+		LOG_INFO("  Preconditioner:     {:.2f} ms", stats.preconditionerSetupTimeMs);
+		LOG_INFO("  Iterations:         {}", stats.iterations);
+	}
+
+	if (stats.recycledSubspaceBytes > 0)
+		LOG_INFO("  Recycled subspace:  {} vectors, {:.2f} MB", stats.recycledVectors, BytesToMiB(stats.recycledSubspaceBytes));
+
+	if (stats.refinementIterations > 0 || stats.precisionFallback)
+	{
+		LOG_INFO("  Refinement steps:   {}", stats.refinementIterations);
+
+		if (stats.precisionFallback)
+			LOG_INFO("  Precision fallback: double precision factorization used");
+	}
+
 	LOG_INFO("  Overhead:           {:.2f} ms", totalTime - stats.elapsedTimeMs);
 	LOG_INFO("  Peak memory:        {:.2f} MB", stats.getPeakMemoryMB());
 	LOG_INFO("  Residual norm:      {:.2e}", stats.residualNorm);
@@ -87,7 +150,7 @@ std::expected<FEMSolverResult, SolverError> fem::solver::FEMSolver::SolveSteady(
 	};
 }
 
-std::expected<FEMSolverResult, SolverError> FEMSolver::SolveTransient(const SpMat& H, const SpMat& C, const Vec& P, const domain::model::TransientConfig& config, linear::LinearSolverType solverType)
+std::expected<FEMSolverResult, SolverError> FEMSolver::SolveTransient(const SpMatRef& H, const SpMatRef& C, const VecRef& P, const domain::model::TransientConfig& config, linear::LinearSolverType solverType, const linear::LinearSolverOptions& solverOptions, const std::function<void()>& releaseSystem)
 {
 	LOG_INFO("Solving Transient Problem");
 
@@ -155,13 +218,26 @@ std::expected<FEMSolverResult, SolverError> FEMSolver::SolveTransient(const SpMa
 	if (saveHistory)
 		LOG_INFO("  Save stride:      every {} steps", saveStride);
 
-	auto linearSolver = linear::LinearSolverFactory::Create(solverType);
+	const auto& steadyCriterion = config.steadyStateCriterion;
+
+	if (steadyCriterion)
+		LOG_INFO("  Steady state:     max |dT|/dt < {:.3e} K/s for {} steps", steadyCriterion->tolerance, steadyCriterion->consecutiveSteps);
+
+	auto linearSolver = linear::LinearSolverFactory::Create(solverType, solverOptions);
 	LOG_INFO("  Linear solver:    {}", linearSolver->GetName());
 
 	auto setupStart = Now();
 
-	SpMat A = H + C / dt;
-	Vec T_current = Vec::Constant(H.rows(), config.initialTemperature);
+	SpMat massOverDt = C / dt;
+	SpMat A = H + massOverDt;
+
+	// H and C are not read past this point
+	if (releaseSystem)
+		releaseSystem();
+
+	math::SpmvEngine massProduct(massOverDt, solverOptions.spmvBackend);
+
+	Vec T_current = Vec::Constant(A.rows(), config.initialTemperature);
 
 	auto setupEnd = Now();
 	double setupTime = ElapsedMs(setupStart, setupEnd);
@@ -185,17 +261,35 @@ std::expected<FEMSolverResult, SolverError> FEMSolver::SolveTransient(const SpMa
 
 	double totalSolverTime = 0.0;
 	double totalFactorizationTime = 0.0;
+	double totalAnalysisTime = 0.0;
 	double totalSolveTime = 0.0;
+	double totalPreconditionerTime = 0.0;
+	size_t totalIterations = 0;
+	size_t recycledVectors = 0;
+	size_t recycledSubspaceBytes = 0;
+	size_t totalRefinementIterations = 0;
+	size_t precisionFallbackCount = 0;
+	size_t reusedOrderingCount = 0;
+	size_t predictedFactorBytes = 0;
+	size_t outOfCoreCount = 0;
 	double minResidual = std::numeric_limits<double>::max();
 	double maxResidual = 0.0;
 
-	for (int step = 0; step < numSteps; ++step)
+	size_t stepsPerformed = 0;
+	size_t stepsBelowTolerance = 0;
+	std::optional<SteadyStateStats> steadyState;
+
+	Vec b(A.rows());
+
+	for (size_t step = 0; step < numSteps; ++step)
 	{
 		double currentTime = step * dt;
 
-		Vec b = P + (C / dt) * T_current;
+		massProduct.Multiply(T_current, b);
+		b += P;
 
-		auto result = linearSolver->Solve(A, b);
+		// Warm start from the previous step - consecutive states differ only slightly
+		auto result = linearSolver->SolveWithGuess(A, b, T_current);
 
 		if (!result)
 			return std::unexpected(result.error());
@@ -204,18 +298,54 @@ std::expected<FEMSolverResult, SolverError> FEMSolver::SolveTransient(const SpMa
 
 		totalSolverTime += stats.elapsedTimeMs;
 		totalFactorizationTime += stats.factorizationTimeMs;
+		totalAnalysisTime += stats.analysisTimeMs;
+		reusedOrderingCount += stats.reusedOrdering ? 1 : 0;
+		predictedFactorBytes = std::max(predictedFactorBytes, stats.predictedFactorBytes);
+		outOfCoreCount += stats.outOfCore ? 1 : 0;
 		totalSolveTime += stats.solveTimeMs;
+		totalPreconditionerTime += stats.preconditionerSetupTimeMs;
+		totalIterations += stats.iterations;
+		recycledVectors = stats.recycledVectors;
+		recycledSubspaceBytes = std::max(recycledSubspaceBytes, stats.recycledSubspaceBytes);
+		totalRefinementIterations += stats.refinementIterations;
+		precisionFallbackCount += stats.precisionFallback ? 1 : 0;
 		minResidual = std::min(minResidual, stats.residualNorm);
 		maxResidual = std::max(maxResidual, stats.residualNorm);
 
+		double changeRate = 0.0;
+
+		if (steadyCriterion)
+		{
+			changeRate = (result->solution - T_current).cwiseAbs().maxCoeff() / dt;
+			stepsBelowTolerance = changeRate < steadyCriterion->tolerance ? stepsBelowTolerance + 1 : 0;
+		}
+
 		T_current = std::move(result->solution);
+		stepsPerformed = step + 1;
+
+		bool steadyReached = steadyCriterion && stepsBelowTolerance >= steadyCriterion->consecutiveSteps;
 
-		if (saveHistory && (step % saveStride == 0 || step == numSteps - 1))
+		if (saveHistory && (step % saveStride == 0 || step == numSteps - 1 || steadyReached))
 		{
 			temperatures.push_back(T_current);
 			timeSteps.push_back(currentTime + dt);
 		}
 
+		if (steadyReached)
+		{
+			steadyState = SteadyStateStats{
+				.step = stepsPerformed,
+				.time = currentTime + dt,
+				.changeRate = changeRate,
+				.skippedSteps = numSteps - stepsPerformed
+			};
+
+			LOG_INFO("Steady state reached at t = {:.3f}s (step {}/{}), max |dT|/dt = {:.3e} K/s",
+				currentTime + dt, stepsPerformed, numSteps, changeRate);
+
+			break;
+		}
+
 		if (step == 0 || step % progressStep == 0 || step == numSteps - 1)
 		{
 			double pct = 100.0 * (step + 1) / numSteps;
@@ -225,6 +355,18 @@ std::expected<FEMSolverResult, SolverError> FEMSolver::SolveTransient(const SpMa
 		}
 	}
 
+	if (steadyState && saveHistory && steadyCriterion->fillRemainingHistory)
+	{
+		for (size_t step = stepsPerformed; step < numSteps; ++step)
+		{
+			if (step % saveStride == 0 || step == numSteps - 1)
+			{
+				temperatures.push_back(T_current);
+				timeSteps.push_back((step + 1) * dt);
+			}
+		}
+	}
+
 	auto totalEnd = Now();
 	size_t peakMem = metrics::MemoryMonitor::GetPeakUsage();
 
@@ -232,18 +374,29 @@ std::expected<FEMSolverResult, SolverError> FEMSolver::SolveTransient(const SpMa
 
 	FEMSolverStats stats{
 		.factorizationTimeMs = totalFactorizationTime,
+		.analysisTimeMs = totalAnalysisTime,
 		.solveTimeMs = totalSolveTime,
 		.totalSolverTimeMs = totalSolverTime,
 		.totalTimeMs = totalTime,
 		.setupTimeMs = setupTime,
 		.overheadMs = totalTime - totalSolverTime,
+		.preconditionerSetupTimeMs = totalPreconditionerTime,
 		.peakMemoryBytes = peakMem,
 		.residualNorm = maxResidual,
 		.minResidual = minResidual,
 		.maxResidual = maxResidual,
-		.matrixSize = static_cast<size_t>(H.rows()),
+		.matrixSize = static_cast<size_t>(A.rows()),
 		.matrixNonZeros = static_cast<size_t>(A.nonZeros()),
-		.linearSolveCount = numSteps
+		.linearSolveCount = stepsPerformed,
+		.totalIterations = totalIterations,
+		.recycledVectors = recycledVectors,
+		.recycledSubspaceBytes = recycledSubspaceBytes,
+		.totalRefinementIterations = totalRefinementIterations,
+		.precisionFallbackCount = precisionFallbackCount,
+		.reusedOrderingCount = reusedOrderingCount,
+		.predictedFactorBytes = predictedFactorBytes,
+		.outOfCoreCount = outOfCoreCount,
+		.steadyState = steadyState
 	};
 
 	LOG_INFO("Transient Analysis Complete:");
@@ -251,12 +404,38 @@ std::expected<FEMSolverResult, SolverError> FEMSolver::SolveTransient(const SpMa
 	LOG_INFO("  Total solver time:  {:.2f} ms", stats.totalSolverTimeMs);
 	LOG_INFO("  Loop overhead:      {:.2f} ms ({:.1f}%)", stats.overheadMs, stats.getOverheadPercent());
 	LOG_INFO("  Avg factorization:  {:.2f} ms/step", stats.getAvgFactorizationMs());
+
+	if (stats.analysisTimeMs > 0.0)
+		LOG_INFO("  Symbolic analysis:  {:.2f} ms total, ordering reused in {} steps", stats.analysisTimeMs, stats.reusedOrderingCount);
+
+	if (stats.predictedFactorBytes > 0)
+		LOG_INFO("  Factor memory:      {:.2f} MB predicted, out-of-core in {} steps", BytesToMiB(stats.predictedFactorBytes), stats.outOfCoreCount);
+
 	LOG_INFO("  Avg solve:          {:.2f} ms/step", stats.getAvgSolveMs());
 	LOG_INFO("  Avg per step:       {:.2f} ms", stats.getAvgPerStepMs());
+
+	if (stats.totalIterations > 0)
+	{
+		LOG_INFO("  Preconditioner:     {:.2f} ms", stats.preconditionerSetupTimeMs);
+		LOG_INFO("  Avg iterations:     {:.1f} /step", stats.getAvgIterations());
+	}
+
+	if (stats.recycledSubspaceBytes > 0)
+		LOG_INFO("  Recycled subspace:  {} vectors, {:.2f} MB", stats.recycledVectors, BytesToMiB(stats.recycledSubspaceBytes));
+
+	if (stats.totalRefinementIterations > 0 || stats.precisionFallbackCount > 0)
+	{
+		LOG_INFO("  Avg refinement:     {:.1f} /step", stats.getAvgRefinementIterations());
+		LOG_INFO("  Precision fallback: {} steps", stats.precisionFallbackCount);
+	}
+
 	LOG_INFO("  Peak memory:        {:.2f} MB", stats.getPeakMemoryMB());
 	LOG_INFO("  Residual range:     [{:.2e}, {:.2e}]", stats.minResidual, stats.maxResidual);
 	LOG_INFO("  Final temperature:  T_min = {:.2f} K, T_max = {:.2f} K", T_current.minCoeff(), T_current.maxCoeff());  // TODO: Kelvin or else?
 
+	if (steadyState)
+		LOG_INFO("  Steady state:       t = {:.3f} s, {} steps skipped", steadyState->time, steadyState->skippedSteps);
+
 	if (saveHistory)
 		LOG_INFO("  History saved:      {} snapshots", temperatures.size());
 
@@ -8,6 +8,8 @@
 #include "linear/linear.h"
 #include "math/math.h"
 
+#include <functional>
+
 // TODO: Add FEMSolver Error with more information
 namespace fem::solver
 {
@@ -18,9 +20,21 @@ class FEMSolver
 public:
 	static std::expected<FEMSolverResult, SolverError> Solve(const SpMat& H, const SpMat& C, const Vec& P, const FEMSolverConfig& config);
 
+	/// <summary>
+	/// Takes ownership of H and C and frees them as soon as the system matrix is formed:
+	/// C before a steady solve, both once A = H + C/dt and C/dt exist in a transient one
+	/// </summary>
+	static std::expected<FEMSolverResult, SolverError> Solve(SpMat&& H, SpMat&& C, const Vec& P, const FEMSolverConfig& config);
+
+	/// <summary>
+	/// Solves a system that lives in memory-mapped cache files. A transient solve reads H and C in place to form
+	/// A = H + C/dt, a steady one copies H once since the linear solvers factorize an owning matrix
+	/// </summary>
+	static std::expected<FEMSolverResult, SolverError> Solve(const SpMatView& H, const SpMatView& C, const VecView& P, const FEMSolverConfig& config);
+
 private:
-	static std::expected<FEMSolverResult, SolverError> SolveSteady(const SpMat& H, const Vec& P, linear::LinearSolverType solverType);
-	static std::expected<FEMSolverResult, SolverError> SolveTransient(const SpMat& H, const SpMat& C, const Vec& P, const domain::model::TransientConfig& config, linear::LinearSolverType solverType);
+	static std::expected<FEMSolverResult, SolverError> SolveSteady(const SpMat& H, const Vec& P, linear::LinearSolverType solverType, const linear::LinearSolverOptions& solverOptions);
+	static std::expected<FEMSolverResult, SolverError> SolveTransient(const SpMatRef& H, const SpMatRef& C, const VecRef& P, const domain::model::TransientConfig& config, linear::LinearSolverType solverType, const linear::LinearSolverOptions& solverOptions, const std::function<void()>& releaseSystem = {});
 };
 
 } // namespace fem::solver
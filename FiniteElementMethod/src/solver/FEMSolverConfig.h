@@ -13,6 +13,7 @@ struct FEMSolverConfig
 	domain::model::ProblemType problemType;
 
 	linear::LinearSolverType linearSolver;
+	linear::LinearSolverOptions linearSolverOptions;
 
 	std::optional<domain::model::TransientConfig> transientConfig;
 };
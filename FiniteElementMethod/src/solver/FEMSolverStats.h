@@ -5,18 +5,29 @@
 #include "utils/utils.h"
 
 #include <limits>
+#include <optional>
 
 namespace fem::solver
 {
 
+struct SteadyStateStats
+{
+	size_t step = 0;           // Step at which the criterion was satisfied
+	double time = 0.0;         // Simulated time at which the loop stopped [s]
+	double changeRate = 0.0;   // max |dT|/dt at the stopping step [K/s]
+	size_t skippedSteps = 0;   // Steps not computed thanks to early termination
+};
+
 struct FEMSolverStats
 {
 	double factorizationTimeMs = 0.0;
+	double analysisTimeMs = 0.0; // Direct solvers only, part of factorizationTimeMs
 	double solveTimeMs = 0.0;
 	double totalSolverTimeMs = 0.0;
 	double totalTimeMs = 0.0;
 	double setupTimeMs = 0.0;
 	double overheadMs = 0.0;
+	double preconditionerSetupTimeMs = 0.0;
 
 	size_t peakMemoryBytes = 0;
 
@@ -27,6 +38,16 @@ struct FEMSolverStats
 	size_t matrixSize = 0;
 	size_t matrixNonZeros = 0;
 	size_t linearSolveCount = 1;
+	size_t totalIterations = 0; // Iterative solvers only
+	size_t recycledVectors = 0; // Deflated PCG only
+	size_t recycledSubspaceBytes = 0;
+	size_t totalRefinementIterations = 0; // Mixed precision solvers only
+	size_t precisionFallbackCount = 0;
+	size_t reusedOrderingCount = 0; // Direct solves that skipped the fill-reducing ordering
+	size_t predictedFactorBytes = 0; // Direct solvers only - largest analysis estimate
+	size_t outOfCoreCount = 0;       // Pardiso factorizations that ran out-of-core
+
+	std::optional<SteadyStateStats> steadyState;
 
 	double getPeakMemoryMB() const
 	{
@@ -51,6 +72,18 @@ struct FEMSolverStats
 		return solveTimeMs / linearSolveCount;
 	}
 
+	double getAvgIterations() const
+	{
+		if (linearSolveCount == 0) return 0.0;
+		return static_cast<double>(totalIterations) / linearSolveCount;
+	}
+
+	double getAvgRefinementIterations() const
+	{
+		if (linearSolveCount == 0) return 0.0;
+		return static_cast<double>(totalRefinementIterations) / linearSolveCount;
+	}
+
 	double getAvgPerStepMs() const
 	{
 		if (linearSolveCount == 0) return 0.0;
@@ -61,18 +94,28 @@ struct FEMSolverStats
 	{
 		return FEMSolverStats{
 			.factorizationTimeMs = linearStats.factorizationTimeMs,
+			.analysisTimeMs = linearStats.analysisTimeMs,
 			.solveTimeMs = linearStats.solveTimeMs,
 			.totalSolverTimeMs = linearStats.elapsedTimeMs,
 			.totalTimeMs = totalTimeMs,
 			.setupTimeMs = 0.0,
 			.overheadMs = totalTimeMs - linearStats.elapsedTimeMs,
+			.preconditionerSetupTimeMs = linearStats.preconditionerSetupTimeMs,
 			.peakMemoryBytes = linearStats.peakMemoryBytes,
 			.residualNorm = linearStats.residualNorm,
 			.minResidual = linearStats.residualNorm,
 			.maxResidual = linearStats.residualNorm,
 			.matrixSize = linearStats.matrixSize,
 			.matrixNonZeros = linearStats.matrixNonZeros,
-			.linearSolveCount = 1
+			.linearSolveCount = 1,
+			.totalIterations = linearStats.iterations,
+			.recycledVectors = linearStats.recycledVectors,
+			.recycledSubspaceBytes = linearStats.recycledSubspaceBytes,
+			.totalRefinementIterations = linearStats.refinementIterations,
+			.precisionFallbackCount = linearStats.precisionFallback ? 1u : 0u,
+			.reusedOrderingCount = linearStats.reusedOrdering ? 1u : 0u,
+			.predictedFactorBytes = linearStats.predictedFactorBytes,
+			.outOfCoreCount = linearStats.outOfCore ? 1u : 0u
 		};
 	}
 };
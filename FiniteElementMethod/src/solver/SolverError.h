@@ -10,6 +10,8 @@ enum class SolverErrorCode : int
 	SingularMatrix = 0,
 	NumericalInstability,
 	InvalidInput,
+	OutOfMemory,
+	TimeLimitExceeded,
 	Unknown,
 };
 
@@ -32,6 +34,12 @@ struct SolverError
 		case SolverErrorCode::InvalidInput:
 			msg += "Invalid input";
 			break;
+		case SolverErrorCode::OutOfMemory:
+			msg += "Out of memory";
+			break;
+		case SolverErrorCode::TimeLimitExceeded:
+			msg += "Time limit exceeded";
+			break;
 		case SolverErrorCode::Unknown:
 			msg += "Unknown error";
 			break;
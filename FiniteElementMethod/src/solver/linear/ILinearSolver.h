@@ -17,6 +17,14 @@ public:
 
 	virtual std::expected<LinearSolverResult, SolverError> Solve(const SpMat& A, const Vec& b) = 0;
 
+	/// <summary>
+	/// Solve starting from the initial guess x0. Direct solvers ignore the guess
+	/// </summary>
+	virtual std::expected<LinearSolverResult, SolverError> SolveWithGuess(const SpMat& A, const Vec& b, [[maybe_unused]] const Vec& x0)
+	{
+		return Solve(A, b);
+	}
+
 	virtual std::string GetName() const = 0;
 };
 
@@ -3,7 +3,12 @@
 #include "LinearSolverType.h"
 
 #include "cholesky/CholeskyLDLTSolver.h"
+#include "cholesky/CholeskyLLTSolver.h"
 #include "lu/SparseLUSolver.h"
+#include "mixed/MixedPrecisionLDLTSolver.h"
+#include "multigrid/MultigridSolver.h"
+#include "pcg/ConjugateGradientSolver.h"
+#include "pcg/DeflatedConjugateGradientSolver.h"
 #include "qr/SparseQRSolver.h"
 
 #include "logger/logger.h"
@@ -11,14 +16,20 @@
 namespace fem::solver::linear
 {
 
-std::unique_ptr<ILinearSolver> LinearSolverFactory::Create(LinearSolverType type)
+std::unique_ptr<ILinearSolver> LinearSolverFactory::Create(LinearSolverType type, const LinearSolverOptions& options)
 {
 	using enum LinearSolverType;
 
 	switch (type)
 	{
 	case SimplicialLDLT:
-		return std::make_unique<CholeskyLDLTSolver>();
+		return std::make_unique<CholeskyLDLTSolver>(options);
+
+	case SimplicialLLT:
+		return std::make_unique<CholeskyLLTSolver>(options);
+
+	case MixedPrecisionLDLT:
+		return std::make_unique<MixedPrecisionLDLTSolver>(options);
 
 	case SparseLU:
 		return std::make_unique<SparseLUSolver>();
@@ -26,6 +37,18 @@ std::unique_ptr<ILinearSolver> LinearSolverFactory::Create(LinearSolverType type
 	case SparseQR:
 		return std::make_unique<SparseQRSolver>();
 
+	case ConjugateGradient:
+		return std::make_unique<ConjugateGradientSolver>(options);
+
+	case DeflatedConjugateGradient:
+		return std::make_unique<DeflatedConjugateGradientSolver>(options);
+
+	case AlgebraicMultigrid:
+		return std::make_unique<MultigridSolver>(options, CoarseningType::SmoothedAggregation);
+
+	case GeometricMultigrid:
+		return std::make_unique<MultigridSolver>(options, CoarseningType::Geometric);
+
 	default:
 		LOG_ERROR("Unknown solver type: {}", LinearSolverTypeToString(type));
 		std::unreachable();
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ILinearSolver.h"
+#include "LinearSolverOptions.h"
 #include "LinearSolverType.h"
 
 #include <memory>
@@ -15,9 +16,9 @@ class LinearSolverFactory
 {
 public:
 	/// <summary>
-	/// Create solver based on type
+	/// Create solver based on type. Options are forwarded to iterative solvers
 	/// </summary>
-	static std::unique_ptr<ILinearSolver> Create(LinearSolverType type);
+	static std::unique_ptr<ILinearSolver> Create(LinearSolverType type, const LinearSolverOptions& options = {});
 };
 
 } // namespace fem::solver::linear
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "OrderingType.h"
+
+#include "cholesky/CholeskyFactor.h"
+#include "cholesky/SymbolicAnalysis.h"
+#include "multigrid/SmootherType.h"
+#include "preconditioner/PreconditionerType.h"
+
+#include "math/spmv/SpmvBackend.h"
+#include "mesh/model/StructuredGrid.h"
+#include "mesh/partition/MeshPartition.h"
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+
+namespace fem::solver::linear
+{
+
+/// <summary>
+/// Tuning knobs for iterative solvers. Direct solvers only read the ordering; the SpMV backend
+/// also drives the transient right-hand side
+/// </summary>
+struct LinearSolverOptions
+{
+	PreconditionerType preconditioner = PreconditionerType::Jacobi;
+
+	double tolerance = 1e-10;      // Relative residual ||b - Ax|| / ||b|| required to stop
+	std::size_t maxIterations = 0; // 0 = matrix size
+	double timeLimitMs = 0.0;      // 0 = unlimited, iterative solvers give up once a solve runs longer
+	double ssorOmega = 1.0;        // Relaxation factor, must be in (0, 2)
+
+	OrderingType ordering = OrderingType::Default; // Cholesky solvers only
+
+	// Cholesky solvers only - fill-reducing permutation reused across solves and runs
+	std::shared_ptr<SymbolicAnalysisCache> symbolicAnalysis;
+
+	// Sequential Cholesky solvers only - numeric factors of the matrix, exported or reused
+	std::shared_ptr<CholeskyFactorCache> factor;
+
+	// Cholesky solvers only - a predicted factorization above the budget runs Pardiso out-of-core
+	std::size_t memoryBudgetMb = 0;           // 0 = unlimited
+	std::filesystem::path outOfCoreDirectory; // Pardiso scratch files, working directory when empty
+	std::size_t factorLimitBytes = 0;         // 0 = none, a predicted factorization above it fails instead of running out-of-core
+
+	math::SpmvBackend spmvBackend = math::SpmvBackend::Auto; // Repeated products (Krylov iterations, transient right-hand sides)
+
+	// Deflated PCG
+	std::size_t recycleSize = 8; // Approximate eigenvectors carried between solves, each costs up to 8 vectors of matrix size
+
+	// Mixed precision
+	std::size_t maxRefinementIterations = 10; // Refinement steps before falling back to a double precision factorization
+
+	// Multigrid
+	SmootherType smoother = SmootherType::Chebyshev;
+	std::size_t smootherSweeps = 2;    // Jacobi sweeps or Chebyshev degree, applied before and after coarse correction
+	double strengthThreshold = 0.08;   // |a_ij| >= theta * sqrt(|a_ii * a_jj|) marks a strong connection
+	std::size_t coarsestSize = 1000;   // Stop coarsening below this many unknowns and factorize directly
+	std::size_t maxLevels = 20;
+
+	// Domain decomposition (Schwarz preconditioner)
+	std::size_t subdomains = 0; // 0 = one per OpenMP thread, at least 2
+	std::size_t overlap = 1;    // Layers of matrix neighbours added around each subdomain
+
+	// Node partition of the mesh (matrix row = local node index), contiguous row blocks when absent
+	std::shared_ptr<const mesh::partition::MeshPartition> partition;
+
+	// Geometric multigrid only - tensor-product layout of the mesh nodes (matrix row = local node index)
+	std::shared_ptr<const mesh::model::StructuredGrid> structuredGrid;
+};
+
+} // namespace fem::solver::linear
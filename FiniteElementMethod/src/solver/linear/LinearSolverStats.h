@@ -9,7 +9,21 @@ struct LinearSolverStats
 {
 	double elapsedTimeMs = 0.0;
 	double factorizationTimeMs = 0.0;
+	double analysisTimeMs = 0.0;            // Direct solvers only - ordering and symbolic factorization, part of factorizationTimeMs
+	bool reusedOrdering = false;            // Direct solvers only - analysis started from a known permutation
+	bool reusedFactorization = false;       // Direct solvers only - substitution with stored factors, nothing factorized
+	size_t predictedFactorBytes = 0;        // Direct solvers only - factorization memory estimated by the analysis
+	bool outOfCore = false;                 // Pardiso only - factors kept in scratch files instead of RAM
 	double solveTimeMs = 0.0;
+	double preconditionerSetupTimeMs = 0.0; // Iterative solvers only, 0 when the preconditioner was reused
+
+	size_t iterations = 0; // Iterative solvers only
+
+	size_t recycledVectors = 0;       // Deflated PCG only - subspace size after the solve
+	size_t recycledSubspaceBytes = 0; // Deflated PCG only - subspace and harvest buffers
+
+	size_t refinementIterations = 0; // Mixed precision only - double precision correction steps
+	bool precisionFallback = false;  // Mixed precision only - single precision did not converge, solved in double
 
 	double residualNorm = 0.0;
 
@@ -14,6 +14,12 @@ enum class LinearSolverType : int
 	SimplicialLDLT = 0,
 	SparseLU,
 	SparseQR,
+	ConjugateGradient,
+	DeflatedConjugateGradient,
+	AlgebraicMultigrid,
+	GeometricMultigrid,
+	MixedPrecisionLDLT,
+	SimplicialLLT,
 };
 
 struct LinearSolverInfo
@@ -23,10 +29,16 @@ struct LinearSolverInfo
 	std::string description;
 };
 
-inline static const std::array<LinearSolverInfo, 3> LINEAR_SOLVERS = { {
-	{ LinearSolverType::SimplicialLDLT, "cholesky", "Cholesky decomposition (fastest for SPD)" },
-	{ LinearSolverType::SparseLU,       "lu",       "LU decomposition (general purpose)" },
-	{ LinearSolverType::SparseQR,       "qr",       "QR decomposition (most stable)" }
+inline static const std::array<LinearSolverInfo, 9> LINEAR_SOLVERS = { {
+	{ LinearSolverType::SimplicialLDLT,            "cholesky",       "Cholesky decomposition (fastest for SPD)" },
+	{ LinearSolverType::SimplicialLLT,             "cholesky-llt",   "Cholesky LL^T decomposition without the diagonal factor (SPD)" },
+	{ LinearSolverType::MixedPrecisionLDLT,        "cholesky-mixed", "Single precision Cholesky with double precision refinement (SPD)" },
+	{ LinearSolverType::SparseLU,                  "lu",             "LU decomposition (general purpose)" },
+	{ LinearSolverType::SparseQR,                  "qr",             "QR decomposition (most stable)" },
+	{ LinearSolverType::ConjugateGradient,         "pcg",            "Preconditioned conjugate gradient (SPD, low memory)" },
+	{ LinearSolverType::DeflatedConjugateGradient, "dpcg",           "Deflated PCG recycling slow eigenmodes between solves (SPD, transient)" },
+	{ LinearSolverType::AlgebraicMultigrid,        "amg",            "Smoothed-aggregation algebraic multigrid (SPD, very large meshes)" },
+	{ LinearSolverType::GeometricMultigrid,        "gmg",            "Geometric multigrid (structured quad meshes only)" }
 } };
 
 inline std::optional<LinearSolverType> ParseSolverType(std::string_view str)
@@ -34,8 +46,14 @@ inline std::optional<LinearSolverType> ParseSolverType(std::string_view str)
 	using enum LinearSolverType;
 
 	if (str == "cholesky") return SimplicialLDLT;
+	else if (str == "cholesky-llt") return SimplicialLLT;
+	else if (str == "cholesky-mixed") return MixedPrecisionLDLT;
 	else if (str == "lu") return SparseLU;
 	else if (str == "qr") return SparseQR;
+	else if (str == "pcg") return ConjugateGradient;
+	else if (str == "dpcg") return DeflatedConjugateGradient;
+	else if (str == "amg") return AlgebraicMultigrid;
+	else if (str == "gmg") return GeometricMultigrid;
 
 	return std::nullopt;
 }
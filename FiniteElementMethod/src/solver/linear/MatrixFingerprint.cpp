@@ -0,0 +1,72 @@
+#include "MatrixFingerprint.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include <xxhash.h>
+
+namespace fem::solver::linear
+{
+
+namespace
+{
+
+constexpr size_t SEGMENT_BYTES = 4 * 1024 * 1024;
+
+/// <summary>
+/// XXH3 of fixed-size segments hashed on all threads, combined with the length
+/// </summary>
+uint64_t HashArray(const void* data, size_t bytes)
+{
+	if (data == nullptr || bytes == 0)
+		return 0;
+
+	const auto* begin = static_cast<const std::byte*>(data);
+	const std::ptrdiff_t segments = static_cast<std::ptrdiff_t>((bytes + SEGMENT_BYTES - 1) / SEGMENT_BYTES);
+
+	std::vector<uint64_t> digests(segments + 1);
+	digests[segments] = bytes;
+
+#pragma omp parallel for schedule(static)
+	for (std::ptrdiff_t i = 0; i < segments; ++i)
+	{
+		const size_t offset = static_cast<size_t>(i) * SEGMENT_BYTES;
+		digests[i] = XXH3_64bits(begin + offset, std::min(SEGMENT_BYTES, bytes - offset));
+	}
+
+	return XXH3_64bits(digests.data(), digests.size() * sizeof(uint64_t));
+}
+
+}
+
+MatrixFingerprint MatrixFingerprint::Of(const SpMat& A)
+{
+	using StorageIndex = SpMat::StorageIndex;
+
+	const size_t outerSize = static_cast<size_t>(A.outerSize());
+	const size_t entries = static_cast<size_t>(A.outerIndexPtr()[outerSize]);
+
+	// Uncompressed matrices may hash the gaps between columns too, which can only cause a rebuild
+	const std::array<uint64_t, 5> parts{
+		HashArray(A.outerIndexPtr(), (outerSize + 1) * sizeof(StorageIndex)),
+		HashArray(A.innerNonZeroPtr(), A.isCompressed() ? 0 : outerSize * sizeof(StorageIndex)),
+		HashArray(A.innerIndexPtr(), entries * sizeof(StorageIndex)),
+		HashArray(A.valuePtr(), entries * sizeof(double)),
+		static_cast<uint64_t>(A.rows())
+	};
+
+	return MatrixFingerprint{
+		.valid = true,
+		.rows = A.rows(),
+		.cols = A.cols(),
+		.nonZeros = A.nonZeros(),
+		.contentHash = XXH3_64bits(parts.data(), parts.size() * sizeof(uint64_t)),
+		.outer = reinterpret_cast<std::uintptr_t>(A.outerIndexPtr()),
+		.inner = reinterpret_cast<std::uintptr_t>(A.innerIndexPtr()),
+		.values = reinterpret_cast<std::uintptr_t>(A.valuePtr())
+	};
+}
+
+} // namespace fem::solver::linear
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "math/math.h"
+
+#include <cstdint>
+
+namespace fem::solver::linear
+{
+
+/// <summary>
+/// Identity of a sparse matrix used to decide whether setup work (preconditioners, multigrid
+/// hierarchies, SpMV kernels) built for one matrix can be reused for the next solve. The content
+/// hash covers the pattern and the values, so a matrix modified in place is never mistaken for the old one
+/// </summary>
+struct MatrixFingerprint
+{
+	bool valid = false;
+	Eigen::Index rows = 0;
+	Eigen::Index cols = 0;
+	Eigen::Index nonZeros = 0;
+	uint64_t contentHash = 0;
+
+	// Addresses of the arrays the hash was taken from, compared but never dereferenced
+	std::uintptr_t outer = 0;
+	std::uintptr_t inner = 0;
+	std::uintptr_t values = 0;
+
+	/// <summary>
+	/// Hashes the compressed arrays in parallel segments, a pass over the matrix comparable to one product
+	/// </summary>
+	static MatrixFingerprint Of(const SpMat& A);
+
+	/// <summary>
+	/// Same pattern and values, wherever they are stored. Enough to reuse a preconditioner
+	/// </summary>
+	bool SameContent(const MatrixFingerprint& other) const
+	{
+		return valid && other.valid
+			&& rows == other.rows
+			&& cols == other.cols
+			&& nonZeros == other.nonZeros
+			&& contentHash == other.contentHash;
+	}
+
+	/// <summary>
+	/// Same content in the same arrays. Required to reuse an SpMV kernel, which may read the arrays in place
+	/// </summary>
+	bool SameStorage(const MatrixFingerprint& other) const
+	{
+		return SameContent(other)
+			&& outer == other.outer
+			&& inner == other.inner
+			&& values == other.values;
+	}
+};
+
+} // namespace fem::solver::linear
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "config/CompileConfig.h"
+
+#include <array>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace fem::solver::linear
+{
+
+/// <summary>
+/// Fill-reducing ordering of the Cholesky solvers. Pardiso picks it at run time (iparm[1]), the
+/// sequential build instantiates the matching Eigen ordering
+/// </summary>
+enum class OrderingType : int
+{
+	Default = 0,
+	MinimumDegree,
+	Metis,
+	ParallelMetis,
+	Colamd,
+	Natural,
+};
+
+struct OrderingInfo
+{
+	OrderingType type;
+	std::string name;
+	std::string description;
+};
+
+inline static const std::array<OrderingInfo, 6> ORDERINGS = { {
+	{ OrderingType::Default,       "default",        "Compile-time configuration (see CompileConfig.h)" },
+	{ OrderingType::MinimumDegree, "amd",            "Approximate minimum degree" },
+	{ OrderingType::Metis,         "metis",          "METIS nested dissection (Pardiso only)" },
+	{ OrderingType::ParallelMetis, "metis-parallel", "OpenMP nested dissection (Pardiso only)" },
+	{ OrderingType::Colamd,        "colamd",         "Column approximate minimum degree (sequential solver only)" },
+	{ OrderingType::Natural,       "natural",        "No reordering (sequential solver only)" }
+} };
+
+inline std::optional<OrderingType> ParseOrderingType(std::string_view str)
+{
+	using enum OrderingType;
+
+	if (str == "default") return Default;
+	else if (str == "amd") return MinimumDegree;
+	else if (str == "metis") return Metis;
+	else if (str == "metis-parallel") return ParallelMetis;
+	else if (str == "colamd") return Colamd;
+	else if (str == "natural") return Natural;
+
+	return std::nullopt;
+}
+
+inline std::string_view OrderingTypeToString(OrderingType type)
+{
+	for (const auto& info : ORDERINGS)
+		if (info.type == type)
+			return info.name;
+
+	std::unreachable();
+}
+
+/// <summary>
+/// Whether the Cholesky solvers compiled in can use this ordering
+/// </summary>
+constexpr bool IsOrderingAvailable(OrderingType type)
+{
+	using enum OrderingType;
+
+	switch (type)
+	{
+	case Default:
+	case MinimumDegree:
+		return true;
+
+	case Metis:
+	case ParallelMetis:
+		return !config::UseSequentialSolver;
+
+	case Colamd:
+	case Natural:
+		return config::UseSequentialSolver;
+	}
+
+	return false;
+}
+
+} // namespace fem::solver::linear
@@ -0,0 +1,66 @@
+#include "AutotuneCache.h"
+
+#include "cache/JsonFile.h"
+#include "logger/logger.h"
+
+#include <filesystem>
+
+#include <nlohmann/json.hpp>
+
+namespace fem::solver::linear
+{
+
+namespace fs = std::filesystem;
+
+std::optional<SolverCandidate> AutotuneCache::Load(const std::string& cacheRoot, const std::string& key)
+{
+	auto decisions = cache::JsonFile::Read(GetFilePath(cacheRoot));
+
+	auto it = decisions.find(key);
+	if (it == decisions.end())
+		return std::nullopt;
+
+	try
+	{
+		auto solver = ParseSolverType(it->at("solver").get<std::string>());
+		auto preconditioner = ParsePreconditionerType(it->at("preconditioner").get<std::string>());
+		auto ordering = ParseOrderingType(it->at("ordering").get<std::string>());
+
+		if (!solver || !preconditioner || !ordering)
+			return std::nullopt;
+
+		return SolverCandidate{ *solver, *preconditioner, *ordering };
+	}
+	catch (const nlohmann::json::exception& e)
+	{
+		LOG_WARN("Ignoring malformed autotune entry {}: {}", key, e.what());
+		return std::nullopt;
+	}
+}
+
+bool AutotuneCache::Save(const std::string& cacheRoot, const std::string& key, const SolverCandidate& candidate, double estimatedMs)
+{
+	return cache::JsonFile::Update(GetFilePath(cacheRoot), [&](nlohmann::json& decisions)
+		{
+			decisions[key] = {
+				{ "solver",         LinearSolverTypeToString(candidate.solver) },
+				{ "preconditioner", PreconditionerTypeToString(candidate.preconditioner) },
+				{ "ordering",       OrderingTypeToString(candidate.ordering) },
+				{ "estimated_ms",   estimatedMs }
+			};
+		});
+}
+
+bool AutotuneCache::Clear(const std::string& cacheRoot)
+{
+	std::error_code ec;
+	fs::remove(GetFilePath(cacheRoot), ec);
+	return !ec;
+}
+
+std::string AutotuneCache::GetFilePath(const std::string& cacheRoot)
+{
+	return cacheRoot + "/autotune.json";
+}
+
+} // namespace fem::solver::linear
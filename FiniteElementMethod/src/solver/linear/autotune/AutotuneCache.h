@@ -0,0 +1,30 @@
+#pragma once
+
+#include "SolverCandidate.h"
+
+#include <optional>
+#include <string>
+
+namespace fem::solver::linear
+{
+
+/// <summary>
+/// Autotuner decisions persisted in one JSON file under the cache root, keyed by sparsity
+/// pattern. Values do not matter for the choice, so a re-run with a different material still hits
+/// </summary>
+class AutotuneCache
+{
+public:
+	AutotuneCache() = delete;
+
+	static std::optional<SolverCandidate> Load(const std::string& cacheRoot, const std::string& key);
+
+	static bool Save(const std::string& cacheRoot, const std::string& key, const SolverCandidate& candidate, double estimatedMs);
+
+	static bool Clear(const std::string& cacheRoot);
+
+private:
+	static std::string GetFilePath(const std::string& cacheRoot);
+};
+
+} // namespace fem::solver::linear
@@ -0,0 +1,248 @@
+#include "SolverAutotuner.h"
+
+#include "AutotuneCache.h"
+
+#include "../LinearSolverFactory.h"
+
+#include "config/CompileConfig.h"
+#include "logger/logger.h"
+#include "utils/utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <limits>
+
+namespace fem::solver::linear
+{
+
+namespace
+{
+
+// A candidate must reach this multiple of the requested tolerance to count as a solution
+constexpr double ResidualSlack = 100.0;
+
+// Factorization time grows faster than the factor size, a Cholesky candidate predicted at this multiple of
+// the best estimate by the cheapest factor byte seen so far cannot win
+constexpr double FactorSlack = 2.0;
+
+double RelativeResidual(const SpMat& A, const Vec& x, const Vec& b)
+{
+	const double bNorm = b.norm();
+	return (b - A * x).norm() / (bNorm > 0.0 ? bNorm : 1.0);
+}
+
+}
+
+std::vector<SolverCandidate> SolverAutotuner::GetCandidates(const LinearSolverOptions& options, std::size_t expectedSolves)
+{
+	using enum LinearSolverType;
+	using enum PreconditionerType;
+
+	std::vector<SolverCandidate> candidates;
+
+	// Default aliases one of the explicit orderings, and the natural ordering fills in far beyond any
+	// other on a mesh - it could run out of memory before any limit applies
+	for (auto solver : { SimplicialLDLT, SimplicialLLT })
+		for (const auto& info : ORDERINGS)
+			if (info.type != OrderingType::Default && info.type != OrderingType::Natural && IsOrderingAvailable(info.type))
+				candidates.push_back({ .solver = solver, .ordering = info.type });
+
+	candidates.push_back({ .solver = MixedPrecisionLDLT });
+
+	std::vector<PreconditionerType> preconditioners = { Jacobi, SSOR, IncompleteCholesky, AMG, Schwarz };
+
+	if (options.structuredGrid)
+		preconditioners.push_back(GMG);
+
+	for (auto preconditioner : preconditioners)
+		candidates.push_back({ .solver = ConjugateGradient, .preconditioner = preconditioner });
+
+	// Recycling only pays off over a sequence of solves
+	if (expectedSolves > 1)
+		for (auto preconditioner : preconditioners)
+			candidates.push_back({ .solver = DeflatedConjugateGradient, .preconditioner = preconditioner });
+
+	candidates.push_back({ .solver = AlgebraicMultigrid });
+
+	if (options.structuredGrid)
+		candidates.push_back({ .solver = GeometricMultigrid });
+
+	return candidates;
+}
+
+std::expected<AutotuneResult, SolverError> SolverAutotuner::Tune(const SpMat& A, const Vec& b, const LinearSolverOptions& options, std::size_t expectedSolves)
+{
+	expectedSolves = std::max<std::size_t>(1, expectedSolves);
+
+	auto candidates = GetCandidates(options, expectedSolves);
+
+	LOG_INFO("Autotuning {} candidates on {}x{} matrix ({} nnz), {} expected solve(s)", candidates.size(), A.rows(), A.cols(), A.nonZeros(), expectedSolves);
+
+	AutotuneResult result;
+	result.estimatedMs = std::numeric_limits<double>::infinity();
+	result.trials.reserve(candidates.size());
+
+	double msPerFactorByte = std::numeric_limits<double>::infinity();
+
+	for (const auto& candidate : candidates)
+	{
+		auto trial = RunTrial(candidate, A, b, options, expectedSolves, result.estimatedMs, msPerFactorByte);
+
+		if (trial.succeeded && trial.factorBytes > 0)
+			msPerFactorByte = std::min(msPerFactorByte, trial.firstMs / static_cast<double>(trial.factorBytes));
+
+		if (trial.succeeded && trial.estimatedMs < result.estimatedMs)
+		{
+			result.best = candidate;
+			result.estimatedMs = trial.estimatedMs;
+		}
+
+		result.trials.push_back(std::move(trial));
+	}
+
+	LOG_INFO("  {:<24} {:>12} {:>12} {:>14}", "Candidate", "First [ms]", "Repeat [ms]", "Estimate [ms]");
+
+	for (const auto& trial : result.trials)
+	{
+		if (trial.pruned)
+			LOG_INFO("  {:<24} {:>12.2f} {:>12} {:>14}", trial.candidate.ToString(), trial.firstMs, "-", "pruned");
+		else if (!trial.succeeded)
+			LOG_INFO("  {:<24} failed: {}", trial.candidate.ToString(), trial.error);
+		else
+			LOG_INFO("  {:<24} {:>12.2f} {:>12.2f} {:>14.2f}", trial.candidate.ToString(), trial.firstMs, trial.repeatMs, trial.estimatedMs);
+	}
+
+	if (!std::isfinite(result.estimatedMs))
+	{
+		return std::unexpected(
+			SolverError{
+				SolverErrorCode::NumericalInstability,
+				"Autotuner: no candidate solved the system"
+			}
+		);
+	}
+
+	LOG_INFO("Autotuner selected {} (estimated {:.2f} ms)", result.best.ToString(), result.estimatedMs);
+
+	return result;
+}
+
+std::expected<AutotuneResult, SolverError> SolverAutotuner::Resolve(const std::string& cacheRoot, const std::string& key, const SpMat& A, const Vec& b, const LinearSolverOptions& options, std::size_t expectedSolves)
+{
+	if (auto cached = AutotuneCache::Load(cacheRoot, key))
+	{
+		auto candidates = GetCandidates(options, expectedSolves);
+
+		if (std::ranges::find(candidates, *cached) != candidates.end())
+		{
+			LOG_INFO("Autotuner decision loaded from cache: {} (key {})", cached->ToString(), key);
+			return AutotuneResult{ .best = *cached, .fromCache = true };
+		}
+
+		LOG_WARN("Cached autotuner decision {} is not available in this run, re-tuning", cached->ToString());
+	}
+
+	auto result = Tune(A, b, options, expectedSolves);
+
+	if (result)
+		AutotuneCache::Save(cacheRoot, key, result->best, result->estimatedMs);
+
+	return result;
+}
+
+std::string SolverAutotuner::MakeDecisionKey(std::string_view patternHash, std::size_t expectedSolves, int threads)
+{
+	return std::format("{}-{}-t{}-{}",
+		patternHash,
+		expectedSolves > 1 ? "transient" : "steady",
+		threads,
+		config::UseSequentialSolver ? "eigen" : "pardiso");
+}
+
+AutotuneTrial SolverAutotuner::RunTrial(const SolverCandidate& candidate, const SpMat& A, const Vec& b, const LinearSolverOptions& options, std::size_t expectedSolves, double bestMs, double msPerFactorByte)
+{
+	AutotuneTrial trial{ .candidate = candidate };
+
+	auto trialOptions = candidate.ApplyTo(options);
+
+	// A solve running past the best estimate cannot win, iterative candidates stop there
+	if (std::isfinite(bestMs))
+		trialOptions.timeLimitMs = bestMs;
+
+	// Factorizations cannot be stopped midway, they are screened by the analysis before allocating the factors
+	if (candidate.IsCholesky())
+	{
+		std::size_t limit = options.memoryBudgetMb * 1024 * 1024;
+
+		if (std::isfinite(bestMs) && std::isfinite(msPerFactorByte) && msPerFactorByte > 0.0)
+		{
+			const double slowest = FactorSlack * bestMs / msPerFactorByte;
+			const auto bytes = slowest < static_cast<double>(std::numeric_limits<std::size_t>::max())
+				? std::max<std::size_t>(1, static_cast<std::size_t>(slowest))
+				: std::size_t{ 0 };
+
+			if (bytes > 0)
+				limit = limit > 0 ? std::min(limit, bytes) : bytes;
+		}
+
+		trialOptions.factorLimitBytes = limit;
+	}
+
+	auto solver = LinearSolverFactory::Create(candidate.solver, trialOptions);
+
+	auto start = Now();
+	auto first = solver->Solve(A, b);
+	trial.firstMs = ElapsedMs(start, Now());
+
+	if (!first)
+	{
+		trial.pruned = first.error().code == SolverErrorCode::TimeLimitExceeded
+			|| (first.error().code == SolverErrorCode::OutOfMemory && trialOptions.factorLimitBytes > 0);
+		trial.error = first.error().ToString();
+		return trial;
+	}
+
+	if (candidate.IsCholesky())
+		trial.factorBytes = first->stats.predictedFactorBytes;
+
+	const double residual = RelativeResidual(A, first->solution, b);
+	const double allowed = std::max(ResidualSlack * options.tolerance, 1e-8);
+
+	if (!(residual <= allowed))
+	{
+		trial.error = std::format("relative residual {:.3e} above {:.3e}", residual, allowed);
+		return trial;
+	}
+
+	trial.succeeded = true;
+	trial.estimatedMs = trial.firstMs;
+
+	if (expectedSolves == 1)
+		return trial;
+
+	// Every later solve costs at least nothing, so this one cannot win
+	if (trial.firstMs >= bestMs)
+	{
+		trial.pruned = true;
+		return trial;
+	}
+
+	start = Now();
+	auto repeat = solver->Solve(A, b);
+	trial.repeatMs = ElapsedMs(start, Now());
+
+	if (!repeat)
+	{
+		trial.succeeded = false;
+		trial.pruned = repeat.error().code == SolverErrorCode::TimeLimitExceeded;
+		trial.error = repeat.error().ToString();
+		return trial;
+	}
+
+	trial.estimatedMs = trial.firstMs + static_cast<double>(expectedSolves - 1) * trial.repeatMs;
+
+	return trial;
+}
+
+} // namespace fem::solver::linear
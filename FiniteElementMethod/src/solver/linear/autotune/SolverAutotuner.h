@@ -0,0 +1,75 @@
+#pragma once
+
+#include "SolverCandidate.h"
+
+#include "../../SolverError.h"
+#include "../LinearSolverOptions.h"
+
+#include "math/math.h"
+
+#include <cstddef>
+#include <expected>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace fem::solver::linear
+{
+
+struct AutotuneTrial
+{
+	SolverCandidate candidate;
+	double firstMs = 0.0;        // Includes setup: symbolic analysis, factorization, preconditioner build
+	double repeatMs = 0.0;       // Second solve on the same matrix, measures what the solver reuses
+	double estimatedMs = 0.0;    // first + (expectedSolves - 1) * repeat
+	std::size_t factorBytes = 0; // Cholesky candidates only, predicted by the analysis
+	bool succeeded = false;
+	bool pruned = false;         // Stopped once it could no longer beat the best estimate
+	std::string error;
+};
+
+struct AutotuneResult
+{
+	SolverCandidate best;
+	double estimatedMs = 0.0;
+	bool fromCache = false;
+	std::vector<AutotuneTrial> trials;
+};
+
+/// <summary>
+/// Picks the fastest solver configuration for a matrix by running every candidate on it. The
+/// cost model covers one factorization / setup plus the remaining solves of a transient run,
+/// so solvers that amortize setup over many right-hand sides win there
+/// </summary>
+class SolverAutotuner
+{
+public:
+	SolverAutotuner() = delete;
+
+	/// <summary>
+	/// Search space for the given options: Cholesky fill-reducing orderings available in this build, mixed
+	/// precision, PCG preconditioners and multigrid. GMG only with a structured grid
+	/// </summary>
+	static std::vector<SolverCandidate> GetCandidates(const LinearSolverOptions& options, std::size_t expectedSolves);
+
+	static std::expected<AutotuneResult, SolverError> Tune(const SpMat& A, const Vec& b, const LinearSolverOptions& options, std::size_t expectedSolves);
+
+	/// <summary>
+	/// Cached decision for key when it is still a valid candidate, otherwise tunes and stores the winner
+	/// </summary>
+	static std::expected<AutotuneResult, SolverError> Resolve(const std::string& cacheRoot, const std::string& key, const SpMat& A, const Vec& b, const LinearSolverOptions& options, std::size_t expectedSolves);
+
+	/// <summary>
+	/// Decisions depend on the pattern, the workload and the machine setup, not on matrix values
+	/// </summary>
+	static std::string MakeDecisionKey(std::string_view patternHash, std::size_t expectedSolves, int threads);
+
+private:
+	/// <summary>
+	/// Iterative candidates stop once they run past bestMs. Cholesky candidates are not factorized when their
+	/// predicted factors exceed the memory budget or, at msPerFactorByte, would take far longer than bestMs
+	/// </summary>
+	static AutotuneTrial RunTrial(const SolverCandidate& candidate, const SpMat& A, const Vec& b, const LinearSolverOptions& options, std::size_t expectedSolves, double bestMs, double msPerFactorByte);
+};
+
+} // namespace fem::solver::linear
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "../LinearSolverOptions.h"
+#include "../LinearSolverType.h"
+
+#include <format>
+#include <string>
+
+namespace fem::solver::linear
+{
+
+/// <summary>
+/// One point of the autotuner search space
+/// </summary>
+struct SolverCandidate
+{
+	LinearSolverType solver = LinearSolverType::SimplicialLDLT;
+	PreconditionerType preconditioner = PreconditionerType::Jacobi; // Krylov solvers only
+	OrderingType ordering = OrderingType::Default;                  // Cholesky solvers only
+
+	bool IsKrylov() const
+	{
+		return solver == LinearSolverType::ConjugateGradient
+			|| solver == LinearSolverType::DeflatedConjugateGradient;
+	}
+
+	bool IsCholesky() const
+	{
+		return solver == LinearSolverType::SimplicialLDLT
+			|| solver == LinearSolverType::SimplicialLLT;
+	}
+
+	/// <summary>
+	/// Options for this candidate, everything it does not choose is taken from base
+	/// </summary>
+	LinearSolverOptions ApplyTo(const LinearSolverOptions& base) const
+	{
+		LinearSolverOptions options = base;
+
+		if (IsKrylov())
+			options.preconditioner = preconditioner;
+
+		if (IsCholesky())
+			options.ordering = ordering;
+
+		return options;
+	}
+
+	std::string ToString() const
+	{
+		if (IsKrylov())
+			return std::format("{}/{}", LinearSolverTypeToString(solver), PreconditionerTypeToString(preconditioner));
+
+		if (IsCholesky())
+			return std::format("{}/{}", LinearSolverTypeToString(solver), OrderingTypeToString(ordering));
+
+		return std::string(LinearSolverTypeToString(solver));
+	}
+
+	bool operator==(const SolverCandidate&) const = default;
+};
+
+} // namespace fem::solver::linear
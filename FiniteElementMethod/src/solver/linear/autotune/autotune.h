@@ -0,0 +1,5 @@
+#pragma once
+
+#include "AutotuneCache.h"
+#include "SolverAutotuner.h"
+#include "SolverCandidate.h"
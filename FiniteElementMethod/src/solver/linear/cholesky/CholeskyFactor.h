@@ -0,0 +1,75 @@
+#pragma once
+
+#include "math/math.h"
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace fem::solver::linear
+{
+
+/// <summary>
+/// Numeric factors of a simplicial Cholesky factorization, P A P^T = L D L^T (LDL^T) or L L^T
+/// (LL^T, D empty). Enough to solve for any right-hand side without refactorizing
+/// </summary>
+struct CholeskyFactor
+{
+	std::string signature;        // Solver, ordering and backend that produced it
+	CscMat L;                     // Unit lower triangular for LDL^T, lower triangular for LL^T
+	Vec D;
+	std::vector<int> permutation; // Empty for the natural ordering
+	double factorizationTimeMs = 0.0;
+
+	bool Matches(std::string_view otherSignature, const SpMat& A) const
+	{
+		return signature == otherSignature
+			&& L.rows() == A.rows()
+			&& (permutation.empty() || permutation.size() == static_cast<std::size_t>(A.rows()));
+	}
+
+	/// <summary>
+	/// Forward and back substitution, mirrors Eigen::SimplicialCholeskyBase::_solve_impl
+	/// </summary>
+	Vec Solve(const Vec& b) const
+	{
+		const Eigen::Map<const Eigen::VectorXi> indices(permutation.data(), static_cast<Eigen::Index>(permutation.size()));
+		const Eigen::PermutationWrapper<const Eigen::Map<const Eigen::VectorXi>> P(indices);
+
+		Vec x = permutation.empty() ? b : Vec(P * b);
+
+		if (D.size() > 0)
+		{
+			L.triangularView<Eigen::UnitLower>().solveInPlace(x);
+			x = D.asDiagonal().inverse() * x;
+			L.transpose().triangularView<Eigen::UnitUpper>().solveInPlace(x);
+		}
+		else
+		{
+			L.triangularView<Eigen::Lower>().solveInPlace(x);
+			L.transpose().triangularView<Eigen::Upper>().solveInPlace(x);
+		}
+
+		if (!permutation.empty())
+			x = P.transpose() * x;
+
+		return x;
+	}
+};
+
+/// <summary>
+/// Shared by the application and the simplicial Cholesky solvers. The application offers a factor
+/// of exactly the matrix about to be solved, the solver then only substitutes; otherwise it leaves
+/// its own factorization in computed for the application to store
+/// </summary>
+struct CholeskyFactorCache
+{
+	std::optional<CholeskyFactor> loaded;
+	std::optional<CholeskyFactor> computed;
+
+	std::size_t loadedHits = 0; // Solves that skipped the factorization thanks to loaded
+};
+
+} // namespace fem::solver::linear
@@ -0,0 +1,461 @@
+#pragma once
+
+#include "CholeskyFactor.h"
+#include "SymbolicAnalysis.h"
+
+#include "../LinearSolverResult.h"
+#include "../LinearSolverType.h"
+#include "../OrderingType.h"
+#include "../../SolverError.h"
+
+#include "config/config.h"
+#include "math/math.h"
+#include "metrics/metrics.h"
+#include "utils/utils.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <expected>
+#include <filesystem>
+#include <format>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <Eigen/PardisoSupport>
+#include <Eigen/Sparse>
+
+namespace fem::solver::linear
+{
+
+/// <summary>
+/// Limit on the memory a factorization may hold, see LinearSolverOptions::memoryBudgetMb
+/// </summary>
+struct MemoryBudget
+{
+	std::size_t bytes = 0;      // 0 = unlimited
+	std::size_t limitBytes = 0; // 0 = none, above it the factorization fails even where it could run out-of-core
+	std::filesystem::path scratchDirectory;
+};
+
+#ifdef FEM_USE_SEQUENTIAL_SOLVER
+
+/// <summary>
+/// Calls function.template operator()&lt;Ordering&gt;() with the Eigen ordering matching the run-time
+/// choice. Orderings only Pardiso provides fall back to the compile-time default
+/// </summary>
+template<typename Function>
+decltype(auto) WithOrdering(OrderingType ordering, Function&& function)
+{
+	using enum OrderingType;
+
+	switch (ordering)
+	{
+	case MinimumDegree:
+		return function.template operator()<Eigen::AMDOrdering<int>>();
+
+	case Colamd:
+		return function.template operator()<Eigen::COLAMDOrdering<int>>();
+
+	case Natural:
+		return function.template operator()<Eigen::NaturalOrdering<int>>();
+
+	default:
+		return function.template operator()<config::DefaultOrderingType>();
+	}
+}
+
+/// <summary>
+/// Simplicial factorization whose analysis phase can start from a known permutation instead of
+/// running the ordering. Only the elimination tree is recomputed then
+/// </summary>
+template<typename Factorization, bool DoLDLT>
+class PresetOrderingSolver : public Factorization
+{
+public:
+	using typename Factorization::MatrixType;
+
+	void SetPermutation(std::span<const int> permutation)
+	{
+		m_Preset.assign(permutation.begin(), permutation.end());
+	}
+
+	std::vector<int> GetPermutation() const
+	{
+		const auto& indices = this->permutationP().indices();
+		return std::vector<int>(indices.data(), indices.data() + indices.size());
+	}
+
+	void analyzePattern(const MatrixType& a)
+	{
+		if (m_Preset.size() != static_cast<std::size_t>(a.rows()))
+		{
+			Factorization::analyzePattern(a);
+			return;
+		}
+
+		this->m_P.indices() = Eigen::Map<const Eigen::VectorXi>(m_Preset.data(), a.rows());
+		this->m_Pinv = this->m_P.inverse();
+
+		typename Factorization::Base::CholMatrixType ap(a.rows(), a.cols());
+		ap.template selfadjointView<Eigen::Upper>() = a.template selfadjointView<Factorization::UpLo>().twistedBy(this->m_P);
+
+		this->analyzePattern_preordered(ap, DoLDLT);
+	}
+
+	/// <summary>
+	/// Size of the factors, the analysis has already sized L from the elimination tree
+	/// </summary>
+	std::size_t PredictFactorBytes() const
+	{
+		using StorageIndex = typename Factorization::StorageIndex;
+
+		const auto rows = static_cast<std::size_t>(this->m_matrix.rows());
+		const auto nonZeros = static_cast<std::size_t>(this->m_matrix.nonZeros());
+
+		return nonZeros * (sizeof(double) + sizeof(StorageIndex)) + (rows + 1) * sizeof(StorageIndex) + (DoLDLT ? rows * sizeof(double) : 0);
+	}
+
+	CholeskyFactor ExportFactor() const
+	{
+		CholeskyFactor factor;
+		factor.L = this->matrixL().nestedExpression();
+		factor.permutation = GetPermutation();
+
+		if constexpr (DoLDLT)
+			factor.D = this->vectorD();
+
+		return factor;
+	}
+
+private:
+	std::vector<int> m_Preset;
+};
+
+#else
+
+/// <summary>
+/// Pardiso iparm[1]: 0 = minimum degree, 2 = METIS, 3 = OpenMP nested dissection. Orderings only the
+/// sequential solver provides keep Pardiso's default (METIS)
+/// </summary>
+template<typename Factorization>
+void ApplyOrdering(Factorization& solver, OrderingType ordering)
+{
+	using enum OrderingType;
+
+	switch (ordering)
+	{
+	case MinimumDegree:
+		solver.pardisoParameterArray()[1] = 0;
+		break;
+
+	case Metis:
+		solver.pardisoParameterArray()[1] = 2;
+		break;
+
+	case ParallelMetis:
+		solver.pardisoParameterArray()[1] = 3;
+		break;
+
+	default:
+		break;
+	}
+}
+
+/// <summary>
+/// Pardiso factorization that exchanges its fill-reducing permutation: without a preset, phase 11
+/// returns the computed one (iparm[4] = 2), with a preset it is used as the user permutation
+/// (iparm[4] = 1) and the reordering step is skipped
+/// </summary>
+template<typename Factorization>
+class PresetOrderingSolver : public Factorization
+{
+public:
+	using typename Factorization::MatrixType;
+	using typename Factorization::StorageIndex;
+
+	void SetPermutation(std::span<const int> permutation)
+	{
+		m_Preset.assign(permutation.begin(), permutation.end());
+	}
+
+	std::vector<int> GetPermutation() const
+	{
+		return std::vector<int>(this->m_perm.data(), this->m_perm.data() + this->m_perm.size());
+	}
+
+	// Mirrors PardisoImpl::analyzePattern, which always clears the permutation first
+	Factorization& analyzePattern(const MatrixType& a)
+	{
+		this->m_size = a.rows();
+		this->pardisoRelease();
+
+		if (m_Preset.size() == static_cast<std::size_t>(a.rows()))
+		{
+			this->m_perm = Eigen::Map<const Eigen::VectorXi>(m_Preset.data(), a.rows()).template cast<StorageIndex>();
+			this->m_iparm[4] = 1;
+		}
+		else
+		{
+			this->m_perm.setZero(this->m_size);
+			this->m_iparm[4] = 2;
+		}
+
+		this->getMatrix(a);
+
+		auto error = Eigen::internal::pardiso_run_selector<StorageIndex>::run(
+			this->m_pt, 1, 1, this->m_type, 11, Eigen::internal::convert_index<StorageIndex>(this->m_size),
+			this->m_matrix.valuePtr(), this->m_matrix.outerIndexPtr(), this->m_matrix.innerIndexPtr(),
+			this->m_perm.data(), 0, this->m_iparm.data(), this->m_msglvl, nullptr, nullptr);
+
+		this->manageErrorCode(error);
+		this->m_analysisIsOk = true;
+		this->m_factorizationIsOk = false;
+		this->m_isInitialized = true;
+
+		return this->derived();
+	}
+
+	/// <summary>
+	/// Peak of analysis and factorization as reported by phase 11 in KB: max(iparm[14], iparm[15] + iparm[16])
+	/// </summary>
+	std::size_t PredictFactorBytes() const
+	{
+		const auto& iparm = this->m_iparm;
+		const auto kilobytes = std::max<std::size_t>(iparm[14], static_cast<std::size_t>(iparm[15]) + iparm[16]);
+
+		return kilobytes * 1024;
+	}
+
+	/// <summary>
+	/// Keeps the factors in scratch files (iparm[59] = 2). The analysis is redone in out-of-core mode,
+	/// starting from the permutation it has just computed so the ordering is not repeated
+	/// </summary>
+	void EnableOutOfCore(const MemoryBudget& budget, const MatrixType& a)
+	{
+		config::MKLConfig::SetPardisoOutOfCore(budget.scratchDirectory, budget.bytes / (1024 * 1024));
+
+		m_Preset = GetPermutation();
+		this->m_iparm[59] = 2;
+
+		analyzePattern(a);
+	}
+
+private:
+	std::vector<int> m_Preset;
+};
+
+#endif
+
+/// <summary>
+/// Identifies what produced an analysis or factor, they are only exchanged between equal signatures
+/// </summary>
+inline std::string SymbolicSignature(LinearSolverType solver, OrderingType ordering)
+{
+	return std::format("{}/{}/{}",
+		LinearSolverTypeToString(solver),
+		OrderingTypeToString(ordering),
+		config::UseSequentialSolver ? "eigen" : "pardiso");
+}
+
+/// <summary>
+/// Optional state the Cholesky solvers share with their caller, see SymbolicAnalysisCache and CholeskyFactorCache
+/// </summary>
+struct FactorizationReuse
+{
+	std::string signature;
+	SymbolicAnalysisCache* symbolic = nullptr;
+	CholeskyFactorCache* numeric = nullptr; // Only simplicial factorizations export their factors
+};
+
+/// <summary>
+/// Factorizes A and solves for b, shared by the Cholesky variants. A matching loaded factor
+/// replaces the factorization by substitution; otherwise the ordering is taken from a matching
+/// earlier analysis, and fresh analyses and factors are handed back through reuse. A factorization
+/// predicted to exceed the budget runs out-of-core where the backend supports it and fails before
+/// allocating the factors otherwise
+/// </summary>
+template<typename Factorization>
+std::expected<LinearSolverResult, SolverError> FactorizeAndSolve(Factorization& solver, const SpMat& A, const Vec& b, const FactorizationReuse& reuse = {}, const MemoryBudget& budget = {})
+{
+	if (A.rows() != A.cols())
+	{
+		return std::unexpected(
+			SolverError{
+				SolverErrorCode::InvalidInput,
+				"Matrix must be a square"
+			}
+		);
+	}
+
+	if (A.rows() != b.size())
+	{
+		return std::unexpected(
+			SolverError{
+				SolverErrorCode::InvalidInput,
+				std::format("Matrix size ({}) doesn't match vector size ({})", A.rows(), b.size())
+			}
+		);
+	}
+
+	auto start = Now();
+
+	LinearSolverStats stats;
+	stats.matrixSize = A.rows();
+	stats.matrixNonZeros = A.nonZeros();
+
+	auto* numericCache = reuse.numeric;
+
+	if (numericCache && numericCache->loaded && numericCache->loaded->Matches(reuse.signature, A))
+	{
+		auto solveStart = Now();
+
+		Vec x = numericCache->loaded->Solve(b);
+
+		stats.solveTimeMs = ElapsedMs(solveStart, Now());
+		stats.residualNorm = (b - A * x).norm();
+		stats.reusedFactorization = true;
+		stats.peakMemoryBytes = metrics::MemoryMonitor::GetPeakUsage();
+		stats.elapsedTimeMs = ElapsedMs(start, Now());
+
+		++numericCache->loadedHits;
+
+		return LinearSolverResult{
+			.solution = std::move(x),
+			.stats = stats
+		};
+	}
+
+	auto* analysisCache = reuse.symbolic;
+	const std::string_view signature = reuse.signature;
+
+	const SymbolicAnalysis* preset = analysisCache ? analysisCache->Find(signature, A) : nullptr;
+	const bool presetIsLoaded = preset && analysisCache->loaded && preset == &*analysisCache->loaded;
+
+	if (preset)
+		solver.SetPermutation(preset->permutation);
+
+	auto factorStart = Now();
+
+	solver.analyzePattern(A);
+
+	if (solver.info() == Eigen::Success)
+	{
+		stats.predictedFactorBytes = solver.PredictFactorBytes();
+
+		if (budget.limitBytes > 0 && stats.predictedFactorBytes > budget.limitBytes)
+		{
+			return std::unexpected(
+				SolverError{
+					SolverErrorCode::OutOfMemory,
+					std::format("Predicted factorization memory {:.2f} MB exceeds the {:.2f} MB limit",
+						BytesToMiB(stats.predictedFactorBytes), BytesToMiB(budget.limitBytes))
+				}
+			);
+		}
+
+		if (budget.bytes > 0 && stats.predictedFactorBytes > budget.bytes)
+		{
+			if constexpr (requires { solver.EnableOutOfCore(budget, A); })
+			{
+				LOG_WARN("Predicted factorization memory {:.2f} MB exceeds the {:.2f} MB budget, factorizing out-of-core",
+					BytesToMiB(stats.predictedFactorBytes), BytesToMiB(budget.bytes));
+
+				solver.EnableOutOfCore(budget, A);
+				stats.outOfCore = true;
+			}
+			else
+			{
+				return std::unexpected(
+					SolverError{
+						SolverErrorCode::OutOfMemory,
+						std::format("Predicted factorization memory {:.2f} MB exceeds the {:.2f} MB budget and the simplicial solver cannot run out-of-core",
+							BytesToMiB(stats.predictedFactorBytes), BytesToMiB(budget.bytes))
+					}
+				);
+			}
+		}
+	}
+
+	auto analysisEnd = Now();
+	stats.analysisTimeMs = ElapsedMs(factorStart, analysisEnd);
+	stats.reusedOrdering = preset != nullptr;
+
+	if (solver.info() == Eigen::Success)
+		solver.factorize(A);
+
+	auto factorEnd = Now();
+	stats.factorizationTimeMs = ElapsedMs(factorStart, factorEnd);
+
+	// TODO: Map Eigen errors to SolverError more precisely
+	if (solver.info() != Eigen::Success)
+	{
+		return std::unexpected(
+			SolverError{
+				SolverErrorCode::SingularMatrix,
+				"Cholesky decomposition failed - matrix not symmetric positive-definite"
+			}
+		);
+	}
+
+	if (presetIsLoaded && analysisCache->loadedHits++ == 0)
+		analysisCache->loadedHitAnalysisMs = stats.analysisTimeMs;
+
+	if (analysisCache && !preset)
+	{
+		auto permutation = solver.GetPermutation();
+
+		// Natural ordering leaves no permutation, nothing to reuse
+		if (!permutation.empty())
+		{
+			analysisCache->computed = SymbolicAnalysis{
+				.signature = std::string(signature),
+				.rows = A.rows(),
+				.nonZeros = A.nonZeros(),
+				.permutation = std::move(permutation),
+				.analysisTimeMs = stats.analysisTimeMs
+			};
+		}
+	}
+
+	if constexpr (requires { solver.ExportFactor(); })
+	{
+		if (numericCache && !numericCache->computed)
+		{
+			numericCache->computed = solver.ExportFactor();
+			numericCache->computed->signature = std::string(signature);
+			numericCache->computed->factorizationTimeMs = stats.factorizationTimeMs;
+		}
+	}
+
+	auto solveStart = Now();
+
+	Vec x = solver.solve(b);
+
+	auto solveEnd = Now();
+	stats.solveTimeMs = ElapsedMs(solveStart, solveEnd);
+	stats.residualNorm = (b - A * x).norm();
+
+	// TODO: Map Eigen errors to SolverError more precisely
+	if (solver.info() != Eigen::Success)
+	{
+		return std::unexpected(
+			SolverError{
+				SolverErrorCode::NumericalInstability,
+				"Cholesky solve failed"
+			}
+		);
+	}
+
+	stats.peakMemoryBytes = metrics::MemoryMonitor::GetPeakUsage();
+
+	auto end = Now();
+	stats.elapsedTimeMs = ElapsedMs(start, end);
+
+	return LinearSolverResult{
+		.solution = std::move(x),
+		.stats = stats
+	};
+}
+
+} // namespace fem::solver::linear
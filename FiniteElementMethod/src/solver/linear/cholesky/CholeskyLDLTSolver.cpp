@@ -1,95 +1,35 @@
 #include "CholeskyLDLTSolver.h"
 
-#include "config/config.h"
-#include "metrics/metrics.h"
-#include "utils/utils.h"
-
-#include <Eigen/PardisoSupport>
-#include <Eigen/Sparse>
+#include "CholeskyFactorization.h"
 
 namespace fem::solver::linear
 {
 
 std::expected<LinearSolverResult, SolverError> CholeskyLDLTSolver::Solve(const SpMat& A, const Vec& b)
 {
-	if (A.rows() != A.cols())
-	{
-		return std::unexpected(
-			SolverError{
-				SolverErrorCode::InvalidInput,
-				"Matrix must be a square"
-			}
-		);
-	}
-
-	if (A.rows() != b.size())
-	{
-		return std::unexpected(
-			SolverError{
-				SolverErrorCode::InvalidInput,
-				std::format("Matrix size ({}) doesn't match vector size ({})", A.rows(), b.size())
-			}
-		);
-	}
-
-	auto start = Now();
-
-	LinearSolverStats stats;
-	stats.matrixSize = A.rows();
-	stats.matrixNonZeros = A.nonZeros();
+	const FactorizationReuse reuse{
+		.signature = SymbolicSignature(LinearSolverType::SimplicialLDLT, m_Ordering),
+		.symbolic = m_SymbolicAnalysis.get(),
+		.numeric = m_Factor.get()
+	};
 
-	auto factorStart = Now();
+	const MemoryBudget budget{
+		.bytes = m_MemoryBudgetMb * 1024 * 1024,
+		.limitBytes = m_FactorLimitBytes,
+		.scratchDirectory = m_OutOfCoreDirectory
+	};
 
 #ifdef FEM_USE_SEQUENTIAL_SOLVER
-	Eigen::SimplicialLDLT<SpMat, Eigen::Lower, config::DefaultOrderingType> solver;
+	return WithOrdering(m_Ordering, [&]<typename Ordering>()
+		{
+			PresetOrderingSolver<Eigen::SimplicialLDLT<SpMat, Eigen::Lower, Ordering>, true> solver;
+			return FactorizeAndSolve(solver, A, b, reuse, budget);
+		});
 #else
-	Eigen::PardisoLDLT<SpMat> solver;
+	PresetOrderingSolver<Eigen::PardisoLDLT<SpMat>> solver;
+	ApplyOrdering(solver, m_Ordering);
+	return FactorizeAndSolve(solver, A, b, reuse, budget);
 #endif
-
-	solver.compute(A);
-
-	auto factorEnd = Now();
-	stats.factorizationTimeMs = ElapsedMs(factorStart, factorEnd);
-
-	// TODO: Map Eigen errors to SolverError more precisely
-	if (solver.info() != Eigen::Success)
-	{
-		return std::unexpected(
-			SolverError{
-				SolverErrorCode::SingularMatrix,
-				"Cholesky decomposition failed - matrix not symmetric positive-definite"
-			}
-		);
-	}
-
-	auto solveStart = Now();
-
-	Vec x = solver.solve(b);
-
-	auto solveEnd = Now();
-	stats.solveTimeMs = ElapsedMs(solveStart, solveEnd);
-	stats.residualNorm = (A * x - b).norm();
-
-	// TODO: Map Eigen errors to SolverError more precisely
-	if (solver.info() != Eigen::Success)
-	{
-		return std::unexpected(
-			SolverError{
-				SolverErrorCode::NumericalInstability,
-				"Cholesky solve failed"
-			}
-		);
-	}
-
-	stats.peakMemoryBytes = metrics::MemoryMonitor::GetPeakUsage();
-
-	auto end = Now();
-	stats.elapsedTimeMs = ElapsedMs(start, end);
-
-	return LinearSolverResult{
-		.solution = std::move(x),
-		.stats = stats
-	};
 }
 
 } // namespace fem::solver::linear
@@ -1,21 +1,39 @@
 #pragma once
 
 #include "../ILinearSolver.h"
+#include "../LinearSolverOptions.h"
 
 #include "math/math.h"
 
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+
 namespace fem::solver::linear
 {
 
 class CholeskyLDLTSolver : public ILinearSolver
 {
 public:
+	explicit CholeskyLDLTSolver(const LinearSolverOptions& options = {}) : m_Ordering(options.ordering), m_SymbolicAnalysis(options.symbolicAnalysis), m_Factor(options.factor), m_MemoryBudgetMb(options.memoryBudgetMb), m_OutOfCoreDirectory(options.outOfCoreDirectory), m_FactorLimitBytes(options.factorLimitBytes) {}
+
 	std::expected<LinearSolverResult, SolverError> Solve(const SpMat& A, const Vec& b) override;
 
 	std::string GetName() const override
 	{
-		return "Cholesky (SimplicialLDLT)";
+		if (m_Ordering == OrderingType::Default)
+			return "Cholesky (SimplicialLDLT)";
+
+		return std::format("Cholesky (SimplicialLDLT, {})", OrderingTypeToString(m_Ordering));
 	}
+
+private:
+	OrderingType m_Ordering;
+	std::shared_ptr<SymbolicAnalysisCache> m_SymbolicAnalysis; // Optional, shared with the caller
+	std::shared_ptr<CholeskyFactorCache> m_Factor;             // Optional, shared with the caller
+	std::size_t m_MemoryBudgetMb;
+	std::filesystem::path m_OutOfCoreDirectory;
+	std::size_t m_FactorLimitBytes;
 };
 
 } // namespace fem::solver::linear
@@ -0,0 +1,35 @@
+#include "CholeskyLLTSolver.h"
+
+#include "CholeskyFactorization.h"
+
+namespace fem::solver::linear
+{
+
+std::expected<LinearSolverResult, SolverError> CholeskyLLTSolver::Solve(const SpMat& A, const Vec& b)
+{
+	const FactorizationReuse reuse{
+		.signature = SymbolicSignature(LinearSolverType::SimplicialLLT, m_Ordering),
+		.symbolic = m_SymbolicAnalysis.get(),
+		.numeric = m_Factor.get()
+	};
+
+	const MemoryBudget budget{
+		.bytes = m_MemoryBudgetMb * 1024 * 1024,
+		.limitBytes = m_FactorLimitBytes,
+		.scratchDirectory = m_OutOfCoreDirectory
+	};
+
+#ifdef FEM_USE_SEQUENTIAL_SOLVER
+	return WithOrdering(m_Ordering, [&]<typename Ordering>()
+		{
+			PresetOrderingSolver<Eigen::SimplicialLLT<SpMat, Eigen::Lower, Ordering>, false> solver;
+			return FactorizeAndSolve(solver, A, b, reuse, budget);
+		});
+#else
+	PresetOrderingSolver<Eigen::PardisoLLT<SpMat>> solver;
+	ApplyOrdering(solver, m_Ordering);
+	return FactorizeAndSolve(solver, A, b, reuse, budget);
+#endif
+}
+
+} // namespace fem::solver::linear
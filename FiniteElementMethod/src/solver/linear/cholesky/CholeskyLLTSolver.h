@@ -0,0 +1,43 @@
+#pragma once
+
+#include "../ILinearSolver.h"
+#include "../LinearSolverOptions.h"
+
+#include "math/math.h"
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+
+namespace fem::solver::linear
+{
+
+/// <summary>
+/// LL^T Cholesky for SPD matrices. Pardiso runs it as a positive definite factorization instead of
+/// the symmetric indefinite one behind LDL^T, which is usually faster
+/// </summary>
+class CholeskyLLTSolver : public ILinearSolver
+{
+public:
+	explicit CholeskyLLTSolver(const LinearSolverOptions& options = {}) : m_Ordering(options.ordering), m_SymbolicAnalysis(options.symbolicAnalysis), m_Factor(options.factor), m_MemoryBudgetMb(options.memoryBudgetMb), m_OutOfCoreDirectory(options.outOfCoreDirectory), m_FactorLimitBytes(options.factorLimitBytes) {}
+
+	std::expected<LinearSolverResult, SolverError> Solve(const SpMat& A, const Vec& b) override;
+
+	std::string GetName() const override
+	{
+		if (m_Ordering == OrderingType::Default)
+			return "Cholesky (SimplicialLLT)";
+
+		return std::format("Cholesky (SimplicialLLT, {})", OrderingTypeToString(m_Ordering));
+	}
+
+private:
+	OrderingType m_Ordering;
+	std::shared_ptr<SymbolicAnalysisCache> m_SymbolicAnalysis; // Optional, shared with the caller
+	std::shared_ptr<CholeskyFactorCache> m_Factor;             // Optional, shared with the caller
+	std::size_t m_MemoryBudgetMb;
+	std::filesystem::path m_OutOfCoreDirectory;
+	std::size_t m_FactorLimitBytes;
+};
+
+} // namespace fem::solver::linear
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "math/math.h"
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace fem::solver::linear
+{
+
+/// <summary>
+/// Fill-reducing permutation found by the analysis phase of a Cholesky factorization. It depends
+/// only on the sparsity pattern, so it stays valid for every matrix with the same structure
+/// </summary>
+struct SymbolicAnalysis
+{
+	std::string signature;        // Solver, ordering and backend that produced it
+	Eigen::Index rows = 0;        // Of the analyzed matrix
+	Eigen::Index nonZeros = 0;
+	std::vector<int> permutation;
+	double analysisTimeMs = 0.0;  // Ordering and symbolic factorization, measured when it was computed
+
+	bool Matches(std::string_view otherSignature, const SpMat& A) const
+	{
+		return signature == otherSignature
+			&& rows == A.rows()
+			&& nonZeros == A.nonZeros()
+			&& permutation.size() == static_cast<std::size_t>(A.rows());
+	}
+};
+
+/// <summary>
+/// Shared by the application and the Cholesky solvers. The application offers an analysis loaded
+/// from the cache, the solver reuses it when it matches and otherwise leaves its own in computed,
+/// which later solves of the same run pick up as well
+/// </summary>
+struct SymbolicAnalysisCache
+{
+	std::optional<SymbolicAnalysis> loaded;
+	std::optional<SymbolicAnalysis> computed;
+
+	std::size_t loadedHits = 0;        // Solves that skipped the ordering thanks to loaded
+	double loadedHitAnalysisMs = 0.0;  // Analysis time of the first such solve
+
+	const SymbolicAnalysis* Find(std::string_view signature, const SpMat& A) const
+	{
+		if (computed && computed->Matches(signature, A))
+			return &*computed;
+
+		if (loaded && loaded->Matches(signature, A))
+			return &*loaded;
+
+		return nullptr;
+	}
+
+	/// <summary>
+	/// Time the loaded analysis saved on its first use, 0 when it was not used
+	/// </summary>
+	double GetSavedMs() const
+	{
+		if (!loaded || loadedHits == 0)
+			return 0.0;
+
+		return loaded->analysisTimeMs - loadedHitAnalysisMs;
+	}
+};
+
+} // namespace fem::solver::linear
@@ -1,3 +1,7 @@
 #pragma once
 
+#include "CholeskyFactor.h"
+#include "CholeskyFactorization.h"
 #include "CholeskyLDLTSolver.h"
+#include "CholeskyLLTSolver.h"
+#include "SymbolicAnalysis.h"
@@ -2,9 +2,17 @@
 
 #include "ILinearSolver.h"
 #include "LinearSolverFactory.h"
+#include "LinearSolverOptions.h"
 #include "LinearSolverStats.h"
 #include "LinearSolverType.h"
+#include "MatrixFingerprint.h"
 
+#include "autotune/autotune.h"
 #include "cholesky/cholesky.h"
 #include "lu/lu.h"
+#include "mixed/mixed.h"
+#include "multigrid/multigrid.h"
+#include "pcg/pcg.h"
+#include "preconditioner/preconditioner.h"
 #include "qr/qr.h"
+#include "schwarz/schwarz.h"
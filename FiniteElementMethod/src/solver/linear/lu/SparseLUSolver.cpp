@@ -84,7 +84,7 @@ std::expected<LinearSolverResult, SolverError> SparseLUSolver::Solve(const SpMat
 
 	auto end = Now();
 	stats.elapsedTimeMs = ElapsedMs(start, end);
-	stats.residualNorm = (A * x - b).norm();
+	stats.residualNorm = (b - A * x).norm();
 
 	return LinearSolverResult{
 		.solution = std::move(x),
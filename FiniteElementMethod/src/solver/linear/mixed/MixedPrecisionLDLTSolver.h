@@ -0,0 +1,41 @@
+#pragma once
+
+#include "../ILinearSolver.h"
+#include "../LinearSolverOptions.h"
+
+#include "math/math.h"
+
+namespace fem::solver::linear
+{
+
+/// <summary>
+/// LDLT factorization of a single precision copy of A followed by iterative refinement with
+/// residuals computed against the original double matrix. Falls back to a double precision
+/// factorization when refinement does not reach the tolerance
+/// </summary>
+class MixedPrecisionLDLTSolver : public ILinearSolver
+{
+public:
+	explicit MixedPrecisionLDLTSolver(const LinearSolverOptions& options = {})
+		: m_Options(options)
+	{
+	}
+
+	std::expected<LinearSolverResult, SolverError> Solve(const SpMat& A, const Vec& b) override;
+
+	std::string GetName() const override
+	{
+#ifdef FEM_USE_SEQUENTIAL_SOLVER
+		return "Mixed precision Cholesky (SimplicialLDLT float + refinement)";
+#else
+		return "Mixed precision Cholesky (PardisoLDLT float + refinement)";
+#endif
+	}
+
+private:
+	std::expected<Vec, SolverError> SolveDouble(const SpMat& A, const Vec& b, LinearSolverStats& stats) const;
+
+	LinearSolverOptions m_Options;
+};
+
+} // namespace fem::solver::linear
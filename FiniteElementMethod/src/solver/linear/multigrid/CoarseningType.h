@@ -0,0 +1,12 @@
+#pragma once
+
+namespace fem::solver::linear
+{
+
+enum class CoarseningType : int
+{
+	SmoothedAggregation = 0, // Algebraic, works on any SPD matrix
+	Geometric,               // Structured grids only, requires LinearSolverOptions::structuredGrid
+};
+
+} // namespace fem::solver::linear
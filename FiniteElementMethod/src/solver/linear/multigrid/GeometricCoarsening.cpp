@@ -0,0 +1,200 @@
+#include "GeometricCoarsening.h"
+
+#include "logger/logger.h"
+
+#include <array>
+#include <omp.h>
+
+namespace fem::solver::linear
+{
+
+using StorageIndex = CsrMat::StorageIndex;
+
+std::expected<std::vector<MultigridLevel>, SolverError> GeometricCoarsening::BuildLevels(const SpMat& A, const LinearSolverOptions& options)
+{
+	const auto& grid = options.structuredGrid;
+
+	if (!grid)
+		return std::unexpected(
+			SolverError{
+				SolverErrorCode::InvalidInput,
+				"Geometric multigrid requires a structured (transfinite quad) mesh"
+			}
+		);
+
+	if (A.rows() != A.cols() || static_cast<size_t>(A.rows()) != grid->nx * grid->ny)
+		return std::unexpected(
+			SolverError{
+				SolverErrorCode::InvalidInput,
+				std::format("Matrix size ({} x {}) doesn't match structured grid {} x {}", A.rows(), A.cols(), grid->nx, grid->ny)
+			}
+		);
+
+	std::vector<MultigridLevel> levels;
+	levels.reserve(options.maxLevels);
+
+	levels.emplace_back();
+	levels.back().A = A;
+	levels.back().A.makeCompressed();
+
+	std::vector<double> x = grid->x;
+	std::vector<double> y = grid->y;
+
+	while (levels.size() < options.maxLevels && static_cast<size_t>(levels.back().A.rows()) > options.coarsestSize)
+	{
+		const size_t nx = x.size();
+		const size_t ny = y.size();
+
+		if (nx < 3 && ny < 3)
+			break;
+
+		std::vector<size_t> coarseX = CoarseLines(nx);
+		std::vector<size_t> coarseY = CoarseLines(ny);
+
+		Interpolation1D ix = BuildInterpolation(x, coarseX);
+		Interpolation1D iy = BuildInterpolation(y, coarseY);
+
+		// The finest level follows the mesh node numbering, coarser ones are lexicographic
+		CsrMat P = levels.size() == 1
+			? BuildProlongation(ix, iy, coarseX.size(), coarseY.size(), [&](size_t i, size_t j) { return grid->GetNodeIndex(i, j); })
+			: BuildProlongation(ix, iy, coarseX.size(), coarseY.size(), [nx](size_t i, size_t j) { return j * nx + i; });
+
+		CsrMat R = P.transpose();
+
+		CsrMat coarseA = math::SparseOps::TripleProduct(R, levels.back().A, P);
+
+		// Eigen sparse matrices have no move assignment, swap hands the arrays over without copying
+		levels.back().P.swap(P);
+		levels.back().R.swap(R);
+		levels.emplace_back().A.swap(coarseA);
+
+		std::vector<double> nextX, nextY;
+		for (size_t i : coarseX) nextX.push_back(x[i]);
+		for (size_t j : coarseY) nextY.push_back(y[j]);
+
+		x = std::move(nextX);
+		y = std::move(nextY);
+	}
+
+	LOG_INFO("Geometric multigrid: {} x {} fine grid, {} x {} coarsest grid", grid->nx, grid->ny, x.size(), y.size());
+
+	return levels;
+}
+
+std::vector<std::size_t> GeometricCoarsening::CoarseLines(std::size_t count)
+{
+	std::vector<std::size_t> lines;
+
+	// Direction already exhausted - keep every line (semi-coarsening)
+	const std::size_t stride = count >= 3 ? 2 : 1;
+
+	for (std::size_t i = 0; i < count; i += stride)
+		lines.push_back(i);
+
+	if (count > 0 && lines.back() != count - 1)
+		lines.push_back(count - 1);
+
+	return lines;
+}
+
+GeometricCoarsening::Interpolation1D GeometricCoarsening::BuildInterpolation(const std::vector<double>& fine, const std::vector<std::size_t>& coarseLines)
+{
+	const size_t n = fine.size();
+
+	Interpolation1D interpolation;
+	interpolation.left.resize(n);
+	interpolation.right.resize(n);
+	interpolation.leftWeight.resize(n);
+
+	size_t c = 0;
+
+	for (size_t f = 0; f < n; ++f)
+	{
+		while (coarseLines[c] < f)
+			++c;
+
+		if (coarseLines[c] == f)
+		{
+			interpolation.left[f] = c;
+			interpolation.right[f] = c;
+			interpolation.leftWeight[f] = 1.0;
+			continue;
+		}
+
+		const double xl = fine[coarseLines[c - 1]];
+		const double xr = fine[coarseLines[c]];
+
+		interpolation.left[f] = c - 1;
+		interpolation.right[f] = c;
+		interpolation.leftWeight[f] = (xr - fine[f]) / (xr - xl);
+	}
+
+	return interpolation;
+}
+
+template<typename FineIndex>
+CsrMat GeometricCoarsening::BuildProlongation(const Interpolation1D& ix, const Interpolation1D& iy, std::size_t coarseNx, std::size_t coarseNy, FineIndex&& fineIndex)
+{
+	const size_t nx = ix.left.size();
+	const size_t ny = iy.left.size();
+	const size_t rows = nx * ny;
+
+	auto entries = [](const Interpolation1D& interpolation, size_t f) {
+		std::array<std::pair<size_t, double>, 2> result{ {
+			{ interpolation.left[f], interpolation.leftWeight[f] },
+			{ interpolation.right[f], 1.0 - interpolation.leftWeight[f] }
+		} };
+
+		return std::pair{ result, interpolation.left[f] == interpolation.right[f] ? 1 : 2 };
+	};
+
+	CsrMat P(static_cast<Eigen::Index>(rows), static_cast<Eigen::Index>(coarseNx * coarseNy));
+	P.makeCompressed();
+
+	StorageIndex* outer = P.outerIndexPtr();
+
+#pragma omp parallel for schedule(static)
+	for (std::int64_t j = 0; j < static_cast<std::int64_t>(ny); ++j)
+	{
+		const int countY = entries(iy, j).second;
+
+		for (size_t i = 0; i < nx; ++i)
+			outer[fineIndex(i, j) + 1] = static_cast<StorageIndex>(entries(ix, i).second * countY);
+	}
+
+	outer[0] = 0;
+	for (size_t r = 0; r < rows; ++r)
+		outer[r + 1] += outer[r];
+
+	P.resizeNonZeros(outer[rows]);
+
+	StorageIndex* inner = P.innerIndexPtr();
+	double* values = P.valuePtr();
+
+#pragma omp parallel for schedule(static)
+	for (std::int64_t j = 0; j < static_cast<std::int64_t>(ny); ++j)
+	{
+		const auto [wy, countY] = entries(iy, j);
+
+		for (size_t i = 0; i < nx; ++i)
+		{
+			const auto [wx, countX] = entries(ix, i);
+
+			StorageIndex pos = outer[fineIndex(i, j)];
+
+			for (int b = 0; b < countY; ++b)
+			{
+				for (int a = 0; a < countX; ++a)
+				{
+					inner[pos] = static_cast<StorageIndex>(wy[b].first * coarseNx + wx[a].first);
+					values[pos] = wx[a].second * wy[b].second;
+					++pos;
+				}
+			}
+		}
+	}
+
+	return P;
+}
+
+} // namespace fem::solver::linear
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "MultigridLevel.h"
+
+#include "../LinearSolverOptions.h"
+#include "../../SolverError.h"
+
+#include "math/math.h"
+
+#include <expected>
+#include <vector>
+
+namespace fem::solver::linear
+{
+
+/// <summary>
+/// Geometric coarsening of structured (transfinite) quad meshes: every other grid line is kept,
+/// transfers are bilinear in the physical coordinates (so graded spacing is respected) and coarse
+/// operators are Galerkin products R A P, which equal rediscretization for bilinear elements
+/// </summary>
+class GeometricCoarsening
+{
+public:
+	GeometricCoarsening() = delete;
+
+	static std::expected<std::vector<MultigridLevel>, SolverError> BuildLevels(const SpMat& A, const LinearSolverOptions& options);
+
+private:
+	/// <summary>
+	/// Indices of the grid lines kept on the coarse level: all even lines plus the last one.
+	/// Directions with fewer than 3 lines are not coarsened
+	/// </summary>
+	static std::vector<std::size_t> CoarseLines(std::size_t count);
+
+	/// <summary>
+	/// 1D linear interpolation weights from coarse lines to every fine line
+	/// </summary>
+	struct Interpolation1D
+	{
+		std::vector<std::size_t> left;  // Coarse line index
+		std::vector<std::size_t> right; // Coarse line index (== left on coarse lines)
+		std::vector<double> leftWeight; // Weight of left, right gets 1 - leftWeight
+	};
+
+	static Interpolation1D BuildInterpolation(const std::vector<double>& fine, const std::vector<std::size_t>& coarseLines);
+
+	/// <summary>
+	/// Tensor product of the x and y interpolations. Fine rows are given by fineIndex(i, j), coarse columns are lexicographic
+	/// </summary>
+	template<typename FineIndex>
+	static CsrMat BuildProlongation(const Interpolation1D& ix, const Interpolation1D& iy, std::size_t coarseNx, std::size_t coarseNy, FineIndex&& fineIndex);
+};
+
+} // namespace fem::solver::linear
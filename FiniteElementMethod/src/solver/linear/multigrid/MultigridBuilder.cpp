@@ -0,0 +1,39 @@
+#include "MultigridBuilder.h"
+
+#include "GeometricCoarsening.h"
+#include "SmoothedAggregation.h"
+
+#include <utility>
+
+namespace fem::solver::linear
+{
+
+std::expected<std::vector<MultigridLevel>, SolverError> MultigridBuilder::BuildLevels(CoarseningType type, const SpMat& A, const LinearSolverOptions& options)
+{
+	switch (type)
+	{
+	case CoarseningType::SmoothedAggregation:
+		return SmoothedAggregation::BuildLevels(A, options);
+
+	case CoarseningType::Geometric:
+		return GeometricCoarsening::BuildLevels(A, options);
+	}
+
+	std::unreachable();
+}
+
+std::string_view MultigridBuilder::GetShortName(CoarseningType type)
+{
+	switch (type)
+	{
+	case CoarseningType::SmoothedAggregation:
+		return "AMG";
+
+	case CoarseningType::Geometric:
+		return "GMG";
+	}
+
+	std::unreachable();
+}
+
+} // namespace fem::solver::linear
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "CoarseningType.h"
+#include "MultigridLevel.h"
+
+#include "../LinearSolverOptions.h"
+#include "../../SolverError.h"
+
+#include "math/math.h"
+
+#include <expected>
+#include <string_view>
+#include <vector>
+
+namespace fem::solver::linear
+{
+
+/// <summary>
+/// Dispatches hierarchy construction to the selected coarsening strategy
+/// </summary>
+class MultigridBuilder
+{
+public:
+	MultigridBuilder() = delete;
+
+	static std::expected<std::vector<MultigridLevel>, SolverError> BuildLevels(CoarseningType type, const SpMat& A, const LinearSolverOptions& options);
+
+	static std::string_view GetShortName(CoarseningType type);
+};
+
+} // namespace fem::solver::linear
@@ -0,0 +1,141 @@
+#include "MultigridHierarchy.h"
+
+#include "Smoother.h"
+
+#include "logger/logger.h"
+#include "utils/utils.h"
+
+namespace fem::solver::linear
+{
+
+std::expected<void, SolverError> MultigridHierarchy::Setup(std::vector<MultigridLevel> levels, SmootherType smoother, size_t sweeps)
+{
+	if (levels.empty())
+		return std::unexpected(
+			SolverError{
+				SolverErrorCode::InvalidInput,
+				"Multigrid hierarchy requires at least one level"
+			}
+		);
+
+	m_Levels = std::move(levels);
+	m_Smoother = smoother;
+	m_Sweeps = sweeps;
+
+	for (size_t l = 0; l < m_Levels.size(); ++l)
+	{
+		auto& level = m_Levels[l];
+		const Eigen::Index n = level.A.rows();
+
+		Vec diagonal = level.A.diagonal();
+
+		if ((diagonal.array() <= 0.0).any())
+		{
+			m_Levels.clear();
+
+			return std::unexpected(
+				SolverError{
+					SolverErrorCode::InvalidInput,
+					std::format("Multigrid level {} has a non-positive diagonal entry - matrix is not SPD", l)
+				}
+			);
+		}
+
+		level.inverseDiagonal = diagonal.cwiseInverse();
+		level.residual.resize(n);
+
+		if (l + 1 < m_Levels.size())
+		{
+			level.spectralRadius = Smoother::EstimateSpectralRadius(level.A, level.inverseDiagonal);
+
+			if (level.R.size() == 0)
+				level.R = level.P.transpose();
+
+			level.coarseRhs.resize(level.P.cols());
+			level.coarseCorrection.resize(level.P.cols());
+		}
+	}
+
+	m_CoarseSolver.compute(Eigen::SparseMatrix<double>(m_Levels.back().A));
+
+	if (m_CoarseSolver.info() != Eigen::Success)
+	{
+		m_Levels.clear();
+
+		return std::unexpected(
+			SolverError{
+				SolverErrorCode::SingularMatrix,
+				"Multigrid coarsest level factorization failed"
+			}
+		);
+	}
+
+	return {};
+}
+
+void MultigridHierarchy::VCycle(const Vec& b, Vec& x) const
+{
+	Cycle(0, b, x);
+}
+
+void MultigridHierarchy::Cycle(size_t l, const Vec& b, Vec& x) const
+{
+	const auto& level = m_Levels[l];
+
+	if (l + 1 == m_Levels.size())
+	{
+		x = m_CoarseSolver.solve(b);
+		return;
+	}
+
+	Smoother::Smooth(m_Smoother, level, b, x, m_Sweeps);
+
+	level.residual.noalias() = b - level.A * x;
+	level.coarseRhs.noalias() = level.R * level.residual;
+	level.coarseCorrection.setZero();
+
+	Cycle(l + 1, level.coarseRhs, level.coarseCorrection);
+
+	x.noalias() += level.P * level.coarseCorrection;
+
+	Smoother::Smooth(m_Smoother, level, b, x, m_Sweeps);
+}
+
+double MultigridHierarchy::GetOperatorComplexity() const
+{
+	if (m_Levels.empty())
+		return 0.0;
+
+	size_t total = 0;
+	for (const auto& level : m_Levels)
+		total += level.A.nonZeros();
+
+	return static_cast<double>(total) / m_Levels.front().A.nonZeros();
+}
+
+size_t MultigridHierarchy::GetMemoryBytes() const
+{
+	constexpr size_t entryBytes = sizeof(double) + sizeof(CsrMat::StorageIndex);
+
+	size_t bytes = 0;
+
+	for (const auto& level : m_Levels)
+	{
+		bytes += (level.A.nonZeros() + level.P.nonZeros() + level.R.nonZeros()) * entryBytes;
+		bytes += (level.A.rows() + level.P.rows() + level.R.rows()) * sizeof(CsrMat::StorageIndex);
+		bytes += (level.inverseDiagonal.size() + level.residual.size() + level.coarseRhs.size() + level.coarseCorrection.size()) * sizeof(double);
+	}
+
+	return bytes;
+}
+
+void MultigridHierarchy::LogSummary() const
+{
+	LOG_INFO("Multigrid hierarchy: {} levels, operator complexity {:.2f}, {:.2f} MB",
+		m_Levels.size(), GetOperatorComplexity(), BytesToMiB(GetMemoryBytes()));
+
+	for (size_t l = 0; l < m_Levels.size(); ++l)
+		LOG_TRACE("  Level {}: {} unknowns, {} nonzeros", l, m_Levels[l].A.rows(), m_Levels[l].A.nonZeros());
+}
+
+} // namespace fem::solver::linear
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "MultigridLevel.h"
+#include "SmootherType.h"
+
+#include "../../SolverError.h"
+
+#include "math/math.h"
+
+#include <expected>
+#include <vector>
+
+namespace fem::solver::linear
+{
+
+/// <summary>
+/// Grid hierarchy and V-cycle shared by algebraic and geometric multigrid. Builders provide the
+/// fine-to-coarse operators and prolongations; Setup prepares smoothers and factorizes the coarsest level
+/// </summary>
+class MultigridHierarchy
+{
+public:
+	/// <summary>
+	/// Levels are ordered fine to coarse. Every level except the last one must have P set
+	/// </summary>
+	std::expected<void, SolverError> Setup(std::vector<MultigridLevel> levels, SmootherType smoother, size_t sweeps);
+
+	/// <summary>
+	/// One V-cycle on the finest level, x is used as the initial guess
+	/// </summary>
+	void VCycle(const Vec& b, Vec& x) const;
+
+	bool IsReady() const
+	{
+		return !m_Levels.empty();
+	}
+
+	size_t GetLevelsCount() const
+	{
+		return m_Levels.size();
+	}
+
+	/// <summary>
+	/// Sum of nonzeros of all level operators divided by nonzeros of the finest one
+	/// </summary>
+	double GetOperatorComplexity() const;
+
+	size_t GetMemoryBytes() const;
+
+	void LogSummary() const;
+
+private:
+	void Cycle(size_t level, const Vec& b, Vec& x) const;
+
+	std::vector<MultigridLevel> m_Levels;
+	Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> m_CoarseSolver;
+
+	SmootherType m_Smoother = SmootherType::Chebyshev;
+	size_t m_Sweeps = 2;
+};
+
+} // namespace fem::solver::linear
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "math/math.h"
+
+namespace fem::solver::linear
+{
+
+struct MultigridLevel
+{
+	CsrMat A;
+	CsrMat P; // Prolongation from the next coarser level (empty on the coarsest level)
+	CsrMat R; // Restriction to the next coarser level, P^T
+
+	Vec inverseDiagonal;
+	double spectralRadius = 0.0; // Estimate of rho(D^-1 A), bounds the smoother spectrum
+
+	// Cycle work vectors, sized once during setup
+	mutable Vec residual;
+	mutable Vec coarseRhs;
+	mutable Vec coarseCorrection;
+};
+
+} // namespace fem::solver::linear
@@ -0,0 +1,158 @@
+#include "MultigridSolver.h"
+
+#include "MultigridBuilder.h"
+
+#include "logger/logger.h"
+#include "metrics/metrics.h"
+#include "utils/utils.h"
+
+#include <cmath>
+
+namespace fem::solver::linear
+{
+
+MultigridSolver::MultigridSolver(const LinearSolverOptions& options, CoarseningType coarsening)
+	: m_Options(options),
+	m_Coarsening(coarsening)
+{
+}
+
+std::string MultigridSolver::GetName() const
+{
+	return std::format("{} ({} smoother)", MultigridBuilder::GetShortName(m_Coarsening), SmootherTypeToString(m_Options.smoother));
+}
+
+std::expected<LinearSolverResult, SolverError> MultigridSolver::Solve(const SpMat& A, const Vec& b)
+{
+	return SolveWithGuess(A, b, Vec::Zero(b.size()));
+}
+
+std::expected<LinearSolverResult, SolverError> MultigridSolver::SolveWithGuess(const SpMat& A, const Vec& b, const Vec& x0)
+{
+	if (A.rows() != A.cols())
+	{
+		return std::unexpected(
+			SolverError{
+				SolverErrorCode::InvalidInput,
+				"Matrix must be square"
+			}
+		);
+	}
+
+	if (A.rows() != b.size() || A.rows() != x0.size())
+	{
+		return std::unexpected(
+			SolverError{
+				SolverErrorCode::InvalidInput,
+				std::format("Matrix size ({}) doesn't match vector sizes (b: {}, x0: {})", A.rows(), b.size(), x0.size())
+			}
+		);
+	}
+
+	auto start = Now();
+
+	LinearSolverStats stats;
+	stats.matrixSize = A.rows();
+	stats.matrixNonZeros = A.nonZeros();
+
+	const auto fingerprint = MatrixFingerprint::Of(A);
+
+	if (!fingerprint.SameContent(m_HierarchyMatrix))
+	{
+		auto setupStart = Now();
+
+		m_HierarchyMatrix = {};
+
+		auto levels = MultigridBuilder::BuildLevels(m_Coarsening, A, m_Options);
+
+		if (!levels)
+			return std::unexpected(levels.error());
+
+		if (auto res = m_Hierarchy.Setup(std::move(*levels), m_Options.smoother, m_Options.smootherSweeps); !res)
+			return std::unexpected(res.error());
+
+		auto setupEnd = Now();
+		stats.preconditionerSetupTimeMs = ElapsedMs(setupStart, setupEnd);
+
+		m_Hierarchy.LogSummary();
+	}
+
+	// Kernels may read the arrays of A in place, so they are rebuilt whenever the arrays move
+	if (!fingerprint.SameStorage(m_HierarchyMatrix))
+		m_Product.emplace(A, m_Options.spmvBackend);
+
+	m_HierarchyMatrix = fingerprint;
+
+	auto solveStart = Now();
+
+	const size_t maxIterations = m_Options.maxIterations > 0
+		? m_Options.maxIterations
+		: static_cast<size_t>(A.rows());
+
+	const double bNorm = b.norm();
+	const double threshold = m_Options.tolerance * (bNorm > 0.0 ? bNorm : 1.0);
+
+	Vec x = x0;
+	Vec r;
+
+	m_Product->Residual(b, x, r);
+	double rNorm = r.norm();
+	size_t iteration = 0;
+
+	while (rNorm > threshold && iteration < maxIterations)
+	{
+		m_Hierarchy.VCycle(b, x);
+
+		++iteration;
+
+		m_Product->Residual(b, x, r);
+		rNorm = r.norm();
+
+		if (!std::isfinite(rNorm))
+		{
+			return std::unexpected(
+				SolverError{
+					SolverErrorCode::NumericalInstability,
+					std::format("{} diverged at iteration {}", MultigridBuilder::GetShortName(m_Coarsening), iteration)
+				}
+			);
+		}
+
+		if (m_Options.timeLimitMs > 0.0 && ElapsedMs(start, Now()) > m_Options.timeLimitMs)
+		{
+			return std::unexpected(
+				SolverError{
+					SolverErrorCode::TimeLimitExceeded,
+					std::format("{} stopped at iteration {}, time limit of {:.0f} ms reached", MultigridBuilder::GetShortName(m_Coarsening), iteration, m_Options.timeLimitMs)
+				}
+			);
+		}
+	}
+
+	auto solveEnd = Now();
+	stats.solveTimeMs = ElapsedMs(solveStart, solveEnd);
+	stats.iterations = iteration;
+
+	if (rNorm > threshold)
+	{
+		return std::unexpected(
+			SolverError{
+				SolverErrorCode::NumericalInstability,
+				std::format("{} did not converge in {} iterations (relative residual {:.2e})", MultigridBuilder::GetShortName(m_Coarsening), iteration, rNorm / (bNorm > 0.0 ? bNorm : 1.0))
+			}
+		);
+	}
+
+	stats.peakMemoryBytes = metrics::MemoryMonitor::GetPeakUsage();
+
+	auto end = Now();
+	stats.elapsedTimeMs = ElapsedMs(start, end);
+	stats.residualNorm = rNorm;
+
+	return LinearSolverResult{
+		.solution = std::move(x),
+		.stats = stats
+	};
+}
+
+} // namespace fem::solver::linear
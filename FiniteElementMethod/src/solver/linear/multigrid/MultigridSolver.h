@@ -0,0 +1,40 @@
+#pragma once
+
+#include "CoarseningType.h"
+#include "MultigridHierarchy.h"
+
+#include "../ILinearSolver.h"
+#include "../LinearSolverOptions.h"
+#include "../MatrixFingerprint.h"
+
+#include "math/math.h"
+
+#include <optional>
+
+namespace fem::solver::linear
+{
+
+/// <summary>
+/// Standalone multigrid (algebraic or geometric): repeated V-cycles until the relative residual drops
+/// below the tolerance. The hierarchy is built on the first solve and reused while the matrix is unchanged
+/// </summary>
+class MultigridSolver : public ILinearSolver
+{
+public:
+	MultigridSolver(const LinearSolverOptions& options, CoarseningType coarsening);
+
+	std::expected<LinearSolverResult, SolverError> Solve(const SpMat& A, const Vec& b) override;
+
+	std::expected<LinearSolverResult, SolverError> SolveWithGuess(const SpMat& A, const Vec& b, const Vec& x0) override;
+
+	std::string GetName() const override;
+
+private:
+	LinearSolverOptions m_Options;
+	CoarseningType m_Coarsening;
+	MultigridHierarchy m_Hierarchy;
+	MatrixFingerprint m_HierarchyMatrix;
+	std::optional<math::SpmvEngine> m_Product; // Built together with the hierarchy
+};
+
+} // namespace fem::solver::linear
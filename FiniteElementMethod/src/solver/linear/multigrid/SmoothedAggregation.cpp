@@ -0,0 +1,293 @@
+#include "SmoothedAggregation.h"
+
+#include "Smoother.h"
+
+#include "logger/logger.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace fem::solver::linear
+{
+
+using StorageIndex = CsrMat::StorageIndex;
+
+std::expected<std::vector<MultigridLevel>, SolverError> SmoothedAggregation::BuildLevels(const SpMat& A, const LinearSolverOptions& options)
+{
+	if (A.rows() != A.cols())
+		return std::unexpected(
+			SolverError{
+				SolverErrorCode::InvalidInput,
+				"Matrix must be square"
+			}
+		);
+
+	std::vector<MultigridLevel> levels;
+	levels.reserve(options.maxLevels);
+
+	levels.emplace_back();
+	levels.back().A = A;
+	levels.back().A.makeCompressed();
+
+	while (levels.size() < options.maxLevels && static_cast<size_t>(levels.back().A.rows()) > options.coarsestSize)
+	{
+		const CsrMat& fineA = levels.back().A;
+
+		StrengthGraph graph = BuildStrengthGraph(fineA, options.strengthThreshold);
+
+		StorageIndex aggregatesCount = 0;
+		auto aggregates = Aggregate(graph, &aggregatesCount);
+
+		if (aggregatesCount == 0 || aggregatesCount >= fineA.rows())
+		{
+			LOG_WARN("AMG coarsening stagnated at level {} ({} unknowns)", levels.size() - 1, fineA.rows());
+			break;
+		}
+
+		CsrMat T = BuildTentativeProlongator(aggregates, aggregatesCount);
+		CsrMat P = SmoothProlongator(fineA, T);
+		CsrMat R = P.transpose();
+
+		CsrMat coarseA = math::SparseOps::TripleProduct(R, fineA, P);
+
+		// Eigen sparse matrices have no move assignment, swap hands the arrays over without copying
+		levels.back().P.swap(P);
+		levels.back().R.swap(R);
+		levels.emplace_back().A.swap(coarseA);
+	}
+
+	return levels;
+}
+
+SmoothedAggregation::StrengthGraph SmoothedAggregation::BuildStrengthGraph(const CsrMat& A, double threshold)
+{
+	const StorageIndex* outer = A.outerIndexPtr();
+	const StorageIndex* inner = A.innerIndexPtr();
+	const double* values = A.valuePtr();
+
+	const Eigen::Index n = A.rows();
+	const Vec diagonal = A.diagonal().cwiseAbs();
+	const double thresholdSq = threshold * threshold;
+
+	auto isStrong = [&](Eigen::Index i, StorageIndex k) {
+		StorageIndex j = inner[k];
+		return j != i && values[k] * values[k] >= thresholdSq * diagonal[i] * diagonal[j];
+	};
+
+	StrengthGraph graph;
+	graph.offsets.assign(n + 1, 0);
+
+#pragma omp parallel for schedule(static)
+	for (Eigen::Index i = 0; i < n; ++i)
+	{
+		StorageIndex count = 0;
+
+		for (StorageIndex k = outer[i]; k < outer[i + 1]; ++k)
+			if (isStrong(i, k))
+				++count;
+
+		graph.offsets[i + 1] = count;
+	}
+
+	for (Eigen::Index i = 0; i < n; ++i)
+		graph.offsets[i + 1] += graph.offsets[i];
+
+	graph.neighbors.resize(graph.offsets[n]);
+
+#pragma omp parallel for schedule(static)
+	for (Eigen::Index i = 0; i < n; ++i)
+	{
+		StorageIndex pos = graph.offsets[i];
+
+		for (StorageIndex k = outer[i]; k < outer[i + 1]; ++k)
+			if (isStrong(i, k))
+				graph.neighbors[pos++] = inner[k];
+	}
+
+	return graph;
+}
+
+std::vector<StorageIndex> SmoothedAggregation::Aggregate(const StrengthGraph& graph, StorageIndex* aggregatesCount)
+{
+	enum State : std::uint64_t
+	{
+		Out = 0,
+		Undecided = 1,
+		In = 2,
+	};
+
+	constexpr StorageIndex Unassigned = -1;
+
+	const StorageIndex n = static_cast<StorageIndex>(graph.offsets.size() - 1);
+
+	std::vector<std::uint8_t> states(n, Undecided);
+
+	// Key orders nodes by (state, pseudo-random priority, index), so every key is unique
+	auto key = [&](StorageIndex i) {
+		std::uint64_t h = static_cast<std::uint64_t>(i) * 0x9E3779B97F4A7C15ull;
+		h ^= h >> 29;
+
+		return (static_cast<std::uint64_t>(states[i]) << 62)
+			| ((h & 0x3FFFFFFFull) << 32)
+			| static_cast<std::uint32_t>(i);
+	};
+
+	std::vector<std::uint64_t> distance1(n), distance2(n);
+	StorageIndex undecided = n;
+
+	// Distance-2 maximal independent set: a node joins when it holds the largest key within two hops
+	while (undecided > 0)
+	{
+#pragma omp parallel for schedule(static)
+		for (StorageIndex i = 0; i < n; ++i)
+		{
+			std::uint64_t best = key(i);
+
+			for (StorageIndex k = graph.offsets[i]; k < graph.offsets[i + 1]; ++k)
+				best = std::max<std::uint64_t>(best, key(graph.neighbors[k]));
+
+			distance1[i] = best;
+		}
+
+#pragma omp parallel for schedule(static)
+		for (StorageIndex i = 0; i < n; ++i)
+		{
+			std::uint64_t best = distance1[i];
+
+			for (StorageIndex k = graph.offsets[i]; k < graph.offsets[i + 1]; ++k)
+				best = std::max<std::uint64_t>(best, distance1[graph.neighbors[k]]);
+
+			distance2[i] = best;
+		}
+
+		undecided = 0;
+
+#pragma omp parallel for schedule(static) reduction(+:undecided)
+		for (StorageIndex i = 0; i < n; ++i)
+		{
+			if (states[i] != Undecided)
+				continue;
+
+			if (static_cast<StorageIndex>(distance2[i] & 0xFFFFFFFFull) == i)
+				states[i] = In;
+			else if ((distance2[i] >> 62) == In)
+				states[i] = Out;
+			else
+				++undecided;
+		}
+	}
+
+	// Every independent node roots an aggregate
+	std::vector<StorageIndex> aggregates(n, Unassigned);
+	StorageIndex count = 0;
+
+	for (StorageIndex i = 0; i < n; ++i)
+		if (states[i] == In)
+			aggregates[i] = count++;
+
+	// Roots are at least three hops apart, so each node sees at most one root among its neighbours
+#pragma omp parallel for schedule(static)
+	for (StorageIndex i = 0; i < n; ++i)
+	{
+		if (states[i] == In)
+			continue;
+
+		for (StorageIndex k = graph.offsets[i]; k < graph.offsets[i + 1]; ++k)
+		{
+			StorageIndex j = graph.neighbors[k];
+
+			if (states[j] == In)
+			{
+				aggregates[i] = aggregates[j];
+				break;
+			}
+		}
+	}
+
+	// Nodes two hops away from a root join the aggregate of a neighbour assigned above
+	std::vector<StorageIndex> joined = aggregates;
+
+#pragma omp parallel for schedule(static)
+	for (StorageIndex i = 0; i < n; ++i)
+	{
+		if (aggregates[i] != Unassigned)
+			continue;
+
+		for (StorageIndex k = graph.offsets[i]; k < graph.offsets[i + 1]; ++k)
+		{
+			StorageIndex j = graph.neighbors[k];
+
+			if (aggregates[j] != Unassigned)
+			{
+				joined[i] = aggregates[j];
+				break;
+			}
+		}
+	}
+
+	for (StorageIndex i = 0; i < n; ++i)
+		if (joined[i] == Unassigned)
+			joined[i] = count++;
+
+	*aggregatesCount = count;
+
+	return joined;
+}
+
+CsrMat SmoothedAggregation::BuildTentativeProlongator(const std::vector<StorageIndex>& aggregates, StorageIndex aggregatesCount)
+{
+	const StorageIndex n = static_cast<StorageIndex>(aggregates.size());
+
+	// Piecewise constant near-nullspace, columns normalized to unit length
+	std::vector<StorageIndex> sizes(aggregatesCount, 0);
+	for (StorageIndex aggregate : aggregates)
+		++sizes[aggregate];
+
+	CsrMat T(n, aggregatesCount);
+	T.makeCompressed();
+	T.resizeNonZeros(n);
+
+	StorageIndex* outer = T.outerIndexPtr();
+	StorageIndex* inner = T.innerIndexPtr();
+	double* values = T.valuePtr();
+
+#pragma omp parallel for schedule(static)
+	for (StorageIndex i = 0; i < n; ++i)
+	{
+		outer[i] = i;
+		inner[i] = aggregates[i];
+		values[i] = 1.0 / std::sqrt(static_cast<double>(sizes[aggregates[i]]));
+	}
+
+	outer[n] = n;
+
+	return T;
+}
+
+CsrMat SmoothedAggregation::SmoothProlongator(const CsrMat& A, const CsrMat& T)
+{
+	const Vec inverseDiagonal = A.diagonal().cwiseInverse();
+	const double omega = 4.0 / (3.0 * Smoother::EstimateSpectralRadius(A, inverseDiagonal));
+
+	CsrMat AT = math::SparseOps::Multiply(A, T);
+
+	const StorageIndex* outer = AT.outerIndexPtr();
+	double* values = AT.valuePtr();
+
+#pragma omp parallel for schedule(static)
+	for (Eigen::Index i = 0; i < AT.rows(); ++i)
+	{
+		const double scale = omega * inverseDiagonal[i];
+
+		for (StorageIndex k = outer[i]; k < outer[i + 1]; ++k)
+			values[k] *= scale;
+	}
+
+	CsrMat P = T - AT;
+	P.makeCompressed();
+
+	return P;
+}
+
+} // namespace fem::solver::linear
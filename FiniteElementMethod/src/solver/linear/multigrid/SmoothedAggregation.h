@@ -0,0 +1,51 @@
+#pragma once
+
+#include "MultigridLevel.h"
+
+#include "../LinearSolverOptions.h"
+#include "../../SolverError.h"
+
+#include "math/math.h"
+
+#include <expected>
+#include <vector>
+
+namespace fem::solver::linear
+{
+
+/// <summary>
+/// Smoothed-aggregation AMG coarsening. Every setup phase is parallel: the strength graph and
+/// prolongator smoothing are row-parallel, aggregates are grown around a distance-2 maximal
+/// independent set computed with parallel max-propagation sweeps (independent of node numbering)
+/// and Galerkin products use SparseOps::Multiply
+/// </summary>
+class SmoothedAggregation
+{
+public:
+	SmoothedAggregation() = delete;
+
+	static std::expected<std::vector<MultigridLevel>, SolverError> BuildLevels(const SpMat& A, const LinearSolverOptions& options);
+
+private:
+	struct StrengthGraph
+	{
+		std::vector<CsrMat::StorageIndex> offsets;
+		std::vector<CsrMat::StorageIndex> neighbors;
+	};
+
+	static StrengthGraph BuildStrengthGraph(const CsrMat& A, double threshold);
+
+	/// <summary>
+	/// Returns the aggregate index of every node
+	/// </summary>
+	static std::vector<CsrMat::StorageIndex> Aggregate(const StrengthGraph& graph, CsrMat::StorageIndex* aggregatesCount);
+
+	static CsrMat BuildTentativeProlongator(const std::vector<CsrMat::StorageIndex>& aggregates, CsrMat::StorageIndex aggregatesCount);
+
+	/// <summary>
+	/// P = (I - w D^-1 A) T with w = 4 / (3 rho(D^-1 A))
+	/// </summary>
+	static CsrMat SmoothProlongator(const CsrMat& A, const CsrMat& T);
+};
+
+} // namespace fem::solver::linear
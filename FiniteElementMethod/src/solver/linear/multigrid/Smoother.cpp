@@ -0,0 +1,120 @@
+#include "Smoother.h"
+
+#include <cmath>
+#include <omp.h>
+
+namespace fem::solver::linear
+{
+
+void Smoother::Smooth(SmootherType type, const MultigridLevel& level, const Vec& b, Vec& x, size_t sweeps)
+{
+	using enum SmootherType;
+
+	switch (type)
+	{
+	case Jacobi:
+		Smoother::Jacobi(level, b, x, sweeps);
+		return;
+
+	case Chebyshev:
+		Smoother::Chebyshev(level, b, x, sweeps);
+		return;
+	}
+}
+
+void Smoother::Jacobi(const MultigridLevel& level, const Vec& b, Vec& x, size_t sweeps)
+{
+	const double omega = 4.0 / (3.0 * level.spectralRadius);
+
+	Vec& r = level.residual;
+
+	for (size_t sweep = 0; sweep < sweeps; ++sweep)
+	{
+		ScaledResidual(level, b, x, r);
+		x += omega * r;
+	}
+}
+
+void Smoother::Chebyshev(const MultigridLevel& level, const Vec& b, Vec& x, size_t degree)
+{
+	const double upper = 1.1 * level.spectralRadius;
+	const double lower = 0.3 * level.spectralRadius;
+
+	const double theta = 0.5 * (upper + lower);
+	const double delta = 0.5 * (upper - lower);
+	const double sigma = theta / delta;
+
+	double rho = 1.0 / sigma;
+
+	Vec& z = level.residual;
+	ScaledResidual(level, b, x, z);
+
+	Vec d = z / theta;
+
+	for (size_t k = 0; k < degree; ++k)
+	{
+		x += d;
+
+		if (k + 1 == degree)
+			break;
+
+		ScaledResidual(level, b, x, z);
+
+		double rhoNext = 1.0 / (2.0 * sigma - rho);
+		d = (rhoNext * rho) * d + (2.0 * rhoNext / delta) * z;
+		rho = rhoNext;
+	}
+}
+
+double Smoother::EstimateSpectralRadius(const CsrMat& A, const Vec& inverseDiagonal, size_t iterations)
+{
+	const Eigen::Index n = A.rows();
+
+	// Deterministic, non-smooth start vector so runs are reproducible
+	Vec v(n);
+	for (Eigen::Index i = 0; i < n; ++i)
+		v[i] = 1.0 + 0.1 * static_cast<double>(i % 7);
+
+	v.normalize();
+
+	double lambda = 0.0;
+
+	for (size_t it = 0; it < iterations; ++it)
+	{
+		Vec w = inverseDiagonal.cwiseProduct(A * v);
+		lambda = w.norm();
+
+		if (lambda == 0.0)
+			break;
+
+		v = w / lambda;
+	}
+
+	return lambda;
+}
+
+void Smoother::ScaledResidual(const MultigridLevel& level, const Vec& b, const Vec& x, Vec& r)
+{
+	using StorageIndex = CsrMat::StorageIndex;
+
+	const CsrMat& A = level.A;
+	const StorageIndex* outer = A.outerIndexPtr();
+	const StorageIndex* inner = A.innerIndexPtr();
+	const double* values = A.valuePtr();
+
+	const Eigen::Index n = A.rows();
+	r.resize(n);
+
+#pragma omp parallel for schedule(static)
+	for (Eigen::Index i = 0; i < n; ++i)
+	{
+		double sum = b[i];
+
+		for (StorageIndex k = outer[i]; k < outer[i + 1]; ++k)
+			sum -= values[k] * x[inner[k]];
+
+		r[i] = level.inverseDiagonal[i] * sum;
+	}
+}
+
+} // namespace fem::solver::linear
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "MultigridLevel.h"
+#include "SmootherType.h"
+
+#include "math/math.h"
+
+namespace fem::solver::linear
+{
+
+/// <summary>
+/// Parallel point smoothers used inside multigrid cycles. Both are symmetric, so a V-cycle
+/// with equal pre- and post-smoothing is a valid SPD preconditioner for CG
+/// </summary>
+class Smoother
+{
+public:
+	Smoother() = delete;
+
+	static void Smooth(SmootherType type, const MultigridLevel& level, const Vec& b, Vec& x, size_t sweeps);
+
+	/// <summary>
+	/// x += w * D^-1 (b - A x) with w = 4 / (3 rho)
+	/// </summary>
+	static void Jacobi(const MultigridLevel& level, const Vec& b, Vec& x, size_t sweeps);
+
+	/// <summary>
+	/// Chebyshev polynomial of D^-1 A targeting the upper part [0.3 rho, 1.1 rho] of the spectrum.
+	/// Lower end of the spectrum is left to the coarse-grid correction
+	/// </summary>
+	static void Chebyshev(const MultigridLevel& level, const Vec& b, Vec& x, size_t degree);
+
+	/// <summary>
+	/// Power iteration estimate of the largest eigenvalue of D^-1 A
+	/// </summary>
+	static double EstimateSpectralRadius(const CsrMat& A, const Vec& inverseDiagonal, size_t iterations = 15);
+
+private:
+	/// <summary>
+	/// r = D^-1 (b - A x), row-parallel
+	/// </summary>
+	static void ScaledResidual(const MultigridLevel& level, const Vec& b, const Vec& x, Vec& r);
+};
+
+} // namespace fem::solver::linear
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <array>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace fem::solver::linear
+{
+
+enum class SmootherType : int
+{
+	Jacobi = 0,
+	Chebyshev,
+};
+
+struct SmootherInfo
+{
+	SmootherType type;
+	std::string name;
+	std::string description;
+};
+
+inline static const std::array<SmootherInfo, 2> SMOOTHERS = { {
+	{ SmootherType::Jacobi,    "jacobi",    "Weighted Jacobi" },
+	{ SmootherType::Chebyshev, "chebyshev", "Chebyshev polynomial of D^-1 A (default)" }
+} };
+
+inline std::optional<SmootherType> ParseSmootherType(std::string_view str)
+{
+	using enum SmootherType;
+
+	if (str == "jacobi") return Jacobi;
+	else if (str == "chebyshev") return Chebyshev;
+
+	return std::nullopt;
+}
+
+inline std::string_view SmootherTypeToString(SmootherType type)
+{
+	for (const auto& info : SMOOTHERS)
+		if (info.type == type)
+			return info.name;
+
+	std::unreachable();
+}
+
+} // namespace fem::solver::linear
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "CoarseningType.h"
+#include "GeometricCoarsening.h"
+#include "MultigridHierarchy.h"
+#include "MultigridBuilder.h"
+#include "MultigridLevel.h"
+#include "MultigridSolver.h"
+#include "SmoothedAggregation.h"
+#include "Smoother.h"
+#include "SmootherType.h"
@@ -0,0 +1,181 @@
+#include "ConjugateGradientSolver.h"
+
+#include "../preconditioner/PreconditionerFactory.h"
+
+#include "logger/logger.h"
+#include "metrics/metrics.h"
+#include "utils/utils.h"
+
+namespace fem::solver::linear
+{
+
+ConjugateGradientSolver::ConjugateGradientSolver(const LinearSolverOptions& options)
+	: m_Options(options),
+	m_Preconditioner(PreconditionerFactory::Create(options.preconditioner, options))
+{
+}
+
+std::string ConjugateGradientSolver::GetName() const
+{
+	return std::format("PCG ({})", m_Preconditioner->GetName());
+}
+
+std::expected<LinearSolverResult, SolverError> ConjugateGradientSolver::Solve(const SpMat& A, const Vec& b)
+{
+	return SolveWithGuess(A, b, Vec::Zero(b.size()));
+}
+
+std::expected<LinearSolverResult, SolverError> ConjugateGradientSolver::SolveWithGuess(const SpMat& A, const Vec& b, const Vec& x0)
+{
+	if (A.rows() != A.cols())
+	{
+		return std::unexpected(
+			SolverError{
+				SolverErrorCode::InvalidInput,
+				"Matrix must be square"
+			}
+		);
+	}
+
+	if (A.rows() != b.size() || A.rows() != x0.size())
+	{
+		return std::unexpected(
+			SolverError{
+				SolverErrorCode::InvalidInput,
+				std::format("Matrix size ({}) doesn't match vector sizes (b: {}, x0: {})", A.rows(), b.size(), x0.size())
+			}
+		);
+	}
+
+	auto start = Now();
+
+	LinearSolverStats stats;
+	stats.matrixSize = A.rows();
+	stats.matrixNonZeros = A.nonZeros();
+
+	const auto fingerprint = MatrixFingerprint::Of(A);
+
+	if (!fingerprint.SameContent(m_PreconditionedMatrix))
+	{
+		auto setupStart = Now();
+
+		if (!m_Preconditioner->Compute(A))
+		{
+			m_PreconditionedMatrix = {};
+
+			return std::unexpected(
+				SolverError{
+					SolverErrorCode::NumericalInstability,
+					std::format("{} preconditioner setup failed", m_Preconditioner->GetName())
+				}
+			);
+		}
+
+		auto setupEnd = Now();
+		stats.preconditionerSetupTimeMs = ElapsedMs(setupStart, setupEnd);
+	}
+
+	// Kernels may read the arrays of A in place, so they are rebuilt whenever the arrays move
+	if (!fingerprint.SameStorage(m_PreconditionedMatrix))
+		m_Product.emplace(A, m_Options.spmvBackend);
+
+	m_PreconditionedMatrix = fingerprint;
+
+	auto solveStart = Now();
+
+	const size_t maxIterations = m_Options.maxIterations > 0
+		? m_Options.maxIterations
+		: static_cast<size_t>(A.rows());
+
+	const double bNorm = b.norm();
+	const double threshold = m_Options.tolerance * (bNorm > 0.0 ? bNorm : 1.0);
+
+	Vec x = x0;
+	Vec r = m_Product->Residual(b, x);
+	Vec z(x.size());
+	Vec p(x.size());
+	Vec Ap(x.size());
+
+	double rNorm = r.norm();
+	size_t iteration = 0;
+
+	if (rNorm > threshold)
+	{
+		m_Preconditioner->Apply(r, z);
+		p = z;
+
+		double rz = r.dot(z);
+
+		while (iteration < maxIterations)
+		{
+			m_Product->Multiply(p, Ap);
+
+			double pAp = p.dot(Ap);
+
+			if (pAp <= 0.0)
+			{
+				return std::unexpected(
+					SolverError{
+						SolverErrorCode::NumericalInstability,
+						std::format("PCG breakdown at iteration {} - matrix is not positive definite", iteration)
+					}
+				);
+			}
+
+			double alpha = rz / pAp;
+			x += alpha * p;
+			r -= alpha * Ap;
+
+			++iteration;
+			rNorm = r.norm();
+
+			if (rNorm <= threshold)
+				break;
+
+			if (m_Options.timeLimitMs > 0.0 && ElapsedMs(start, Now()) > m_Options.timeLimitMs)
+			{
+				return std::unexpected(
+					SolverError{
+						SolverErrorCode::TimeLimitExceeded,
+						std::format("PCG stopped at iteration {}, time limit of {:.0f} ms reached", iteration, m_Options.timeLimitMs)
+					}
+				);
+			}
+
+			m_Preconditioner->Apply(r, z);
+
+			double rzNew = r.dot(z);
+			double beta = rzNew / rz;
+			rz = rzNew;
+
+			p = z + beta * p;
+		}
+	}
+
+	auto solveEnd = Now();
+	stats.solveTimeMs = ElapsedMs(solveStart, solveEnd);
+	stats.iterations = iteration;
+
+	if (rNorm > threshold)
+	{
+		return std::unexpected(
+			SolverError{
+				SolverErrorCode::NumericalInstability,
+				std::format("PCG did not converge in {} iterations (relative residual {:.2e})", iteration, rNorm / (bNorm > 0.0 ? bNorm : 1.0))
+			}
+		);
+	}
+
+	stats.peakMemoryBytes = metrics::MemoryMonitor::GetPeakUsage();
+
+	auto end = Now();
+	stats.elapsedTimeMs = ElapsedMs(start, end);
+	stats.residualNorm = m_Product->Residual(b, x).norm();
+
+	return LinearSolverResult{
+		.solution = std::move(x),
+		.stats = stats
+	};
+}
+
+} // namespace fem::solver::linear
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "../ILinearSolver.h"
+#include "../LinearSolverOptions.h"
+#include "../MatrixFingerprint.h"
+#include "../preconditioner/IPreconditioner.h"
+
+#include "math/math.h"
+
+#include <memory>
+#include <optional>
+
+namespace fem::solver::linear
+{
+
+/// <summary>
+/// Preconditioned conjugate gradient for SPD systems. The preconditioner is built on the first
+/// solve and reused as long as the same matrix is passed, so a transient loop pays for it once
+/// </summary>
+class ConjugateGradientSolver : public ILinearSolver
+{
+public:
+	explicit ConjugateGradientSolver(const LinearSolverOptions& options = {});
+
+	std::expected<LinearSolverResult, SolverError> Solve(const SpMat& A, const Vec& b) override;
+
+	std::expected<LinearSolverResult, SolverError> SolveWithGuess(const SpMat& A, const Vec& b, const Vec& x0) override;
+
+	std::string GetName() const override;
+
+private:
+	LinearSolverOptions m_Options;
+	std::unique_ptr<IPreconditioner> m_Preconditioner;
+	MatrixFingerprint m_PreconditionedMatrix;
+	std::optional<math::SpmvEngine> m_Product; // Built together with the preconditioner
+};
+
+} // namespace fem::solver::linear
@@ -0,0 +1,212 @@
+#include "DeflatedConjugateGradientSolver.h"
+
+#include "../preconditioner/PreconditionerFactory.h"
+
+#include "logger/logger.h"
+#include "metrics/metrics.h"
+#include "utils/utils.h"
+
+namespace fem::solver::linear
+{
+
+DeflatedConjugateGradientSolver::DeflatedConjugateGradientSolver(const LinearSolverOptions& options)
+	: m_Options(options),
+	m_Preconditioner(PreconditionerFactory::Create(options.preconditioner, options)),
+	m_Subspace(options.recycleSize),
+	m_Harvester(options.recycleSize)
+{
+}
+
+std::string DeflatedConjugateGradientSolver::GetName() const
+{
+	return std::format("Deflated PCG ({}, {} recycled vectors)", m_Preconditioner->GetName(), m_Subspace.GetCapacity());
+}
+
+std::expected<LinearSolverResult, SolverError> DeflatedConjugateGradientSolver::Solve(const SpMat& A, const Vec& b)
+{
+	return SolveWithGuess(A, b, Vec::Zero(b.size()));
+}
+
+std::expected<LinearSolverResult, SolverError> DeflatedConjugateGradientSolver::SolveWithGuess(const SpMat& A, const Vec& b, const Vec& x0)
+{
+	if (A.rows() != A.cols())
+	{
+		return std::unexpected(
+			SolverError{
+				SolverErrorCode::InvalidInput,
+				"Matrix must be square"
+			}
+		);
+	}
+
+	if (A.rows() != b.size() || A.rows() != x0.size())
+	{
+		return std::unexpected(
+			SolverError{
+				SolverErrorCode::InvalidInput,
+				std::format("Matrix size ({}) doesn't match vector sizes (b: {}, x0: {})", A.rows(), b.size(), x0.size())
+			}
+		);
+	}
+
+	auto start = Now();
+
+	LinearSolverStats stats;
+	stats.matrixSize = A.rows();
+	stats.matrixNonZeros = A.nonZeros();
+
+	const auto fingerprint = MatrixFingerprint::Of(A);
+
+	if (!fingerprint.SameContent(m_PreconditionedMatrix))
+	{
+		auto setupStart = Now();
+
+		if (!m_Preconditioner->Compute(A))
+		{
+			m_PreconditionedMatrix = {};
+
+			return std::unexpected(
+				SolverError{
+					SolverErrorCode::NumericalInstability,
+					std::format("{} preconditioner setup failed", m_Preconditioner->GetName())
+				}
+			);
+		}
+
+		auto setupEnd = Now();
+		stats.preconditionerSetupTimeMs = ElapsedMs(setupStart, setupEnd);
+	}
+
+	// Kernels may read the arrays of A in place, so they are rebuilt whenever the arrays move
+	if (!fingerprint.SameStorage(m_PreconditionedMatrix))
+		m_Product.emplace(A, m_Options.spmvBackend);
+
+	m_PreconditionedMatrix = fingerprint;
+
+	auto solveStart = Now();
+
+	m_Subspace.Bind(A, fingerprint);
+
+	const size_t maxIterations = m_Options.maxIterations > 0
+		? m_Options.maxIterations
+		: static_cast<size_t>(A.rows());
+
+	const double bNorm = b.norm();
+	const double threshold = m_Options.tolerance * (bNorm > 0.0 ? bNorm : 1.0);
+
+	Vec x = x0;
+	Vec r = m_Product->Residual(b, x);
+	Vec z(x.size());
+	Vec p(x.size());
+	Vec Ap(x.size());
+
+	m_Subspace.Correct(x, r);
+
+	double rNorm = r.norm();
+	size_t iteration = 0;
+
+	if (rNorm > threshold)
+	{
+		m_Preconditioner->Apply(r, z);
+
+		double rz = r.dot(z);
+
+		m_Subspace.Deflate(z);
+		p = z;
+
+		// Harvesting costs a few dense updates per iteration, stop once the subspace has settled
+		if (!m_Subspace.IsConverged())
+			m_Harvester.Begin(z, rz);
+		else
+			m_Harvester.Stop();
+
+		while (iteration < maxIterations)
+		{
+			m_Product->Multiply(p, Ap);
+
+			double pAp = p.dot(Ap);
+
+			if (pAp <= 0.0)
+			{
+				return std::unexpected(
+					SolverError{
+						SolverErrorCode::NumericalInstability,
+						std::format("Deflated PCG breakdown at iteration {} - matrix is not positive definite", iteration)
+					}
+				);
+			}
+
+			double alpha = rz / pAp;
+			x += alpha * p;
+			r -= alpha * Ap;
+
+			m_Harvester.Advance(alpha);
+
+			++iteration;
+			rNorm = r.norm();
+
+			if (rNorm <= threshold)
+				break;
+
+			if (m_Options.timeLimitMs > 0.0 && ElapsedMs(start, Now()) > m_Options.timeLimitMs)
+			{
+				return std::unexpected(
+					SolverError{
+						SolverErrorCode::TimeLimitExceeded,
+						std::format("Deflated PCG stopped at iteration {}, time limit of {:.0f} ms reached", iteration, m_Options.timeLimitMs)
+					}
+				);
+			}
+
+			m_Preconditioner->Apply(r, z);
+
+			double rzNew = r.dot(z);
+			double beta = rzNew / rz;
+			rz = rzNew;
+
+			m_Subspace.Deflate(z);
+			m_Harvester.Append(z, rz, beta);
+			p = z + beta * p;
+		}
+	}
+
+	if (rNorm > threshold)
+	{
+		return std::unexpected(
+			SolverError{
+				SolverErrorCode::NumericalInstability,
+				std::format("Deflated PCG did not converge in {} iterations (relative residual {:.2e})", iteration, rNorm / (bNorm > 0.0 ? bNorm : 1.0))
+			}
+		);
+	}
+
+	if (iteration > 0 && m_Harvester.IsActive())
+	{
+		Eigen::MatrixXd ritz = m_Harvester.Extract();
+		Eigen::MatrixXd Aritz(ritz.rows(), ritz.cols());
+
+		for (Eigen::Index j = 0; j < ritz.cols(); ++j)
+			Aritz.col(j).noalias() = A * ritz.col(j);
+
+		m_Subspace.Update(ritz, Aritz, ritz.cols());
+	}
+
+	auto solveEnd = Now();
+	stats.solveTimeMs = ElapsedMs(solveStart, solveEnd);
+	stats.iterations = iteration;
+	stats.recycledVectors = m_Subspace.GetSize();
+	stats.recycledSubspaceBytes = m_Subspace.GetMemoryBytes() + m_Harvester.GetMemoryBytes();
+
+	stats.peakMemoryBytes = metrics::MemoryMonitor::GetPeakUsage();
+
+	auto end = Now();
+	stats.elapsedTimeMs = ElapsedMs(start, end);
+	stats.residualNorm = m_Product->Residual(b, x).norm();
+
+	return LinearSolverResult{
+		.solution = std::move(x),
+		.stats = stats
+	};
+}
+
+} // namespace fem::solver::linear
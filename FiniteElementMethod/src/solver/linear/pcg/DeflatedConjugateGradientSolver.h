@@ -0,0 +1,45 @@
+#pragma once
+
+#include "LanczosHarvester.h"
+#include "RecycledSubspace.h"
+
+#include "../ILinearSolver.h"
+#include "../LinearSolverOptions.h"
+#include "../MatrixFingerprint.h"
+#include "../preconditioner/IPreconditioner.h"
+
+#include "math/math.h"
+
+#include <memory>
+#include <optional>
+
+namespace fem::solver::linear
+{
+
+/// <summary>
+/// Deflated PCG with Krylov subspace recycling for sequences of related SPD systems. Ritz vectors harvested
+/// from each solve refine a small set of approximate slow eigenvectors that is projected out of the
+/// next solve, so iteration counts drop after the first few steps of a transient run
+/// </summary>
+class DeflatedConjugateGradientSolver : public ILinearSolver
+{
+public:
+	explicit DeflatedConjugateGradientSolver(const LinearSolverOptions& options = {});
+
+	std::expected<LinearSolverResult, SolverError> Solve(const SpMat& A, const Vec& b) override;
+
+	std::expected<LinearSolverResult, SolverError> SolveWithGuess(const SpMat& A, const Vec& b, const Vec& x0) override;
+
+	std::string GetName() const override;
+
+private:
+	LinearSolverOptions m_Options;
+	std::unique_ptr<IPreconditioner> m_Preconditioner;
+	MatrixFingerprint m_PreconditionedMatrix;
+	std::optional<math::SpmvEngine> m_Product; // Built together with the preconditioner
+
+	RecycledSubspace m_Subspace;
+	LanczosHarvester m_Harvester;
+};
+
+} // namespace fem::solver::linear
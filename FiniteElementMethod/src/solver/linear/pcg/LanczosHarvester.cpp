@@ -0,0 +1,128 @@
+#include "LanczosHarvester.h"
+
+#include <Eigen/Eigenvalues>
+#include <Eigen/QR>
+
+#include <cmath>
+
+namespace fem::solver::linear
+{
+
+LanczosHarvester::LanczosHarvester(size_t count)
+	: m_Count(static_cast<Eigen::Index>(count)),
+	m_Window(4 * static_cast<Eigen::Index>(count))
+{
+}
+
+void LanczosHarvester::Begin(const Vec& z, double rz)
+{
+	m_Columns = 0;
+	m_Alpha = 0.0;
+	m_Beta = 0.0;
+	m_Active = m_Count > 0 && rz > 0.0;
+
+	if (!m_Active)
+		return;
+
+	if (m_V.rows() != z.size() || m_V.cols() != m_Window)
+	{
+		m_V.resize(z.size(), m_Window);
+		m_Restart.resize(z.size(), 2 * m_Count);
+	}
+
+	m_T = Eigen::MatrixXd::Zero(m_Window, m_Window);
+
+	m_V.col(0) = z / std::sqrt(rz);
+	m_Columns = 1;
+}
+
+void LanczosHarvester::Advance(double alpha)
+{
+	if (!m_Active)
+		return;
+
+	const Eigen::Index j = m_Columns - 1;
+
+	m_T(j, j) = 1.0 / alpha + (m_Alpha > 0.0 ? m_Beta / m_Alpha : 0.0);
+	m_Alpha = alpha;
+}
+
+void LanczosHarvester::Append(const Vec& z, double rz, double beta)
+{
+	if (!m_Active)
+		return;
+
+	if (rz <= 0.0)
+	{
+		m_Active = false;
+		return;
+	}
+
+	const double offDiagonal = -std::sqrt(beta) / m_Alpha;
+	m_Beta = beta;
+
+	if (m_Columns == m_Window)
+	{
+		Restart();
+
+		// Coupling of the new vector to the restarted block follows from A V = V T + t v e_m^T
+		const Eigen::Index k = m_Columns;
+		m_T.col(k).head(k) = offDiagonal * m_Coupling;
+		m_T.row(k).head(k) = offDiagonal * m_Coupling.transpose();
+	}
+	else
+	{
+		const Eigen::Index j = m_Columns - 1;
+		m_T(j, j + 1) = offDiagonal;
+		m_T(j + 1, j) = offDiagonal;
+	}
+
+	m_V.col(m_Columns) = z / std::sqrt(rz);
+	++m_Columns;
+}
+
+void LanczosHarvester::Restart()
+{
+	const Eigen::Index m = m_Columns;
+	const Eigen::Index k = m_Count;
+
+	// Smallest Ritz vectors of T_m and T_{m-1} - keeping both preserves the CG three-term history
+	Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> full(m_T.topLeftCorner(m, m));
+	Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> previous(m_T.topLeftCorner(m - 1, m - 1));
+
+	Eigen::MatrixXd Y = Eigen::MatrixXd::Zero(m, 2 * k);
+	Y.leftCols(k) = full.eigenvectors().leftCols(k);
+	Y.block(0, k, m - 1, k) = previous.eigenvectors().leftCols(k);
+
+	Eigen::HouseholderQR<Eigen::MatrixXd> qr(Y);
+	Eigen::MatrixXd Q = qr.householderQ() * Eigen::MatrixXd::Identity(m, 2 * k);
+
+	Eigen::MatrixXd H = Q.transpose() * m_T.topLeftCorner(m, m) * Q;
+	Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> projected(0.5 * (H + H.transpose()));
+
+	Eigen::MatrixXd QZ = Q * projected.eigenvectors();
+
+	m_Restart.noalias() = m_V.leftCols(m) * QZ;
+	m_V.leftCols(2 * k) = m_Restart;
+
+	m_Coupling = QZ.row(m - 1).transpose();
+
+	m_T.setZero();
+	m_T.topLeftCorner(2 * k, 2 * k) = projected.eigenvalues().asDiagonal();
+	m_Columns = 2 * k;
+}
+
+Eigen::MatrixXd LanczosHarvester::Extract() const
+{
+	// The last vector only has a diagonal entry once its step length is known
+	const Eigen::Index m = m_Active ? m_Columns - (m_T(m_Columns - 1, m_Columns - 1) == 0.0 ? 1 : 0) : 0;
+
+	if (m < m_Count)
+		return {};
+
+	Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eigen(m_T.topLeftCorner(m, m));
+
+	return m_V.leftCols(m) * eigen.eigenvectors().leftCols(m_Count);
+}
+
+} // namespace fem::solver::linear
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "math/math.h"
+
+#include <Eigen/Dense>
+
+namespace fem::solver::linear
+{
+
+/// <summary>
+/// Extracts approximate eigenvectors from a running CG solve (eigCG). The CG coefficients define the
+/// Lanczos tridiagonal matrix; preconditioned residuals are kept in a fixed window that is thick-restarted
+/// to the smallest Ritz vectors whenever it fills up, so memory stays bounded however long the solve runs
+/// </summary>
+class LanczosHarvester
+{
+public:
+	explicit LanczosHarvester(size_t count);
+
+	/// <summary>
+	/// First Lanczos vector, z = M^-1 r and rz = r^T z of the initial residual
+	/// </summary>
+	void Begin(const Vec& z, double rz);
+
+	void Stop()
+	{
+		m_Active = false;
+	}
+
+	bool IsActive() const
+	{
+		return m_Active;
+	}
+
+	/// <summary>
+	/// Records the step length alpha of the current CG iteration
+	/// </summary>
+	void Advance(double alpha);
+
+	/// <summary>
+	/// Next Lanczos vector from the new preconditioned residual and the CG beta
+	/// </summary>
+	void Append(const Vec& z, double rz, double beta);
+
+	/// <summary>
+	/// Ritz vectors of the smallest Ritz values seen so far, at most `count` columns
+	/// </summary>
+	Eigen::MatrixXd Extract() const;
+
+	size_t GetMemoryBytes() const
+	{
+		return static_cast<size_t>(m_V.size() + m_Restart.size()) * sizeof(double);
+	}
+
+private:
+	void Restart();
+
+	Eigen::Index m_Count;
+	Eigen::Index m_Window;
+
+	Eigen::MatrixXd m_V;       // Lanczos vectors, M-orthonormal
+	Eigen::MatrixXd m_T;       // Projection V^T A V, tridiagonal apart from the restarted block
+	Eigen::MatrixXd m_Restart; // Scratch for V * Q
+	Eigen::VectorXd m_Coupling;
+
+	Eigen::Index m_Columns = 0;
+	double m_Alpha = 0.0;
+	double m_Beta = 0.0;
+	bool m_Active = false;
+};
+
+} // namespace fem::solver::linear
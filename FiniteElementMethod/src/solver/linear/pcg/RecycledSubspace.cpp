@@ -0,0 +1,141 @@
+#include "RecycledSubspace.h"
+
+#include "logger/logger.h"
+
+#include <Eigen/Eigenvalues>
+
+#include <cmath>
+
+namespace fem::solver::linear
+{
+
+RecycledSubspace::RecycledSubspace(size_t capacity)
+	: m_Capacity(capacity)
+{
+}
+
+void RecycledSubspace::Bind(const SpMat& A, const MatrixFingerprint& fingerprint)
+{
+	if (fingerprint.SameContent(m_Operator))
+		return;
+
+	m_Operator = fingerprint;
+	m_Converged = false;
+
+	if (Empty())
+		return;
+
+	if (m_W.rows() != A.rows())
+	{
+		m_W.resize(0, 0);
+		m_AW.resize(0, 0);
+		m_RitzValues.resize(0);
+		return;
+	}
+
+	m_AW.resize(m_W.rows(), m_W.cols());
+
+	for (Eigen::Index j = 0; j < m_W.cols(); ++j)
+		m_AW.col(j).noalias() = A * m_W.col(j);
+
+	Factorize();
+}
+
+void RecycledSubspace::Correct(Vec& x, Vec& r) const
+{
+	if (Empty())
+		return;
+
+	Vec mu = m_E.solve(m_W.transpose() * r);
+
+	x.noalias() += m_W * mu;
+	r.noalias() -= m_AW * mu;
+}
+
+void RecycledSubspace::Deflate(Vec& v) const
+{
+	if (Empty())
+		return;
+
+	Vec mu = m_E.solve(m_AW.transpose() * v);
+
+	v.noalias() -= m_W * mu;
+}
+
+void RecycledSubspace::Update(const Eigen::MatrixXd& P, const Eigen::MatrixXd& AP, Eigen::Index count)
+{
+	if (m_Capacity == 0 || count == 0)
+		return;
+
+	const Eigen::Index k = m_W.cols();
+	const Eigen::Index m = k + count;
+
+	Eigen::MatrixXd Z(P.rows(), m);
+	Eigen::MatrixXd AZ(P.rows(), m);
+
+	if (k > 0)
+	{
+		Z.leftCols(k) = m_W;
+		AZ.leftCols(k) = m_AW;
+	}
+
+	Z.rightCols(count) = P.leftCols(count);
+	AZ.rightCols(count) = AP.leftCols(count);
+
+	// Unit A-norm columns keep the projected pencil well scaled
+	for (Eigen::Index j = 0; j < m; ++j)
+	{
+		double norm = std::sqrt(Z.col(j).dot(AZ.col(j)));
+
+		if (norm > 0.0 && std::isfinite(norm))
+		{
+			Z.col(j) /= norm;
+			AZ.col(j) /= norm;
+		}
+	}
+
+	Eigen::MatrixXd G = Z.transpose() * AZ;
+	G = 0.5 * (G + G.transpose()).eval();
+	Eigen::MatrixXd F = Z.transpose() * Z;
+
+	// Z^T Z y = (1 / theta) Z^T A Z y - the largest eigenvalues belong to the smallest Ritz values of A,
+	// and the eigenvectors come out normalized so that Y^T G Y = I
+	Eigen::GeneralizedSelfAdjointEigenSolver<Eigen::MatrixXd> eigen(F, G);
+
+	if (eigen.info() != Eigen::Success)
+	{
+		LOG_WARN("Recycled subspace update failed, keeping the previous {} vectors", k);
+		return;
+	}
+
+	const Eigen::Index keep = std::min<Eigen::Index>(static_cast<Eigen::Index>(m_Capacity), m);
+	Eigen::MatrixXd Y = eigen.eigenvectors().rightCols(keep);
+	Eigen::VectorXd ritzValues = eigen.eigenvalues().tail(keep).cwiseInverse();
+
+	m_Converged = m_RitzValues.size() == keep
+		&& ((ritzValues - m_RitzValues).cwiseAbs().array() <= RitzTolerance * ritzValues.array().abs()).all();
+	m_RitzValues = std::move(ritzValues);
+
+	m_W = Z * Y;
+	m_AW = AZ * Y;
+
+	Factorize();
+}
+
+void RecycledSubspace::Factorize()
+{
+	Eigen::MatrixXd E = m_W.transpose() * m_AW;
+	m_E.compute(0.5 * (E + E.transpose()));
+
+	if (m_E.info() != Eigen::Success)
+	{
+		LOG_WARN("Recycled subspace lost positive definiteness, discarding {} vectors", m_W.cols());
+
+		m_W.resize(0, 0);
+		m_AW.resize(0, 0);
+		m_RitzValues.resize(0);
+		m_Converged = false;
+	}
+}
+
+} // namespace fem::solver::linear
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "../MatrixFingerprint.h"
+
+#include "math/math.h"
+
+#include <Eigen/Dense>
+
+namespace fem::solver::linear
+{
+
+/// <summary>
+/// Approximate eigenvectors of the smallest eigenvalues carried from one solve to the next.
+/// Stores W, AW and the Cholesky factor of W^T A W; the basis itself survives matrix changes
+/// and only AW is recomputed when a different operator is bound. Once the Ritz values stop moving
+/// the subspace reports itself converged so callers can skip further harvesting
+/// </summary>
+class RecycledSubspace
+{
+public:
+	explicit RecycledSubspace(size_t capacity);
+
+	/// <summary>
+	/// Makes AW and W^T A W consistent with A. Cheap when A is the matrix of the previous solve,
+	/// a different operator resets convergence. The fingerprint is the one of A taken by the caller
+	/// </summary>
+	void Bind(const SpMat& A, const MatrixFingerprint& fingerprint);
+
+	/// <summary>
+	/// Galerkin correction x += W (W^T A W)^-1 W^T r with the matching residual update,
+	/// afterwards r is orthogonal to W
+	/// </summary>
+	void Correct(Vec& x, Vec& r) const;
+
+	/// <summary>
+	/// v -= W (W^T A W)^-1 (AW)^T v, removes the components that are not A-orthogonal to W
+	/// </summary>
+	void Deflate(Vec& v) const;
+
+	/// <summary>
+	/// Rayleigh-Ritz on span[W, P] keeping the Ritz vectors with the smallest Ritz values.
+	/// The first `count` columns of P and AP hold search directions of the last solve
+	/// </summary>
+	void Update(const Eigen::MatrixXd& P, const Eigen::MatrixXd& AP, Eigen::Index count);
+
+	bool Empty() const
+	{
+		return m_W.cols() == 0;
+	}
+
+	bool IsConverged() const
+	{
+		return m_Converged;
+	}
+
+	size_t GetSize() const
+	{
+		return static_cast<size_t>(m_W.cols());
+	}
+
+	size_t GetCapacity() const
+	{
+		return m_Capacity;
+	}
+
+	size_t GetMemoryBytes() const
+	{
+		return static_cast<size_t>(m_W.size() + m_AW.size()) * sizeof(double);
+	}
+
+private:
+	void Factorize();
+
+	size_t m_Capacity;
+
+	Eigen::MatrixXd m_W;
+	Eigen::MatrixXd m_AW;
+	Eigen::LLT<Eigen::MatrixXd> m_E;
+	Eigen::VectorXd m_RitzValues;
+
+	MatrixFingerprint m_Operator;
+	bool m_Converged = false;
+
+	// Relative change of every kept Ritz value below which further updates are skipped
+	inline static constexpr double RitzTolerance = 1e-2;
+};
+
+} // namespace fem::solver::linear
@@ -0,0 +1,5 @@
+#pragma once
+
+#include "ConjugateGradientSolver.h"
+#include "DeflatedConjugateGradientSolver.h"
+#include "RecycledSubspace.h"
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "math/math.h"
+
+#include <string>
+
+namespace fem::solver::linear
+{
+
+/// <summary>
+/// Approximate inverse M^-1 of a symmetric positive definite matrix used by iterative solvers
+/// </summary>
+class IPreconditioner
+{
+public:
+	virtual ~IPreconditioner() = default;
+
+	/// <summary>
+	/// Build the preconditioner for A. Returns false if A is unsuitable (e.g. zero diagonal)
+	/// </summary>
+	virtual bool Compute(const SpMat& A) = 0;
+
+	/// <summary>
+	/// z = M^-1 * r
+	/// </summary>
+	virtual void Apply(const Vec& r, Vec& z) const = 0;
+
+	virtual std::string GetName() const = 0;
+};
+
+} // namespace fem::solver::linear
@@ -0,0 +1,18 @@
+#include "IncompleteCholeskyPreconditioner.h"
+
+namespace fem::solver::linear
+{
+
+bool IncompleteCholeskyPreconditioner::Compute(const SpMat& A)
+{
+	m_Factor.compute(A);
+
+	return m_Factor.info() == Eigen::Success;
+}
+
+void IncompleteCholeskyPreconditioner::Apply(const Vec& r, Vec& z) const
+{
+	z = m_Factor.solve(r);
+}
+
+} // namespace fem::solver::linear
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "IPreconditioner.h"
+
+#include <Eigen/IterativeLinearSolvers>
+
+namespace fem::solver::linear
+{
+
+class IncompleteCholeskyPreconditioner : public IPreconditioner
+{
+public:
+	bool Compute(const SpMat& A) override;
+
+	void Apply(const Vec& r, Vec& z) const override;
+
+	std::string GetName() const override
+	{
+		return "IncompleteCholesky";
+	}
+
+private:
+	Eigen::IncompleteCholesky<double, Eigen::Lower, Eigen::AMDOrdering<int>> m_Factor;
+};
+
+} // namespace fem::solver::linear
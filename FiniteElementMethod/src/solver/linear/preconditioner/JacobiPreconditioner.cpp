@@ -0,0 +1,23 @@
+#include "JacobiPreconditioner.h"
+
+namespace fem::solver::linear
+{
+
+bool JacobiPreconditioner::Compute(const SpMat& A)
+{
+	Vec diagonal = A.diagonal();
+
+	if ((diagonal.array() == 0.0).any())
+		return false;
+
+	m_InverseDiagonal = diagonal.cwiseInverse();
+
+	return true;
+}
+
+void JacobiPreconditioner::Apply(const Vec& r, Vec& z) const
+{
+	z = m_InverseDiagonal.cwiseProduct(r);
+}
+
+} // namespace fem::solver::linear
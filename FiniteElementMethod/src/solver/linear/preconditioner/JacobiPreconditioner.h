@@ -0,0 +1,24 @@
+#pragma once
+
+#include "IPreconditioner.h"
+
+namespace fem::solver::linear
+{
+
+class JacobiPreconditioner : public IPreconditioner
+{
+public:
+	bool Compute(const SpMat& A) override;
+
+	void Apply(const Vec& r, Vec& z) const override;
+
+	std::string GetName() const override
+	{
+		return "Jacobi";
+	}
+
+private:
+	Vec m_InverseDiagonal;
+};
+
+} // namespace fem::solver::linear
@@ -0,0 +1,42 @@
+#include "MultigridPreconditioner.h"
+
+#include "../multigrid/MultigridBuilder.h"
+
+#include "logger/logger.h"
+
+namespace fem::solver::linear
+{
+
+bool MultigridPreconditioner::Compute(const SpMat& A)
+{
+	auto levels = MultigridBuilder::BuildLevels(m_Coarsening, A, m_Options);
+
+	if (!levels)
+	{
+		LOG_ERROR("{} setup failed: {}", GetName(), levels.error().message);
+		return false;
+	}
+
+	if (auto res = m_Hierarchy.Setup(std::move(*levels), m_Options.smoother, m_Options.smootherSweeps); !res)
+	{
+		LOG_ERROR("{} setup failed: {}", GetName(), res.error().message);
+		return false;
+	}
+
+	m_Hierarchy.LogSummary();
+
+	return true;
+}
+
+void MultigridPreconditioner::Apply(const Vec& r, Vec& z) const
+{
+	z.setZero(r.size());
+	m_Hierarchy.VCycle(r, z);
+}
+
+std::string MultigridPreconditioner::GetName() const
+{
+	return std::string(MultigridBuilder::GetShortName(m_Coarsening));
+}
+
+} // namespace fem::solver::linear
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "IPreconditioner.h"
+
+#include "../LinearSolverOptions.h"
+#include "../multigrid/CoarseningType.h"
+#include "../multigrid/MultigridHierarchy.h"
+
+namespace fem::solver::linear
+{
+
+/// <summary>
+/// One multigrid V-cycle from a zero initial guess per application
+/// </summary>
+class MultigridPreconditioner : public IPreconditioner
+{
+public:
+	MultigridPreconditioner(const LinearSolverOptions& options, CoarseningType coarsening)
+		: m_Options(options),
+		m_Coarsening(coarsening)
+	{
+	}
+
+	bool Compute(const SpMat& A) override;
+
+	void Apply(const Vec& r, Vec& z) const override;
+
+	std::string GetName() const override;
+
+private:
+	LinearSolverOptions m_Options;
+	CoarseningType m_Coarsening;
+	MultigridHierarchy m_Hierarchy;
+};
+
+} // namespace fem::solver::linear
@@ -0,0 +1,45 @@
+#include "PreconditionerFactory.h"
+
+#include "IncompleteCholeskyPreconditioner.h"
+#include "JacobiPreconditioner.h"
+#include "MultigridPreconditioner.h"
+#include "SSORPreconditioner.h"
+#include "SchwarzPreconditioner.h"
+
+#include "logger/logger.h"
+
+namespace fem::solver::linear
+{
+
+std::unique_ptr<IPreconditioner> PreconditionerFactory::Create(PreconditionerType type, const LinearSolverOptions& options)
+{
+	using enum PreconditionerType;
+
+	switch (type)
+	{
+	case Jacobi:
+		return std::make_unique<JacobiPreconditioner>();
+
+	case SSOR:
+		return std::make_unique<SSORPreconditioner>(options.ssorOmega);
+
+	case IncompleteCholesky:
+		return std::make_unique<IncompleteCholeskyPreconditioner>();
+
+	case AMG:
+		return std::make_unique<MultigridPreconditioner>(options, CoarseningType::SmoothedAggregation);
+
+	case GMG:
+		return std::make_unique<MultigridPreconditioner>(options, CoarseningType::Geometric);
+
+	case Schwarz:
+		return std::make_unique<SchwarzPreconditioner>(options);
+
+	default:
+		LOG_ERROR("Unknown preconditioner type: {}", PreconditionerTypeToString(type));
+		std::unreachable();
+		std::abort();
+	}
+}
+
+} // namespace fem::solver::linear
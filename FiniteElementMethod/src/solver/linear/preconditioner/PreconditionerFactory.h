@@ -0,0 +1,22 @@
+#pragma once
+
+#include "IPreconditioner.h"
+#include "PreconditionerType.h"
+
+#include "../LinearSolverOptions.h"
+
+#include <memory>
+
+namespace fem::solver::linear
+{
+
+/// <summary>
+/// Factory for creating preconditioner instances
+/// </summary>
+class PreconditionerFactory
+{
+public:
+	static std::unique_ptr<IPreconditioner> Create(PreconditionerType type, const LinearSolverOptions& options);
+};
+
+} // namespace fem::solver::linear
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <array>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace fem::solver::linear
+{
+
+enum class PreconditionerType : int
+{
+	Jacobi = 0,
+	SSOR,
+	IncompleteCholesky,
+	AMG,
+	GMG,
+	Schwarz,
+};
+
+struct PreconditionerInfo
+{
+	PreconditionerType type;
+	std::string name;
+	std::string description;
+};
+
+inline static const std::array<PreconditionerInfo, 6> PRECONDITIONERS = { {
+	{ PreconditionerType::Jacobi,             "jacobi",  "Diagonal scaling (cheapest, fully parallel)" },
+	{ PreconditionerType::SSOR,               "ssor",    "Symmetric successive over-relaxation" },
+	{ PreconditionerType::IncompleteCholesky, "ic",      "Incomplete Cholesky with limited fill-in" },
+	{ PreconditionerType::AMG,                "amg",     "Smoothed-aggregation algebraic multigrid V-cycle (large meshes)" },
+	{ PreconditionerType::GMG,                "gmg",     "Geometric multigrid V-cycle (structured quad meshes only)" },
+	{ PreconditionerType::Schwarz,            "schwarz", "Overlapping additive Schwarz with coarse space, one direct solve per subdomain" }
+} };
+
+inline std::optional<PreconditionerType> ParsePreconditionerType(std::string_view str)
+{
+	using enum PreconditionerType;
+
+	if (str == "jacobi") return Jacobi;
+	else if (str == "ssor") return SSOR;
+	else if (str == "ic") return IncompleteCholesky;
+	else if (str == "amg") return AMG;
+	else if (str == "gmg") return GMG;
+	else if (str == "schwarz") return Schwarz;
+
+	return std::nullopt;
+}
+
+inline std::string_view PreconditionerTypeToString(PreconditionerType type)
+{
+	for (const auto& info : PRECONDITIONERS)
+		if (info.type == type)
+			return info.name;
+
+	std::unreachable();
+}
+
+} // namespace fem::solver::linear
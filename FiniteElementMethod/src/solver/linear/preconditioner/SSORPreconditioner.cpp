@@ -0,0 +1,36 @@
+#include "SSORPreconditioner.h"
+
+namespace fem::solver::linear
+{
+
+bool SSORPreconditioner::Compute(const SpMat& A)
+{
+	if (m_Omega <= 0.0 || m_Omega >= 2.0)
+		return false;
+
+	Vec diagonal = A.diagonal();
+
+	if ((diagonal.array() == 0.0).any())
+		return false;
+
+	m_ScaledDiagonal = diagonal / m_Omega;
+
+	m_Lower = A.triangularView<Eigen::Lower>();
+	m_Lower.diagonal() = m_ScaledDiagonal;
+
+	m_Upper = A.triangularView<Eigen::Upper>();
+	m_Upper.diagonal() = m_ScaledDiagonal;
+
+	return true;
+}
+
+void SSORPreconditioner::Apply(const Vec& r, Vec& z) const
+{
+	z = r;
+	m_Lower.triangularView<Eigen::Lower>().solveInPlace(z);
+	z = m_ScaledDiagonal.cwiseProduct(z);
+	m_Upper.triangularView<Eigen::Upper>().solveInPlace(z);
+	z *= (2.0 - m_Omega) / m_Omega;
+}
+
+} // namespace fem::solver::linear
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "IPreconditioner.h"
+
+namespace fem::solver::linear
+{
+
+/// <summary>
+/// M = w/(2-w) * (D/w + L) * (D/w)^-1 * (D/w + L^T), applied with one forward and one backward sweep
+/// </summary>
+class SSORPreconditioner : public IPreconditioner
+{
+public:
+	explicit SSORPreconditioner(double omega = 1.0)
+		: m_Omega(omega)
+	{
+	}
+
+	bool Compute(const SpMat& A) override;
+
+	void Apply(const Vec& r, Vec& z) const override;
+
+	std::string GetName() const override
+	{
+		return "SSOR";
+	}
+
+private:
+	double m_Omega;
+
+	SpMat m_Lower;        // lower triangle of A with diagonal replaced by D/w
+	SpMat m_Upper;        // upper triangle of A with diagonal replaced by D/w
+	Vec m_ScaledDiagonal; // D/w
+};
+
+} // namespace fem::solver::linear
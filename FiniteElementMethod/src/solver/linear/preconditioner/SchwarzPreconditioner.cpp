@@ -0,0 +1,61 @@
+#include "SchwarzPreconditioner.h"
+
+#include "logger/logger.h"
+
+#include <algorithm>
+#include <omp.h>
+
+namespace fem::solver::linear
+{
+
+bool SchwarzPreconditioner::Compute(const SpMat& A)
+{
+	if (m_Options.partition)
+	{
+		if (!m_Schwarz.Setup(A, *m_Options.partition, m_Options.overlap))
+			return false;
+	}
+	else
+	{
+		const size_t parts = std::min<size_t>(ResolveSubdomains(m_Options.subdomains), std::max<Eigen::Index>(A.rows(), 1));
+
+		LOG_WARN("No mesh partition provided, Schwarz falls back to {} contiguous row blocks", parts);
+
+		mesh::partition::MeshPartition blocks{
+			.parts = parts,
+			.nodePart = std::vector<std::uint32_t>(A.rows())
+		};
+
+		for (Eigen::Index i = 0; i < A.rows(); ++i)
+			blocks.nodePart[i] = static_cast<std::uint32_t>(i * static_cast<Eigen::Index>(parts) / A.rows());
+
+		if (!m_Schwarz.Setup(A, blocks, m_Options.overlap))
+			return false;
+	}
+
+	m_Schwarz.LogSummary(m_Options.overlap);
+
+	return true;
+}
+
+void SchwarzPreconditioner::Apply(const Vec& r, Vec& z) const
+{
+	m_Schwarz.Apply(r, z);
+}
+
+std::string SchwarzPreconditioner::GetName() const
+{
+	const size_t parts = m_Options.partition ? m_Options.partition->parts : ResolveSubdomains(m_Options.subdomains);
+
+	return std::format("Schwarz {}x{}", parts, m_Options.overlap);
+}
+
+size_t SchwarzPreconditioner::ResolveSubdomains(size_t requested)
+{
+	if (requested > 0)
+		return requested;
+
+	return std::max<size_t>(2, static_cast<size_t>(omp_get_max_threads()));
+}
+
+} // namespace fem::solver::linear
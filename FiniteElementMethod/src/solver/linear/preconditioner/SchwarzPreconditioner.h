@@ -0,0 +1,39 @@
+#pragma once
+
+#include "IPreconditioner.h"
+
+#include "../LinearSolverOptions.h"
+#include "../schwarz/AdditiveSchwarz.h"
+
+namespace fem::solver::linear
+{
+
+/// <summary>
+/// Two-level overlapping additive Schwarz. Uses the mesh partition from the options, or contiguous
+/// row blocks when none was provided
+/// </summary>
+class SchwarzPreconditioner : public IPreconditioner
+{
+public:
+	explicit SchwarzPreconditioner(const LinearSolverOptions& options)
+		: m_Options(options)
+	{
+	}
+
+	bool Compute(const SpMat& A) override;
+
+	void Apply(const Vec& r, Vec& z) const override;
+
+	std::string GetName() const override;
+
+	/// <summary>
+	/// Subdomain count requested by the options, 0 resolves to one per thread (at least 2)
+	/// </summary>
+	static size_t ResolveSubdomains(size_t requested);
+
+private:
+	LinearSolverOptions m_Options;
+	AdditiveSchwarz m_Schwarz;
+};
+
+} // namespace fem::solver::linear
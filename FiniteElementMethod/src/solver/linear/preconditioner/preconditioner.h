@@ -0,0 +1,10 @@
+#pragma once
+
+#include "IPreconditioner.h"
+#include "IncompleteCholeskyPreconditioner.h"
+#include "JacobiPreconditioner.h"
+#include "MultigridPreconditioner.h"
+#include "PreconditionerFactory.h"
+#include "PreconditionerType.h"
+#include "SSORPreconditioner.h"
+#include "SchwarzPreconditioner.h"
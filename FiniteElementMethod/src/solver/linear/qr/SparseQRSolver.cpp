@@ -76,7 +76,7 @@ std::expected<LinearSolverResult, SolverError> SparseQRSolver::Solve(const SpMat
 
 	auto end = Now();
 	stats.elapsedTimeMs = ElapsedMs(start, end);
-	stats.residualNorm = (A * x - b).norm();
+	stats.residualNorm = (b - A * x).norm();
 
 	return LinearSolverResult{
 		.solution = std::move(x),
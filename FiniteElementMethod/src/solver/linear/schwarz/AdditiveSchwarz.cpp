@@ -0,0 +1,263 @@
+#include "AdditiveSchwarz.h"
+
+#include "logger/logger.h"
+#include "utils/utils.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <omp.h>
+
+namespace fem::solver::linear
+{
+
+bool AdditiveSchwarz::Setup(const SpMat& A, const mesh::partition::MeshPartition& partition, size_t overlap)
+{
+	const Eigen::Index n = A.rows();
+
+	if (static_cast<Eigen::Index>(partition.nodePart.size()) != n)
+	{
+		LOG_ERROR("Partition covers {} nodes, matrix has {} rows", partition.nodePart.size(), n);
+		return false;
+	}
+
+	// Empty parts would make the coarse operator singular - renumber the non-empty ones
+	std::vector<std::uint32_t> partIndex(partition.parts, 0);
+	std::vector<std::size_t> partSizes = partition.GetPartSizes();
+	std::uint32_t parts = 0;
+
+	for (std::size_t p = 0; p < partition.parts; ++p)
+		partIndex[p] = partSizes[p] > 0 ? parts++ : 0;
+
+	m_RowPart.resize(n);
+	m_Subdomains = std::vector<Subdomain>(parts);
+
+	for (Eigen::Index i = 0; i < n; ++i)
+	{
+		m_RowPart[i] = partIndex[partition.nodePart[i]];
+		m_Subdomains[m_RowPart[i]].rows.push_back(i); // Core rows, grown by the overlap layers below
+	}
+
+	std::atomic<bool> factorized = true;
+
+#pragma omp parallel
+	{
+		std::vector<std::int64_t> marker(n, -1);
+		std::vector<Eigen::Index> localIndex(n, -1);
+
+#pragma omp for schedule(dynamic, 1)
+		for (std::int64_t s = 0; s < static_cast<std::int64_t>(parts); ++s)
+		{
+			BuildSubdomain(A, static_cast<size_t>(s), overlap, marker, localIndex);
+
+			if (m_Subdomains[s].factor.info() != Eigen::Success)
+				factorized = false;
+		}
+	}
+
+	if (!factorized)
+	{
+		LOG_ERROR("Subdomain factorization failed - matrix is not symmetric positive definite");
+		return false;
+	}
+
+	BuildOwners(n);
+
+	return BuildCoarseSpace(A);
+}
+
+void AdditiveSchwarz::BuildSubdomain(const SpMat& A, size_t index, size_t overlap, std::vector<std::int64_t>& marker, std::vector<Eigen::Index>& localIndex)
+{
+	auto& subdomain = m_Subdomains[index];
+	const auto tag = static_cast<std::int64_t>(index);
+
+	for (auto row : subdomain.rows)
+		marker[row] = tag;
+
+	// Each layer adds the matrix neighbours of the previous one; A is symmetric so inner vectors
+	// list the neighbours in either storage order
+	size_t layerBegin = 0;
+
+	for (size_t layer = 0; layer < overlap; ++layer)
+	{
+		const size_t layerEnd = subdomain.rows.size();
+
+		for (size_t k = layerBegin; k < layerEnd; ++k)
+		{
+			for (SpMat::InnerIterator it(A, subdomain.rows[k]); it; ++it)
+			{
+				if (marker[it.index()] != tag)
+				{
+					marker[it.index()] = tag;
+					subdomain.rows.push_back(it.index());
+				}
+			}
+		}
+
+		layerBegin = layerEnd;
+	}
+
+	std::sort(subdomain.rows.begin(), subdomain.rows.end());
+
+	const auto size = static_cast<Eigen::Index>(subdomain.rows.size());
+
+	for (Eigen::Index k = 0; k < size; ++k)
+		localIndex[subdomain.rows[k]] = k;
+
+	std::vector<Triplet> triplets;
+
+	for (Eigen::Index k = 0; k < size; ++k)
+	{
+		for (SpMat::InnerIterator it(A, subdomain.rows[k]); it; ++it)
+		{
+			Eigen::Index j = localIndex[it.index()];
+
+			if (j >= 0)
+				triplets.emplace_back(k, j, it.value());
+		}
+	}
+
+	for (auto row : subdomain.rows)
+		localIndex[row] = -1;
+
+	Eigen::SparseMatrix<double> local(size, size);
+	local.setFromTriplets(triplets.begin(), triplets.end());
+
+	subdomain.factor.compute(local);
+	subdomain.rhs.resize(size);
+	subdomain.solution.resize(size);
+}
+
+void AdditiveSchwarz::BuildOwners(Eigen::Index rows)
+{
+	m_OwnerStart.assign(rows + 1, 0);
+
+	for (const auto& subdomain : m_Subdomains)
+		for (auto row : subdomain.rows)
+			++m_OwnerStart[row + 1];
+
+	for (Eigen::Index i = 0; i < rows; ++i)
+		m_OwnerStart[i + 1] += m_OwnerStart[i];
+
+	m_Owners.resize(m_OwnerStart[rows]);
+
+	std::vector<Eigen::Index> next(m_OwnerStart.begin(), m_OwnerStart.end() - 1);
+
+	for (std::uint32_t s = 0; s < m_Subdomains.size(); ++s)
+	{
+		const auto& rowsOfSubdomain = m_Subdomains[s].rows;
+
+		for (std::uint32_t k = 0; k < rowsOfSubdomain.size(); ++k)
+			m_Owners[next[rowsOfSubdomain[k]]++] = { s, k };
+	}
+}
+
+bool AdditiveSchwarz::BuildCoarseSpace(const SpMat& A)
+{
+	const Eigen::Index parts = static_cast<Eigen::Index>(m_Subdomains.size());
+
+	// A_0 = Z^T A Z with Z the part indicators, so A_0(p, q) sums the entries coupling parts p and q
+	Mat coarse = Mat::Zero(parts, parts);
+
+#pragma omp parallel
+	{
+		Mat local = Mat::Zero(parts, parts);
+
+#pragma omp for schedule(static)
+		for (Eigen::Index k = 0; k < A.outerSize(); ++k)
+			for (SpMat::InnerIterator it(A, k); it; ++it)
+				local(m_RowPart[it.row()], m_RowPart[it.col()]) += it.value();
+
+#pragma omp critical
+		coarse += local;
+	}
+
+	m_Coarse.compute(coarse);
+
+	if (m_Coarse.info() != Eigen::Success || !m_Coarse.isPositive())
+	{
+		LOG_ERROR("Schwarz coarse operator is not positive definite");
+		return false;
+	}
+
+	return true;
+}
+
+void AdditiveSchwarz::Apply(const Vec& r, Vec& z) const
+{
+	const Eigen::Index n = r.size();
+	const Eigen::Index parts = static_cast<Eigen::Index>(m_Subdomains.size());
+
+	z.resize(n);
+
+#pragma omp parallel for schedule(dynamic, 1)
+	for (std::int64_t s = 0; s < static_cast<std::int64_t>(parts); ++s)
+	{
+		const auto& subdomain = m_Subdomains[s];
+
+		for (size_t k = 0; k < subdomain.rows.size(); ++k)
+			subdomain.rhs[k] = r[subdomain.rows[k]];
+
+		subdomain.solution = subdomain.factor.solve(subdomain.rhs);
+	}
+
+	Vec coarseRhs = Vec::Zero(parts);
+
+#pragma omp parallel
+	{
+		Vec local = Vec::Zero(parts);
+
+#pragma omp for schedule(static)
+		for (Eigen::Index i = 0; i < n; ++i)
+			local[m_RowPart[i]] += r[i];
+
+#pragma omp critical
+		coarseRhs += local;
+	}
+
+	Vec coarseSolution = m_Coarse.solve(coarseRhs);
+
+#pragma omp parallel for schedule(static)
+	for (Eigen::Index i = 0; i < n; ++i)
+	{
+		double sum = coarseSolution[m_RowPart[i]];
+
+		for (Eigen::Index k = m_OwnerStart[i]; k < m_OwnerStart[i + 1]; ++k)
+			sum += m_Subdomains[m_Owners[k].first].solution[m_Owners[k].second];
+
+		z[i] = sum;
+	}
+}
+
+size_t AdditiveSchwarz::GetFactorNonZeros() const
+{
+	size_t nonZeros = 0;
+
+	for (const auto& subdomain : m_Subdomains)
+		nonZeros += static_cast<size_t>(subdomain.factor.matrixL().nestedExpression().nonZeros());
+
+	return nonZeros;
+}
+
+void AdditiveSchwarz::LogSummary(size_t overlap) const
+{
+	size_t smallest = std::numeric_limits<size_t>::max();
+	size_t largest = 0;
+	size_t total = 0;
+
+	for (const auto& subdomain : m_Subdomains)
+	{
+		smallest = std::min(smallest, subdomain.rows.size());
+		largest = std::max(largest, subdomain.rows.size());
+		total += subdomain.rows.size();
+	}
+
+	const size_t factorBytes = GetFactorNonZeros() * (sizeof(double) + sizeof(int));
+
+	LOG_INFO("Additive Schwarz: {} subdomains, overlap {}, sizes {}..{} (avg {:.0f}), factors {:.2f} MB, coarse space {}",
+		m_Subdomains.size(), overlap, smallest, largest,
+		static_cast<double>(total) / std::max<size_t>(1, m_Subdomains.size()),
+		BytesToMiB(factorBytes), m_Subdomains.size());
+}
+
+} // namespace fem::solver::linear
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Subdomain.h"
+
+#include "math/math.h"
+#include "mesh/partition/MeshPartition.h"
+
+#include <Eigen/Dense>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace fem::solver::linear
+{
+
+/// <summary>
+/// Two-level additive Schwarz: z = sum_i R_i^T A_i^-1 R_i r + Z A_0^-1 Z^T r. Subdomains are the parts of
+/// a node partition grown by overlap layers of matrix neighbours; each one is factorized independently
+/// on its own thread. The coarse space holds one constant per part (Nicolaides), which keeps the
+/// iteration count from growing with the number of subdomains
+/// </summary>
+class AdditiveSchwarz
+{
+public:
+	bool Setup(const SpMat& A, const mesh::partition::MeshPartition& partition, size_t overlap);
+
+	void Apply(const Vec& r, Vec& z) const;
+
+	size_t GetSubdomainsCount() const
+	{
+		return m_Subdomains.size();
+	}
+
+	size_t GetFactorNonZeros() const;
+
+	void LogSummary(size_t overlap) const;
+
+private:
+	void BuildSubdomain(const SpMat& A, size_t index, size_t overlap, std::vector<std::int64_t>& marker, std::vector<Eigen::Index>& localIndex);
+	void BuildOwners(Eigen::Index rows);
+	bool BuildCoarseSpace(const SpMat& A);
+
+	std::vector<Subdomain> m_Subdomains;
+
+	// Subdomains holding each row as (subdomain, local index), CSR by row
+	std::vector<Eigen::Index> m_OwnerStart;
+	std::vector<std::pair<std::uint32_t, std::uint32_t>> m_Owners;
+
+	std::vector<std::uint32_t> m_RowPart;
+	Eigen::LDLT<Mat> m_Coarse;
+};
+
+} // namespace fem::solver::linear
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "math/math.h"
+
+#include <Eigen/SparseCholesky>
+
+#include <vector>
+
+namespace fem::solver::linear
+{
+
+/// <summary>
+/// One overlapping subdomain: its global rows and the direct factorization of A restricted to them
+/// </summary>
+struct Subdomain
+{
+	std::vector<Eigen::Index> rows; // Core rows plus overlap layers, ascending
+
+	Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>, Eigen::Lower, Eigen::AMDOrdering<int>> factor;
+
+	// Work vectors reused across applications
+	mutable Vec rhs;
+	mutable Vec solution;
+};
+
+} // namespace fem::solver::linear
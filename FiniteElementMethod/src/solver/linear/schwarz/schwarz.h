@@ -0,0 +1,4 @@
+#pragma once
+
+#include "AdditiveSchwarz.h"
+#include "Subdomain.h"
@@ -20,6 +20,7 @@ struct Options
 	fs::path directory;
 	fs::path matrixFile;
 	fs::path rhsFile;
+	bool binary = false;
 	fs::path solutionFile;
 	fs::path metricsFile;
 	bool useLU = false;
@@ -34,6 +35,8 @@ void PrintUsage(const char* name)
 		<< "The directory should contain:\n"
 		<< "  H.mtx  - stiffness matrix (Matrix Market format)\n"
 		<< "  P.txt  - load vector\n"
+		<< "or, preferred when present, the binary files of an --export-mtx directory or a cache entry:\n"
+		<< "  H.bin, P.bin\n"
 		<< "\n"
 		<< "Output:\n"
 		<< "  solution.txt - solution vector (saved in the same directory)\n"
@@ -58,8 +61,15 @@ bool ParseArgs(int argc, char* argv[], Options& opts)
 		return false;
 	}
 
-	opts.matrixFile = opts.directory / "H.mtx";
-	opts.rhsFile = opts.directory / "P.txt";
+	// Column-major builds export CSC binaries, their Matrix Market files are read instead
+	opts.binary = fs::exists(opts.directory / "H.bin") && fs::exists(opts.directory / "P.bin")
+		&& IsBinaryMatrixUsable((opts.directory / "H.bin").string());
+
+	if (!opts.binary && fs::exists(opts.directory / "H.bin"))
+		std::cerr << "Note: H.bin is not in a layout this solver reads, falling back to H.mtx and P.txt\n";
+
+	opts.matrixFile = opts.directory / (opts.binary ? "H.bin" : "H.mtx");
+	opts.rhsFile = opts.directory / (opts.binary ? "P.bin" : "P.txt");
 	opts.solutionFile = opts.directory / "solution.txt";
 
 	if (!fs::exists(opts.matrixFile))
@@ -149,10 +159,20 @@ int main(int argc, char* argv[])
 	SpMat H;
 	Vec P, T;
 
-	if (!LoadMatrixMarket(opts.matrixFile.string(), H))
-		return 1;
-	if (!LoadVector(opts.rhsFile.string(), P))
-		return 1;
+	if (opts.binary)
+	{
+		if (!LoadBinaryMatrix(opts.matrixFile.string(), H))
+			return 1;
+		if (!LoadBinaryVector(opts.rhsFile.string(), P))
+			return 1;
+	}
+	else
+	{
+		if (!LoadMatrixMarket(opts.matrixFile.string(), H))
+			return 1;
+		if (!LoadVector(opts.rhsFile.string(), P))
+			return 1;
+	}
 
 	SolverStats stats;
 	bool success = opts.useLU ? SolvePARDISO_LU(H, P, T, stats) : SolvePARDISO_LDLT(H, P, T, stats);
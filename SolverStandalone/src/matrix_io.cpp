@@ -1,15 +1,132 @@
 #include "matrix_io.h"
 
+#include <cstdint>
 #include <fstream>
 #include <sstream>
 #include <iostream>
 #include <iomanip>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <unsupported/Eigen/SparseExtra>
 
 namespace fem::solver::standalone
 {
 
+	namespace
+	{
+
+		// Mirrors FiniteElementMethod/src/cache/BinaryFormat.h
+		constexpr uint32_t BINARY_MAGIC = 0x424D4546;
+		constexpr uint16_t BINARY_VERSION = 1;
+		constexpr uint8_t KIND_SPARSE_MATRIX = 1;
+		constexpr uint8_t KIND_VECTOR = 2;
+
+		struct BinaryHeader
+		{
+			uint32_t magic;
+			uint16_t version;
+			uint8_t kind;
+			uint8_t indexWidth;
+			uint8_t scalarWidth;
+			uint8_t storageOrder;
+			uint8_t codec; // Compressed cache entries are not supported here
+			uint8_t reserved;
+			uint32_t blockSize;
+			int64_t rows;
+			int64_t cols;
+			int64_t count;
+			uint64_t sectionOffsets[3];
+			uint64_t sectionSizes[3];
+			uint64_t checksum;
+			uint8_t padding[32];
+		};
+
+		static_assert(sizeof(BinaryHeader) == 128);
+
+		struct Mapping
+		{
+			const char* data = nullptr;
+			size_t size = 0;
+
+			~Mapping()
+			{
+				if (data)
+					munmap(const_cast<char*>(data), size);
+			}
+		};
+
+		bool HasSolverLayout(const BinaryHeader& header)
+		{
+			return header.indexWidth == sizeof(SpMat::StorageIndex) && header.scalarWidth == sizeof(double) && header.storageOrder == 1;
+		}
+
+		const BinaryHeader* MapBinary(const std::string& filename, Mapping& mapping, uint8_t kind)
+		{
+			int fd = open(filename.c_str(), O_RDONLY);
+			if (fd < 0)
+			{
+				std::cerr << "Cannot open: " << filename << std::endl;
+				return nullptr;
+			}
+
+			struct stat info;
+			if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(BinaryHeader))
+			{
+				std::cerr << "Not a binary matrix file: " << filename << std::endl;
+				close(fd);
+				return nullptr;
+			}
+
+			void* data = mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+			close(fd);
+
+			if (data == MAP_FAILED)
+			{
+				std::cerr << "Cannot map: " << filename << std::endl;
+				return nullptr;
+			}
+
+			mapping.data = static_cast<const char*>(data);
+			mapping.size = info.st_size;
+
+			const auto* header = reinterpret_cast<const BinaryHeader*>(mapping.data);
+
+			if (header->magic != BINARY_MAGIC || header->version != BINARY_VERSION || header->kind != kind || header->codec != 0)
+			{
+				std::cerr << "Unsupported binary file format: " << filename << std::endl;
+				return nullptr;
+			}
+
+			for (int i = 0; i < 3; ++i)
+			{
+				if (header->sectionSizes[i] > mapping.size || header->sectionOffsets[i] > mapping.size - header->sectionSizes[i])
+				{
+					std::cerr << "Truncated binary file: " << filename << std::endl;
+					return nullptr;
+				}
+			}
+
+			return header;
+		}
+
+	}
+
+	bool IsBinaryMatrixUsable(const std::string& filename)
+	{
+		std::ifstream file(filename, std::ios::binary);
+
+		BinaryHeader header;
+		if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+			return false;
+
+		return header.magic == BINARY_MAGIC && header.version == BINARY_VERSION && header.kind == KIND_SPARSE_MATRIX
+			&& header.codec == 0 && HasSolverLayout(header);
+	}
+
 	bool LoadMatrixMarket(const std::string& filename, SpMat& matrix)
 	{
 		if (!Eigen::loadMarket(matrix, filename))
@@ -50,6 +167,51 @@ namespace fem::solver::standalone
 		return true;
 	}
 
+	bool LoadBinaryMatrix(const std::string& filename, SpMat& matrix)
+	{
+		Mapping mapping;
+		const auto* header = MapBinary(filename, mapping, KIND_SPARSE_MATRIX);
+		if (!header)
+			return false;
+
+		if (!HasSolverLayout(*header))
+		{
+			std::cerr << "Matrix must be stored as CSR with " << sizeof(SpMat::StorageIndex) << "-byte indices: " << filename << std::endl;
+			return false;
+		}
+
+		Eigen::Map<const SpMat> view(header->rows, header->cols, header->count,
+			reinterpret_cast<const SpMat::StorageIndex*>(mapping.data + header->sectionOffsets[0]),
+			reinterpret_cast<const SpMat::StorageIndex*>(mapping.data + header->sectionOffsets[1]),
+			reinterpret_cast<const double*>(mapping.data + header->sectionOffsets[2]));
+
+		// PARDISO takes an owning matrix, so the mapped arrays are copied once instead of parsed
+		matrix = view;
+
+		std::cout << "Matrix loaded: " << matrix.rows() << "x" << matrix.cols()
+			<< ", " << matrix.nonZeros() << " nnz (binary)" << std::endl;
+		return true;
+	}
+
+	bool LoadBinaryVector(const std::string& filename, Vec& vec)
+	{
+		Mapping mapping;
+		const auto* header = MapBinary(filename, mapping, KIND_VECTOR);
+		if (!header)
+			return false;
+
+		if (header->scalarWidth != sizeof(double))
+		{
+			std::cerr << "Vector must be stored in double precision: " << filename << std::endl;
+			return false;
+		}
+
+		vec = Eigen::Map<const Vec>(reinterpret_cast<const double*>(mapping.data + header->sectionOffsets[0]), header->count);
+
+		std::cout << "Vector loaded: " << vec.size() << " elements (binary)" << std::endl;
+		return true;
+	}
+
 	bool SaveVector(const std::string& filename, const Vec& vec)
 	{
 		std::ofstream file(filename);
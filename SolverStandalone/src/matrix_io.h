@@ -8,6 +8,14 @@ namespace fem::solver::standalone
 
 bool LoadMatrixMarket(const std::string& filename, SpMat& matrix);
 bool LoadVector(const std::string& filename, Vec& vec);
+
+// Cache .bin files of the main application (H.bin, P.bin), read through mmap without parsing
+bool LoadBinaryMatrix(const std::string& filename, SpMat& matrix);
+bool LoadBinaryVector(const std::string& filename, Vec& vec);
+
+// Whether LoadBinaryMatrix can read the file: uncompressed CSR with this build's index width
+bool IsBinaryMatrixUsable(const std::string& filename);
+
 bool SaveVector(const std::string& filename, const Vec& vec);
 
 } // namespace fem::solver::standalone
@@ -5,6 +5,7 @@ local debugLibraries = {
   "spdlogd",
   "gmsh.dll.lib",
   "xxhash",
+  "zstd",
   "mkl_intel_lp64",
   "mkl_intel_thread",
   "mkl_core",
@@ -16,12 +17,18 @@ local releaseLibraries = {
   "spdlog",
   "gmsh.dll.lib",
   "xxhash",
+  "zstd",
   "mkl_intel_lp64",
   "mkl_intel_thread",
   "mkl_core",
   "libiomp5md"
 }
 
+newoption {
+  trigger = "with-mpi",
+  description = "Build with MPI for distributed-memory runs (mpirun -np N)"
+}
+
 workspace "FiniteElementMethod"
   architecture "x64"
   startproject "App"
@@ -42,6 +49,18 @@ workspace "FiniteElementMethod"
     linkoptions { "-fopenmp" }
   filter {}
 
+  -- MS-MPI SDK on Windows, flags reported by the Open MPI compiler wrapper on Linux
+  filter { "options:with-mpi" }
+    defines { "FEM_USE_MPI" }
+  filter { "options:with-mpi", "system:windows" }
+    externalincludedirs { "$(MSMPI_INC)", "$(MSMPI_INC)/x64" }
+    libdirs { "$(MSMPI_LIB64)" }
+    links { "msmpi" }
+  filter { "options:with-mpi", "system:linux" }
+    buildoptions { os.outputof("mpicxx --showme:compile") or "" }
+    linkoptions { os.outputof("mpicxx --showme:link") or "" }
+  filter {}
+
   OutputDir = "%{_WORKING_DIR}/build/bin/%{cfg.buildcfg}-%{cfg.system}-%{cfg.architecture}"
   IntermediateDir = "%{_WORKING_DIR}/build/bin/int/%{cfg.buildcfg}-%{cfg.system}-%{cfg.architecture}"
 